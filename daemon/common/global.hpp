@@ -32,6 +32,8 @@
 
 namespace nfd {
 
+class TimerWheel;
+
 /**
  * \brief Returns the global io_context instance for the calling thread.
  */
@@ -44,6 +46,14 @@ getGlobalIoService();
 ndn::Scheduler&
 getScheduler();
 
+/**
+ * \brief Returns the global TimerWheel instance for the calling thread.
+ *
+ * The wheel is driven by getScheduler().
+ */
+TimerWheel&
+getTimerWheel();
+
 boost::asio::io_context&
 getMainIoService();
 
@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2023,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/slab-pool.hpp"
+
+#include <new>
+
+namespace nfd {
+
+static size_t
+roundUp(size_t size, size_t alignment)
+{
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * \brief Header at the start of each slab.
+ */
+struct SlabPool::Slab
+{
+  Slab* prev = nullptr;
+  Slab* next = nullptr;
+  FreeBlock* freeList = nullptr;
+  size_t nFreeBlocks = 0;
+  size_t index = 0; ///< position in m_slabs
+};
+
+SlabPool::SlabPool(size_t blockSize, size_t maxFreeSlabs)
+  : m_blockSize(roundUp(std::max(blockSize, sizeof(FreeBlock)), BLOCK_ALIGNMENT))
+  , m_slabSize(SLAB_SIZE)
+  , m_blocksOffset(roundUp(sizeof(Slab), BLOCK_ALIGNMENT))
+  , m_maxFreeSlabs(maxFreeSlabs)
+{
+  // the slab size is a power of two, so that a block can find its slab by masking its address
+  while (m_slabSize < m_blocksOffset + m_blockSize) {
+    m_slabSize *= 2;
+  }
+  m_nBlocksPerSlab = (m_slabSize - m_blocksOffset) / m_blockSize;
+}
+
+SlabPool::~SlabPool()
+{
+  BOOST_ASSERT_MSG(m_nBlocksInUse == 0, "SlabPool destroyed while blocks are in use");
+  for (Slab* slab : m_slabs) {
+    slab->~Slab();
+    ::operator delete(slab, std::align_val_t(m_slabSize));
+  }
+}
+
+SlabPool::Slab*
+SlabPool::getSlab(void* block) const noexcept
+{
+  return reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(block) & ~(m_slabSize - 1));
+}
+
+void
+SlabPool::pushFront(Slab*& list, Slab* slab) noexcept
+{
+  slab->prev = nullptr;
+  slab->next = list;
+  if (list != nullptr) {
+    list->prev = slab;
+  }
+  list = slab;
+}
+
+void
+SlabPool::unlink(Slab*& list, Slab* slab) noexcept
+{
+  if (slab->prev != nullptr) {
+    slab->prev->next = slab->next;
+  }
+  else {
+    list = slab->next;
+  }
+  if (slab->next != nullptr) {
+    slab->next->prev = slab->prev;
+  }
+  slab->prev = slab->next = nullptr;
+}
+
+SlabPool::Slab*
+SlabPool::addSlab()
+{
+  m_slabs.reserve(m_slabs.size() + 1);
+  void* memory = ::operator new(m_slabSize, std::align_val_t(m_slabSize));
+  auto slab = new (memory) Slab;
+  slab->index = m_slabs.size();
+  m_slabs.push_back(slab);
+
+  // thread the new blocks onto the free list so that they are handed out in address order
+  auto blocks = static_cast<std::byte*>(memory) + m_blocksOffset;
+  for (size_t i = m_nBlocksPerSlab; i > 0; --i) {
+    auto block = reinterpret_cast<FreeBlock*>(blocks + (i - 1) * m_blockSize);
+    block->next = slab->freeList;
+    slab->freeList = block;
+  }
+  slab->nFreeBlocks = m_nBlocksPerSlab;
+
+  pushFront(m_freeSlabs, slab);
+  ++m_nFreeSlabs;
+  return slab;
+}
+
+void
+SlabPool::releaseSlab(Slab* slab) noexcept
+{
+  BOOST_ASSERT(m_slabs[slab->index] == slab);
+  m_slabs[slab->index] = m_slabs.back();
+  m_slabs[slab->index]->index = slab->index;
+  m_slabs.pop_back();
+
+  slab->~Slab();
+  ::operator delete(slab, std::align_val_t(m_slabSize));
+  ++m_nSlabsReleased;
+}
+
+void*
+SlabPool::allocate()
+{
+  // fill partially used slabs first, so that free slabs stay free and can be released
+  Slab* slab = m_partialSlabs != nullptr ? m_partialSlabs : m_freeSlabs;
+  if (slab == nullptr) {
+    slab = addSlab();
+  }
+
+  if (slab->nFreeBlocks == m_nBlocksPerSlab) {
+    unlink(m_freeSlabs, slab);
+    --m_nFreeSlabs;
+    if (m_nBlocksPerSlab > 1) {
+      pushFront(m_partialSlabs, slab);
+    }
+  }
+  else if (slab->nFreeBlocks == 1) {
+    unlink(m_partialSlabs, slab);
+  }
+
+  FreeBlock* block = slab->freeList;
+  slab->freeList = block->next;
+  --slab->nFreeBlocks;
+  ++m_nBlocksInUse;
+  ++m_nAllocations;
+  return block;
+}
+
+void
+SlabPool::deallocate(void* p) noexcept
+{
+  BOOST_ASSERT(p != nullptr);
+  BOOST_ASSERT(m_nBlocksInUse > 0);
+
+  Slab* slab = getSlab(p);
+  auto block = static_cast<FreeBlock*>(p);
+  block->next = slab->freeList;
+  slab->freeList = block;
+  ++slab->nFreeBlocks;
+  --m_nBlocksInUse;
+
+  if (slab->nFreeBlocks == m_nBlocksPerSlab) {
+    if (m_nBlocksPerSlab > 1) {
+      unlink(m_partialSlabs, slab);
+    }
+    if (m_nFreeSlabs < m_maxFreeSlabs) {
+      pushFront(m_freeSlabs, slab);
+      ++m_nFreeSlabs;
+    }
+    else {
+      releaseSlab(slab);
+    }
+  }
+  else if (slab->nFreeBlocks == 1) {
+    pushFront(m_partialSlabs, slab);
+  }
+}
+
+SlabPool*
+SlabPoolSet::getPool(size_t size, size_t alignment)
+{
+  if (size == 0 || size > MAX_BLOCK_SIZE || alignment > SlabPool::BLOCK_ALIGNMENT) {
+    return nullptr;
+  }
+
+  auto& pool = m_pools[(size - 1) / SlabPool::BLOCK_ALIGNMENT];
+  if (pool == nullptr) {
+    pool = make_unique<SlabPool>(roundUp(size, SlabPool::BLOCK_ALIGNMENT));
+  }
+  return pool.get();
+}
+
+} // namespace nfd
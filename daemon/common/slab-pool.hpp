@@ -0,0 +1,289 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2023,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_SLAB_POOL_HPP
+#define NFD_DAEMON_COMMON_SLAB_POOL_HPP
+
+#include "core/common.hpp"
+
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <boost/smart_ptr/intrusive_ref_counter.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace nfd {
+
+/**
+ * \brief A pool of fixed-size memory blocks carved out of large slabs.
+ *
+ * Each slab is aligned to its size and begins with a header that holds the free list of its
+ * blocks, so that a block is returned to its own slab in constant time. Allocations are served
+ * from partially used slabs first. When a slab becomes completely free, it is kept for reuse
+ * if fewer than `maxFreeSlabs` slabs are free, and returned to the system otherwise.
+ * All blocks must be deallocated before the pool is destroyed.
+ *
+ * \warning This class is not thread-safe.
+ */
+class SlabPool : noncopyable
+{
+public:
+  /** \brief Minimum size of each slab, in bytes.
+   */
+  static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+  /** \brief Alignment of every block returned by allocate().
+   */
+  static constexpr size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+
+  /** \brief Default number of completely free slabs kept for reuse.
+   */
+  static constexpr size_t DEFAULT_MAX_FREE_SLABS = 2;
+
+  /** \param blockSize size of each block, will be rounded up to a multiple of BLOCK_ALIGNMENT
+   *  \param maxFreeSlabs number of completely free slabs kept for reuse; further free slabs
+   *                      are returned to the system
+   */
+  explicit
+  SlabPool(size_t blockSize, size_t maxFreeSlabs = DEFAULT_MAX_FREE_SLABS);
+
+  ~SlabPool();
+
+  /** \brief Allocate one block.
+   *  \throw std::bad_alloc a new slab cannot be obtained
+   */
+  void*
+  allocate();
+
+  /** \brief Return a block previously obtained from allocate().
+   */
+  void
+  deallocate(void* block) noexcept;
+
+  size_t
+  getBlockSize() const noexcept
+  {
+    return m_blockSize;
+  }
+
+  size_t
+  getNBlocksPerSlab() const noexcept
+  {
+    return m_nBlocksPerSlab;
+  }
+
+  /** \return number of slabs currently obtained from the system
+   */
+  size_t
+  getNSlabs() const noexcept
+  {
+    return m_slabs.size();
+  }
+
+  /** \return number of bytes held in slabs, including free blocks and slab headers
+   */
+  size_t
+  getNBytesReserved() const noexcept
+  {
+    return m_slabs.size() * m_slabSize;
+  }
+
+  /** \return number of blocks currently handed out
+   */
+  size_t
+  getNBlocksInUse() const noexcept
+  {
+    return m_nBlocksInUse;
+  }
+
+  /** \return total number of allocate() calls since construction
+   */
+  uint64_t
+  getNAllocations() const noexcept
+  {
+    return m_nAllocations;
+  }
+
+  /** \return number of completely free slabs returned to the system since construction
+   */
+  uint64_t
+  getNSlabsReleased() const noexcept
+  {
+    return m_nSlabsReleased;
+  }
+
+private:
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  struct Slab;
+
+  Slab*
+  getSlab(void* block) const noexcept;
+
+  Slab*
+  addSlab();
+
+  void
+  releaseSlab(Slab* slab) noexcept;
+
+  static void
+  pushFront(Slab*& list, Slab* slab) noexcept;
+
+  static void
+  unlink(Slab*& list, Slab* slab) noexcept;
+
+private:
+  size_t m_blockSize;
+  size_t m_slabSize;
+  size_t m_blocksOffset;
+  size_t m_nBlocksPerSlab;
+  size_t m_maxFreeSlabs;
+
+  std::vector<Slab*> m_slabs;
+  Slab* m_partialSlabs = nullptr; ///< slabs with both used and free blocks
+  Slab* m_freeSlabs = nullptr; ///< slabs with no used blocks
+  size_t m_nFreeSlabs = 0;
+
+  size_t m_nBlocksInUse = 0;
+  uint64_t m_nAllocations = 0;
+  uint64_t m_nSlabsReleased = 0;
+};
+
+/**
+ * \brief A set of SlabPools, one per size class.
+ *
+ * Size classes are multiples of SlabPool::BLOCK_ALIGNMENT up to MAX_BLOCK_SIZE.
+ * Pools are created on first use. A SlabPoolSet is shared by the tables of one Forwarder
+ * through reference counting, so that it outlives every container allocating from it.
+ *
+ * \warning This class is not thread-safe.
+ */
+class SlabPoolSet : public boost::intrusive_ref_counter<SlabPoolSet, boost::thread_unsafe_counter>,
+                    noncopyable
+{
+public:
+  static constexpr size_t MAX_BLOCK_SIZE = 1024;
+
+  /** \brief Return the pool serving objects of \p size bytes with \p alignment.
+   *  \return the pool, or nullptr if \p size or \p alignment is not supported
+   */
+  SlabPool*
+  getPool(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  /** \brief Invoke \p f on each pool that has been created, in increasing block size order.
+   */
+  template<typename F>
+  void
+  forEach(F&& f) const
+  {
+    for (const auto& pool : m_pools) {
+      if (pool != nullptr) {
+        f(*pool);
+      }
+    }
+  }
+
+private:
+  std::array<unique_ptr<SlabPool>, MAX_BLOCK_SIZE / SlabPool::BLOCK_ALIGNMENT> m_pools;
+};
+
+/**
+ * \brief Standard-conforming allocator that obtains single objects from a SlabPoolSet.
+ *
+ * Array allocations, over-aligned or oversized types, and allocators constructed without
+ * a SlabPoolSet fall back to the global operator new.
+ */
+template<typename T>
+class SlabAllocator
+{
+public:
+  using value_type = T;
+
+  SlabAllocator() noexcept = default;
+
+  explicit
+  SlabAllocator(boost::intrusive_ptr<SlabPoolSet> pools)
+    : m_pools(std::move(pools))
+    , m_pool(m_pools == nullptr ? nullptr : m_pools->getPool(sizeof(T), alignof(T)))
+  {
+  }
+
+  template<typename U>
+  SlabAllocator(const SlabAllocator<U>& other)
+    : SlabAllocator(other.getPoolSet())
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    if (m_pool != nullptr && n == 1) {
+      return static_cast<T*>(m_pool->allocate());
+    }
+    return std::allocator<T>().allocate(n);
+  }
+
+  void
+  deallocate(T* p, size_t n) noexcept
+  {
+    if (m_pool != nullptr && n == 1) {
+      m_pool->deallocate(p);
+    }
+    else {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  const boost::intrusive_ptr<SlabPoolSet>&
+  getPoolSet() const noexcept
+  {
+    return m_pools;
+  }
+
+  template<typename U>
+  friend bool
+  operator==(const SlabAllocator& lhs, const SlabAllocator<U>& rhs) noexcept
+  {
+    return lhs.m_pools == rhs.getPoolSet();
+  }
+
+  template<typename U>
+  friend bool
+  operator!=(const SlabAllocator& lhs, const SlabAllocator<U>& rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  boost::intrusive_ptr<SlabPoolSet> m_pools;
+  SlabPool* m_pool = nullptr;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_SLAB_POOL_HPP
@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_SPSC_QUEUE_HPP
+#define NFD_DAEMON_COMMON_SPSC_QUEUE_HPP
+
+#include "core/common.hpp"
+
+#include <atomic>
+
+namespace nfd {
+
+/**
+ * \brief A bounded lock-free queue between one producer thread and one consumer thread.
+ *
+ * Items are stored in a ring whose capacity is a power of two. push() must only be called
+ * by the producer, and pop() and consumeAll() must only be called by the consumer.
+ * The head and tail indices are on separate cache lines, and each side caches the index
+ * owned by the other side, so that the cache line of the other side is read only when
+ * the queue appears full or empty.
+ *
+ * \tparam T item type, which must be default-constructible and move-assignable;
+ *           a popped slot is reset to `T{}`, so that resources held by the item are released
+ */
+template<typename T>
+class SpscQueue : noncopyable
+{
+public:
+  /** \param capacity minimum number of items the queue can hold, will be rounded up to
+   *                  a power of two
+   */
+  explicit
+  SpscQueue(size_t capacity)
+    : m_mask(roundUpToPowerOfTwo(std::max<size_t>(capacity, 2)) - 1)
+    , m_slots(make_unique<T[]>(m_mask + 1))
+  {
+  }
+
+  size_t
+  capacity() const noexcept
+  {
+    return m_mask + 1;
+  }
+
+  /** \brief Append an item; called by the producer.
+   *  \retval false the queue is full, and \p item is left unchanged
+   */
+  bool
+  push(T&& item)
+  {
+    size_t tail = m_producer.tail.load(std::memory_order_relaxed);
+    if (tail - m_producer.cachedHead > m_mask) {
+      m_producer.cachedHead = m_consumer.head.load(std::memory_order_acquire);
+      if (tail - m_producer.cachedHead > m_mask) {
+        return false;
+      }
+    }
+    m_slots[tail & m_mask] = std::move(item);
+    m_producer.tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** \brief Remove the first item; called by the consumer.
+   *  \retval false the queue is empty
+   */
+  bool
+  pop(T& item)
+  {
+    size_t head = m_consumer.head.load(std::memory_order_relaxed);
+    if (head == m_consumer.cachedTail) {
+      m_consumer.cachedTail = m_producer.tail.load(std::memory_order_acquire);
+      if (head == m_consumer.cachedTail) {
+        return false;
+      }
+    }
+    item = std::exchange(m_slots[head & m_mask], T{});
+    m_consumer.head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** \brief Remove all items present when the call begins, passing each to \p f; called by the consumer.
+   *  \param f a callable that accepts `T&&`
+   *  \return number of items removed
+   *
+   *  The slots are released to the producer together, after the last item has been processed.
+   */
+  template<typename F>
+  size_t
+  consumeAll(F&& f)
+  {
+    size_t head = m_consumer.head.load(std::memory_order_relaxed);
+    size_t tail = m_consumer.cachedTail = m_producer.tail.load(std::memory_order_acquire);
+    for (size_t i = head; i != tail; ++i) {
+      f(std::exchange(m_slots[i & m_mask], T{}));
+    }
+    m_consumer.head.store(tail, std::memory_order_release);
+    return tail - head;
+  }
+
+  /** \brief Return whether the queue is empty.
+   *  \note The result is exact only when neither side is concurrently modifying the queue.
+   */
+  bool
+  empty() const noexcept
+  {
+    return m_consumer.head.load(std::memory_order_acquire) ==
+           m_producer.tail.load(std::memory_order_acquire);
+  }
+
+private:
+  static constexpr size_t
+  roundUpToPowerOfTwo(size_t n) noexcept
+  {
+    size_t p = 1;
+    while (p < n) {
+      p <<= 1;
+    }
+    return p;
+  }
+
+private:
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  const size_t m_mask;
+  unique_ptr<T[]> m_slots;
+
+  struct alignas(CACHE_LINE_SIZE) ProducerSide
+  {
+    std::atomic<size_t> tail{0};
+    size_t cachedHead = 0; ///< last observed value of ConsumerSide::head
+  } m_producer;
+
+  struct alignas(CACHE_LINE_SIZE) ConsumerSide
+  {
+    std::atomic<size_t> head{0};
+    size_t cachedTail = 0; ///< last observed value of ProducerSide::tail
+  } m_consumer;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_SPSC_QUEUE_HPP
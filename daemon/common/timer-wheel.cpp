@@ -0,0 +1,266 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/timer-wheel.hpp"
+
+#include <algorithm>
+
+namespace nfd {
+
+static_assert(TimerWheel::N_SLOTS % 64 == 0);
+static_assert(TimerWheel::SLOT_BITS * TimerWheel::N_LEVELS < 64);
+
+/** \return the first set bit in \p bitmap at or after position \p from, or N_SLOTS if none
+ */
+template<size_t N>
+static size_t
+findNextSetBit(const std::array<uint64_t, N>& bitmap, size_t from)
+{
+  for (size_t word = from / 64; word < N; ++word) {
+    uint64_t bits = bitmap[word];
+    if (word == from / 64) {
+      bits &= ~uint64_t{0} << (from % 64);
+    }
+    if (bits != 0) {
+      return word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+    }
+  }
+  return N * 64;
+}
+
+void
+TimerWheel::Timer::cancel()
+{
+  if (!m_hook.is_linked()) {
+    return;
+  }
+  m_wheel->remove(*this);
+
+  // the callback may own the object containing this timer, so release it last
+  std::function<void()> callback;
+  callback.swap(m_callback);
+}
+
+TimerWheel::TimerWheel(ndn::Scheduler& scheduler, time::nanoseconds tick)
+  : m_scheduler(scheduler)
+  , m_tick(tick)
+  , m_epoch(time::steady_clock::now())
+{
+  BOOST_ASSERT(m_tick > time::nanoseconds::zero());
+}
+
+TimerWheel::~TimerWheel()
+{
+  for (auto& level : m_levels) {
+    for (auto& slot : level.slots) {
+      while (!slot.empty()) {
+        Timer& timer = slot.front();
+        slot.pop_front();
+        --m_nPending;
+        std::function<void()> callback;
+        callback.swap(timer.m_callback);
+      }
+    }
+  }
+}
+
+TimerWheel::Tick
+TimerWheel::toTick(time::steady_clock::time_point tp) const
+{
+  if (tp <= m_epoch) {
+    return 0;
+  }
+  return static_cast<Tick>((tp - m_epoch) / m_tick);
+}
+
+void
+TimerWheel::schedule(Timer& timer, time::nanoseconds after, std::function<void()> callback)
+{
+  timer.cancel();
+
+  auto now = time::steady_clock::now();
+  if (m_nPending == 0 && !m_isAdvancing) {
+    // nothing to process in between, skip idle ticks
+    m_current = std::max(m_current, toTick(now));
+  }
+
+  // round up, so that the timer never fires early
+  auto sinceEpoch = now + std::max(after, time::nanoseconds::zero()) - m_epoch;
+  auto expiry = static_cast<Tick>((sinceEpoch.count() + m_tick.count() - 1) / m_tick.count());
+
+  timer.m_wheel = this;
+  timer.m_callback = std::move(callback);
+  timer.m_expiry = std::max(expiry, m_current + 1);
+  insert(timer);
+  ++m_nPending;
+
+  if (!m_isAdvancing && (!m_driver || timer.m_expiry < m_armedTick)) {
+    arm();
+  }
+}
+
+void
+TimerWheel::insert(Timer& timer)
+{
+  BOOST_ASSERT(timer.m_expiry >= m_current);
+  Tick delta = timer.m_expiry - m_current;
+  Tick position = timer.m_expiry;
+
+  size_t level = 0;
+  while (level < N_LEVELS - 1 && delta >= (Tick{1} << (SLOT_BITS * (level + 1)))) {
+    ++level;
+  }
+  if (delta >= (Tick{1} << (SLOT_BITS * N_LEVELS))) {
+    // beyond the range of the wheel: park in the farthest top-level slot, to be cascaded again
+    position = m_current + (Tick{1} << (SLOT_BITS * N_LEVELS)) - 1;
+  }
+
+  size_t slot = (position >> (SLOT_BITS * level)) & (N_SLOTS - 1);
+  timer.m_level = static_cast<uint8_t>(level);
+  timer.m_slot = static_cast<uint8_t>(slot);
+  m_levels[level].slots[slot].push_back(timer);
+  m_levels[level].occupied[slot / 64] |= uint64_t{1} << (slot % 64);
+}
+
+void
+TimerWheel::remove(Timer& timer)
+{
+  timer.m_hook.unlink();
+  --m_nPending;
+
+  Level& level = m_levels[timer.m_level];
+  if (level.slots[timer.m_slot].empty()) {
+    level.occupied[timer.m_slot / 64] &= ~(uint64_t{1} << (timer.m_slot % 64));
+  }
+}
+
+std::optional<TimerWheel::Tick>
+TimerWheel::findNextTick() const
+{
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    const auto& occupied = m_levels[level].occupied;
+    size_t shift = SLOT_BITS * level;
+    size_t current = (m_current >> shift) & (N_SLOTS - 1);
+    Tick rotationStart = m_current >> (shift + SLOT_BITS) << (shift + SLOT_BITS);
+
+    // slots after the current one hold timers of the current rotation of this level;
+    // at level 0 they expire there, at higher levels they are cascaded at the start of the slot
+    size_t next = findNextSetBit(occupied, current + 1);
+    if (next < N_SLOTS) {
+      return rotationStart + (Tick{next} << shift);
+    }
+    // other slots hold timers of the next rotation, which starts with a cascade from above
+    if (std::any_of(occupied.begin(), occupied.end(), [] (uint64_t bits) { return bits != 0; })) {
+      return rotationStart + (Tick{N_SLOTS} << shift);
+    }
+  }
+  return std::nullopt;
+}
+
+void
+TimerWheel::arm()
+{
+  auto next = findNextTick();
+  if (!next) {
+    m_driver.cancel();
+    return;
+  }
+  if (m_driver && *next == m_armedTick) {
+    return;
+  }
+
+  m_armedTick = *next;
+  auto delay = m_epoch + m_tick * static_cast<time::nanoseconds::rep>(m_armedTick) -
+               time::steady_clock::now();
+  m_driver = m_scheduler.schedule(std::max(delay, time::nanoseconds::zero()), [this] { advance(); });
+}
+
+void
+TimerWheel::advance()
+{
+  m_isAdvancing = true;
+
+  Tick now = toTick(time::steady_clock::now());
+  while (m_current < now) {
+    auto next = findNextTick();
+    if (!next || *next > now) {
+      m_current = now;
+      break;
+    }
+    m_current = *next;
+
+    if ((m_current & (N_SLOTS - 1)) == 0) {
+      // entering a new rotation of level 0: cascade from the highest level whose slot starts here
+      size_t top = 1;
+      while (top < N_LEVELS - 1 &&
+             (m_current & ((Tick{1} << (SLOT_BITS * (top + 1))) - 1)) == 0) {
+        ++top;
+      }
+      for (size_t level = top; level > 0; --level) {
+        cascade(level, (m_current >> (SLOT_BITS * level)) & (N_SLOTS - 1));
+      }
+    }
+    expire(m_current & (N_SLOTS - 1));
+  }
+
+  m_isAdvancing = false;
+  arm();
+}
+
+void
+TimerWheel::cascade(size_t level, size_t slot)
+{
+  TimerList timers;
+  timers.swap(m_levels[level].slots[slot]);
+  m_levels[level].occupied[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+
+  while (!timers.empty()) {
+    Timer& timer = timers.front();
+    timers.pop_front();
+    insert(timer);
+  }
+}
+
+void
+TimerWheel::expire(size_t slot)
+{
+  TimerList timers;
+  timers.swap(m_levels[0].slots[slot]);
+  m_levels[0].occupied[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+
+  // a callback may cancel or reschedule timers that are still in the list
+  while (!timers.empty()) {
+    Timer& timer = timers.front();
+    BOOST_ASSERT(timer.m_expiry == m_current);
+    timers.pop_front();
+    --m_nPending;
+
+    std::function<void()> callback;
+    callback.swap(timer.m_callback);
+    callback();
+  }
+}
+
+} // namespace nfd
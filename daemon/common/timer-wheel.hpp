@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_TIMER_WHEEL_HPP
+#define NFD_DAEMON_COMMON_TIMER_WHEEL_HPP
+
+#include "core/common.hpp"
+
+#include <boost/intrusive/list.hpp>
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <array>
+#include <functional>
+
+namespace nfd {
+
+/**
+ * \brief A hierarchical timing wheel for short-lived forwarding-plane timers.
+ *
+ * Time is divided into ticks. A timer is linked into a slot of one of N_LEVELS levels, each having
+ * N_SLOTS slots; a slot at level \em L covers N_SLOTS<sup>L</sup> ticks. Timers in a higher level
+ * are moved to a lower level when the wheel reaches their slot, and are invoked from level 0.
+ * Scheduling and cancelling a timer therefore take constant time, and the Timer node is embedded
+ * in the object that owns it, so that neither operation allocates.
+ *
+ * The wheel is driven by a single event on an ndn::Scheduler, which is armed for the next tick
+ * holding a timer, or for the next cascade when only higher levels are occupied.
+ * A timer fires no earlier than requested and at most one tick later.
+ *
+ * \warning This class is not thread-safe.
+ */
+class TimerWheel : noncopyable
+{
+public:
+  /**
+   * \brief A timer that can be scheduled on a TimerWheel.
+   *
+   * Destroying a pending timer cancels it. The callback is released when the timer fires or is
+   * cancelled, so it may hold a reference to the object that contains the timer.
+   */
+  class Timer : noncopyable
+  {
+  public:
+    Timer() = default;
+
+    ~Timer()
+    {
+      cancel();
+    }
+
+    /** \brief Whether the timer is scheduled and has not fired yet.
+     */
+    bool
+    isPending() const noexcept
+    {
+      return m_hook.is_linked();
+    }
+
+    /** \brief Cancel the timer if it is pending.
+     */
+    void
+    cancel();
+
+  private:
+    using Hook = boost::intrusive::list_member_hook<
+                   boost::intrusive::link_mode<boost::intrusive::auto_unlink>>;
+
+    Hook m_hook;
+    TimerWheel* m_wheel = nullptr;
+    std::function<void()> m_callback;
+    uint64_t m_expiry = 0;
+    uint8_t m_level = 0;
+    uint8_t m_slot = 0;
+
+    friend TimerWheel;
+  };
+
+  static constexpr size_t N_LEVELS = 4;
+  static constexpr size_t SLOT_BITS = 8;
+  static constexpr size_t N_SLOTS = 1 << SLOT_BITS;
+
+  /** \param scheduler the scheduler that drives the wheel
+   *  \param tick the resolution of the wheel; must be positive
+   */
+  explicit
+  TimerWheel(ndn::Scheduler& scheduler, time::nanoseconds tick = 1_ms);
+
+  /** \brief Cancel all pending timers without invoking them.
+   */
+  ~TimerWheel();
+
+  /** \brief Schedule \p timer to invoke \p callback after \p after.
+   *
+   *  If \p timer is already pending, it is rescheduled. Durations beyond the range of the wheel
+   *  are supported by re-cascading the timer from the top level.
+   */
+  void
+  schedule(Timer& timer, time::nanoseconds after, std::function<void()> callback);
+
+  /** \return number of pending timers
+   */
+  size_t
+  size() const noexcept
+  {
+    return m_nPending;
+  }
+
+  time::nanoseconds
+  getTick() const noexcept
+  {
+    return m_tick;
+  }
+
+private:
+  using Tick = uint64_t;
+
+  /** \return the number of whole ticks elapsed between the epoch and \p tp
+   */
+  Tick
+  toTick(time::steady_clock::time_point tp) const;
+
+  /** \brief Link \p timer into the slot that covers its expiry, relative to m_current.
+   */
+  void
+  insert(Timer& timer);
+
+  /** \brief Unlink \p timer, keeping the occupancy bitmap of its slot accurate.
+   */
+  void
+  remove(Timer& timer);
+
+  /** \return the next tick after m_current that needs processing, or nullopt if the wheel is empty
+   */
+  std::optional<Tick>
+  findNextTick() const;
+
+  /** \brief (Re)schedule the driving event for the next tick that needs processing.
+   */
+  void
+  arm();
+
+  /** \brief Process all ticks up to the current time; invoked by the driving event.
+   */
+  void
+  advance();
+
+  /** \brief Redistribute the timers in \p slot of \p level into lower levels.
+   */
+  void
+  cascade(size_t level, size_t slot);
+
+  /** \brief Invoke the timers in \p slot of level 0.
+   */
+  void
+  expire(size_t slot);
+
+private:
+  using TimerList = boost::intrusive::list<Timer,
+                      boost::intrusive::member_hook<Timer, Timer::Hook, &Timer::m_hook>,
+                      boost::intrusive::constant_time_size<false>>;
+
+  struct Level
+  {
+    std::array<TimerList, N_SLOTS> slots;
+    std::array<uint64_t, N_SLOTS / 64> occupied{}; ///< bitmap of non-empty slots
+  };
+
+  ndn::Scheduler& m_scheduler;
+  const time::nanoseconds m_tick;
+  const time::steady_clock::time_point m_epoch;
+  std::array<Level, N_LEVELS> m_levels;
+  Tick m_current = 0; ///< last processed tick
+  Tick m_armedTick = 0;
+  ndn::scheduler::ScopedEventId m_driver;
+  size_t m_nPending = 0;
+  bool m_isAdvancing = false;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_TIMER_WHEEL_HPP
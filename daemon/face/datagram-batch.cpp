@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "datagram-batch.hpp"
+#include "receive-buffer-pool.hpp"
+
+#include <cerrno>
+
+namespace nfd::face {
+
+static boost::system::error_code
+makeErrorCode(int errNum)
+{
+  return {errNum == EAGAIN ? EWOULDBLOCK : errNum, boost::system::system_category()};
+}
+
+DatagramBatchReceiver&
+DatagramBatchReceiver::getThreadInstance()
+{
+  static thread_local DatagramBatchReceiver instance;
+  return instance;
+}
+
+DatagramBatchReceiver::DatagramBatchReceiver()
+  : m_buffers(MAX_DATAGRAM_BATCH_SIZE)
+  , m_sizes(MAX_DATAGRAM_BATCH_SIZE)
+  , m_sources(MAX_DATAGRAM_BATCH_SIZE)
+  , m_sourceLengths(MAX_DATAGRAM_BATCH_SIZE)
+#ifdef __linux__
+  , m_msgs(MAX_DATAGRAM_BATCH_SIZE)
+  , m_iovecs(MAX_DATAGRAM_BATCH_SIZE)
+#endif
+{
+}
+
+size_t
+DatagramBatchReceiver::receive(int fd, size_t maxDatagrams, boost::system::error_code& error)
+{
+  BOOST_ASSERT(maxDatagrams >= 1 && maxDatagrams <= MAX_DATAGRAM_BATCH_SIZE);
+  error.clear();
+  m_nReceived = 0;
+
+  for (size_t i = 0; i < maxDatagrams; ++i) {
+    // buffers are allocated on first use
+    if (m_buffers[i] == nullptr) {
+      m_buffers[i] = ReceiveBufferPool::get().allocateReceiveBuffer();
+    }
+  }
+
+#ifdef __linux__
+  for (size_t i = 0; i < maxDatagrams; ++i) {
+    m_iovecs[i] = {m_buffers[i]->data(), m_buffers[i]->size()};
+    auto& hdr = m_msgs[i].msg_hdr;
+    hdr = {};
+    hdr.msg_name = &m_sources[i];
+    hdr.msg_namelen = sizeof(m_sources[i]);
+    hdr.msg_iov = &m_iovecs[i];
+    hdr.msg_iovlen = 1;
+  }
+
+  int n = ::recvmmsg(fd, m_msgs.data(), static_cast<unsigned>(maxDatagrams), MSG_DONTWAIT, nullptr);
+  if (n < 0) {
+    error = makeErrorCode(errno);
+    return 0;
+  }
+  for (int i = 0; i < n; ++i) {
+    m_sizes[i] = m_msgs[i].msg_len;
+    m_sourceLengths[i] = m_msgs[i].msg_hdr.msg_namelen;
+  }
+  m_nReceived = static_cast<size_t>(n);
+#else
+  for (; m_nReceived < maxDatagrams; ++m_nReceived) {
+    socklen_t sourceLength = sizeof(m_sources[m_nReceived]);
+    ssize_t size = ::recvfrom(fd, m_buffers[m_nReceived]->data(), m_buffers[m_nReceived]->size(),
+                              MSG_DONTWAIT,
+                              reinterpret_cast<sockaddr*>(&m_sources[m_nReceived]), &sourceLength);
+    if (size < 0) {
+      if (m_nReceived == 0) {
+        error = makeErrorCode(errno);
+      }
+      break;
+    }
+    m_sizes[m_nReceived] = static_cast<size_t>(size);
+    m_sourceLengths[m_nReceived] = sourceLength;
+  }
+#endif
+
+  return m_nReceived;
+}
+
+ndn::ConstBufferPtr
+DatagramBatchReceiver::takePayload(size_t i)
+{
+  BOOST_ASSERT(i < m_nReceived && m_buffers[i] != nullptr);
+  return ReceiveBufferPool::get().adopt(m_buffers[i], m_sizes[i]);
+}
+
+size_t
+sendDatagramBatch(int fd, const std::deque<Block>& queue, size_t maxDatagrams,
+                  boost::system::error_code& error)
+{
+  BOOST_ASSERT(maxDatagrams >= 1 && maxDatagrams <= MAX_DATAGRAM_BATCH_SIZE);
+  error.clear();
+  size_t nPackets = std::min(queue.size(), maxDatagrams);
+
+#ifdef __linux__
+  static thread_local std::vector<mmsghdr> msgs(MAX_DATAGRAM_BATCH_SIZE);
+  static thread_local std::vector<iovec> iovecs(MAX_DATAGRAM_BATCH_SIZE);
+  for (size_t i = 0; i < nPackets; ++i) {
+    // sendmmsg() does not modify the packet, despite the non-const iov_base
+    iovecs[i] = {const_cast<uint8_t*>(queue[i].data()), queue[i].size()};
+    msgs[i].msg_hdr = {};
+    msgs[i].msg_hdr.msg_iov = &iovecs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int n = ::sendmmsg(fd, msgs.data(), static_cast<unsigned>(nPackets), MSG_DONTWAIT);
+  if (n < 0) {
+    error = makeErrorCode(errno);
+    return 0;
+  }
+  return static_cast<size_t>(n);
+#else
+  size_t nSent = 0;
+  for (; nSent < nPackets; ++nSent) {
+    if (::send(fd, queue[nSent].data(), queue[nSent].size(), MSG_DONTWAIT) < 0) {
+      if (nSent == 0) {
+        error = makeErrorCode(errno);
+      }
+      break;
+    }
+  }
+  return nSent;
+#endif
+}
+
+} // namespace nfd::face
@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_DATAGRAM_BATCH_HPP
+#define NFD_DAEMON_FACE_DATAGRAM_BATCH_HPP
+
+#include "core/common.hpp"
+
+#include <deque>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+namespace nfd::face {
+
+/** \brief Maximum number of datagrams transferred by one batched I/O operation.
+ */
+inline constexpr size_t MAX_DATAGRAM_BATCH_SIZE = 256;
+
+/** \brief Receives several datagrams from a socket with one system call.
+ *
+ *  The datagrams are placed in a ring of buffers from the ReceiveBufferPool, each large enough
+ *  for an NDN packet. On Linux, recvmmsg() is used; on other platforms, recvfrom() is called
+ *  repeatedly.
+ *
+ *  The datagrams are valid until the next call to receive(). Since a received datagram is
+ *  processed before the next readiness event is handled, all sockets served by the same
+ *  thread share one instance, obtained from getThreadInstance().
+ */
+class DatagramBatchReceiver : noncopyable
+{
+public:
+  /** \brief Return the instance of the calling thread.
+   */
+  static DatagramBatchReceiver&
+  getThreadInstance();
+
+  /** \brief Receive pending datagrams from \p fd without blocking.
+   *  \param maxDatagrams maximum number of datagrams to receive, at most MAX_DATAGRAM_BATCH_SIZE
+   *  \param[out] error set if the first receive failed; `would_block` if nothing is pending
+   *  \return number of datagrams received
+   */
+  size_t
+  receive(int fd, size_t maxDatagrams, boost::system::error_code& error);
+
+  /** \brief Take the payload of the \p i-th datagram of the last batch.
+   *
+   *  A payload of more than 4096 bytes is handed over without copying; a smaller payload is
+   *  copied into a buffer of its size class, see ReceiveBufferPool::adopt().
+   *  It can be taken only once.
+   */
+  ndn::ConstBufferPtr
+  takePayload(size_t i);
+
+  /** \brief Return the source address of the \p i-th datagram of the last batch.
+   */
+  const sockaddr*
+  getSource(size_t i) const
+  {
+    BOOST_ASSERT(i < m_nReceived);
+    return reinterpret_cast<const sockaddr*>(&m_sources[i]);
+  }
+
+  socklen_t
+  getSourceLength(size_t i) const
+  {
+    BOOST_ASSERT(i < m_nReceived);
+    return m_sourceLengths[i];
+  }
+
+private:
+  DatagramBatchReceiver();
+
+private:
+  std::vector<shared_ptr<ndn::Buffer>> m_buffers;
+  std::vector<size_t> m_sizes;
+  std::vector<sockaddr_storage> m_sources;
+  std::vector<socklen_t> m_sourceLengths;
+#ifdef __linux__
+  std::vector<mmsghdr> m_msgs;
+  std::vector<iovec> m_iovecs;
+#endif
+  size_t m_nReceived = 0;
+};
+
+/** \brief Send up to \p maxDatagrams packets from the front of \p queue on the connected socket
+ *         \p fd, without blocking, with one system call.
+ *
+ *  On Linux, sendmmsg() is used; on other platforms, send() is called repeatedly.
+ *  The packets are not removed from \p queue.
+ *
+ *  \param[out] error set if the first send failed; `would_block` if the socket buffer is full
+ *  \return number of packets sent
+ */
+size_t
+sendDatagramBatch(int fd, const std::deque<Block>& queue, size_t maxDatagrams,
+                  boost::system::error_code& error);
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_DATAGRAM_BATCH_HPP
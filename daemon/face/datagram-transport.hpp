@@ -27,23 +27,59 @@
 #define NFD_DAEMON_FACE_DATAGRAM_TRANSPORT_HPP
 
 #include "transport.hpp"
+#include "datagram-batch.hpp"
+#include "receive-buffer-pool.hpp"
 #include "socket-utils.hpp"
 #include "common/global.hpp"
 
-#include <array>
+#ifdef NFD_HAVE_IO_URING
+#include "io-uring.hpp"
+#endif
 
 #include <boost/asio/defer.hpp>
+#include <boost/asio/post.hpp>
 
 namespace nfd::face {
 
 struct Unicast {};
 struct Multicast {};
 
+/**
+ * \brief Selects how a DatagramTransport performs socket I/O.
+ */
+enum class DatagramIoBackend {
+  /// Boost.Asio asynchronous operations
+  ASIO,
+  /// io_uring multishot receive and batched send submission, see IoUring (Linux only);
+  /// if the kernel does not support it, the transport falls back to ASIO
+  IO_URING,
+};
+
+inline std::ostream&
+operator<<(std::ostream& os, DatagramIoBackend backend)
+{
+  switch (backend) {
+    case DatagramIoBackend::ASIO:
+      return os << "asio";
+    case DatagramIoBackend::IO_URING:
+      return os << "io_uring";
+  }
+  return os << "none";
+}
+
 /**
  * \brief Implements a Transport for datagram-based protocols.
  *
  * \tparam Protocol A datagram-based protocol in Boost.Asio
  * \tparam Addressing The addressing mode, either Unicast or Multicast
+ *
+ * If the batch size is greater than one, the transport waits for the socket to become readable
+ * and then drains up to that many datagrams with one system call, instead of receiving one
+ * datagram per asynchronous operation. Likewise, packets sent while handling an event are
+ * queued and transmitted together once the event has been handled.
+ *
+ * With the IO_URING backend, the batch size is ignored: the socket receives with a multishot
+ * request, and sends of all transports are submitted together once the event has been handled.
  */
 template<class Protocol, class Addressing>
 class DatagramTransport : public Transport
@@ -56,9 +92,15 @@ public:
    * \brief Construct datagram transport.
    *
    * \param socket Protocol-specific socket for the created transport
+   * \param batchSize Maximum number of datagrams per system call, at most MAX_DATAGRAM_BATCH_SIZE;
+   *                  1 disables batched I/O
+   * \param ioBackend How socket I/O is performed
    */
   explicit
-  DatagramTransport(typename protocol::socket&& socket);
+  DatagramTransport(typename protocol::socket&& socket, size_t batchSize = 1,
+                    DatagramIoBackend ioBackend = DatagramIoBackend::ASIO);
+
+  ~DatagramTransport() override;
 
   ssize_t
   getSendQueueLength() override;
@@ -69,6 +111,12 @@ public:
   void
   receiveDatagram(span<const uint8_t> buffer, const boost::system::error_code& error);
 
+  /**
+   * \brief Receive datagram held in \p buffer, which the decoded packet adopts without copying.
+   */
+  void
+  receiveDatagram(ndn::ConstBufferPtr buffer, const boost::system::error_code& error);
+
 protected:
   void
   doClose() override;
@@ -82,9 +130,33 @@ protected:
   void
   handleReceive(const boost::system::error_code& error, size_t nBytesReceived);
 
+  void
+  asyncReceive();
+
+  /**
+   * \brief Receive a batch of datagrams after the socket has become readable.
+   */
+  void
+  handleReadable(const boost::system::error_code& error);
+
+  /**
+   * \brief Send queued packets in batches until the queue is empty or the socket is full.
+   */
+  void
+  flushSendQueue();
+
+  void
+  clearSendQueue();
+
   void
   processErrorCode(const boost::system::error_code& error);
 
+#ifdef NFD_HAVE_IO_URING
+  void
+  handleUringReceive(const boost::system::error_code& error,
+                     span<const uint8_t> source, span<const uint8_t> payload);
+#endif
+
   bool
   hasRecentlyReceived() const;
 
@@ -98,15 +170,34 @@ protected:
   NFD_LOG_MEMBER_DECL();
 
 private:
-  std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> m_receiveBuffer;
+  shared_ptr<ndn::Buffer> m_receiveBuffer = ReceiveBufferPool::get().allocateReceiveBuffer();
   bool m_hasRecentlyReceived = false;
+
+  const size_t m_batchSize;
+  std::deque<Block> m_sendQueue; ///< packets waiting for a batched send
+  size_t m_sendQueueBytes = 0;
+#ifdef NFD_HAVE_IO_URING
+  IoUring* m_ioUring = nullptr; ///< non-null if the transport uses the IO_URING backend
+#endif
 };
 
 
 template<class T, class U>
-DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol::socket&& socket)
+DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol::socket&& socket,
+                                           size_t batchSize,
+                                           [[maybe_unused]] DatagramIoBackend ioBackend)
   : m_socket(std::move(socket))
+  , m_batchSize(batchSize)
 {
+  BOOST_ASSERT(m_batchSize >= 1 && m_batchSize <= MAX_DATAGRAM_BATCH_SIZE);
+#ifdef NFD_HAVE_IO_URING
+  if (ioBackend == DatagramIoBackend::IO_URING) {
+    m_ioUring = IoUring::get(getGlobalIoService());
+  }
+#else
+  BOOST_ASSERT(ioBackend == DatagramIoBackend::ASIO);
+#endif
+
   boost::asio::socket_base::send_buffer_size sendBufferSizeOption;
   boost::system::error_code error;
   m_socket.get_option(sendBufferSizeOption, error);
@@ -118,10 +209,18 @@ DatagramTransport<T, U>::DatagramTransport(typename DatagramTransport::protocol:
     this->setSendQueueCapacity(sendBufferSizeOption.value());
   }
 
-  m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
-                              [this] (auto&&... args) {
-                                this->handleReceive(std::forward<decltype(args)>(args)...);
-                              });
+  asyncReceive();
+}
+
+template<class T, class U>
+DatagramTransport<T, U>::~DatagramTransport()
+{
+#ifdef NFD_HAVE_IO_URING
+  // the io_uring requests must not invoke handlers of a destroyed transport
+  if (m_ioUring != nullptr && m_socket.is_open()) {
+    m_ioUring->cancel(m_socket.native_handle(), this);
+  }
+#endif
 }
 
 template<class T, class U>
@@ -132,6 +231,9 @@ DatagramTransport<T, U>::getSendQueueLength()
   if (queueLength == QUEUE_ERROR) {
     NFD_LOG_FACE_WARN("Failed to obtain send queue length from socket: " << std::strerror(errno));
   }
+  else if (queueLength >= 0) {
+    queueLength += static_cast<ssize_t>(m_sendQueueBytes);
+  }
   return queueLength;
 }
 
@@ -142,12 +244,18 @@ DatagramTransport<T, U>::doClose()
   NFD_LOG_FACE_TRACE(__func__);
 
   if (m_socket.is_open()) {
+#ifdef NFD_HAVE_IO_URING
+    if (m_ioUring != nullptr) {
+      m_ioUring->cancel(m_socket.native_handle(), this);
+    }
+#endif
     // Cancel all outstanding operations and close the socket.
     // Use the non-throwing variants and ignore errors, if any.
     boost::system::error_code error;
     m_socket.cancel(error);
     m_socket.close(error);
   }
+  clearSendQueue();
 
   // Ensure that the Transport stays alive at least until
   // all pending handlers are dispatched
@@ -162,6 +270,34 @@ DatagramTransport<T, U>::doSend(const Block& packet)
 {
   NFD_LOG_FACE_TRACE(__func__);
 
+#ifdef NFD_HAVE_IO_URING
+  if (m_ioUring != nullptr) {
+    bool isQueued = m_ioUring->send(m_socket.native_handle(), this, packet,
+                                    [this, size = packet.size()] (const auto& error, size_t nBytesSent) {
+                                      m_sendQueueBytes -= std::min(size, m_sendQueueBytes);
+                                      this->handleSend(error, nBytesSent);
+                                    });
+    if (isQueued) {
+      m_sendQueueBytes += packet.size();
+    }
+    else {
+      NFD_LOG_FACE_DEBUG("io_uring submission queue is full, dropping packet");
+      ++this->nOutDrops;
+    }
+    return;
+  }
+#endif
+
+  if (m_batchSize > 1) {
+    m_sendQueue.push_back(packet);
+    m_sendQueueBytes += packet.size();
+    if (m_sendQueue.size() == 1) {
+      // flush after the current event has been handled, so that the packets it sends are batched
+      boost::asio::post(m_socket.get_executor(), [this] { flushSendQueue(); });
+    }
+    return;
+  }
+
   m_socket.async_send(boost::asio::buffer(packet),
                       // 'packet' is copied into the lambda to retain the underlying Buffer
                       [this, packet] (auto&&... args) {
@@ -177,7 +313,18 @@ DatagramTransport<T, U>::receiveDatagram(span<const uint8_t> buffer,
   if (error)
     return processErrorCode(error);
 
-  NFD_LOG_FACE_TRACE("Received: " << buffer.size() << " bytes from " << m_sender);
+  receiveDatagram(ReceiveBufferPool::get().copy(buffer), error);
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::receiveDatagram(ndn::ConstBufferPtr buffer,
+                                         const boost::system::error_code& error)
+{
+  if (error)
+    return processErrorCode(error);
+
+  NFD_LOG_FACE_TRACE("Received: " << buffer->size() << " bytes from " << m_sender);
 
   auto [isOk, element] = Block::fromBuffer(buffer);
   if (!isOk) {
@@ -185,7 +332,7 @@ DatagramTransport<T, U>::receiveDatagram(span<const uint8_t> buffer,
     // This packet won't extend the face lifetime
     return;
   }
-  if (element.size() != buffer.size()) {
+  if (element.size() != buffer->size()) {
     NFD_LOG_FACE_WARN("Received datagram size and decoded element size don't match");
     // This packet won't extend the face lifetime
     return;
@@ -202,14 +349,89 @@ template<class T, class U>
 void
 DatagramTransport<T, U>::handleReceive(const boost::system::error_code& error, size_t nBytesReceived)
 {
-  receiveDatagram(ndn::make_span(m_receiveBuffer).first(nBytesReceived), error);
+  if (error)
+    processErrorCode(error);
+  else
+    receiveDatagram(ReceiveBufferPool::get().adopt(m_receiveBuffer, nBytesReceived), error);
 
   if (m_socket.is_open())
-    m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
+    asyncReceive();
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::asyncReceive()
+{
+#ifdef NFD_HAVE_IO_URING
+  if (m_ioUring != nullptr) {
+    m_ioUring->startReceive(m_socket.native_handle(), this, [this] (const auto& error, auto source, auto payload) {
+      this->handleUringReceive(error, source, payload);
+    });
+    return;
+  }
+#endif
+
+  if (m_batchSize > 1) {
+    m_socket.async_wait(boost::asio::socket_base::wait_read, [this] (const auto& error) {
+      this->handleReadable(error);
+    });
+  }
+  else {
+    m_socket.async_receive_from(boost::asio::buffer(*m_receiveBuffer), m_sender,
                                 [this] (auto&&... args) {
                                   this->handleReceive(std::forward<decltype(args)>(args)...);
                                 });
+  }
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::handleReadable(const boost::system::error_code& error)
+{
+  if (error) {
+    processErrorCode(error);
+  }
+  else {
+    auto& receiver = DatagramBatchReceiver::getThreadInstance();
+    boost::system::error_code recvError;
+    size_t nReceived = receiver.receive(m_socket.native_handle(), m_batchSize, recvError);
+    NFD_LOG_FACE_TRACE("Received batch of " << nReceived << " datagrams");
+
+    for (size_t i = 0; i < nReceived && m_socket.is_open(); ++i) {
+      std::memcpy(m_sender.data(), receiver.getSource(i), receiver.getSourceLength(i));
+      m_sender.resize(receiver.getSourceLength(i));
+      receiveDatagram(receiver.takePayload(i), {});
+    }
+
+    if (recvError && recvError != boost::asio::error::would_block) {
+      processErrorCode(recvError);
+    }
+  }
+
+  if (m_socket.is_open())
+    asyncReceive();
+}
+
+#ifdef NFD_HAVE_IO_URING
+template<class T, class U>
+void
+DatagramTransport<T, U>::handleUringReceive(const boost::system::error_code& error,
+                                            span<const uint8_t> source, span<const uint8_t> payload)
+{
+  if (error) {
+    processErrorCode(error);
+    // the multishot receive has ended; restart it unless the transport has been closed
+    if (m_socket.is_open())
+      asyncReceive();
+    return;
+  }
+
+  size_t sourceLen = std::min(source.size(), m_sender.capacity());
+  std::memcpy(m_sender.data(), source.data(), sourceLen);
+  m_sender.resize(sourceLen);
+  receiveDatagram(payload, {});
 }
+#endif // NFD_HAVE_IO_URING
 
 template<class T, class U>
 void
@@ -221,6 +443,48 @@ DatagramTransport<T, U>::handleSend(const boost::system::error_code& error, size
   NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes");
 }
 
+template<class T, class U>
+void
+DatagramTransport<T, U>::flushSendQueue()
+{
+  while (!m_sendQueue.empty() && m_socket.is_open()) {
+    boost::system::error_code error;
+    size_t nSent = sendDatagramBatch(m_socket.native_handle(), m_sendQueue, m_batchSize, error);
+    for (size_t i = 0; i < nSent; ++i) {
+      NFD_LOG_FACE_TRACE("Successfully sent: " << m_sendQueue.front().size() << " bytes");
+      m_sendQueueBytes -= m_sendQueue.front().size();
+      m_sendQueue.pop_front();
+    }
+
+    if (error == boost::asio::error::would_block) {
+      m_socket.async_wait(boost::asio::socket_base::wait_write, [this] (const auto& error) {
+        if (error)
+          return this->processErrorCode(error);
+        this->flushSendQueue();
+      });
+      return;
+    }
+    if (error) {
+      // only the datagram at the front of the queue failed; drop it and keep flushing the rest,
+      // unless the error fails the transport, which closes the socket and clears the queue
+      NFD_LOG_FACE_DEBUG("Dropping datagram of " << m_sendQueue.front().size() << " bytes: "
+                         << error.message());
+      m_sendQueueBytes -= m_sendQueue.front().size();
+      m_sendQueue.pop_front();
+      ++this->nOutDrops;
+      processErrorCode(error);
+    }
+  }
+}
+
+template<class T, class U>
+void
+DatagramTransport<T, U>::clearSendQueue()
+{
+  m_sendQueue.clear();
+  m_sendQueueBytes = 0;
+}
+
 template<class T, class U>
 void
 DatagramTransport<T, U>::processErrorCode(const boost::system::error_code& error)
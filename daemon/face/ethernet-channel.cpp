@@ -38,11 +38,13 @@ namespace nfd::face {
 NFD_LOG_INIT(EthernetChannel);
 
 EthernetChannel::EthernetChannel(shared_ptr<const ndn::net::NetworkInterface> localEndpoint,
-                                 time::nanoseconds idleTimeout)
+                                 time::nanoseconds idleTimeout,
+                                 EthernetIoBackend ioBackend)
   : m_localEndpoint(std::move(localEndpoint))
   , m_socket(getGlobalIoService())
   , m_pcap(m_localEndpoint->getName())
   , m_idleFaceTimeout(idleTimeout)
+  , m_ioBackend(ioBackend)
 {
   setUri(FaceUri::fromDev(m_localEndpoint->getName()));
   NFD_LOG_CHAN_INFO("Creating channel");
@@ -197,7 +199,8 @@ EthernetChannel::createFace(const ethernet::Address& remoteEndpoint,
 
   auto linkService = make_unique<GenericLinkService>(options);
   auto transport = make_unique<UnicastEthernetTransport>(*m_localEndpoint, remoteEndpoint,
-                                                         params.persistency, m_idleFaceTimeout);
+                                                         params.persistency, m_idleFaceTimeout,
+                                                         m_ioBackend);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
   face->setChannel(weak_from_this());
 
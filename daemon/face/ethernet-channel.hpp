@@ -28,6 +28,7 @@
 
 #include "channel.hpp"
 #include "ethernet-protocol.hpp"
+#include "ethernet-transport.hpp"
 #include "pcap-helper.hpp"
 
 #include <boost/asio/posix/stream_descriptor.hpp>
@@ -57,9 +58,13 @@ public:
    *
    * To enable the creation of faces upon incoming connections, one needs to
    * explicitly call listen().
+   *
+   * \param ioBackend I/O backend of the faces created by this channel; the channel
+   *                  itself always listens for frames from new peers with libpcap
    */
   EthernetChannel(shared_ptr<const ndn::net::NetworkInterface> localEndpoint,
-                  time::nanoseconds idleTimeout);
+                  time::nanoseconds idleTimeout,
+                  EthernetIoBackend ioBackend = EthernetIoBackend::PCAP);
 
   bool
   isListening() const final
@@ -128,6 +133,7 @@ private:
   PcapHelper m_pcap;
   std::map<ethernet::Address, shared_ptr<Face>> m_channelFaces;
   const time::nanoseconds m_idleFaceTimeout; ///< Timeout for automatic closure of idle on-demand faces
+  const EthernetIoBackend m_ioBackend;
 
 #ifndef NDEBUG
   /// Number of frames dropped by the kernel, as reported by libpcap
@@ -59,6 +59,7 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
   // {
   //   listen yes
   //   idle_timeout 600
+  //   io_backend pcap
   //   mcast yes
   //   mcast_group 01:00:5E:00:17:AA
   //   mcast_ad_hoc no
@@ -73,6 +74,7 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
 
   UnicastConfig unicastConfig;
   MulticastConfig mcastConfig;
+  EthernetIoBackend ioBackend = EthernetIoBackend::PCAP;
 
   if (configSection) {
     // listen and mcast default to 'yes' but only if face_system.ether section is present
@@ -88,6 +90,23 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
       else if (key == "idle_timeout") {
         unicastConfig.idleTimeout = time::seconds(ConfigFile::parseNumber<uint32_t>(pair, "face_system.ether"));
       }
+      else if (key == "io_backend") {
+        const std::string& valueStr = value.get_value<std::string>();
+        if (valueStr == "pcap") {
+          ioBackend = EthernetIoBackend::PCAP;
+        }
+        else if (valueStr == "packet_ring") {
+#ifdef __linux__
+          ioBackend = EthernetIoBackend::PACKET_RING;
+#else
+          NDN_THROW(ConfigFile::Error("face_system.ether.io_backend: 'packet_ring' is supported only on Linux"));
+#endif
+        }
+        else {
+          NDN_THROW(ConfigFile::Error("face_system.ether.io_backend: '" + valueStr +
+                                      "' is not a valid I/O backend"));
+        }
+      }
       else if (key == "mcast") {
         mcastConfig.isEnabled = ConfigFile::parseYesNo(pair, "face_system.ether");
       }
@@ -156,6 +175,14 @@ EthernetFactory::doProcessConfig(OptionalConfigSection configSection,
     }
   }
 
+  if (m_ioBackend != ioBackend) {
+    if (!m_channels.empty() || !m_mcastFaces.empty()) {
+      NFD_LOG_WARN("I/O backend change applies only to new channels and multicast faces");
+    }
+    NFD_LOG_INFO("using " << ioBackend << " I/O backend");
+  }
+  m_ioBackend = ioBackend;
+
   // Even if there are no configuration changes, we still need to re-apply
   // the configuration because netifs may have changed.
   m_unicastConfig = std::move(unicastConfig);
@@ -222,7 +249,7 @@ EthernetFactory::createChannel(const shared_ptr<const ndn::net::NetworkInterface
   if (it != m_channels.end())
     return it->second;
 
-  auto channel = std::make_shared<EthernetChannel>(localEndpoint, idleTimeout);
+  auto channel = std::make_shared<EthernetChannel>(localEndpoint, idleTimeout, m_ioBackend);
   m_channels[localEndpoint->getName()] = channel;
   return channel;
 }
@@ -250,7 +277,8 @@ EthernetFactory::createMulticastFace(const ndn::net::NetworkInterface& netif,
   opts.allowReassembly = true;
 
   auto linkService = make_unique<GenericLinkService>(opts);
-  auto transport = make_unique<MulticastEthernetTransport>(netif, address, m_mcastConfig.linkType);
+  auto transport = make_unique<MulticastEthernetTransport>(netif, address, m_mcastConfig.linkType,
+                                                           m_ioBackend);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
 
   m_mcastFaces[key] = face;
@@ -107,6 +107,8 @@ private:
   // ifname => channel
   std::map<std::string, shared_ptr<EthernetChannel>> m_channels;
 
+  EthernetIoBackend m_ioBackend = EthernetIoBackend::PCAP;
+
   struct UnicastConfig
   {
     bool isEnabled = false;
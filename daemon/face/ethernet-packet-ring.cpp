@@ -0,0 +1,276 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ethernet-packet-ring.hpp"
+#include "ethernet-protocol.hpp"
+
+#include "common/privilege-helper.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <pcap/pcap.h>
+#include <arpa/inet.h>
+#include <linux/filter.h>
+#include <linux/if_packet.h>
+#include <net/ethernet.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#if !defined(PCAP_NETMASK_UNKNOWN)
+#define PCAP_NETMASK_UNKNOWN  0xffffffff
+#endif
+
+namespace nfd::face {
+
+// offset of the link-layer header in a slot of the transmit ring
+constexpr size_t TX_DATA_OFFSET = TPACKET2_HDRLEN - sizeof(sockaddr_ll);
+// offset of the network-layer header in a slot of the receive ring, see tpacket_rcv()
+constexpr size_t RX_NETWORK_OFFSET = TPACKET_ALIGN(TPACKET2_HDRLEN + 16);
+
+/** \brief Compute the size of a slot that holds a frame with a payload of \p mtu octets.
+ *
+ *  The size is a power of two, so that a block of one page or more holds a whole number of slots.
+ */
+static size_t
+computeFrameSize(size_t mtu)
+{
+  size_t needed = std::max(RX_NETWORK_OFFSET, TX_DATA_OFFSET + ethernet::HDR_LEN) + mtu;
+  size_t frameSize = TPACKET_ALIGNMENT;
+  while (frameSize < needed) {
+    frameSize <<= 1;
+  }
+  return frameSize;
+}
+
+static size_t
+roundUpFrameCount(size_t nFrames, size_t framesPerBlock)
+{
+  return std::max<size_t>(1, (nFrames + framesPerBlock - 1) / framesPerBlock) * framesPerBlock;
+}
+
+static tpacket_req
+makeRingRequest(size_t nFrames, size_t frameSize, size_t framesPerBlock)
+{
+  tpacket_req req{};
+  req.tp_block_size = frameSize * framesPerBlock;
+  req.tp_block_nr = nFrames / framesPerBlock;
+  req.tp_frame_size = frameSize;
+  req.tp_frame_nr = nFrames;
+  return req;
+}
+
+static uint32_t
+loadStatus(const tpacket2_hdr* hdr)
+{
+  return __atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE);
+}
+
+static void
+storeStatus(tpacket2_hdr* hdr, uint32_t status)
+{
+  __atomic_store_n(&hdr->tp_status, status, __ATOMIC_RELEASE);
+}
+
+EthernetPacketRing::EthernetPacketRing(int ifIndex, const Options& options)
+  : m_ifIndex(ifIndex)
+  , m_frameSize(computeFrameSize(options.mtu))
+{
+  static const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  m_framesPerBlock = std::max(m_frameSize, pageSize) / m_frameSize;
+  m_nRxFrames = roundUpFrameCount(options.nRxFrames, m_framesPerBlock);
+  m_nTxFrames = roundUpFrameCount(options.nTxFrames, m_framesPerBlock);
+
+  // with protocol 0, the socket receives nothing until it is bound in setPacketFilter()
+  PrivilegeHelper::runElevated([this] {
+    m_fd = ::socket(AF_PACKET, SOCK_RAW | SOCK_CLOEXEC, 0);
+  });
+  if (m_fd < 0)
+    NDN_THROW_ERRNO(Error("socket(AF_PACKET) failed"));
+
+  auto fail = [this] (const char* what) {
+    int errNum = errno;
+    ::close(m_fd);
+    m_fd = -1;
+    errno = errNum;
+    NDN_THROW_ERRNO(Error(what));
+  };
+
+  int version = TPACKET_V2;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+    fail("setsockopt(PACKET_VERSION) failed");
+
+  // skip malformed frames in the transmit ring instead of stopping the transmission
+  int discard = 1;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_LOSS, &discard, sizeof(discard)) < 0)
+    fail("setsockopt(PACKET_LOSS) failed");
+
+  tpacket_req rxReq = makeRingRequest(m_nRxFrames, m_frameSize, m_framesPerBlock);
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_RX_RING, &rxReq, sizeof(rxReq)) < 0)
+    fail("setsockopt(PACKET_RX_RING) failed");
+
+  tpacket_req txReq = makeRingRequest(m_nTxFrames, m_frameSize, m_framesPerBlock);
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_TX_RING, &txReq, sizeof(txReq)) < 0)
+    fail("setsockopt(PACKET_TX_RING) failed");
+
+  // the kernel maps the receive ring first, immediately followed by the transmit ring
+  m_ringSize = (m_nRxFrames + m_nTxFrames) * m_frameSize;
+  void* ring = ::mmap(nullptr, m_ringSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (ring == MAP_FAILED)
+    fail("mmap of packet ring failed");
+  m_ring = static_cast<uint8_t*>(ring);
+}
+
+EthernetPacketRing::~EthernetPacketRing()
+{
+  if (m_ring != nullptr)
+    ::munmap(m_ring, m_ringSize);
+  if (m_fd >= 0)
+    ::close(m_fd);
+}
+
+int
+EthernetPacketRing::getFd() const
+{
+  int fd = ::dup(m_fd);
+  if (fd < 0)
+    NDN_THROW_ERRNO(Error("dup failed"));
+  return fd;
+}
+
+void
+EthernetPacketRing::setPacketFilter(const char* filter)
+{
+  pcap_t* dead = pcap_open_dead(DLT_EN10MB, ethernet::HDR_LEN + ndn::MAX_NDN_PACKET_SIZE);
+  if (dead == nullptr)
+    NDN_THROW(Error("pcap_open_dead failed"));
+
+  bpf_program prog;
+  if (pcap_compile(dead, &prog, filter, 1, PCAP_NETMASK_UNKNOWN) < 0) {
+    std::string msg = "pcap_compile: " + std::string(pcap_geterr(dead));
+    pcap_close(dead);
+    NDN_THROW(Error(msg));
+  }
+  pcap_close(dead);
+
+  // struct bpf_insn and struct sock_filter have the same layout
+  sock_fprog fprog{};
+  fprog.len = static_cast<unsigned short>(prog.bf_len);
+  fprog.filter = reinterpret_cast<sock_filter*>(prog.bf_insns);
+  int ret = ::setsockopt(m_fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog));
+  int errNum = errno;
+  pcap_freecode(&prog);
+  if (ret < 0) {
+    errno = errNum;
+    NDN_THROW_ERRNO(Error("setsockopt(SO_ATTACH_FILTER) failed"));
+  }
+
+  if (!m_isBound) {
+    sockaddr_ll sll{};
+    sll.sll_family = AF_PACKET;
+    sll.sll_protocol = htons(ethernet::ETHERTYPE_NDN);
+    sll.sll_ifindex = m_ifIndex;
+    if (::bind(m_fd, reinterpret_cast<sockaddr*>(&sll), sizeof(sll)) < 0)
+      NDN_THROW_ERRNO(Error("bind(AF_PACKET) failed"));
+    m_isBound = true;
+  }
+}
+
+size_t
+EthernetPacketRing::getMaxPayloadSize() const
+{
+  return m_frameSize - std::max(RX_NETWORK_OFFSET, TX_DATA_OFFSET + ethernet::HDR_LEN);
+}
+
+size_t
+EthernetPacketRing::receive(const std::function<void(span<const uint8_t>)>& processFrame)
+{
+  size_t nProcessed = 0;
+  while (nProcessed < m_nRxFrames) {
+    uint8_t* frame = getRxFrame(m_rxIndex);
+    auto hdr = reinterpret_cast<tpacket2_hdr*>(frame);
+    if ((loadStatus(hdr) & TP_STATUS_USER) == 0)
+      break;
+
+    auto sll = reinterpret_cast<const sockaddr_ll*>(frame + TPACKET_ALIGN(sizeof(tpacket2_hdr)));
+    if (sll->sll_pkttype != PACKET_OUTGOING && hdr->tp_snaplen == hdr->tp_len) {
+      processFrame({frame + hdr->tp_mac, hdr->tp_snaplen});
+    }
+
+    storeStatus(hdr, TP_STATUS_KERNEL);
+    m_rxIndex = (m_rxIndex + 1) % m_nRxFrames;
+    ++nProcessed;
+  }
+  return nProcessed;
+}
+
+bool
+EthernetPacketRing::enqueue(span<const uint8_t> header, span<const uint8_t> payload, size_t paddingLen)
+{
+  size_t frameLen = header.size() + payload.size() + paddingLen;
+  if (TX_DATA_OFFSET + frameLen > m_frameSize)
+    return false;
+
+  uint8_t* frame = getTxFrame(m_txIndex);
+  auto hdr = reinterpret_cast<tpacket2_hdr*>(frame);
+  uint32_t status = loadStatus(hdr);
+  if (status != TP_STATUS_AVAILABLE && status != TP_STATUS_WRONG_FORMAT)
+    return false;
+
+  uint8_t* data = frame + TX_DATA_OFFSET;
+  std::memcpy(data, header.data(), header.size());
+  std::memcpy(data + header.size(), payload.data(), payload.size());
+  std::memset(data + header.size() + payload.size(), 0, paddingLen);
+  hdr->tp_len = static_cast<uint32_t>(frameLen);
+  storeStatus(hdr, TP_STATUS_SEND_REQUEST);
+
+  m_txIndex = (m_txIndex + 1) % m_nTxFrames;
+  return true;
+}
+
+int
+EthernetPacketRing::flush()
+{
+  if (::send(m_fd, nullptr, 0, MSG_DONTWAIT) < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+    return errno;
+  return 0;
+}
+
+size_t
+EthernetPacketRing::getNDropped()
+{
+  // the kernel resets the counters after each read
+  tpacket_stats stats{};
+  socklen_t len = sizeof(stats);
+  if (::getsockopt(m_fd, SOL_PACKET, PACKET_STATISTICS, &stats, &len) < 0)
+    NDN_THROW_ERRNO(Error("getsockopt(PACKET_STATISTICS) failed"));
+
+  m_nDropped += stats.tp_drops;
+  return m_nDropped;
+}
+
+} // namespace nfd::face
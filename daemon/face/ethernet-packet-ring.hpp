@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+#define NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+
+#include "core/common.hpp"
+
+#ifndef __linux__
+#error "Cannot include this file on platforms other than Linux"
+#endif
+
+namespace nfd::face {
+
+/**
+ * @brief A raw AF_PACKET socket with memory-mapped receive and transmit rings.
+ *
+ * Received frames are placed by the kernel into a ring of slots shared with the process,
+ * so that all frames that arrived since the last wakeup are processed without any system
+ * call. Frames to transmit are written into another ring, and a single send() call asks
+ * the kernel to transmit all of them.
+ *
+ * The rings use TPACKET_V2, in which the kernel wakes up the reader on every frame.
+ * TPACKET_V3 hands over whole blocks of frames instead, and delays the delivery of a frame
+ * until its block is full or a timer expires, which adds latency at low packet rates
+ * (see bug #1511).
+ *
+ * Each slot is sized to hold one frame of the interface MTU, so that a ring costs a few
+ * hundred kilobytes for a standard MTU. The ring pages are not locked in memory.
+ */
+class EthernetPacketRing : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  struct Options
+  {
+    /// largest frame payload, which determines the size of the slots
+    size_t mtu = 1500;
+    /// number of frame slots in the receive ring
+    size_t nRxFrames = 256;
+    /// number of frame slots in the transmit ring
+    size_t nTxFrames = 128;
+  };
+
+  /**
+   * @brief Open a socket on interface @p ifIndex and map its rings.
+   * @throw Error on any error
+   *
+   * The socket is bound to the NDN ethertype by the first call to setPacketFilter(),
+   * and receives no frames until then.
+   */
+  EthernetPacketRing(int ifIndex, const Options& options);
+
+  /**
+   * @brief Unmap the rings and close the socket.
+   */
+  ~EthernetPacketRing();
+
+  /**
+   * @brief Obtain a duplicate of the socket file descriptor, for readiness notifications.
+   * @return A file descriptor that the caller must close.
+   * @throw Error on any error
+   */
+  int
+  getFd() const;
+
+  /**
+   * @brief Install a BPF filter on the socket, then bind the socket if it is not bound yet.
+   * @param filter Null-terminated string containing the BPF program source, see pcap-filter(7).
+   * @throw Error on any error
+   *
+   * Binding after the filter is attached ensures that frames rejected by the filter never
+   * occupy the receive ring.
+   */
+  void
+  setPacketFilter(const char* filter);
+
+  /**
+   * @brief Process the frames available in the receive ring.
+   * @param processFrame invoked with each received frame, including the link-layer header;
+   *                     the frame is valid only during the invocation
+   * @return number of frames processed
+   *
+   * Frames sent by this host and truncated frames are skipped. At most one ring's worth
+   * of frames is processed per call, so that a busy interface cannot starve other events.
+   */
+  size_t
+  receive(const std::function<void(span<const uint8_t>)>& processFrame);
+
+  /**
+   * @brief Get the largest frame payload that fits in a slot.
+   *
+   * This is at least Options::mtu.
+   */
+  size_t
+  getMaxPayloadSize() const;
+
+  /**
+   * @brief Copy a frame into the transmit ring.
+   * @param header link-layer header of the frame
+   * @param payload payload of the frame
+   * @param paddingLen number of zero octets appended to the payload
+   * @retval false the transmit ring is full, or the frame does not fit in a slot
+   * @note The frame is transmitted by the next call to flush().
+   */
+  bool
+  enqueue(span<const uint8_t> header, span<const uint8_t> payload, size_t paddingLen);
+
+  /**
+   * @brief Ask the kernel to transmit all frames enqueued in the transmit ring.
+   * @return 0 on success, otherwise errno of the failed send()
+   */
+  int
+  flush();
+
+  /**
+   * @brief Get the number of frames dropped by the kernel because the receive ring was full.
+   * @throw Error on any error
+   */
+  size_t
+  getNDropped();
+
+private:
+  uint8_t*
+  getRxFrame(size_t i) const
+  {
+    return m_ring + i * m_frameSize;
+  }
+
+  uint8_t*
+  getTxFrame(size_t i) const
+  {
+    return m_ring + (m_nRxFrames + i) * m_frameSize;
+  }
+
+private:
+  int m_fd = -1;
+  int m_ifIndex = 0;
+  bool m_isBound = false;
+  uint8_t* m_ring = nullptr;
+  size_t m_ringSize = 0;
+  size_t m_frameSize = 0;
+  size_t m_framesPerBlock = 0;
+  size_t m_nRxFrames = 0;
+  size_t m_nTxFrames = 0;
+  size_t m_rxIndex = 0;
+  size_t m_txIndex = 0;
+  size_t m_nDropped = 0;
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
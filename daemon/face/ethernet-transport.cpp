@@ -25,21 +25,44 @@
 
 #include "ethernet-transport.hpp"
 #include "ethernet-protocol.hpp"
+#include "receive-buffer-pool.hpp"
 #include "common/global.hpp"
 
 #include <pcap/pcap.h>
 
 #include <array>
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include "ethernet-packet-ring.hpp"
+#include <sys/uio.h> // for writev()
+#endif
 
 #include <boost/asio/defer.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/endian/conversion.hpp>
 
 namespace nfd::face {
 
 NFD_LOG_INIT(EthernetTransport);
 
+std::ostream&
+operator<<(std::ostream& os, EthernetIoBackend backend)
+{
+  switch (backend) {
+  case EthernetIoBackend::PCAP:
+    return os << "pcap";
+  case EthernetIoBackend::PACKET_RING:
+    return os << "packet_ring";
+  default:
+    return os << "none";
+  }
+}
+
 EthernetTransport::EthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
-                                     const ethernet::Address& remoteEndpoint)
+                                     const ethernet::Address& remoteEndpoint,
+                                     EthernetIoBackend backend)
   : m_socket(getGlobalIoService())
   , m_pcap(localEndpoint.getName())
   , m_srcAddress(localEndpoint.getEthernetAddress())
@@ -47,12 +70,29 @@ EthernetTransport::EthernetTransport(const ndn::net::NetworkInterface& localEndp
   , m_interfaceName(localEndpoint.getName())
 {
   try {
-    m_pcap.activate(DLT_EN10MB);
-    m_socket.assign(m_pcap.getFd());
+    if (backend == EthernetIoBackend::PACKET_RING) {
+#ifdef __linux__
+      EthernetPacketRing::Options options;
+      options.mtu = localEndpoint.getMtu();
+      m_ring = make_unique<EthernetPacketRing>(localEndpoint.getIndex(), options);
+      m_socket.assign(m_ring->getFd());
+#else
+      NDN_THROW(Error("The packet_ring I/O backend is supported only on Linux"));
+#endif
+    }
+    else {
+      m_pcap.activate(DLT_EN10MB);
+      m_socket.assign(m_pcap.getFd());
+    }
   }
   catch (const PcapHelper::Error& e) {
     NDN_THROW_NESTED(Error(e.what()));
   }
+#ifdef __linux__
+  catch (const EthernetPacketRing::Error& e) {
+    NDN_THROW_NESTED(Error(e.what()));
+  }
+#endif
 
   // Set initial transport state based upon the state of the underlying NetworkInterface
   handleNetifStateChange(localEndpoint.getState());
@@ -64,12 +104,32 @@ EthernetTransport::EthernetTransport(const ndn::net::NetworkInterface& localEndp
 
   m_netifMtuChangedConn = localEndpoint.onMtuChanged.connect(
     [this] (uint32_t, uint32_t mtu) {
+#ifdef __linux__
+      // the slots of the packet ring are sized when the transport is created
+      if (m_ring != nullptr) {
+        mtu = static_cast<uint32_t>(std::min<size_t>(mtu, m_ring->getMaxPayloadSize()));
+      }
+#endif
       setMtu(mtu);
     });
 
   asyncRead();
 }
 
+EthernetTransport::~EthernetTransport() = default;
+
+void
+EthernetTransport::setPacketFilter(const char* filter)
+{
+#ifdef __linux__
+  if (m_ring != nullptr) {
+    m_ring->setPacketFilter(filter);
+    return;
+  }
+#endif
+  m_pcap.setPacketFilter(filter);
+}
+
 void
 EthernetTransport::doClose()
 {
@@ -116,35 +176,88 @@ EthernetTransport::doSend(const Block& packet)
 void
 EthernetTransport::sendPacket(const ndn::Block& block)
 {
-  ndn::EncodingBuffer buffer(block);
-
+  static const std::array<uint8_t, ethernet::MIN_DATA_LEN> padding{};
   // pad with zeroes if the payload is too short
-  if (block.size() < ethernet::MIN_DATA_LEN) {
-    static const std::array<uint8_t, ethernet::MIN_DATA_LEN> padding{};
-    buffer.appendBytes(ndn::span(padding).subspan(block.size()));
-  }
+  size_t paddingLen = block.size() < ethernet::MIN_DATA_LEN ? ethernet::MIN_DATA_LEN - block.size() : 0;
 
-  // construct and prepend the ethernet header
 #if BOOST_VERSION >= 107200
   constexpr
 #endif
   uint16_t ethertype = boost::endian::native_to_big(ethernet::ETHERTYPE_NDN);
+
+#ifdef __linux__
+  // The pcap fd is a raw AF_PACKET socket, on which pcap_inject() is a plain send().
+  // Gather the header, the packet, and the padding into one frame without copying the packet.
+  std::array<uint8_t, ethernet::HDR_LEN> header;
+  auto headerEnd = std::copy(m_destAddress.begin(), m_destAddress.end(), header.begin());
+  headerEnd = std::copy(m_srcAddress.begin(), m_srcAddress.end(), headerEnd);
+  std::memcpy(&*headerEnd, &ethertype, ethernet::TYPE_LEN);
+
+  if (m_ring != nullptr) {
+    // copy the frame into the transmit ring; all frames enqueued while processing
+    // the current event are handed to the kernel with a single system call
+    if (!m_ring->enqueue(header, {block.data(), block.size()}, paddingLen)) {
+      ++this->nOutDrops;
+      NFD_LOG_FACE_DEBUG("Transmit ring is full, dropping frame of " << block.size() << " bytes");
+      return;
+    }
+    if (!m_hasPendingFlush) {
+      m_hasPendingFlush = true;
+      boost::asio::post(getGlobalIoService(), [this] { flushPacketRing(); });
+    }
+    NFD_LOG_FACE_TRACE("Enqueued: " << block.size() << " bytes");
+    return;
+  }
+
+  // writev() does not modify the data, despite the non-const iov_base
+  std::array<iovec, 3> iov{{
+    {header.data(), header.size()},
+    {const_cast<uint8_t*>(block.data()), block.size()},
+    {const_cast<uint8_t*>(padding.data()), paddingLen},
+  }};
+  size_t frameSize = header.size() + block.size() + paddingLen;
+  ssize_t sent = ::writev(m_socket.native_handle(), iov.data(), paddingLen > 0 ? 3 : 2);
+  std::string errorMessage = sent < 0 ? std::strerror(errno) : "";
+#else
+  ndn::EncodingBuffer buffer(block);
+  buffer.appendBytes(ndn::span(padding).first(paddingLen));
+
+  // construct and prepend the ethernet header
   buffer.prependBytes({reinterpret_cast<const uint8_t*>(&ethertype), ethernet::TYPE_LEN});
   buffer.prependBytes(m_srcAddress);
   buffer.prependBytes(m_destAddress);
 
-  // send the frame
+  size_t frameSize = buffer.size();
   int sent = pcap_inject(m_pcap, buffer.data(), buffer.size());
+  std::string errorMessage = sent < 0 ? m_pcap.getLastError() : "";
+#endif
+
   if (sent < 0)
-    handleError("Send operation failed: " + m_pcap.getLastError());
-  else if (static_cast<size_t>(sent) < buffer.size())
-    handleError("Failed to send the full frame: size=" + std::to_string(buffer.size()) +
+    handleError("Send operation failed: " + errorMessage);
+  else if (static_cast<size_t>(sent) < frameSize)
+    handleError("Failed to send the full frame: size=" + std::to_string(frameSize) +
                 " sent=" + std::to_string(sent));
   else
     // print block size because we don't want to count the padding in buffer
     NFD_LOG_FACE_TRACE("Successfully sent: " << block.size() << " bytes");
 }
 
+#ifdef __linux__
+void
+EthernetTransport::flushPacketRing()
+{
+  m_hasPendingFlush = false;
+  if (!m_socket.is_open()) {
+    return;
+  }
+
+  int errNum = m_ring->flush();
+  if (errNum != 0) {
+    handleError("Send operation failed: " + std::string(std::strerror(errNum)));
+  }
+}
+#endif
+
 void
 EthernetTransport::asyncRead()
 {
@@ -167,25 +280,33 @@ EthernetTransport::handleRead(const boost::system::error_code& error)
     return;
   }
 
-  auto [pkt, readErr] = m_pcap.readNextPacket();
-  if (pkt.empty()) {
-    NFD_LOG_FACE_DEBUG("Read error: " << readErr);
+#ifdef __linux__
+  if (m_ring != nullptr) {
+    // process all frames that arrived since the last wakeup
+    m_ring->receive([this] (span<const uint8_t> frame) {
+      if (m_socket.is_open()) {
+        processFrame(frame);
+      }
+    });
   }
-  else {
-    auto [eh, frameErr] = ethernet::checkFrameHeader(pkt, m_srcAddress,
-                                                     m_destAddress.isMulticast() ? m_destAddress : m_srcAddress);
-    if (eh == nullptr) {
-      NFD_LOG_FACE_WARN(frameErr);
+  else
+#endif
+  {
+    auto [pkt, readErr] = m_pcap.readNextPacket();
+    if (pkt.empty()) {
+      NFD_LOG_FACE_DEBUG("Read error: " << readErr);
     }
     else {
-      ethernet::Address sender(eh->ether_shost);
-      pkt = pkt.subspan(ethernet::HDR_LEN);
-      receivePayload(pkt, sender);
+      processFrame(pkt);
     }
   }
 
 #ifndef NDEBUG
+#ifdef __linux__
+  size_t nDropped = m_ring != nullptr ? m_ring->getNDropped() : m_pcap.getNDropped();
+#else
   size_t nDropped = m_pcap.getNDropped();
+#endif
   if (nDropped - m_nDropped > 0)
     NFD_LOG_FACE_DEBUG("Detected " << nDropped - m_nDropped << " dropped frame(s)");
   m_nDropped = nDropped;
@@ -194,12 +315,28 @@ EthernetTransport::handleRead(const boost::system::error_code& error)
   asyncRead();
 }
 
+void
+EthernetTransport::processFrame(span<const uint8_t> frame)
+{
+  auto [eh, frameErr] = ethernet::checkFrameHeader(frame, m_srcAddress,
+                                                   m_destAddress.isMulticast() ? m_destAddress : m_srcAddress);
+  if (eh == nullptr) {
+    NFD_LOG_FACE_WARN(frameErr);
+    return;
+  }
+
+  ethernet::Address sender(eh->ether_shost);
+  receivePayload(frame.subspan(ethernet::HDR_LEN), sender);
+}
+
 void
 EthernetTransport::receivePayload(span<const uint8_t> payload, const ethernet::Address& sender)
 {
   NFD_LOG_FACE_TRACE("Received: " << payload.size() << " bytes from " << sender);
 
-  auto [isOk, element] = Block::fromBuffer(payload);
+  // a valid element is at most MAX_NDN_PACKET_SIZE octets; any padding after it is ignored
+  auto [isOk, element] = Block::fromBuffer(ReceiveBufferPool::get().copy(
+    payload.first(std::min(payload.size(), ndn::MAX_NDN_PACKET_SIZE))));
   if (!isOk) {
     NFD_LOG_FACE_WARN("Failed to parse incoming packet from " << sender);
     // This packet won't extend the face lifetime
@@ -35,6 +35,21 @@
 
 namespace nfd::face {
 
+class EthernetPacketRing;
+
+/**
+ * @brief Selects how Ethernet-based Transports exchange frames with the kernel.
+ */
+enum class EthernetIoBackend {
+  /// libpcap, one system call per frame
+  PCAP,
+  /// memory-mapped AF_PACKET rings, see EthernetPacketRing (Linux only)
+  PACKET_RING,
+};
+
+std::ostream&
+operator<<(std::ostream& os, EthernetIoBackend backend);
+
 /**
  * @brief Base class for Ethernet-based Transports.
  */
@@ -57,11 +72,21 @@ public:
 
 protected:
   EthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
-                    const ethernet::Address& remoteEndpoint);
+                    const ethernet::Address& remoteEndpoint,
+                    EthernetIoBackend backend);
+
+  ~EthernetTransport() override;
 
   void
   doClose() final;
 
+  /**
+   * @brief Installs a BPF filter on the socket of the selected I/O backend.
+   * @param filter Null-terminated string containing the BPF program source
+   */
+  void
+  setPacketFilter(const char* filter);
+
   bool
   hasRecentlyReceived() const
   {
@@ -93,12 +118,30 @@ private:
   void
   handleRead(const boost::system::error_code& error);
 
+  /**
+   * @brief Checks the header of an incoming frame and processes its payload.
+   */
+  void
+  processFrame(span<const uint8_t> frame);
+
+#ifdef __linux__
+  /**
+   * @brief Asks the kernel to transmit the frames enqueued in the packet ring.
+   */
+  void
+  flushPacketRing();
+#endif
+
   void
   handleError(const std::string& errorMessage);
 
 protected:
   boost::asio::posix::stream_descriptor m_socket;
   PcapHelper m_pcap;
+#ifdef __linux__
+  /// non-null if the transport uses the PACKET_RING backend
+  unique_ptr<EthernetPacketRing> m_ring;
+#endif
   ethernet::Address m_srcAddress;
   ethernet::Address m_destAddress;
   std::string m_interfaceName;
@@ -107,8 +150,11 @@ private:
   signal::ScopedConnection m_netifStateChangedConn;
   signal::ScopedConnection m_netifMtuChangedConn;
   bool m_hasRecentlyReceived = false;
+#ifdef __linux__
+  bool m_hasPendingFlush = false;
+#endif
 #ifndef NDEBUG
-  /// Number of frames dropped by the kernel, as reported by libpcap
+  /// Number of frames dropped by the kernel, as reported by libpcap or the packet ring
   size_t m_nDropped = 0;
 #endif
 };
@@ -24,6 +24,7 @@
  */
 
 #include "face-system.hpp"
+#include "io-worker.hpp"
 #include "netdev-bound.hpp"
 #include "protocol-factory.hpp"
 #include "fw/face-table.hpp"
@@ -57,7 +58,11 @@ FaceSystem::makePFCtorParams()
   return {addFace, m_netmon};
 }
 
-FaceSystem::~FaceSystem() = default;
+FaceSystem::~FaceSystem()
+{
+  // stop the I/O workers before the channels whose faces they serve are destroyed
+  m_ioWorkers.reset();
+}
 
 std::set<const ProtocolFactory*>
 FaceSystem::listProtocolFactories() const
@@ -111,12 +116,31 @@ FaceSystem::processConfig(const ConfigSection& configSection, bool isDryRun, con
       if (key == "enable_congestion_marking") {
         context.generalConfig.wantCongestionMarking = ConfigFile::parseYesNo(pair, CFGSEC_GENERAL_FQ);
       }
+      else if (key == "io_threads") {
+        context.generalConfig.nIoThreads = ConfigFile::parseNumber<size_t>(pair, CFGSEC_GENERAL_FQ);
+        ConfigFile::checkRange(context.generalConfig.nIoThreads, size_t{0}, MAX_IO_WORKERS,
+                               key, CFGSEC_GENERAL_FQ);
+      }
       else {
         NDN_THROW(ConfigFile::Error("Unrecognized option " + CFGSEC_GENERAL_FQ + "." + key));
       }
     }
   }
 
+  // the I/O workers must exist before the factories create channels
+  if (!isDryRun) {
+    if (!m_isIoWorkersConfigured) {
+      m_isIoWorkersConfigured = true;
+      if (context.generalConfig.nIoThreads > 0) {
+        m_ioWorkers = make_unique<IoWorkerPool>(context.generalConfig.nIoThreads);
+      }
+    }
+    else if (context.generalConfig.nIoThreads != (m_ioWorkers == nullptr ? 0 : m_ioWorkers->size())) {
+      NFD_LOG_WARN("Changing " << CFGSEC_GENERAL_FQ << ".io_threads requires a restart");
+    }
+  }
+  context.ioWorkers = m_ioWorkers.get();
+
   // process in protocol factories
   for (const auto& [sectionName, factory] : m_factories) {
     std::set<std::string> oldProvidedSchemes = factory->getProvidedSchemes();
@@ -41,6 +41,7 @@ class FaceTable;
 
 namespace face {
 
+class IoWorkerPool;
 class NetdevBound;
 class ProtocolFactory;
 struct ProtocolFactoryCtorParams;
@@ -95,6 +96,7 @@ public:
   struct GeneralConfig
   {
     bool wantCongestionMarking = true;
+    size_t nIoThreads = 0;
   };
 
   /** \brief Context for processing a config section in ProtocolFactory.
@@ -104,6 +106,8 @@ public:
   public:
     GeneralConfig generalConfig;
     bool isDryRun;
+    /// I/O worker threads that channels may create faces in; nullptr if face I/O is in the main thread
+    IoWorkerPool* ioWorkers = nullptr;
   };
 
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
@@ -130,6 +134,11 @@ private:
 
   FaceTable& m_faceTable;
   shared_ptr<ndn::net::NetworkMonitor> m_netmon;
+
+  /** \brief I/O worker threads, created at the first configuration if enabled.
+   */
+  unique_ptr<IoWorkerPool> m_ioWorkers;
+  bool m_isIoWorkersConfigured = false;
 };
 
 } // namespace face
@@ -40,6 +40,7 @@ FaceCounters::FaceCounters(const LinkService::Counters& linkServiceCounters,
   , nOutPackets(transportCounters.nOutPackets)
   , nInBytes(transportCounters.nInBytes)
   , nOutBytes(transportCounters.nOutBytes)
+  , nOutDrops(transportCounters.nOutDrops)
   , m_linkServiceCounters(linkServiceCounters)
   , m_transportCounters(transportCounters)
 {
@@ -50,7 +51,9 @@ Face::Face(unique_ptr<LinkService> service, unique_ptr<Transport> transport)
   , afterReceiveData(service->afterReceiveData)
   , afterReceiveNack(service->afterReceiveNack)
   , onDroppedInterest(service->onDroppedInterest)
+  , afterPersistencyChange(transport->afterPersistencyChange)
   , afterStateChange(transport->afterStateChange)
+  , afterSendQueueCongestionChange(transport->afterSendQueueCongestionChange)
   , m_service(std::move(service))
   , m_transport(std::move(transport))
   , m_counters(m_service->getCounters(), m_transport->getCounters())
@@ -91,6 +91,7 @@ public:
   const PacketCounter& nOutPackets; ///< \copydoc Transport::Counters::nOutPackets
   const ByteCounter& nInBytes;      ///< \copydoc Transport::Counters::nInBytes
   const ByteCounter& nOutBytes;     ///< \copydoc Transport::Counters::nOutBytes
+  const PacketCounter& nOutDrops;   ///< \copydoc Transport::Counters::nOutDrops
 
   /// Count of incoming Interests dropped due to HopLimit == 0.
   PacketCounter nInHopLimitZero;
@@ -252,6 +253,10 @@ public: // properties
     return m_transport->setPersistency(persistency);
   }
 
+  /// \copydoc Transport::afterPersistencyChange
+  signal::Signal<Transport, ndn::nfd::FacePersistency /*old*/,
+                 ndn::nfd::FacePersistency /*new*/>& afterPersistencyChange;
+
   /**
    * \brief Returns the link type of the face (point-to-point, multi-access, ...).
    */
@@ -284,6 +289,16 @@ public: // properties
   /// \copydoc Transport::afterStateChange
   signal::Signal<Transport, FaceState /*old*/, FaceState /*new*/>& afterStateChange;
 
+  /// \copydoc Transport::isSendQueueCongested
+  bool
+  isSendQueueCongested() const noexcept
+  {
+    return m_transport->isSendQueueCongested();
+  }
+
+  /// \copydoc Transport::afterSendQueueCongestionChange
+  signal::Signal<Transport, bool /*isCongested*/>& afterSendQueueCongestionChange;
+
   /**
    * \brief Returns the expiration time of the face.
    * \retval time::steady_clock::time_point::max() The face has an indefinite lifetime.
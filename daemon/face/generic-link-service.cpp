@@ -25,9 +25,8 @@
 
 #include "generic-link-service.hpp"
 
+#include <ndn-cxx/encoding/block-helpers.hpp>
 #include <ndn-cxx/lp/fields.hpp>
-#include <ndn-cxx/lp/pit-token.hpp>
-#include <ndn-cxx/lp/tags.hpp>
 
 #include <cmath>
 
@@ -96,8 +95,8 @@ GenericLinkService::sendLpPacket(lp::Packet&& pkt)
     m_reliability.piggyback(pkt, mtu);
   }
 
-  if (m_options.allowCongestionMarking) {
-    checkCongestionLevel(pkt);
+  if (m_options.allowCongestionMarking && checkCongestionLevel()) {
+    pkt.set<lp::CongestionMarkField>(1);
   }
 
   auto block = pkt.wireEncode();
@@ -112,32 +111,21 @@ GenericLinkService::sendLpPacket(lp::Packet&& pkt)
 void
 GenericLinkService::doSendInterest(const Interest& interest)
 {
-  lp::Packet lpPacket(interest.wireEncode());
-
-  encodeLpFields(interest, lpPacket);
-
-  this->sendNetPacket(std::move(lpPacket), true);
+  this->sendNetPacket(interest.wireEncode(), getLpFields(interest), true);
 }
 
 void
 GenericLinkService::doSendData(const Data& data)
 {
-  lp::Packet lpPacket(data.wireEncode());
-
-  encodeLpFields(data, lpPacket);
-
-  this->sendNetPacket(std::move(lpPacket), false);
+  this->sendNetPacket(data.wireEncode(), getLpFields(data), false);
 }
 
 void
 GenericLinkService::doSendNack(const lp::Nack& nack)
 {
-  lp::Packet lpPacket(nack.getInterest().wireEncode());
-  lpPacket.add<lp::NackField>(nack.getHeader());
-
-  encodeLpFields(nack, lpPacket);
-
-  this->sendNetPacket(std::move(lpPacket), false);
+  auto fields = getLpFields(nack);
+  fields.nack = &nack.getHeader();
+  this->sendNetPacket(nack.getInterest().wireEncode(), fields, false);
 }
 
 void
@@ -148,41 +136,152 @@ GenericLinkService::assignSequences(std::vector<lp::Packet>& pkts)
   });
 }
 
-void
-GenericLinkService::encodeLpFields(const ndn::PacketBase& netPkt, lp::Packet& lpPacket)
+GenericLinkService::LpFields
+GenericLinkService::getLpFields(const ndn::PacketBase& netPkt) const
 {
+  LpFields fields;
+
   if (m_options.allowLocalFields) {
-    auto incomingFaceIdTag = netPkt.getTag<lp::IncomingFaceIdTag>();
-    if (incomingFaceIdTag != nullptr) {
-      lpPacket.add<lp::IncomingFaceIdField>(*incomingFaceIdTag);
-    }
+    fields.incomingFaceId = netPkt.getTag<lp::IncomingFaceIdTag>();
   }
 
-  auto congestionMarkTag = netPkt.getTag<lp::CongestionMarkTag>();
-  if (congestionMarkTag != nullptr) {
-    lpPacket.add<lp::CongestionMarkField>(*congestionMarkTag);
-  }
+  fields.congestionMark = netPkt.getTag<lp::CongestionMarkTag>();
 
   if (m_options.allowSelfLearning) {
-    auto nonDiscoveryTag = netPkt.getTag<lp::NonDiscoveryTag>();
-    if (nonDiscoveryTag != nullptr) {
-      lpPacket.add<lp::NonDiscoveryField>(*nonDiscoveryTag);
-    }
+    fields.nonDiscovery = netPkt.getTag<lp::NonDiscoveryTag>();
+    fields.prefixAnnouncement = netPkt.getTag<lp::PrefixAnnouncementTag>();
+  }
+
+  fields.pitToken = netPkt.getTag<lp::PitToken>();
+
+  return fields;
+}
+
+void
+GenericLinkService::encodeLpFields(const LpFields& fields, lp::Packet& lpPacket)
+{
+  if (fields.nack != nullptr) {
+    lpPacket.add<lp::NackField>(*fields.nack);
+  }
 
-    auto prefixAnnouncementTag = netPkt.getTag<lp::PrefixAnnouncementTag>();
-    if (prefixAnnouncementTag != nullptr) {
-      lpPacket.add<lp::PrefixAnnouncementField>(*prefixAnnouncementTag);
+  if (fields.incomingFaceId != nullptr) {
+    lpPacket.add<lp::IncomingFaceIdField>(*fields.incomingFaceId);
+  }
+
+  if (fields.congestionMark != nullptr) {
+    lpPacket.add<lp::CongestionMarkField>(*fields.congestionMark);
+  }
+
+  if (fields.nonDiscovery != nullptr) {
+    lpPacket.add<lp::NonDiscoveryField>(*fields.nonDiscovery);
+  }
+
+  if (fields.prefixAnnouncement != nullptr) {
+    lpPacket.add<lp::PrefixAnnouncementField>(*fields.prefixAnnouncement);
+  }
+
+  if (fields.pitToken != nullptr) {
+    lpPacket.add<lp::PitTokenField>(*fields.pitToken);
+  }
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+GenericLinkService::prependLpPacket(ndn::EncodingImpl<TAG>& encoder, const Block& netPkt,
+                                    const LpFields& fields, bool isCongestionMarked)
+{
+  // header fields are ordered by TLV-TYPE and precede the fragment, so they are prepended
+  // in descending order of TLV-TYPE
+  size_t length = ndn::encoding::prependBinaryBlock(encoder, lp::tlv::Fragment,
+                                                    ndn::make_span(netPkt.data(), netPkt.size()));
+
+  if (fields.prefixAnnouncement != nullptr) {
+    length += lp::PrefixAnnouncementField::encode(encoder, *fields.prefixAnnouncement);
+  }
+
+  if (fields.nonDiscovery != nullptr) {
+    length += lp::NonDiscoveryField::encode(encoder, *fields.nonDiscovery);
+  }
+
+  if (isCongestionMarked) {
+    length += lp::CongestionMarkField::encode(encoder, 1);
+  }
+  else if (fields.congestionMark != nullptr) {
+    length += lp::CongestionMarkField::encode(encoder, *fields.congestionMark);
+  }
+
+  if (fields.incomingFaceId != nullptr) {
+    length += lp::IncomingFaceIdField::encode(encoder, *fields.incomingFaceId);
+  }
+
+  if (fields.nack != nullptr) {
+    length += lp::NackField::encode(encoder, *fields.nack);
+  }
+
+  if (fields.pitToken != nullptr) {
+    length += lp::PitTokenField::encode(encoder, *fields.pitToken);
+  }
+
+  length += encoder.prependVarNumber(length);
+  length += encoder.prependVarNumber(lp::tlv::LpPacket);
+  return length;
+}
+
+void
+GenericLinkService::sendNetPacket(const Block& netPkt, const LpFields& fields, bool isInterest)
+{
+  // without reliability, a packet that fits in the MTU needs neither a Sequence
+  // nor an lp::Packet to be kept, so it is encoded directly
+  if (!m_options.reliabilityOptions.isEnabled && this->sendUnfragmented(netPkt, fields)) {
+    return;
+  }
+
+  lp::Packet lpPacket(netPkt);
+  encodeLpFields(fields, lpPacket);
+  this->sendFragments(std::move(lpPacket), isInterest);
+}
+
+bool
+GenericLinkService::sendUnfragmented(const Block& netPkt, const LpFields& fields)
+{
+  BOOST_ASSERT(!m_options.reliabilityOptions.isEnabled);
+  const ssize_t mtu = getEffectiveMtu();
+
+  if (m_options.allowFragmentation && mtu != MTU_UNLIMITED) {
+    // same criterion as LpFragmenter, with space reserved for a congestion mark
+    size_t pktSize = netPkt.size();
+    if (!fields.empty()) {
+      ndn::EncodingEstimator estimator;
+      pktSize = prependLpPacket(estimator, netPkt, fields, false);
+    }
+    ssize_t fragMtu = mtu - (m_options.allowCongestionMarking ? CONGESTION_MARK_SIZE : 0);
+    if (static_cast<ssize_t>(LpFragmenter::MAX_SINGLE_FRAG_OVERHEAD + pktSize) > fragMtu) {
+      return false;
     }
   }
 
-  auto pitToken = netPkt.getTag<lp::PitToken>();
-  if (pitToken != nullptr) {
-    lpPacket.add<lp::PitTokenField>(*pitToken);
+  bool isCongestionMarked = m_options.allowCongestionMarking && checkCongestionLevel();
+
+  Block block = netPkt;
+  if (!fields.empty() || isCongestionMarked) {
+    ndn::EncodingEstimator estimator;
+    size_t estimatedSize = prependLpPacket(estimator, netPkt, fields, isCongestionMarked);
+    ndn::EncodingBuffer encoder(estimatedSize, 0);
+    prependLpPacket(encoder, netPkt, fields, isCongestionMarked);
+    block = encoder.block();
+  }
+
+  if (mtu != MTU_UNLIMITED && block.size() > static_cast<size_t>(mtu)) {
+    ++nOutOverMtu;
+    NFD_LOG_FACE_WARN("attempted to send packet over MTU limit");
+    return true;
   }
+  this->sendPacket(block);
+  return true;
 }
 
 void
-GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
+GenericLinkService::sendFragments(lp::Packet&& pkt, bool isInterest)
 {
   std::vector<lp::Packet> frags;
   ssize_t mtu = getEffectiveMtu();
@@ -239,23 +338,28 @@ GenericLinkService::sendNetPacket(lp::Packet&& pkt, bool isInterest)
   }
 }
 
-void
-GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
+bool
+GenericLinkService::checkCongestionLevel()
 {
   ssize_t sendQueueLength = getTransport()->getSendQueueLength();
   // The transport must support retrieving the current send queue length
   if (sendQueueLength < 0) {
-    return;
+    return false;
+  }
+
+  size_t congestionThreshold = m_options.defaultCongestionThreshold;
+  ssize_t sendQueueCapacity = getTransport()->getSendQueueCapacity();
+  if (sendQueueCapacity > 0) {
+    congestionThreshold = std::min(congestionThreshold, static_cast<size_t>(sendQueueCapacity) / 2);
   }
 
   if (sendQueueLength > 0) {
-    NFD_LOG_FACE_TRACE("txqlen=" << sendQueueLength << " threshold=" <<
-                       m_options.defaultCongestionThreshold << " capacity=" <<
-                       getTransport()->getSendQueueCapacity());
+    NFD_LOG_FACE_TRACE("txqlen=" << sendQueueLength << " threshold=" << congestionThreshold <<
+                       " capacity=" << sendQueueCapacity);
   }
 
   // sendQueue is above target
-  if (static_cast<size_t>(sendQueueLength) > m_options.defaultCongestionThreshold) {
+  if (static_cast<size_t>(sendQueueLength) > congestionThreshold) {
     const auto now = time::steady_clock::now();
 
     if (m_nextMarkTime == time::steady_clock::time_point::max()) {
@@ -263,7 +367,6 @@ GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
     }
     // Mark packet if sendQueue stays above target for one interval
     else if (now >= m_nextMarkTime) {
-      pkt.set<lp::CongestionMarkField>(1);
       ++nCongestionMarked;
       NFD_LOG_FACE_DEBUG("LpPacket was marked as congested");
 
@@ -274,6 +377,7 @@ GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
                                    m_options.baseCongestionMarkingInterval.count() /
                                    std::sqrt(m_nMarkedSinceInMarkingState + 1)));
       m_nextMarkTime += interval;
+      return true;
     }
   }
   else if (m_nextMarkTime != time::steady_clock::time_point::max()) {
@@ -282,6 +386,7 @@ GenericLinkService::checkCongestionLevel(lp::Packet& pkt)
     m_nextMarkTime = time::steady_clock::time_point::max();
     m_nMarkedSinceInMarkingState = 0;
   }
+  return false;
 }
 
 void
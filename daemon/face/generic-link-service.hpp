@@ -31,6 +31,9 @@
 #include "lp-reassembler.hpp"
 #include "lp-reliability.hpp"
 
+#include <ndn-cxx/lp/pit-token.hpp>
+#include <ndn-cxx/lp/tags.hpp>
+
 #include <limits>
 
 namespace nfd::face {
@@ -80,6 +83,12 @@ public:
    */
   PacketCounter nRetxExhausted;
 
+  /**
+   * \brief Count of fragment retransmissions found to be unnecessary, because an Ack
+   *        for an earlier transmission of the fragment was received.
+   */
+  PacketCounter nSpuriousRetx;
+
   /// Count of LpPackets dropped due to duplicate Sequence numbers.
   PacketCounter nDuplicateSequence;
 
@@ -135,6 +144,8 @@ struct GenericLinkServiceOptions
    *  Packets are marked if the queue size stays above THRESHOLD for at least one INTERVAL.
    *
    *  The default value (64 KiB) works well for a queue capacity of 200 KiB.
+   *  If the transport reports a send queue capacity, the threshold is lowered to half of
+   *  that capacity when necessary.
    */
   size_t defaultCongestionThreshold = 65536;
 
@@ -183,6 +194,15 @@ public:
     return m_options;
   }
 
+  /**
+   * \brief Get the reassembler, e.g., for its latency statistics.
+   */
+  const LpReassembler&
+  getLpReassembler() const noexcept
+  {
+    return m_reassembler;
+  }
+
   /**
    * \brief Sets the options used by GenericLinkService.
    */
@@ -231,26 +251,76 @@ NFD_PROTECTED_WITH_TESTS_ELSE_PRIVATE: // send path
   assignSequences(std::vector<lp::Packet>& pkts);
 
 private: // send path
-  /** \brief Encode link protocol fields from tags onto an outgoing LpPacket.
-   *  \param netPkt network-layer packet to extract tags from
-   *  \param lpPacket LpPacket to add link protocol fields to
+  /** \brief Link protocol header fields of an outgoing network-layer packet.
    */
-  void
-  encodeLpFields(const ndn::PacketBase& netPkt, lp::Packet& lpPacket);
+  struct LpFields
+  {
+    const lp::NackHeader* nack = nullptr;
+    shared_ptr<lp::PitToken> pitToken;
+    shared_ptr<lp::IncomingFaceIdTag> incomingFaceId;
+    shared_ptr<lp::CongestionMarkTag> congestionMark;
+    shared_ptr<lp::NonDiscoveryTag> nonDiscovery;
+    shared_ptr<lp::PrefixAnnouncementTag> prefixAnnouncement;
+
+    bool
+    empty() const noexcept
+    {
+      return nack == nullptr && pitToken == nullptr && incomingFaceId == nullptr &&
+             congestionMark == nullptr && nonDiscovery == nullptr && prefixAnnouncement == nullptr;
+    }
+  };
+
+  /** \brief Collect link protocol fields from the tags of an outgoing network-layer packet.
+   */
+  LpFields
+  getLpFields(const ndn::PacketBase& netPkt) const;
+
+  /** \brief Add link protocol fields onto an outgoing LpPacket.
+   */
+  static void
+  encodeLpFields(const LpFields& fields, lp::Packet& lpPacket);
+
+  /** \brief Prepend an LpPacket carrying \p netPkt and \p fields, without Sequence.
+   *  \param isCongestionMarked whether to set CongestionMark to 1, overriding \p fields
+   */
+  template<ndn::encoding::Tag TAG>
+  static size_t
+  prependLpPacket(ndn::EncodingImpl<TAG>& encoder, const Block& netPkt, const LpFields& fields,
+                  bool isCongestionMarked);
 
   /** \brief Send a complete network layer packet.
+   *  \param netPkt wire encoding of the network layer packet
+   *  \param fields link protocol fields to send with the packet
+   *  \param isInterest whether the network layer packet is an Interest
+   */
+  void
+  sendNetPacket(const Block& netPkt, const LpFields& fields, bool isInterest);
+
+  /** \brief Send a network layer packet in a single LpPacket, encoded directly from its wire.
+   *  \return false if the packet needs fragmentation, in which case nothing has been sent
+   *  \pre reliability is disabled
+   *
+   *  A packet without link protocol fields is given to the transport as is, sharing the buffer
+   *  of \p netPkt. Otherwise, the LpPacket is encoded in one pass into a buffer of the exact size.
+   *  Sending a packet on many faces therefore costs at most one copy of it per face, while
+   *  the per-face work on link protocol fields is proportional to their size.
+   */
+  bool
+  sendUnfragmented(const Block& netPkt, const LpFields& fields);
+
+  /** \brief Fragment an LpPacket if necessary, and send the fragments.
    *  \param pkt LpPacket containing a complete network layer packet
    *  \param isInterest whether the network layer packet is an Interest
    */
   void
-  sendNetPacket(lp::Packet&& pkt, bool isInterest);
+  sendFragments(lp::Packet&& pkt, bool isInterest);
 
-  /** \brief If the send queue is found to be congested, add a congestion mark to the packet
-   *         according to CoDel.
+  /** \brief Determine whether an outgoing packet should carry a congestion mark because
+   *         the send queue is found to be congested, according to CoDel.
    *  \sa https://tools.ietf.org/html/rfc8289
    */
-  void
-  checkCongestionLevel(lp::Packet& pkt);
+  bool
+  checkCongestionLevel();
 
 private: // receive path
   void
@@ -0,0 +1,643 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io-uring.hpp"
+#include "common/logger.hpp"
+
+#include <boost/asio/post.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace nfd::face {
+
+NFD_LOG_INIT(IoUring);
+
+// number of submission queue entries; sends beyond this number within one event are submitted early
+constexpr unsigned SQ_ENTRIES = 256;
+// number of completion queue entries; the kernel buffers completions that do not fit
+constexpr unsigned CQ_ENTRIES = 4096;
+// number of provided buffers for received datagrams, a power of two
+constexpr unsigned N_BUFFERS = 256;
+// size of a provided buffer: recvmsg header, source address, and an NDN packet
+constexpr size_t BUFFER_SIZE = 9216;
+constexpr uint16_t BUFFER_GROUP = 0;
+// user_data of requests whose completions are ignored
+constexpr uint64_t IGNORED_USER_DATA = std::numeric_limits<uint64_t>::max();
+// user_data of the requests submitted by probeMultishotReceive()
+constexpr uint64_t PROBE_RECEIVE_USER_DATA = IGNORED_USER_DATA - 1;
+constexpr uint64_t PROBE_CANCEL_USER_DATA = IGNORED_USER_DATA - 2;
+
+static_assert(sizeof(io_uring_recvmsg_out) + sizeof(sockaddr_storage) + ndn::MAX_NDN_PACKET_SIZE <= BUFFER_SIZE);
+
+template<typename T>
+static T
+loadAcquire(const T* p)
+{
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+template<typename T>
+static void
+storeRelease(T* p, T value)
+{
+  __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+static boost::system::error_code
+makeErrorCode(int negErrno)
+{
+  return {-negErrno, boost::system::system_category()};
+}
+
+IoUring*
+IoUring::get(boost::asio::io_context& io)
+{
+  auto& instance = boost::asio::use_service<IoUring>(io);
+  return instance.isSupported() ? &instance : nullptr;
+}
+
+IoUring::IoUring(boost::asio::io_context& io)
+  : boost::asio::execution_context::service(io)
+  , m_io(io)
+  , m_eventDescriptor(io)
+{
+  try {
+    setup();
+    NFD_LOG_INFO("Using io_uring for face I/O");
+  }
+  catch (const Error& e) {
+    NFD_LOG_WARN("io_uring is not available, falling back to asio: " << e.what());
+    close();
+  }
+}
+
+IoUring::~IoUring()
+{
+  close();
+}
+
+void
+IoUring::shutdown()
+{
+  close();
+}
+
+void
+IoUring::setup()
+{
+  io_uring_params params{};
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = CQ_ENTRIES;
+  m_ringFd = static_cast<int>(::syscall(__NR_io_uring_setup, SQ_ENTRIES, &params));
+  if (m_ringFd < 0) {
+    NDN_THROW_ERRNO(Error("io_uring_setup failed"));
+  }
+  if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0 || (params.features & IORING_FEAT_NODROP) == 0) {
+    NDN_THROW(Error("Required io_uring features are missing"));
+  }
+
+  m_ringsSize = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                         params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+  void* rings = ::mmap(nullptr, m_ringsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       m_ringFd, IORING_OFF_SQ_RING);
+  if (rings == MAP_FAILED) {
+    m_ringsSize = 0;
+    NDN_THROW_ERRNO(Error("mmap of io_uring queues failed"));
+  }
+  m_rings = static_cast<uint8_t*>(rings);
+
+  m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      m_ringFd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    m_sqesSize = 0;
+    NDN_THROW_ERRNO(Error("mmap of io_uring submission entries failed"));
+  }
+  m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+  m_sqHead = reinterpret_cast<const unsigned*>(m_rings + params.sq_off.head);
+  m_sqTail = reinterpret_cast<unsigned*>(m_rings + params.sq_off.tail);
+  m_sqMask = *reinterpret_cast<const unsigned*>(m_rings + params.sq_off.ring_mask);
+  m_sqEntries = params.sq_entries;
+  m_sqFlags = reinterpret_cast<const unsigned*>(m_rings + params.sq_off.flags);
+  m_sqeTail = *m_sqTail;
+  // each submission queue slot refers to the entry of the same index
+  auto sqArray = reinterpret_cast<unsigned*>(m_rings + params.sq_off.array);
+  for (unsigned i = 0; i < m_sqEntries; ++i) {
+    sqArray[i] = i;
+  }
+
+  m_cqHead = reinterpret_cast<unsigned*>(m_rings + params.cq_off.head);
+  m_cqTail = reinterpret_cast<const unsigned*>(m_rings + params.cq_off.tail);
+  m_cqMask = *reinterpret_cast<const unsigned*>(m_rings + params.cq_off.ring_mask);
+  m_cqes = reinterpret_cast<const io_uring_cqe*>(m_rings + params.cq_off.cqes);
+
+  probeOpcodes();
+
+  // provided buffers, from which the kernel picks one for each received datagram
+  m_bufferRingSize = N_BUFFERS * sizeof(io_uring_buf);
+  void* bufferRing = ::mmap(nullptr, m_bufferRingSize, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (bufferRing == MAP_FAILED) {
+    m_bufferRingSize = 0;
+    NDN_THROW_ERRNO(Error("mmap of buffer ring failed"));
+  }
+  m_bufferRing = static_cast<io_uring_buf*>(bufferRing);
+
+  m_buffersSize = N_BUFFERS * BUFFER_SIZE;
+  void* buffers = ::mmap(nullptr, m_buffersSize, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (buffers == MAP_FAILED) {
+    m_buffersSize = 0;
+    NDN_THROW_ERRNO(Error("mmap of receive buffers failed"));
+  }
+  m_buffers = static_cast<uint8_t*>(buffers);
+
+  io_uring_buf_reg reg{};
+  reg.ring_addr = reinterpret_cast<uintptr_t>(m_bufferRing);
+  reg.ring_entries = N_BUFFERS;
+  reg.bgid = BUFFER_GROUP;
+  if (::syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) != 0) {
+    NDN_THROW_ERRNO(Error("IORING_REGISTER_PBUF_RING failed"));
+  }
+  for (unsigned i = 0; i < N_BUFFERS; ++i) {
+    recycleBuffer(static_cast<uint16_t>(i));
+  }
+  publishBuffers();
+
+  // in each provided buffer, the source address is followed by the payload
+  m_receiveMsg.msg_namelen = sizeof(sockaddr_storage);
+
+  // before the eventfd is registered, so that the probe completions are not dispatched
+  probeMultishotReceive();
+
+  int eventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (eventFd < 0) {
+    NDN_THROW_ERRNO(Error("eventfd failed"));
+  }
+  m_eventDescriptor.assign(eventFd);
+  if (::syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_EVENTFD, &eventFd, 1) != 0) {
+    NDN_THROW_ERRNO(Error("IORING_REGISTER_EVENTFD failed"));
+  }
+  asyncWaitCompletions();
+}
+
+void
+IoUring::probeOpcodes()
+{
+  // IORING_REGISTER_PROBE fills one entry per opcode, up to the number of entries given
+  constexpr unsigned N_PROBE_OPS = 256;
+  std::vector<uint8_t> buffer(sizeof(io_uring_probe) + N_PROBE_OPS * sizeof(io_uring_probe_op));
+  auto probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+  if (::syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_PROBE, probe, N_PROBE_OPS) != 0) {
+    NDN_THROW_ERRNO(Error("IORING_REGISTER_PROBE failed"));
+  }
+
+  for (unsigned opcode : {IORING_OP_RECVMSG, IORING_OP_SEND, IORING_OP_ASYNC_CANCEL}) {
+    if (opcode > probe->last_op || (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) == 0) {
+      NDN_THROW(Error("io_uring opcode " + std::to_string(opcode) + " is not supported"));
+    }
+  }
+}
+
+void
+IoUring::probeMultishotReceive()
+{
+  int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    NDN_THROW_ERRNO(Error("socket failed"));
+  }
+
+  // requests are started in order, so the receive is armed, or rejected, before the cancel
+  io_uring_sqe* sqe = getSqe();
+  sqe->opcode = IORING_OP_RECVMSG;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<uintptr_t>(&m_receiveMsg);
+  sqe->len = 1;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = BUFFER_GROUP;
+  sqe->user_data = PROBE_RECEIVE_USER_DATA;
+
+  sqe = getSqe();
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = fd;
+  sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+  sqe->user_data = PROBE_CANCEL_USER_DATA;
+
+  storeRelease(m_sqTail, m_sqeTail);
+  long ret = 0;
+  do {
+    ret = ::syscall(__NR_io_uring_enter, m_ringFd, 2, 2, IORING_ENTER_GETEVENTS, nullptr, 0);
+  } while (ret < 0 && errno == EINTR);
+  int enterErrno = errno;
+  ::close(fd);
+  if (ret < 0) {
+    errno = enterErrno;
+    NDN_THROW_ERRNO(Error("io_uring_enter failed"));
+  }
+
+  int receiveResult = 0;
+  int cancelResult = 0;
+  unsigned head = *m_cqHead;
+  for (; head != loadAcquire(m_cqTail); ++head) {
+    const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+    if (cqe.user_data == PROBE_RECEIVE_USER_DATA) {
+      receiveResult = cqe.res;
+    }
+    else if (cqe.user_data == PROBE_CANCEL_USER_DATA) {
+      cancelResult = cqe.res;
+    }
+  }
+  storeRelease(m_cqHead, head);
+
+  // a supported multishot receive ends with -ECANCELED; an unsupported one fails with -EINVAL
+  if (receiveResult != -ECANCELED) {
+    NDN_THROW(Error("multishot recvmsg is not supported: " +
+                    makeErrorCode(receiveResult).message()));
+  }
+  if (cancelResult < 0) {
+    NDN_THROW(Error("cancellation by fd is not supported: " +
+                    makeErrorCode(cancelResult).message()));
+  }
+}
+
+void
+IoUring::close() noexcept
+{
+  boost::system::error_code error;
+  m_eventDescriptor.cancel(error);
+  m_eventDescriptor.close(error);
+
+  // closing the ring cancels all requests
+  if (m_ringFd >= 0) {
+    ::close(m_ringFd);
+    m_ringFd = -1;
+  }
+  if (m_rings != nullptr) {
+    ::munmap(m_rings, m_ringsSize);
+    m_rings = nullptr;
+  }
+  if (m_sqes != nullptr) {
+    ::munmap(m_sqes, m_sqesSize);
+    m_sqes = nullptr;
+  }
+  if (m_bufferRing != nullptr) {
+    ::munmap(m_bufferRing, m_bufferRingSize);
+    m_bufferRing = nullptr;
+  }
+  if (m_buffers != nullptr) {
+    ::munmap(m_buffers, m_buffersSize);
+    m_buffers = nullptr;
+  }
+  m_ops.clear();
+  m_freeOps.clear();
+}
+
+io_uring_sqe*
+IoUring::getSqe()
+{
+  if (m_sqeTail - loadAcquire(m_sqHead) >= m_sqEntries) {
+    submit();
+    if (m_sqeTail - loadAcquire(m_sqHead) >= m_sqEntries) {
+      return nullptr;
+    }
+  }
+
+  io_uring_sqe* sqe = &m_sqes[m_sqeTail & m_sqMask];
+  std::memset(sqe, 0, sizeof(*sqe));
+  ++m_sqeTail;
+  return sqe;
+}
+
+void
+IoUring::submit()
+{
+  m_hasPendingSubmit = false;
+  if (!isSupported()) {
+    // the io_context is being destroyed
+    return;
+  }
+
+  unsigned nQueued = m_sqeTail - loadAcquire(m_sqHead);
+  if (nQueued == 0) {
+    return;
+  }
+
+  storeRelease(m_sqTail, m_sqeTail);
+  if (::syscall(__NR_io_uring_enter, m_ringFd, nQueued, 0, 0, nullptr, 0) < 0 &&
+      errno != EAGAIN && errno != EBUSY && errno != EINTR) {
+    NFD_LOG_ERROR("io_uring_enter failed: " << std::strerror(errno));
+  }
+}
+
+void
+IoUring::scheduleSubmit()
+{
+  if (m_hasPendingSubmit) {
+    return;
+  }
+
+  // submit after the current event has been handled, so that the requests it queues are batched
+  m_hasPendingSubmit = true;
+  boost::asio::post(m_io, [this] {
+    if (m_hasPendingSubmit) {
+      submit();
+    }
+  });
+}
+
+uint32_t
+IoUring::allocateOperation()
+{
+  if (m_freeOps.empty()) {
+    m_ops.emplace_back();
+    return static_cast<uint32_t>(m_ops.size() - 1);
+  }
+
+  uint32_t index = m_freeOps.back();
+  m_freeOps.pop_back();
+  return index;
+}
+
+void
+IoUring::releaseOperation(uint32_t index)
+{
+  m_ops[index] = {};
+  m_freeOps.push_back(index);
+}
+
+void
+IoUring::startReceive(int fd, const void* owner, ReceiveHandler handler)
+{
+  BOOST_ASSERT(isSupported());
+
+  uint32_t index = allocateOperation();
+  Operation& op = m_ops[index];
+  op.kind = Operation::RECEIVE;
+  op.fd = fd;
+  op.owner = owner;
+  op.receiveHandler = std::move(handler);
+
+  prepareReceive(index);
+  submit();
+}
+
+void
+IoUring::prepareReceive(uint32_t index)
+{
+  io_uring_sqe* sqe = getSqe();
+  if (sqe == nullptr) {
+    // unlikely, since completions are processed before the queue can fill up with receives
+    NFD_LOG_ERROR("Submission queue is full, cannot receive on fd " << m_ops[index].fd);
+    auto handler = std::move(m_ops[index].receiveHandler);
+    releaseOperation(index);
+    handler(boost::asio::error::no_buffer_space, {}, {});
+    return;
+  }
+
+  sqe->opcode = IORING_OP_RECVMSG;
+  sqe->fd = m_ops[index].fd;
+  sqe->addr = reinterpret_cast<uintptr_t>(&m_receiveMsg);
+  sqe->len = 1;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = BUFFER_GROUP;
+  sqe->user_data = index;
+}
+
+bool
+IoUring::send(int fd, const void* owner, const Block& packet, SendHandler handler)
+{
+  BOOST_ASSERT(isSupported());
+
+  io_uring_sqe* sqe = getSqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+
+  uint32_t index = allocateOperation();
+  Operation& op = m_ops[index];
+  op.kind = Operation::SEND;
+  op.fd = fd;
+  op.owner = owner;
+  op.sendHandler = std::move(handler);
+  op.packet = packet;
+
+  sqe->opcode = IORING_OP_SEND;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<uintptr_t>(op.packet.data());
+  sqe->len = static_cast<uint32_t>(op.packet.size());
+  sqe->user_data = index;
+
+  scheduleSubmit();
+  return true;
+}
+
+void
+IoUring::cancel(int fd, const void* owner)
+{
+  if (!isSupported()) {
+    return;
+  }
+
+  for (auto& op : m_ops) {
+    if (op.fd == fd && op.owner == owner) {
+      op.isCancelled = true;
+    }
+  }
+
+  // queued requests on fd must reach the kernel before fd is closed and its number reused
+  io_uring_sqe* sqe = getSqe();
+  if (sqe == nullptr) {
+    cancelSync(fd);
+    return;
+  }
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = fd;
+  sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+  sqe->user_data = IGNORED_USER_DATA;
+  submit();
+}
+
+void
+IoUring::cancelSync(int fd)
+{
+  NFD_LOG_DEBUG("Submission queue is full, cancelling requests on fd " << fd << " synchronously");
+
+  // requests on fd that the kernel has not consumed yet complete as no-ops instead,
+  // so that they cannot act on another socket that reuses the number of fd
+  for (unsigned i = loadAcquire(m_sqHead); i != m_sqeTail; ++i) {
+    io_uring_sqe& sqe = m_sqes[i & m_sqMask];
+    if (sqe.fd == fd && sqe.opcode != IORING_OP_NOP) {
+      uint64_t userData = sqe.user_data;
+      std::memset(&sqe, 0, sizeof(sqe));
+      sqe.opcode = IORING_OP_NOP;
+      sqe.user_data = userData;
+    }
+  }
+
+  // IORING_REGISTER_SYNC_CANCEL needs no submission queue entry; it is available on every kernel
+  // that passed probeMultishotReceive() (Linux 6.0 and later), and returns after the requests
+  // have been cancelled, whose completions are then handled as for an asynchronous cancel
+  io_uring_sync_cancel_reg reg{};
+  reg.fd = fd;
+  reg.flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+  reg.timeout.tv_sec = -1;
+  reg.timeout.tv_nsec = -1;
+  long ret = 0;
+  do {
+    ret = ::syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_SYNC_CANCEL, &reg, 1);
+  } while (ret < 0 && errno == EINTR);
+  if (ret < 0 && errno != ENOENT) {
+    NFD_LOG_ERROR("IORING_REGISTER_SYNC_CANCEL failed on fd " << fd << ": " << std::strerror(errno));
+  }
+}
+
+void
+IoUring::asyncWaitCompletions()
+{
+  m_eventDescriptor.async_wait(boost::asio::posix::stream_descriptor::wait_read, [this] (const auto& error) {
+    if (error) {
+      if (error != boost::asio::error::operation_aborted) {
+        NFD_LOG_ERROR("Waiting for io_uring completions failed: " << error.message());
+      }
+      return;
+    }
+    handleCompletions();
+    asyncWaitCompletions();
+  });
+}
+
+void
+IoUring::handleCompletions()
+{
+  uint64_t nEvents = 0;
+  while (::read(m_eventDescriptor.native_handle(), &nEvents, sizeof(nEvents)) > 0)
+    ;
+
+  while (true) {
+    unsigned head = *m_cqHead;
+    unsigned tail = loadAcquire(m_cqTail);
+    if (head == tail) {
+      // completions that did not fit in the queue are flushed into it by the kernel on request
+      if ((loadAcquire(m_sqFlags) & IORING_SQ_CQ_OVERFLOW) == 0) {
+        break;
+      }
+      ::syscall(__NR_io_uring_enter, m_ringFd, 0, 0, IORING_ENTER_GETEVENTS, nullptr, 0);
+      continue;
+    }
+
+    for (; head != tail; ++head) {
+      io_uring_cqe cqe = m_cqes[head & m_cqMask];
+      storeRelease(m_cqHead, head + 1);
+      processCompletion(cqe);
+    }
+    publishBuffers();
+  }
+}
+
+void
+IoUring::processCompletion(const io_uring_cqe& cqe)
+{
+  if (cqe.user_data == IGNORED_USER_DATA) {
+    return;
+  }
+
+  auto index = static_cast<uint32_t>(cqe.user_data);
+  BOOST_ASSERT(index < m_ops.size());
+  Operation& op = m_ops[index];
+  bool isFinal = (cqe.flags & IORING_CQE_F_MORE) == 0;
+
+  if (op.kind == Operation::SEND) {
+    if (!op.isCancelled) {
+      op.sendHandler(cqe.res < 0 ? makeErrorCode(cqe.res) : boost::system::error_code{},
+                     cqe.res < 0 ? 0 : static_cast<size_t>(cqe.res));
+    }
+    releaseOperation(index);
+    return;
+  }
+
+  BOOST_ASSERT(op.kind == Operation::RECEIVE);
+  if (cqe.res >= 0 && (cqe.flags & IORING_CQE_F_BUFFER) != 0) {
+    auto bufferId = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+    const uint8_t* buffer = m_buffers + bufferId * BUFFER_SIZE;
+    auto out = reinterpret_cast<const io_uring_recvmsg_out*>(buffer);
+    size_t headerLen = sizeof(io_uring_recvmsg_out) + m_receiveMsg.msg_namelen + m_receiveMsg.msg_controllen;
+
+    if (static_cast<size_t>(cqe.res) < headerLen || (out->flags & MSG_TRUNC) != 0) {
+      NFD_LOG_DEBUG("Dropping truncated datagram on fd " << op.fd);
+    }
+    else if (!op.isCancelled) {
+      const uint8_t* source = buffer + sizeof(io_uring_recvmsg_out);
+      op.receiveHandler({}, {source, std::min<size_t>(out->namelen, m_receiveMsg.msg_namelen)},
+                        {buffer + headerLen, out->payloadlen});
+    }
+    recycleBuffer(bufferId);
+  }
+  else if (cqe.res < 0 && !op.isCancelled && cqe.res != -ENOBUFS && cqe.res != -ECANCELED) {
+    op.receiveHandler(makeErrorCode(cqe.res), {}, {});
+  }
+
+  if (!isFinal) {
+    return;
+  }
+  // the kernel stops a multishot receive when it runs out of buffers or completion queue space;
+  // restart it once the buffers of this batch have been returned
+  if (!op.isCancelled && (cqe.res >= 0 || cqe.res == -ENOBUFS)) {
+    prepareReceive(index);
+    scheduleSubmit();
+    return;
+  }
+  releaseOperation(index);
+}
+
+void
+IoUring::recycleBuffer(uint16_t bufferId)
+{
+  // not io_uring_buf_ring::bufs, whose offset is wrong in C++ due to __DECLARE_FLEX_ARRAY
+  io_uring_buf& buf = m_bufferRing[m_bufferTail & (N_BUFFERS - 1)];
+  buf.addr = reinterpret_cast<uintptr_t>(m_buffers + bufferId * BUFFER_SIZE);
+  buf.len = BUFFER_SIZE;
+  buf.bid = bufferId;
+  ++m_bufferTail;
+}
+
+void
+IoUring::publishBuffers()
+{
+  // the tail overlays the reserved field of the first buffer
+  storeRelease(&reinterpret_cast<io_uring_buf_ring*>(m_bufferRing)->tail, m_bufferTail);
+}
+
+} // namespace nfd::face
@@ -0,0 +1,260 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_IO_URING_HPP
+#define NFD_DAEMON_FACE_IO_URING_HPP
+
+#include "core/common.hpp"
+
+#ifndef NFD_HAVE_IO_URING
+#error "Cannot include this file when io_uring support is disabled"
+#endif
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+
+#include <deque>
+
+#include <sys/socket.h>
+
+struct io_uring_buf;
+struct io_uring_cqe;
+struct io_uring_sqe;
+
+namespace nfd::face {
+
+/**
+ * @brief An io_uring instance that performs socket I/O for the transports of one io_context.
+ *
+ * Each socket receives datagrams with a single multishot recvmsg request, which keeps
+ * producing completions until it is cancelled. The datagrams are placed into a ring of
+ * buffers that is registered with the kernel and shared by all sockets. Send requests are
+ * queued and submitted together, with one system call, after the current event has been
+ * handled. Completions are signalled through an eventfd that the io_context waits on, so
+ * that io_uring and the asio reactor serve sockets side by side.
+ *
+ * The instance is an io_context service, obtained with get(). The io_uring features it needs
+ * (single mmap, no-drop completions, provided buffer rings, multishot recvmsg, cancellation
+ * by fd) are probed when it is created, rather than inferred from the kernel version. If any
+ * of them is missing, or if io_uring is not permitted, get() returns nullptr and the caller
+ * should fall back to the asio I/O operations.
+ */
+class IoUring final : public boost::asio::execution_context::service
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /**
+   * @brief Handler of a received datagram.
+   * @param error set if the receive request failed; no further datagrams are delivered
+   * @param source source address of the datagram
+   * @param payload the datagram; valid only during the invocation
+   */
+  using ReceiveHandler = std::function<void(const boost::system::error_code& error,
+                                            span<const uint8_t> source,
+                                            span<const uint8_t> payload)>;
+
+  /**
+   * @brief Handler of a completed send request.
+   */
+  using SendHandler = std::function<void(const boost::system::error_code& error, size_t nBytesSent)>;
+
+  /**
+   * @brief Return the instance serving @p io, or nullptr if io_uring is not supported.
+   *
+   * The reason why io_uring is not supported is logged when the instance is created.
+   */
+  static IoUring*
+  get(boost::asio::io_context& io);
+
+  explicit
+  IoUring(boost::asio::io_context& io);
+
+  ~IoUring() final;
+
+  bool
+  isSupported() const noexcept
+  {
+    return m_ringFd >= 0;
+  }
+
+  /**
+   * @brief Start receiving datagrams on socket @p fd.
+   * @param owner identifies the requests to cancel with cancel()
+   * @param handler invoked for each datagram, until cancel() is called or the request fails
+   *
+   * The request is submitted immediately.
+   */
+  void
+  startReceive(int fd, const void* owner, ReceiveHandler handler);
+
+  /**
+   * @brief Queue a send of @p packet on the connected socket @p fd.
+   * @param owner identifies the requests to cancel with cancel()
+   * @param handler invoked when the send completes, unless cancel() is called before
+   * @retval false the submission queue is full, and the packet is not sent
+   *
+   * @p packet is retained until the send completes.
+   */
+  bool
+  send(int fd, const void* owner, const Block& packet, SendHandler handler);
+
+  /**
+   * @brief Cancel all requests on socket @p fd and disable the handlers of @p owner.
+   *
+   * This must be called before @p fd is closed.
+   */
+  void
+  cancel(int fd, const void* owner);
+
+private:
+  void
+  shutdown() final;
+
+  void
+  setup();
+
+  /**
+   * @brief Check that the kernel supports every opcode used by this class.
+   * @throw Error an opcode is not supported
+   */
+  void
+  probeOpcodes();
+
+  /**
+   * @brief Check that the kernel supports multishot recvmsg and cancellation by fd.
+   *
+   * Neither can be detected from the opcode probe, so a multishot recvmsg is submitted on
+   * a throwaway socket and cancelled, and both completions are inspected.
+   * @throw Error the kernel rejected either request
+   */
+  void
+  probeMultishotReceive();
+
+  void
+  close() noexcept;
+
+  io_uring_sqe*
+  getSqe();
+
+  /**
+   * @brief Hand all queued requests to the kernel.
+   */
+  void
+  submit();
+
+  void
+  scheduleSubmit();
+
+  /**
+   * @brief Cancel all requests on socket @p fd without using a submission queue entry.
+   *
+   * This is the fallback of cancel() when the submission queue is full.
+   */
+  void
+  cancelSync(int fd);
+
+  void
+  asyncWaitCompletions();
+
+  void
+  handleCompletions();
+
+  void
+  processCompletion(const io_uring_cqe& cqe);
+
+  void
+  prepareReceive(uint32_t index);
+
+  void
+  recycleBuffer(uint16_t bufferId);
+
+  void
+  publishBuffers();
+
+  uint32_t
+  allocateOperation();
+
+  void
+  releaseOperation(uint32_t index);
+
+private:
+  struct Operation
+  {
+    enum Kind : uint8_t { NONE, RECEIVE, SEND };
+
+    Kind kind = NONE;
+    bool isCancelled = false;
+    int fd = -1;
+    const void* owner = nullptr;
+    ReceiveHandler receiveHandler;
+    SendHandler sendHandler;
+    Block packet;
+  };
+
+  boost::asio::io_context& m_io;
+  boost::asio::posix::stream_descriptor m_eventDescriptor;
+  int m_ringFd = -1;
+
+  // submission and completion queues, in one mapping
+  uint8_t* m_rings = nullptr;
+  size_t m_ringsSize = 0;
+  io_uring_sqe* m_sqes = nullptr;
+  size_t m_sqesSize = 0;
+  const unsigned* m_sqHead = nullptr;
+  unsigned* m_sqTail = nullptr;
+  unsigned m_sqMask = 0;
+  unsigned m_sqEntries = 0;
+  const unsigned* m_sqFlags = nullptr;
+  unsigned m_sqeTail = 0; ///< tail including queued, not yet submitted, requests
+  bool m_hasPendingSubmit = false;
+
+  unsigned* m_cqHead = nullptr;
+  const unsigned* m_cqTail = nullptr;
+  unsigned m_cqMask = 0;
+  const io_uring_cqe* m_cqes = nullptr;
+
+  // provided buffers for received datagrams
+  io_uring_buf* m_bufferRing = nullptr;
+  size_t m_bufferRingSize = 0;
+  uint8_t* m_buffers = nullptr;
+  size_t m_buffersSize = 0;
+  uint16_t m_bufferTail = 0;
+  msghdr m_receiveMsg{}; ///< layout of received datagrams in the provided buffers
+
+  std::deque<Operation> m_ops; ///< deque so that a running handler is not relocated
+  std::vector<uint32_t> m_freeOps;
+
+public:
+  static inline boost::asio::execution_context::id id;
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_IO_URING_HPP
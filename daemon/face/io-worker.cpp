@@ -0,0 +1,568 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io-worker.hpp"
+#include "face.hpp"
+#include "common/global.hpp"
+#include "common/logger.hpp"
+
+#include <boost/asio/defer.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+
+#include <set>
+
+namespace nfd::face {
+
+NFD_LOG_INIT(IoWorker);
+
+namespace {
+
+/** \brief A copy of the counters of a transport.
+ */
+struct TransportCountersCopy
+{
+  explicit
+  TransportCountersCopy(const Transport::Counters& counters)
+    : nInPackets(counters.nInPackets)
+    , nOutPackets(counters.nOutPackets)
+    , nInBytes(counters.nInBytes)
+    , nOutBytes(counters.nOutBytes)
+    , nOutDrops(counters.nOutDrops)
+  {
+  }
+
+  uint64_t nInPackets;
+  uint64_t nOutPackets;
+  uint64_t nInBytes;
+  uint64_t nOutBytes;
+  uint64_t nOutDrops;
+};
+
+} // namespace
+
+/** \brief The Transport of a face in the main thread that stands for a face of the worker.
+ *
+ * It is created in the worker thread, where the properties of the face of the worker can be
+ * read, and is then used only in the main thread.
+ */
+class IoWorker::ProxyTransport final : public Transport
+{
+public:
+  ProxyTransport(const Face& face, shared_ptr<IoWorker> worker, uint64_t localId)
+    : m_worker(std::move(worker))
+    , m_localId(localId)
+  {
+    this->setLocalUri(face.getLocalUri());
+    this->setRemoteUri(face.getRemoteUri());
+    this->setScope(face.getScope());
+    this->setPersistency(face.getPersistency());
+    this->setLinkType(face.getLinkType());
+    this->setMtu(face.getTransport()->getMtu());
+    if (face.getState() == TransportState::DOWN) {
+      this->setState(TransportState::DOWN);
+    }
+    this->setSendQueueCongested(face.isSendQueueCongested());
+    this->updateCounters(TransportCountersCopy(face.getTransport()->getCounters()));
+
+    for (auto persistency : {ndn::nfd::FACE_PERSISTENCY_ON_DEMAND,
+                             ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                             ndn::nfd::FACE_PERSISTENCY_PERMANENT}) {
+      if (face.getTransport()->canChangePersistencyTo(persistency)) {
+        m_allowedPersistencies.insert(persistency);
+      }
+    }
+  }
+
+  /** \brief Follow a state change of the face of the worker.
+   */
+  void
+  followState(TransportState newState)
+  {
+    auto isUpOrDown = [] (TransportState state) {
+      return state == TransportState::UP || state == TransportState::DOWN;
+    };
+    TransportState state = this->getState();
+    if (newState == state || state == TransportState::CLOSED) {
+      return;
+    }
+
+    switch (newState) {
+      case TransportState::UP:
+      case TransportState::DOWN:
+      case TransportState::CLOSING:
+      case TransportState::FAILED:
+        if (isUpOrDown(state)) {
+          this->setState(newState);
+        }
+        break;
+      case TransportState::CLOSED:
+        if (isUpOrDown(state)) {
+          this->setState(TransportState::CLOSING);
+        }
+        // the Transport may be deallocated after this
+        this->setState(TransportState::CLOSED);
+        break;
+    }
+  }
+
+  void
+  followSendQueueCongested(bool isCongested)
+  {
+    this->setSendQueueCongested(isCongested);
+  }
+
+  void
+  updateCounters(const TransportCountersCopy& counters)
+  {
+    this->nInPackets.set(counters.nInPackets);
+    this->nOutPackets.set(counters.nOutPackets);
+    this->nInBytes.set(counters.nInBytes);
+    this->nOutBytes.set(counters.nOutBytes);
+    this->nOutDrops.set(counters.nOutDrops);
+  }
+
+private:
+  bool
+  canChangePersistencyToImpl(ndn::nfd::FacePersistency newPersistency) const final
+  {
+    return m_allowedPersistencies.count(newPersistency) > 0;
+  }
+
+  void
+  afterChangePersistency(ndn::nfd::FacePersistency) final
+  {
+    m_worker->setFacePersistency(m_localId, this->getPersistency());
+  }
+
+  void
+  doClose() final
+  {
+    m_worker->closeFace(m_localId);
+    this->setState(TransportState::CLOSED);
+  }
+
+  void
+  doSend(const Block&) final
+  {
+    // ShardLinkService never sends through the transport
+  }
+
+private:
+  shared_ptr<IoWorker> m_worker;
+  const uint64_t m_localId;
+  std::set<ndn::nfd::FacePersistency> m_allowedPersistencies;
+};
+
+static ShardPacket
+makePacket(ShardPacket::Type type, uint64_t localId, const EndpointId& endpointId = {})
+{
+  ShardPacket packet;
+  packet.type = type;
+  packet.faceId = localId;
+  packet.endpointId = endpointId;
+  return packet;
+}
+
+IoWorker::IoWorker(size_t index, size_t queueCapacity)
+  : m_index(index)
+  , m_mainIo(getGlobalIoService())
+  , m_ingress(queueCapacity)
+  , m_egress(queueCapacity)
+{
+}
+
+IoWorker::~IoWorker()
+{
+  stop();
+}
+
+void
+IoWorker::start()
+{
+  BOOST_ASSERT(!m_thread.joinable());
+  std::promise<boost::asio::io_context*> ioPromise;
+  auto ioFuture = ioPromise.get_future();
+  m_thread = std::thread([this, ioPromise = std::move(ioPromise)] () mutable { run(ioPromise); });
+  m_io = ioFuture.get();
+  m_isRunning = true;
+}
+
+void
+IoWorker::stop()
+{
+  if (!m_isRunning) {
+    return;
+  }
+  m_isRunning = false;
+  m_io->stop();
+  m_thread.join();
+
+  // the faces of the main thread refer to this worker
+  m_proxyFaces.clear();
+  std::vector<PendingFace> pendingFaces;
+  {
+    std::lock_guard<std::mutex> lock(m_pendingFacesMutex);
+    pendingFaces.swap(m_pendingFaces);
+  }
+}
+
+void
+IoWorker::run(std::promise<boost::asio::io_context*>& ioPromise)
+{
+  auto& io = getGlobalIoService();
+  auto workGuard = boost::asio::make_work_guard(io);
+  scheduleCountersRefresh();
+  ioPromise.set_value(&io);
+
+  // run until stopped, which needs the io_context to be alive
+  while (!io.stopped()) {
+    try {
+      io.run();
+    }
+    catch (const std::exception& e) {
+      NFD_LOG_FATAL("worker=" << m_index << ": " << boost::diagnostic_information(e));
+      // let the main thread terminate as it would if face I/O failed there
+      boost::asio::post(m_mainIo, [e = std::current_exception()] { std::rethrow_exception(e); });
+    }
+  }
+
+  // the faces must be destroyed in this thread, before its io_context and Scheduler
+  m_countersEvent.cancel();
+  std::vector<std::function<void()>> atStop;
+  {
+    std::lock_guard<std::mutex> lock(m_atStopMutex);
+    atStop.swap(m_atStop);
+  }
+  for (const auto& f : atStop) {
+    f();
+  }
+  atStop.clear();
+  m_localIds.clear();
+  m_workerFaces.clear();
+}
+
+void
+IoWorker::atStop(std::function<void()> f)
+{
+  std::lock_guard<std::mutex> lock(m_atStopMutex);
+  m_atStop.push_back(std::move(f));
+}
+
+void
+IoWorker::adoptFace(const shared_ptr<Face>& face, FaceCreatedCallback onAdopted)
+{
+  if (face == nullptr) {
+    return;
+  }
+
+  PendingFace pending;
+  pending.onAdopted = std::move(onAdopted);
+  if (auto it = m_localIds.find(face.get()); it != m_localIds.end()) {
+    pending.localId = it->second;
+  }
+  else {
+    uint64_t localId = pending.localId = ++m_lastLocalId;
+    pending.proxy = makeProxyFace(*face, localId);
+    m_localIds.emplace(face.get(), localId);
+
+    WorkerFace& workerFace = m_workerFaces[localId];
+    workerFace.face = face;
+    auto& connections = workerFace.connections;
+    connections.emplace_back(face->afterReceiveInterest.connect(
+      [this, localId] (const Interest& interest, const EndpointId& endpointId) {
+        auto packet = makePacket(ShardPacket::INTEREST, localId, endpointId);
+        packet.interest = shareOrCopy(interest);
+        pushIngress(std::move(packet));
+      }));
+    connections.emplace_back(face->afterReceiveData.connect(
+      [this, localId] (const Data& data, const EndpointId& endpointId) {
+        auto packet = makePacket(ShardPacket::DATA, localId, endpointId);
+        packet.data = shareOrCopy(data);
+        pushIngress(std::move(packet));
+      }));
+    connections.emplace_back(face->afterReceiveNack.connect(
+      [this, localId] (const lp::Nack& nack, const EndpointId& endpointId) {
+        auto packet = makePacket(ShardPacket::NACK, localId, endpointId);
+        packet.nack = make_shared<lp::Nack>(nack);
+        pushIngress(std::move(packet));
+      }));
+    connections.emplace_back(face->onDroppedInterest.connect(
+      [this, localId] (const Interest& interest) {
+        auto packet = makePacket(ShardPacket::DROPPED_INTEREST, localId);
+        // LpReliability emits a temporary
+        packet.interest = make_shared<Interest>(interest);
+        pushIngress(std::move(packet));
+      }));
+    connections.emplace_back(face->afterStateChange.connect(
+      [this, localId] (FaceState, FaceState newState) {
+        postToMain([localId, newState] (IoWorker& worker) {
+          if (auto transport = worker.findProxyTransport(localId); transport != nullptr) {
+            transport->followState(newState);
+          }
+        });
+        if (newState == FaceState::CLOSED) {
+          // the face must not be deallocated during its afterStateChange signal
+          boost::asio::defer(getGlobalIoService(), [this, localId] { releaseFace(localId); });
+        }
+      }));
+    connections.emplace_back(face->afterSendQueueCongestionChange.connect(
+      [this, localId] (bool isCongested) {
+        postToMain([localId, isCongested] (IoWorker& worker) {
+          if (auto transport = worker.findProxyTransport(localId); transport != nullptr) {
+            transport->followSendQueueCongested(isCongested);
+          }
+        });
+      }));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_pendingFacesMutex);
+    m_pendingFaces.push_back(std::move(pending));
+  }
+  postToMain([] (IoWorker& worker) { worker.addPendingFaces(); });
+}
+
+shared_ptr<Face>
+IoWorker::makeProxyFace(const Face& face, uint64_t localId)
+{
+  auto send = [worker = shared_from_this(), localId] (ShardPacket&& packet) {
+    packet.faceId = localId;
+    worker->pushEgress(std::move(packet));
+  };
+  return make_shared<Face>(make_unique<ShardLinkService>(std::move(send)),
+                           make_unique<ProxyTransport>(face, shared_from_this(), localId));
+}
+
+void
+IoWorker::pushIngress(ShardPacket&& packet)
+{
+  if (!m_ingress.push(std::move(packet))) {
+    m_nQueueDrops.fetch_add(1, std::memory_order_relaxed);
+    NFD_LOG_DEBUG("worker=" << m_index << " ingress queue full, dropping packet");
+    return;
+  }
+  if (!m_hasIngressWakeup.exchange(true, std::memory_order_acq_rel)) {
+    postToMain([] (IoWorker& worker) { worker.drainIngress(); });
+  }
+}
+
+void
+IoWorker::drainEgress()
+{
+  m_hasEgressWakeup.exchange(false, std::memory_order_acq_rel);
+  m_egress.consumeAll([this] (ShardPacket&& packet) {
+    auto it = m_workerFaces.find(packet.faceId);
+    if (it == m_workerFaces.end()) {
+      return; // the face has been closed
+    }
+
+    Face& face = *it->second.face;
+    switch (packet.type) {
+      case ShardPacket::INTEREST:
+        face.sendInterest(*packet.interest);
+        break;
+      case ShardPacket::DATA:
+        face.sendData(*packet.data);
+        break;
+      case ShardPacket::NACK:
+        face.sendNack(*packet.nack);
+        break;
+      case ShardPacket::DROPPED_INTEREST:
+        // never sent by the main thread
+        break;
+    }
+  });
+}
+
+void
+IoWorker::releaseFace(uint64_t localId)
+{
+  auto it = m_workerFaces.find(localId);
+  if (it == m_workerFaces.end()) {
+    return;
+  }
+  m_localIds.erase(it->second.face.get());
+  m_workerFaces.erase(it);
+}
+
+void
+IoWorker::scheduleCountersRefresh()
+{
+  m_countersEvent = getScheduler().schedule(COUNTERS_REFRESH_INTERVAL, [this] {
+    if (!m_workerFaces.empty()) {
+      std::vector<std::pair<uint64_t, TransportCountersCopy>> counters;
+      counters.reserve(m_workerFaces.size());
+      for (const auto& [localId, workerFace] : m_workerFaces) {
+        counters.emplace_back(localId, TransportCountersCopy(workerFace.face->getTransport()->getCounters()));
+      }
+      postToMain([counters = std::move(counters)] (IoWorker& worker) {
+        for (const auto& [localId, copy] : counters) {
+          if (auto transport = worker.findProxyTransport(localId); transport != nullptr) {
+            transport->updateCounters(copy);
+          }
+        }
+      });
+    }
+    scheduleCountersRefresh();
+  });
+}
+
+void
+IoWorker::pushEgress(ShardPacket&& packet)
+{
+  if (!m_isRunning) {
+    return;
+  }
+  if (!m_egress.push(std::move(packet))) {
+    m_nQueueDrops.fetch_add(1, std::memory_order_relaxed);
+    NFD_LOG_DEBUG("worker=" << m_index << " egress queue full, dropping packet");
+    return;
+  }
+  if (!m_hasEgressWakeup.exchange(true, std::memory_order_acq_rel)) {
+    boost::asio::post(*m_io, [this] { drainEgress(); });
+  }
+}
+
+void
+IoWorker::drainIngress()
+{
+  m_hasIngressWakeup.exchange(false, std::memory_order_acq_rel);
+  m_ingress.consumeAll([this] (ShardPacket&& packet) {
+    auto it = m_proxyFaces.find(packet.faceId);
+    if (it == m_proxyFaces.end()) {
+      addPendingFaces();
+      it = m_proxyFaces.find(packet.faceId);
+      if (it == m_proxyFaces.end()) {
+        return; // the face has been closed
+      }
+    }
+
+    Face& face = *it->second;
+    packet.faceId = face.getId();
+    static_cast<ShardLinkService*>(face.getLinkService())->deliver(packet);
+  });
+}
+
+void
+IoWorker::addPendingFaces()
+{
+  std::vector<PendingFace> faces;
+  {
+    std::lock_guard<std::mutex> lock(m_pendingFacesMutex);
+    faces.swap(m_pendingFaces);
+  }
+
+  for (auto& pending : faces) {
+    uint64_t localId = pending.localId;
+    if (pending.proxy != nullptr) {
+      connectFaceClosedSignal(*pending.proxy, [this, localId] {
+        auto it = m_proxyFaces.find(localId);
+        if (it == m_proxyFaces.end()) {
+          return;
+        }
+        // defer Face deallocation, so that Transport isn't deallocated during afterStateChange signal
+        boost::asio::defer(getGlobalIoService(), [face = std::move(it->second)] {});
+        m_proxyFaces.erase(it);
+      });
+      m_proxyFaces.emplace(localId, std::move(pending.proxy));
+    }
+
+    auto it = m_proxyFaces.find(localId);
+    if (it != m_proxyFaces.end() && pending.onAdopted) {
+      pending.onAdopted(it->second);
+    }
+  }
+}
+
+IoWorker::ProxyTransport*
+IoWorker::findProxyTransport(uint64_t localId)
+{
+  addPendingFaces();
+  auto it = m_proxyFaces.find(localId);
+  if (it == m_proxyFaces.end()) {
+    return nullptr;
+  }
+  return static_cast<ProxyTransport*>(it->second->getTransport());
+}
+
+void
+IoWorker::closeFace(uint64_t localId)
+{
+  if (!m_isRunning) {
+    return;
+  }
+  boost::asio::post(*m_io, [this, localId] {
+    auto it = m_workerFaces.find(localId);
+    if (it != m_workerFaces.end()) {
+      it->second.face->close();
+    }
+  });
+}
+
+void
+IoWorker::setFacePersistency(uint64_t localId, ndn::nfd::FacePersistency persistency)
+{
+  if (!m_isRunning) {
+    return;
+  }
+  boost::asio::post(*m_io, [this, localId, persistency] {
+    auto it = m_workerFaces.find(localId);
+    if (it != m_workerFaces.end() &&
+        it->second.face->getTransport()->canChangePersistencyTo(persistency)) {
+      it->second.face->getTransport()->setPersistency(persistency);
+    }
+  });
+}
+
+IoWorkerPool::IoWorkerPool(size_t nWorkers, size_t queueCapacity)
+{
+  BOOST_ASSERT(nWorkers >= 1 && nWorkers <= MAX_IO_WORKERS);
+  for (size_t i = 0; i < nWorkers; ++i) {
+    auto worker = make_shared<IoWorker>(i, queueCapacity);
+    worker->start();
+    m_workers.push_back(std::move(worker));
+  }
+  NFD_LOG_INFO("Face I/O in " << nWorkers << " threads");
+}
+
+IoWorkerPool::~IoWorkerPool()
+{
+  for (const auto& worker : m_workers) {
+    worker->stop();
+  }
+}
+
+uint64_t
+IoWorkerPool::getNQueueDrops() const noexcept
+{
+  uint64_t n = 0;
+  for (const auto& worker : m_workers) {
+    n += worker->getNQueueDrops();
+  }
+  return n;
+}
+
+} // namespace nfd::face
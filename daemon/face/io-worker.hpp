@@ -0,0 +1,312 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_IO_WORKER_HPP
+#define NFD_DAEMON_FACE_IO_WORKER_HPP
+
+#include "channel.hpp"
+#include "shard-face.hpp"
+#include "common/spsc-queue.hpp"
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+
+#include <atomic>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace nfd::face {
+
+/**
+ * \brief Maximum number of threads in an IoWorkerPool.
+ */
+inline constexpr size_t MAX_IO_WORKERS = 64;
+
+/**
+ * \brief A thread that performs the I/O of faces on behalf of the main thread.
+ *
+ * A face created with createFace() belongs to the worker: its socket reads and writes, TLV
+ * decoding, NDNLP fragmentation, reassembly, and reliability, and its timers run in the worker
+ * thread, with the worker's own io_context and Scheduler. The main thread gets a face that
+ * stands for it, which has the same properties and is added to the FaceTable in its place.
+ * Packets received on the face of the worker are passed to the main thread, and packets sent on
+ * the face of the main thread are passed to the worker, through bounded single-producer
+ * single-consumer queues; the consuming thread is woken up at most once per batch of packets.
+ * A packet is dropped if the queue is full.
+ *
+ * The face of the main thread follows the state and send queue congestion of the face of the
+ * worker, and its transport counters are refreshed every second. Closing the face of the main
+ * thread, or changing its persistency, is applied to the face of the worker.
+ *
+ * \note The counters specific to GenericLinkService are not available in the main thread.
+ */
+class IoWorker : public std::enable_shared_from_this<IoWorker>, noncopyable
+{
+public:
+  /** \brief Interval at which the transport counters are copied to the main thread.
+   */
+  static constexpr time::nanoseconds COUNTERS_REFRESH_INTERVAL = 1_s;
+
+  IoWorker(size_t index, size_t queueCapacity);
+
+  ~IoWorker();
+
+  /** \brief Start the thread, and wait until its io_context is available.
+   *
+   *  The calling thread becomes the main thread of this worker.
+   */
+  void
+  start();
+
+  /** \brief Stop the thread, and release the faces that belong to it.
+   *
+   *  Packets sent afterwards on the faces of the main thread are dropped.
+   */
+  void
+  stop();
+
+  size_t
+  getIndex() const noexcept
+  {
+    return m_index;
+  }
+
+  /** \brief Return the io_context of the worker thread.
+   *
+   *  A socket that is opened on this io_context can be passed to a face created by createFace().
+   */
+  boost::asio::io_context&
+  getIo() const noexcept
+  {
+    return *m_io;
+  }
+
+  /** \brief Number of packets dropped because a queue between the main thread and the worker
+   *         was full.
+   */
+  uint64_t
+  getNQueueDrops() const noexcept
+  {
+    return m_nQueueDrops.load(std::memory_order_relaxed);
+  }
+
+public: // main thread
+  /** \brief Create a face that belongs to the worker.
+   *  \param makeFace a callable, which may be move-only, that is invoked in the worker thread
+   *                  and returns `shared_ptr<Face>`; nothing happens if it returns nullptr
+   *  \param onCreated invoked in the main thread with the face that stands for the new face
+   */
+  template<typename MakeFace>
+  void
+  createFace(MakeFace&& makeFace, FaceCreatedCallback onCreated)
+  {
+    if (!m_isRunning) {
+      return;
+    }
+    boost::asio::post(*m_io, [this, makeFace = std::forward<MakeFace>(makeFace),
+                              onCreated = std::move(onCreated)] () mutable {
+      adoptFace(makeFace(), std::move(onCreated));
+    });
+  }
+
+  /** \brief Invoke \p f in the worker thread when it stops, before its io_context is destroyed.
+   *
+   *  This releases objects other than faces that use the io_context of the worker, such as
+   *  sockets that are not owned by a face.
+   */
+  void
+  atStop(std::function<void()> f);
+
+public: // worker thread
+  /** \brief Hand \p face, which belongs to the worker thread, to the main thread.
+   *  \param onAdopted invoked in the main thread with the face that stands for \p face;
+   *                   if \p face has been adopted before, the same face is passed again
+   */
+  void
+  adoptFace(const shared_ptr<Face>& face, FaceCreatedCallback onAdopted);
+
+  /** \brief Invoke `f(*this)` in the main thread, unless the worker has been stopped.
+   */
+  template<typename F>
+  void
+  postToMain(F&& f)
+  {
+    boost::asio::post(m_mainIo, [self = weak_from_this(), f = std::forward<F>(f)] {
+      if (auto worker = self.lock(); worker != nullptr && worker->m_isRunning) {
+        f(*worker);
+      }
+    });
+  }
+
+private:
+  class ProxyTransport;
+
+  void
+  run(std::promise<boost::asio::io_context*>& ioPromise);
+
+private: // worker thread
+  shared_ptr<Face>
+  makeProxyFace(const Face& face, uint64_t localId);
+
+  void
+  pushIngress(ShardPacket&& packet);
+
+  void
+  drainEgress();
+
+  void
+  releaseFace(uint64_t localId);
+
+  void
+  scheduleCountersRefresh();
+
+private: // main thread
+  void
+  pushEgress(ShardPacket&& packet);
+
+  void
+  drainIngress();
+
+  void
+  addPendingFaces();
+
+  ProxyTransport*
+  findProxyTransport(uint64_t localId);
+
+  void
+  closeFace(uint64_t localId);
+
+  void
+  setFacePersistency(uint64_t localId, ndn::nfd::FacePersistency persistency);
+
+private:
+  const size_t m_index;
+  boost::asio::io_context& m_mainIo;
+  boost::asio::io_context* m_io = nullptr;
+  std::thread m_thread;
+  bool m_isRunning = false; ///< accessed by the main thread
+
+  /** \brief A face of the worker, with the connections to its signals.
+   */
+  struct WorkerFace
+  {
+    shared_ptr<Face> face;
+    std::vector<signal::ScopedConnection> connections;
+  };
+
+  // owned by the worker thread; faces are identified by a number local to the worker
+  std::map<uint64_t, WorkerFace> m_workerFaces;
+  std::map<const Face*, uint64_t> m_localIds;
+  uint64_t m_lastLocalId = 0;
+  ndn::scheduler::ScopedEventId m_countersEvent;
+
+  // owned by the main thread
+  std::map<uint64_t, shared_ptr<Face>> m_proxyFaces;
+
+  SpscQueue<ShardPacket> m_ingress; ///< worker to main thread; faceId is the local number
+  SpscQueue<ShardPacket> m_egress;  ///< main thread to worker; faceId is the local number
+  std::atomic<bool> m_hasIngressWakeup{false};
+  std::atomic<bool> m_hasEgressWakeup{false};
+  std::atomic<uint64_t> m_nQueueDrops{0};
+
+  /** \brief A face adopted by the worker, to be passed to the main thread.
+   */
+  struct PendingFace
+  {
+    uint64_t localId;
+    shared_ptr<Face> proxy; ///< nullptr if the face has been adopted before
+    FaceCreatedCallback onAdopted;
+  };
+
+  std::mutex m_pendingFacesMutex;
+  std::vector<PendingFace> m_pendingFaces;
+
+  std::mutex m_atStopMutex;
+  std::vector<std::function<void()>> m_atStop;
+};
+
+/**
+ * \brief A pool of I/O worker threads.
+ *
+ * The pool belongs to the thread that creates it, which is the main thread of every worker.
+ * Channels that support I/O workers spread their faces among the workers of the pool.
+ */
+class IoWorkerPool : noncopyable
+{
+public:
+  /** \brief Start \p nWorkers threads.
+   *  \param nWorkers number of threads, between 1 and MAX_IO_WORKERS
+   *  \param queueCapacity capacity of each queue between the main thread and a worker, in packets
+   */
+  explicit
+  IoWorkerPool(size_t nWorkers, size_t queueCapacity = 16384);
+
+  /** \brief Stop all workers.
+   *
+   *  The faces that belong to the workers are released in their threads. Objects that use the
+   *  io_context of a worker, such as the channels that have faces in the pool, must not be used
+   *  afterwards; they should be destroyed after the pool.
+   */
+  ~IoWorkerPool();
+
+  size_t
+  size() const noexcept
+  {
+    return m_workers.size();
+  }
+
+  IoWorker&
+  operator[](size_t i) const noexcept
+  {
+    return *m_workers[i];
+  }
+
+  /** \brief Return the next worker in round-robin order.
+   */
+  IoWorker&
+  next() noexcept
+  {
+    IoWorker& worker = *m_workers[m_next];
+    m_next = (m_next + 1) % m_workers.size();
+    return worker;
+  }
+
+  /** \brief Number of packets dropped because a queue of a worker was full.
+   */
+  uint64_t
+  getNQueueDrops() const noexcept;
+
+private:
+  std::vector<shared_ptr<IoWorker>> m_workers;
+  size_t m_next = 0;
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_IO_WORKER_HPP
@@ -38,14 +38,6 @@ static_assert(lp::tlv::FragIndex < 253, "FragIndex TLV-TYPE must fit in 1 octet"
 static_assert(lp::tlv::FragCount < 253, "FragCount TLV-TYPE must fit in 1 octet");
 static_assert(lp::tlv::Fragment < 253, "Fragment TLV-TYPE must fit in 1 octet");
 
-/**
- * \brief Maximum overhead on a single fragment, not counting other NDNLPv2 headers.
- */
-constexpr size_t MAX_SINGLE_FRAG_OVERHEAD =
-  1 + 9 + // LpPacket TLV-TYPE and TLV-LENGTH
-  1 + 1 + 8 + // Sequence TLV
-  1 + 9; // Fragment TLV-TYPE and TLV-LENGTH
-
 /**
  * \brief Maximum overhead of adding fragmentation to payload, not counting other NDNLPv2 headers.
  */
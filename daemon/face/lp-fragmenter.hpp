@@ -50,6 +50,16 @@ public:
     size_t nMaxFragments = 400;
   };
 
+  /**
+   * \brief Maximum overhead on a single fragment, not counting other NDNLPv2 headers.
+   *
+   * A packet is sent unfragmented if it fits in the MTU together with this overhead.
+   */
+  static constexpr size_t MAX_SINGLE_FRAG_OVERHEAD =
+    1 + 9 + // LpPacket TLV-TYPE and TLV-LENGTH
+    1 + 1 + 8 + // Sequence TLV
+    1 + 9; // Fragment TLV-TYPE and TLV-LENGTH
+
   explicit
   LpFragmenter(const Options& options, const LinkService* linkService = nullptr);
 
@@ -25,19 +25,32 @@
 
 #include "lp-reassembler.hpp"
 #include "common/global.hpp"
+#include "common/timer-wheel.hpp"
 #include "link-service.hpp"
 
 #include <ndn-cxx/lp/fields.hpp>
 
-#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string_view>
 
 namespace nfd::face {
 
 NFD_LOG_INIT(LpReassembler);
 
+constexpr size_t INITIAL_N_SLOTS = 16;
+
+static size_t
+hashBytes(span<const uint8_t> bytes)
+{
+  return std::hash<std::string_view>{}({reinterpret_cast<const char*>(bytes.data()), bytes.size()});
+}
+
 LpReassembler::LpReassembler(const LpReassembler::Options& options, const LinkService* linkService)
   : m_options(options)
   , m_linkService(linkService)
+  , m_slots(INITIAL_N_SLOTS)
 {
 }
 
@@ -67,9 +80,9 @@ LpReassembler::receiveFragment(const EndpointId& remoteEndpoint, const lp::Packe
   }
 
   // check for fast path
+  auto [fragBegin, fragEnd] = packet.get<lp::FragmentField>();
   if (fragIndex == 0 && fragCount == 1) {
-    auto frag = packet.get<lp::FragmentField>();
-    Block netPkt({frag.first, frag.second});
+    Block netPkt({fragBegin, fragEnd});
     return {true, netPkt, packet};
   }
 
@@ -81,73 +94,224 @@ LpReassembler::receiveFragment(const EndpointId& remoteEndpoint, const lp::Packe
 
   lp::Sequence messageIdentifier = packet.get<lp::SequenceField>() - fragIndex;
   Key key(remoteEndpoint, messageIdentifier);
+  size_t hash = computeHash(key);
+  size_t slot = findSlot(key, hash);
+
+  // a network-layer packet cannot exceed MAX_NDN_PACKET_SIZE, which also bounds the buffer size
+  size_t fragSize = static_cast<size_t>(std::distance(fragBegin, fragEnd));
+  auto isTooLarge = [fragCount] (size_t stride) {
+    return (fragCount - 1) * stride >= ndn::MAX_NDN_PACKET_SIZE;
+  };
 
   // add to PartialPacket
-  PartialPacket& pp = m_partialPackets[key];
-  if (pp.fragCount == 0) { // new PartialPacket
-    pp.fragCount = fragCount;
-    pp.nReceivedFragments = 0;
-    pp.fragments.resize(fragCount);
+  PartialPacket* pp = m_slots[slot].pp.get();
+  if (pp == nullptr) {
+    if (isTooLarge(fragSize)) {
+      NFD_LOG_FACE_WARN("reassembly error, packet too large: DROP");
+      return {false, {}, {}};
+    }
+    slot = insertPartialPacket(key, hash);
+    pp = m_slots[slot].pp.get();
+    pp->fragCount = fragCount;
+    pp->isReceived.resize(fragCount);
+    pp->fragSizes.resize(fragCount);
+    pp->stride = fragSize;
+    pp->buffer = make_shared<ndn::Buffer>(fragCount * fragSize);
   }
   else {
-    if (fragCount != pp.fragCount) {
+    if (fragCount != pp->fragCount) {
       NFD_LOG_FACE_WARN("reassembly error, FragCount changed: DROP");
       return {false, {}, {}};
     }
-  }
 
-  if (pp.fragments[fragIndex].has<lp::SequenceField>()) {
-    NFD_LOG_FACE_TRACE("fragment already received: DROP");
-    return {false, {}, {}};
+    if (pp->isReceived[fragIndex]) {
+      NFD_LOG_FACE_TRACE("fragment already received: DROP");
+      return {false, {}, {}};
+    }
+
+    if (fragSize > pp->stride) {
+      if (isTooLarge(fragSize)) {
+        NFD_LOG_FACE_WARN("reassembly error, packet too large: DROP");
+        return {false, {}, {}};
+      }
+      restride(*pp, fragSize);
+    }
   }
 
-  pp.fragments[fragIndex] = packet;
-  ++pp.nReceivedFragments;
+  std::copy(fragBegin, fragEnd, pp->buffer->begin() + fragIndex * pp->stride);
+  pp->fragSizes[fragIndex] = fragSize;
+  pp->isReceived[fragIndex] = true;
+  ++pp->nReceivedFragments;
+  if (fragIndex == 0) {
+    pp->firstFragment = packet;
+  }
 
   // check complete condition
-  if (pp.nReceivedFragments == pp.fragCount) {
-    Block reassembled = doReassembly(key);
-    lp::Packet firstFrag(std::move(pp.fragments[0]));
-    m_partialPackets.erase(key);
-    return {true, reassembled, firstFrag};
+  if (pp->nReceivedFragments == pp->fragCount) {
+    recordLatency(time::steady_clock::now() - pp->arrivalTime);
+    lp::Packet firstFrag(std::move(pp->firstFragment));
+    auto wire = doReassembly(*pp);
+    erasePartialPacket(slot);
+    return {true, Block(std::move(wire)), firstFrag};
   }
 
   // set drop timer
-  pp.dropTimer = getScheduler().schedule(m_options.reassemblyTimeout, [=] { timeoutPartialPacket(key); });
+  getTimerWheel().schedule(pp->dropTimer, m_options.reassemblyTimeout, [=] { timeoutPartialPacket(key); });
 
   return {false, {}, {}};
 }
 
-Block
-LpReassembler::doReassembly(const Key& key)
+time::nanoseconds
+LpReassembler::getLatencyPercentile(double percentile) const
 {
-  PartialPacket& pp = m_partialPackets[key];
+  if (m_nLatencySamples == 0) {
+    return 0_ns;
+  }
+
+  auto rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * m_nLatencySamples));
+  rank = std::clamp<uint64_t>(rank, 1, m_nLatencySamples);
+  uint64_t nSamples = 0;
+  for (size_t bucket = 0; bucket < m_latencyBuckets.size(); ++bucket) {
+    nSamples += m_latencyBuckets[bucket];
+    if (nSamples >= rank) {
+      return time::nanoseconds((uint64_t{1} << bucket) - 1);
+    }
+  }
+  return time::nanoseconds::max();
+}
+
+size_t
+LpReassembler::computeHash(const Key& key)
+{
+  size_t h = std::visit([] (const auto& ep) -> size_t {
+    using T = std::decay_t<decltype(ep)>;
+    if constexpr (std::is_same_v<T, ethernet::Address>) {
+      return hashBytes(ep);
+    }
+    else if constexpr (std::is_same_v<T, udp::Endpoint>) {
+      const auto& addr = ep.address();
+      size_t addrHash = addr.is_v4() ? std::hash<uint32_t>{}(addr.to_v4().to_uint())
+                                     : hashBytes(addr.to_v6().to_bytes());
+      return addrHash ^ ep.port();
+    }
+    else {
+      return 0;
+    }
+  }, std::get<0>(key));
 
-  size_t payloadSize = std::accumulate(pp.fragments.begin(), pp.fragments.end(), 0U,
-    [&] (size_t sum, const lp::Packet& pkt) -> size_t {
-      auto [fragBegin, fragEnd] = pkt.get<lp::FragmentField>();
-      return sum + std::distance(fragBegin, fragEnd);
-    });
+  // consecutive message identifiers differ in few bits, so mix them into all bits
+  uint64_t mixed = (h ^ std::get<1>(key)) * 0x9e3779b97f4a7c15;
+  return static_cast<size_t>(mixed ^ (mixed >> 32));
+}
 
-  ndn::Buffer fragBuffer(payloadSize);
-  auto it = fragBuffer.begin();
-  for (const lp::Packet& frag : pp.fragments) {
-    auto [fragBegin, fragEnd] = frag.get<lp::FragmentField>();
-    it = std::copy(fragBegin, fragEnd, it);
+size_t
+LpReassembler::findSlot(const Key& key, size_t hash) const
+{
+  size_t mask = m_slots.size() - 1;
+  size_t i = hash & mask;
+  while (m_slots[i].pp != nullptr && (m_slots[i].hash != hash || m_slots[i].pp->key != key)) {
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+size_t
+LpReassembler::insertPartialPacket(const Key& key, size_t hash)
+{
+  // keep the load factor at most 1/2
+  if ((m_nPartialPackets + 1) * 2 > m_slots.size()) {
+    std::vector<Slot> oldSlots(m_slots.size() * 2);
+    oldSlots.swap(m_slots);
+    for (Slot& old : oldSlots) {
+      if (old.pp != nullptr) {
+        m_slots[findSlot(old.pp->key, old.hash)] = std::move(old);
+      }
+    }
+  }
+
+  size_t slot = findSlot(key, hash);
+  BOOST_ASSERT(m_slots[slot].pp == nullptr);
+  m_slots[slot].hash = hash;
+  m_slots[slot].pp = make_unique<PartialPacket>();
+  m_slots[slot].pp->key = key;
+  m_slots[slot].pp->arrivalTime = time::steady_clock::now();
+  ++m_nPartialPackets;
+  return slot;
+}
+
+void
+LpReassembler::erasePartialPacket(size_t slot)
+{
+  BOOST_ASSERT(m_slots[slot].pp != nullptr);
+  m_slots[slot].pp.reset();
+  --m_nPartialPackets;
+
+  // move back any entry whose home slot is not between the hole and its current slot
+  size_t mask = m_slots.size() - 1;
+  size_t hole = slot;
+  for (size_t i = (hole + 1) & mask; m_slots[i].pp != nullptr; i = (i + 1) & mask) {
+    size_t home = m_slots[i].hash & mask;
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      m_slots[hole] = std::move(m_slots[i]);
+      hole = i;
+    }
   }
-  return Block(fragBuffer);
+}
+
+void
+LpReassembler::restride(PartialPacket& pp, size_t stride)
+{
+  BOOST_ASSERT(stride > pp.stride);
+  pp.buffer->resize(pp.fragCount * stride);
+  // new offsets are greater, so start from the end to avoid overwriting a payload not yet moved
+  for (size_t i = pp.fragCount; i-- > 1;) {
+    if (pp.isReceived[i]) {
+      std::memmove(pp.buffer->data() + i * stride, pp.buffer->data() + i * pp.stride,
+                   pp.fragSizes[i]);
+    }
+  }
+  pp.stride = stride;
+}
+
+ndn::ConstBufferPtr
+LpReassembler::doReassembly(PartialPacket& pp)
+{
+  // payloads are already contiguous if every fragment but the last one fills its slot
+  size_t payloadSize = 0;
+  for (size_t i = 0; i < pp.fragCount; ++i) {
+    if (payloadSize != i * pp.stride) {
+      std::memmove(pp.buffer->data() + payloadSize, pp.buffer->data() + i * pp.stride,
+                   pp.fragSizes[i]);
+    }
+    payloadSize += pp.fragSizes[i];
+  }
+  pp.buffer->resize(payloadSize);
+  return std::move(pp.buffer);
 }
 
 void
 LpReassembler::timeoutPartialPacket(const Key& key)
 {
-  auto it = m_partialPackets.find(key);
-  if (it == m_partialPackets.end()) {
+  size_t slot = findSlot(key, computeHash(key));
+  if (m_slots[slot].pp == nullptr) {
     return;
   }
 
-  this->beforeTimeout(std::get<0>(key), it->second.nReceivedFragments);
-  m_partialPackets.erase(it);
+  this->beforeTimeout(std::get<0>(key), m_slots[slot].pp->nReceivedFragments);
+  erasePartialPacket(slot);
+}
+
+void
+LpReassembler::recordLatency(time::nanoseconds latency)
+{
+  auto ns = static_cast<uint64_t>(std::max(latency, 0_ns).count());
+  size_t bucket = 0;
+  while (ns != 0) {
+    ns >>= 1;
+    ++bucket;
+  }
+  ++m_latencyBuckets[bucket];
+  ++m_nLatencySamples;
 }
 
 std::ostream&
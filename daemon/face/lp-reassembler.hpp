@@ -27,17 +27,27 @@
 #define NFD_DAEMON_FACE_LP_REASSEMBLER_HPP
 
 #include "face-common.hpp"
+#include "common/timer-wheel.hpp"
 
 #include <ndn-cxx/lp/packet.hpp>
 #include <ndn-cxx/lp/sequence.hpp>
-#include <ndn-cxx/util/scheduler.hpp>
 
-#include <map>
+#include <array>
 
 namespace nfd::face {
 
 /**
  * \brief Reassembles fragmented network-layer packets.
+ *
+ * When the first fragment of a packet arrives, a buffer with room for FragCount fragments of
+ * that size is allocated, and each fragment's payload is copied straight into its slot.
+ * Senders normally make all fragments but the last one the same size, in which case the
+ * payloads are contiguous when the packet is complete, and the buffer becomes the packet's wire
+ * encoding without a further copy. Otherwise, the slots are widened or compacted as needed.
+ *
+ * Partial packets are indexed by remote endpoint and message identifier in an open-addressed
+ * hash table with linear probing.
+ *
  * \sa https://redmine.named-data.net/projects/nfd/wiki/NDNLPv2
  */
 class LpReassembler : noncopyable
@@ -103,9 +113,21 @@ public:
   size_t
   size() const noexcept
   {
-    return m_partialPackets.size();
+    return m_nPartialPackets;
   }
 
+  /**
+   * \brief Returns an upper bound of a percentile of the reassembly latency.
+   * \param percentile the percentile, between 0 and 100
+   *
+   * The latency of a packet is the time from the arrival of its first fragment until it is
+   * reassembled; packets that were not fragmented are not counted. Latencies are recorded in
+   * power-of-two buckets, so the result is less than twice the actual percentile.
+   * Returns zero if no packet has been reassembled.
+   */
+  time::nanoseconds
+  getLatencyPercentile(double percentile) const;
+
   /**
    * \brief Notifies before a partial packet is dropped due to timeout.
    *
@@ -118,34 +140,93 @@ public:
 
 private:
   /**
-   * \brief Holds all fragments of a packet until reassembled.
+   * \brief Index key for PartialPackets.
+   */
+  using Key = std::tuple<
+    EndpointId, // remote endpoint
+    lp::Sequence // message identifier (sequence number of the first fragment)
+  >;
+
+  /**
+   * \brief Holds the payloads of all fragments of a packet until reassembled.
+   *
+   * The payload of fragment \em i is stored at offset \em i &times; stride in the buffer.
    */
   struct PartialPacket
   {
-    std::vector<lp::Packet> fragments;
-    size_t fragCount; ///< total fragments
-    size_t nReceivedFragments; ///< number of received fragments
-    ndn::scheduler::ScopedEventId dropTimer;
+    Key key;
+    shared_ptr<ndn::Buffer> buffer;
+    size_t stride = 0; ///< size of each slot in the buffer
+    std::vector<bool> isReceived; ///< whether each fragment has been received
+    std::vector<size_t> fragSizes; ///< payload size of each received fragment
+    lp::Packet firstFragment; ///< fragment 0, for inspecting other NDNLPv2 headers
+    size_t fragCount = 0; ///< total fragments
+    size_t nReceivedFragments = 0; ///< number of received fragments
+    time::steady_clock::time_point arrivalTime; ///< when the first fragment was received
+    TimerWheel::Timer dropTimer;
   };
 
   /**
-   * \brief Index key for PartialPackets.
+   * \brief A slot of the hash table, empty if `pp` is nullptr.
+   *
+   * PartialPackets are held by pointer because their timers cannot be moved.
    */
-  using Key = std::tuple<
-    EndpointId, // remote endpoint
-    lp::Sequence // message identifier (sequence number of the first fragment)
-  >;
+  struct Slot
+  {
+    size_t hash = 0;
+    unique_ptr<PartialPacket> pp;
+  };
+
+  static size_t
+  computeHash(const Key& key);
+
+  /**
+   * \return index of the slot holding \p key, or of the empty slot where it would be inserted
+   */
+  size_t
+  findSlot(const Key& key, size_t hash) const;
+
+  /**
+   * \brief Insert an empty PartialPacket for \p key, which must not be in the table.
+   * \return index of its slot
+   */
+  size_t
+  insertPartialPacket(const Key& key, size_t hash);
+
+  /**
+   * \brief Empty a slot, shifting back entries displaced past it.
+   */
+  void
+  erasePartialPacket(size_t slot);
 
-  Block
-  doReassembly(const Key& key);
+  /**
+   * \brief Widen the slots of \p pp to \p stride octets, moving received payloads.
+   */
+  static void
+  restride(PartialPacket& pp, size_t stride);
+
+  /**
+   * \brief Concatenate the payloads of \p pp in place.
+   * \return the buffer of \p pp, resized to the network-layer packet
+   */
+  static ndn::ConstBufferPtr
+  doReassembly(PartialPacket& pp);
 
   void
   timeoutPartialPacket(const Key& key);
 
+  void
+  recordLatency(time::nanoseconds latency);
+
 private:
   Options m_options;
   const LinkService* m_linkService;
-  std::map<Key, PartialPacket> m_partialPackets;
+  std::vector<Slot> m_slots; ///< number of slots is a power of two
+  size_t m_nPartialPackets = 0;
+
+  /// Bucket \em b counts latencies that need \em b bits in nanoseconds
+  std::array<uint64_t, 64> m_latencyBuckets{};
+  uint64_t m_nLatencySamples = 0;
 };
 
 std::ostream&
@@ -25,6 +25,7 @@
 
 #include "lp-reliability.hpp"
 #include "common/global.hpp"
+#include "common/timer-wheel.hpp"
 #include "generic-link-service.hpp"
 #include "transport.hpp"
 
@@ -39,7 +40,6 @@ NFD_LOG_INIT(LpReliability);
 LpReliability::LpReliability(const LpReliability::Options& options, GenericLinkService* linkService)
   : m_options(options)
   , m_linkService(linkService)
-  , m_firstUnackedFrag(m_unackedFrags.begin())
   , m_lastTxSeqNo(-1) // set to "-1" to start TxSequence numbers at 0
 {
   BOOST_ASSERT(m_linkService != nullptr);
@@ -63,7 +63,6 @@ LpReliability::handleOutgoing(std::vector<lp::Packet>& frags, lp::Packet&& pkt,
 {
   BOOST_ASSERT(m_options.isEnabled);
 
-  auto unackedFragsIt = m_unackedFrags.begin();
   auto sendTime = time::steady_clock::now();
 
   auto netPkt = make_shared<NetPkt>(std::move(pkt), isInterest);
@@ -77,23 +76,19 @@ LpReliability::handleOutgoing(std::vector<lp::Packet>& frags, lp::Packet&& pkt,
     lp::Sequence txSeq = assignTxSequence(frag);
 
     // Store LpPacket for future retransmissions
-    unackedFragsIt = m_unackedFrags.try_emplace(unackedFragsIt, txSeq, frag);
-    unackedFragsIt->second.sendTime = sendTime;
-    auto rto = m_rttEst.getEstimatedRto();
-    lp::Sequence seq = frag.get<lp::SequenceField>();
-    NFD_LOG_FACE_TRACE("transmitting seq=" << seq << ", txseq=" << txSeq << ", rto=" <<
-                       time::duration_cast<time::milliseconds>(rto).count() << "ms");
-    unackedFragsIt->second.rtoTimer = getScheduler().schedule(rto, [=] {
-      onLpPacketLost(txSeq, true);
-    });
-    unackedFragsIt->second.netPkt = netPkt;
-
-    if (m_unackedFrags.size() == 1) {
-      m_firstUnackedFrag = m_unackedFrags.begin();
-    }
+    auto& unackedFrag = m_unackedFrags.emplace(txSeq, frag);
+    unackedFrag.sendTime = sendTime;
+    unackedFrag.netPkt = netPkt;
+    NFD_LOG_FACE_TRACE("transmitting seq=" << frag.get<lp::SequenceField>() << ", txseq=" << txSeq);
 
     // Add to associated NetPkt
-    netPkt->unackedFrags.push_back(unackedFragsIt);
+    netPkt->unackedFrags.push_back(txSeq);
+  }
+
+  // The fragments are newer than any fragment already in flight, so the timer is only started
+  // if it was idle
+  if (!m_rtoTimer.isPending()) {
+    restartRtoTimer();
   }
 }
 
@@ -103,46 +98,58 @@ LpReliability::processIncomingPacket(const lp::Packet& pkt)
   BOOST_ASSERT(m_options.isEnabled);
 
   bool isDuplicate = false;
+  bool hasNewAck = false;
   auto now = time::steady_clock::now();
 
   // Extract and parse Acks
   for (lp::Sequence ackTxSeq : pkt.list<lp::AckField>()) {
-    auto fragIt = m_unackedFrags.find(ackTxSeq);
-    if (fragIt == m_unackedFrags.end()) {
-      // Ignore an Ack for an unknown TxSequence number
-      NFD_LOG_FACE_DEBUG("received ack for unknown txseq=" << ackTxSeq);
+    auto frag = m_unackedFrags.find(ackTxSeq);
+    if (frag == nullptr) {
+      auto retxIt = m_retxTxSeqs.find(ackTxSeq);
+      if (retxIt == m_retxTxSeqs.end()) {
+        // Ignore an Ack for an unknown TxSequence number
+        NFD_LOG_FACE_DEBUG("received ack for unknown txseq=" << ackTxSeq);
+        continue;
+      }
+
+      // An earlier transmission of a fragment that is still unacknowledged has arrived,
+      // so the retransmission was unnecessary. The fragment is acknowledged, but the Ack says
+      // nothing about the fragments sent before the retransmission, nor about the RTT.
+      NFD_LOG_FACE_DEBUG("received ack for txseq=" << ackTxSeq << " retransmitted as txseq=" <<
+                         retxIt->second << ": spurious retransmission");
+      ++m_linkService->nSpuriousRetx;
+      onLpPacketAcknowledged(retxIt->second);
+      hasNewAck = true;
       continue;
     }
-    auto& frag = fragIt->second;
 
-    // Cancel the RTO timer for the acknowledged fragment
-    frag.rtoTimer.cancel();
-
-    if (frag.retxCount == 0) {
-      NFD_LOG_FACE_TRACE("received ack for seq=" << frag.pkt.get<lp::SequenceField>() << ", txseq=" <<
-                         ackTxSeq << ", retx=0, rtt=" <<
-                         time::duration_cast<time::milliseconds>(now - frag.sendTime).count() << "ms");
+    if (frag->retxCount == 0) {
+      auto rtt = now - frag->sendTime;
+      NFD_LOG_FACE_TRACE("received ack for seq=" << frag->pkt.get<lp::SequenceField>() <<
+                         ", txseq=" << ackTxSeq << ", retx=0, rtt=" <<
+                         time::duration_cast<time::milliseconds>(rtt).count() << "ms");
       // This sequence had no retransmissions, so use it to estimate the RTO
-      m_rttEst.addMeasurement(now - frag.sendTime);
+      m_rttEst.addMeasurement(rtt);
+      m_minRtt = std::min<time::nanoseconds>(m_minRtt, rtt);
     }
     else {
-      NFD_LOG_FACE_TRACE("received ack for seq=" << frag.pkt.get<lp::SequenceField>() << ", txseq=" <<
-                         ackTxSeq << ", retx=" << frag.retxCount);
+      NFD_LOG_FACE_TRACE("received ack for seq=" << frag->pkt.get<lp::SequenceField>() <<
+                         ", txseq=" << ackTxSeq << ", retx=" << frag->retxCount);
     }
 
-    // Look for frags with TxSequence numbers < ackTxSeq (allowing for wraparound) and consider
-    // them lost if a configurable number of Acks containing greater TxSequence numbers have been
-    // received.
-    auto lostLpPackets = findLostLpPackets(fragIt);
+    // Look for frags with TxSequence numbers < ackTxSeq (allowing for wraparound) that are
+    // considered lost because of this Ack.
+    auto lostLpPackets = findLostLpPackets(ackTxSeq);
 
-    // Remove the fragment from the map of unacknowledged fragments and from its associated network
+    // Remove the fragment from the unacknowledged fragments and from its associated network
     // packet. Potentially increment the start of the window.
-    onLpPacketAcknowledged(fragIt);
+    onLpPacketAcknowledged(ackTxSeq);
+    hasNewAck = true;
 
     // This set contains TxSequences that have been removed by onLpPacketLost below because they
     // were part of a network packet that was removed due to a fragment exceeding retx, as well as
     // any other TxSequences removed by onLpPacketLost. This prevents onLpPacketLost from being
-    // called later for an invalid iterator.
+    // called later for a fragment that is no longer unacknowledged.
     std::set<lp::Sequence> removedLpPackets;
 
     // Resend or fail fragments considered lost. Potentially increment the start of the window.
@@ -156,6 +163,10 @@ LpReliability::processIncomingPacket(const lp::Packet& pkt)
     }
   }
 
+  if (hasNewAck) {
+    restartRtoTimer();
+  }
+
   // If packet has Fragment and TxSequence fields, extract TxSequence and add to AckQueue
   if (pkt.has<lp::FragmentField>() && pkt.has<lp::TxSequenceField>()) {
     NFD_LOG_FACE_TRACE("queueing ack for remote txseq=" << pkt.get<lp::TxSequenceField>());
@@ -166,7 +177,6 @@ LpReliability::processIncomingPacket(const lp::Packet& pkt)
       lp::Sequence pktSequence = pkt.get<lp::SequenceField>();
       isDuplicate = m_recentRecvSeqs.count(pktSequence) > 0;
       // Check for recent received Sequences to remove
-      auto now = time::steady_clock::now();
       auto rto = m_rttEst.getEstimatedRto();
       while (!m_recentRecvSeqsQueue.empty() &&
              now > m_recentRecvSeqs[m_recentRecvSeqsQueue.front()] + rto) {
@@ -220,7 +230,7 @@ LpReliability::assignTxSequence(lp::Packet& frag)
 {
   lp::Sequence txSeq = ++m_lastTxSeqNo;
   frag.set<lp::TxSequenceField>(txSeq);
-  if (!m_unackedFrags.empty() && m_lastTxSeqNo == m_firstUnackedFrag->first) {
+  if (!m_unackedFrags.empty() && m_lastTxSeqNo == m_unackedFrags.getFirstTxSeq()) {
     NDN_THROW(std::length_error("TxSequence range exceeded"));
   }
   return m_lastTxSeqNo;
@@ -241,27 +251,76 @@ LpReliability::startIdleAckTimer()
   });
 }
 
+void
+LpReliability::restartRtoTimer()
+{
+  if (m_unackedFrags.empty()) {
+    m_rtoTimer.cancel();
+    return;
+  }
+
+  // Fragments are kept in the order they were sent, so the first one expires first
+  const auto& firstFrag = m_unackedFrags.at(m_unackedFrags.getFirstTxSeq());
+  time::nanoseconds delay = firstFrag.sendTime + m_rttEst.getEstimatedRto() -
+                            time::steady_clock::now();
+  getTimerWheel().schedule(m_rtoTimer, std::max(delay, 0_ns), [this] { onRtoTimeout(); });
+}
+
+void
+LpReliability::onRtoTimeout()
+{
+  auto now = time::steady_clock::now();
+  auto rto = m_rttEst.getEstimatedRto();
+
+  // Retransmissions are appended to the window, so collect the expired fragments first
+  std::vector<lp::Sequence> expiredLpPackets;
+  if (!m_unackedFrags.empty()) {
+    for (lp::Sequence txSeq = m_unackedFrags.getFirstTxSeq();
+         txSeq != m_unackedFrags.getEndTxSeq(); ++txSeq) {
+      auto frag = m_unackedFrags.find(txSeq);
+      if (frag == nullptr) {
+        continue;
+      }
+      if (frag->sendTime + rto > now) {
+        break;
+      }
+      expiredLpPackets.push_back(txSeq);
+    }
+  }
+
+  std::set<lp::Sequence> removedLpPackets;
+  for (lp::Sequence txSeq : expiredLpPackets) {
+    if (removedLpPackets.find(txSeq) == removedLpPackets.end()) {
+      auto removedTxSeqs = onLpPacketLost(txSeq, true);
+      removedLpPackets.insert(removedTxSeqs.begin(), removedTxSeqs.end());
+    }
+  }
+
+  restartRtoTimer();
+}
+
 std::vector<lp::Sequence>
-LpReliability::findLostLpPackets(LpReliability::UnackedFrags::iterator ackIt)
+LpReliability::findLostLpPackets(lp::Sequence ackTxSeq)
 {
   std::vector<lp::Sequence> lostLpPackets;
 
-  for (auto it = m_firstUnackedFrag; ; ++it) {
-    if (it == m_unackedFrags.end()) {
-      it = m_unackedFrags.begin();
-    }
+  // Fragments sent more than this long before the acknowledged one are lost, rather than reordered
+  auto ackSendTime = m_unackedFrags.at(ackTxSeq).sendTime;
+  auto reorderWindow = m_minRtt == time::nanoseconds::max() ? 0_ns : m_minRtt / 4;
 
-    if (it->first == ackIt->first) {
-      break;
+  for (lp::Sequence txSeq = m_unackedFrags.getFirstTxSeq(); txSeq != ackTxSeq; ++txSeq) {
+    auto unackedFrag = m_unackedFrags.find(txSeq);
+    if (unackedFrag == nullptr) {
+      continue;
     }
 
-    auto& unackedFrag = it->second;
-    unackedFrag.nGreaterSeqAcks++;
-    NFD_LOG_FACE_TRACE("received ack=" << ackIt->first << " before=" << it->first <<
-                       ", before count=" << unackedFrag.nGreaterSeqAcks);
+    unackedFrag->nGreaterSeqAcks++;
+    NFD_LOG_FACE_TRACE("received ack=" << ackTxSeq << " before=" << txSeq <<
+                       ", before count=" << unackedFrag->nGreaterSeqAcks);
 
-    if (unackedFrag.nGreaterSeqAcks >= m_options.seqNumLossThreshold) {
-      lostLpPackets.push_back(it->first);
+    if (unackedFrag->nGreaterSeqAcks >= m_options.seqNumLossThreshold ||
+        unackedFrag->sendTime + reorderWindow < ackSendTime) {
+      lostLpPackets.push_back(txSeq);
     }
   }
 
@@ -272,10 +331,7 @@ std::vector<lp::Sequence>
 LpReliability::onLpPacketLost(lp::Sequence txSeq, bool isTimeout)
 {
   BOOST_ASSERT(m_unackedFrags.count(txSeq) > 0);
-  auto txSeqIt = m_unackedFrags.find(txSeq);
-
-  auto& txFrag = txSeqIt->second;
-  txFrag.rtoTimer.cancel();
+  auto& txFrag = m_unackedFrags.at(txSeq);
   auto netPkt = txFrag.netPkt;
   std::vector<lp::Sequence> removedThisTxSeq;
   lp::Sequence seq = txFrag.pkt.get<lp::SequenceField>();
@@ -292,10 +348,10 @@ LpReliability::onLpPacketLost(lp::Sequence txSeq, bool isTimeout)
   if (txFrag.retxCount >= m_options.maxRetx) {
     NFD_LOG_FACE_DEBUG("seq=" << seq << " exceeded allowed retransmissions: DROP");
     // Delete all LpPackets of NetPkt from m_unackedFrags (except this one)
-    for (size_t i = 0; i < netPkt->unackedFrags.size(); i++) {
-      if (netPkt->unackedFrags[i] != txSeqIt) {
-        removedThisTxSeq.push_back(netPkt->unackedFrags[i]->first);
-        deleteUnackedFrag(netPkt->unackedFrags[i]);
+    for (lp::Sequence fragTxSeq : netPkt->unackedFrags) {
+      if (fragTxSeq != txSeq) {
+        removedThisTxSeq.push_back(fragTxSeq);
+        deleteUnackedFrag(fragTxSeq);
       }
     }
 
@@ -309,55 +365,52 @@ LpReliability::onLpPacketLost(lp::Sequence txSeq, bool isTimeout)
     }
 
     // Delete this LpPacket from m_unackedFrags
-    removedThisTxSeq.push_back(txSeqIt->first);
-    deleteUnackedFrag(txSeqIt);
+    removedThisTxSeq.push_back(txSeq);
+    deleteUnackedFrag(txSeq);
   }
   else {
     // Assign new TxSequence
     lp::Sequence newTxSeq = assignTxSequence(txFrag.pkt);
     netPkt->didRetx = true;
 
-    // Move fragment to new TxSequence mapping
-    auto hint = m_firstUnackedFrag != m_unackedFrags.end() && m_firstUnackedFrag->first > newTxSeq
-                ? m_firstUnackedFrag
-                : m_unackedFrags.end();
-    auto newTxFragIt = m_unackedFrags.try_emplace(hint, newTxSeq, txFrag.pkt);
-    auto& newTxFrag = newTxFragIt->second;
+    // Move fragment to new TxSequence at the end of the window; references to other
+    // fragments remain valid
+    auto& newTxFrag = m_unackedFrags.emplace(newTxSeq, std::move(txFrag.pkt));
     newTxFrag.retxCount = txFrag.retxCount + 1;
     newTxFrag.netPkt = netPkt;
 
+    // Remember the earlier TxSequences, to recognize a late Ack for any of them
+    newTxFrag.prevTxSeqs.swap(txFrag.prevTxSeqs);
+    newTxFrag.prevTxSeqs.push_back(txSeq);
+    for (lp::Sequence prevTxSeq : newTxFrag.prevTxSeqs) {
+      m_retxTxSeqs[prevTxSeq] = newTxSeq;
+    }
+
     // Update associated NetPkt
-    auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeqIt);
+    auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq);
     BOOST_ASSERT(fragInNetPkt != netPkt->unackedFrags.end());
-    *fragInNetPkt = newTxFragIt;
+    *fragInNetPkt = newTxSeq;
 
-    removedThisTxSeq.push_back(txSeqIt->first);
-    deleteUnackedFrag(txSeqIt);
+    removedThisTxSeq.push_back(txSeq);
+    deleteUnackedFrag(txSeq);
 
     // Retransmit fragment
     m_linkService->sendLpPacket(lp::Packet(newTxFrag.pkt));
 
-    auto rto = m_rttEst.getEstimatedRto();
     NFD_LOG_FACE_TRACE("retransmitting seq=" << seq << ", txseq=" << newTxSeq << ", retx=" <<
-                       txFrag.retxCount << ", rto=" <<
-                       time::duration_cast<time::milliseconds>(rto).count() << "ms");
-
-    // Start RTO timer for this sequence
-    newTxFrag.rtoTimer = getScheduler().schedule(rto, [=] {
-      onLpPacketLost(newTxSeq, true);
-    });
+                       newTxFrag.retxCount);
   }
 
   return removedThisTxSeq;
 }
 
 void
-LpReliability::onLpPacketAcknowledged(UnackedFrags::iterator fragIt)
+LpReliability::onLpPacketAcknowledged(lp::Sequence txSeq)
 {
-  auto netPkt = fragIt->second.netPkt;
+  auto netPkt = m_unackedFrags.at(txSeq).netPkt;
 
   // Remove from NetPkt unacked fragment list
-  auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), fragIt);
+  auto fragInNetPkt = std::find(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(), txSeq);
   BOOST_ASSERT(fragInNetPkt != netPkt->unackedFrags.end());
   *fragInNetPkt = netPkt->unackedFrags.back();
   netPkt->unackedFrags.pop_back();
@@ -372,28 +425,16 @@ LpReliability::onLpPacketAcknowledged(UnackedFrags::iterator fragIt)
     }
   }
 
-  deleteUnackedFrag(fragIt);
+  deleteUnackedFrag(txSeq);
 }
 
 void
-LpReliability::deleteUnackedFrag(UnackedFrags::iterator fragIt)
+LpReliability::deleteUnackedFrag(lp::Sequence txSeq)
 {
-  lp::Sequence firstUnackedTxSeq = m_firstUnackedFrag->first;
-  lp::Sequence currentTxSeq = fragIt->first;
-  auto nextFragIt = m_unackedFrags.erase(fragIt);
-
-  if (!m_unackedFrags.empty() && firstUnackedTxSeq == currentTxSeq) {
-    // If "first" fragment in send window (allowing for wraparound), increment window begin
-    if (nextFragIt == m_unackedFrags.end()) {
-      m_firstUnackedFrag = m_unackedFrags.begin();
-    }
-    else {
-      m_firstUnackedFrag = nextFragIt;
-    }
-  }
-  else if (m_unackedFrags.empty()) {
-    m_firstUnackedFrag = m_unackedFrags.end();
+  for (lp::Sequence prevTxSeq : m_unackedFrags.at(txSeq).prevTxSeqs) {
+    m_retxTxSeqs.erase(prevTxSeq);
   }
+  m_unackedFrags.erase(txSeq);
 }
 
 std::ostream&
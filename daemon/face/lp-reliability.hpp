@@ -27,14 +27,16 @@
 #define NFD_DAEMON_FACE_LP_RELIABILITY_HPP
 
 #include "face-common.hpp"
+#include "common/timer-wheel.hpp"
 
 #include <ndn-cxx/lp/packet.hpp>
 #include <ndn-cxx/lp/sequence.hpp>
 #include <ndn-cxx/util/rtt-estimator.hpp>
 #include <ndn-cxx/util/scheduler.hpp>
 
-#include <map>
+#include <deque>
 #include <queue>
+#include <unordered_map>
 
 namespace nfd::face {
 
@@ -42,6 +44,13 @@ class GenericLinkService;
 
 /**
  * \brief Provides for reliable sending and receiving of link-layer packets.
+ *
+ * Unacknowledged fragments are kept in a window indexed by TxSequence. A single retransmission
+ * timer runs for the oldest fragment in the window. A fragment is also considered lost when
+ * a fragment sent later is acknowledged, and either the later fragment was sent more than
+ * a reordering window after it (as in RACK, RFC 8985), or Options::seqNumLossThreshold
+ * later fragments have been acknowledged.
+ *
  * \sa https://redmine.named-data.net/projects/nfd/wiki/NDNLPv2
  */
 class LpReliability : noncopyable
@@ -120,8 +129,9 @@ public:
 
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   class UnackedFrag;
+  class UnackedFrags;
   class NetPkt;
-  using UnackedFrags = std::map<lp::Sequence, UnackedFrag>;
+  class AckQueue;
 
   /** \brief Assign TxSequence number to a fragment.
    *  \param frag fragment to assign TxSequence to
@@ -140,13 +150,27 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   startIdleAckTimer();
 
-  /** \brief Find and mark as lost fragments where a configurable number of Acks
-   *         (Options::seqNumLossThreshold) have been received for greater TxSequence numbers.
-   *  \param ackIt iterator pointing to acknowledged fragment
+  /** \brief Schedule the retransmission timer for the oldest unacknowledged fragment,
+   *         or cancel it if there is none.
+   */
+  void
+  restartRtoTimer();
+
+  /** \brief Resend (or give up on) all fragments whose RTO has expired.
+   */
+  void
+  onRtoTimeout();
+
+  /** \brief Find fragments sent before an acknowledged fragment that are considered lost.
+   *  \param ackTxSeq TxSequence of the acknowledged fragment, which must be unacknowledged
    *  \return vector containing TxSequences of fragments marked lost by this mechanism
+   *
+   *  A fragment is lost if a configurable number of Acks (Options::seqNumLossThreshold) have been
+   *  received for greater TxSequence numbers, or if the acknowledged fragment was sent more than
+   *  a reordering window (a quarter of the minimum RTT) after it.
    */
   std::vector<lp::Sequence>
-  findLostLpPackets(UnackedFrags::iterator ackIt);
+  findLostLpPackets(lp::Sequence ackTxSeq);
 
   /** \brief Resend (or give up on) a lost fragment.
    *  \return vector of the TxSequences of fragments removed due to a network packet being removed
@@ -154,25 +178,21 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   std::vector<lp::Sequence>
   onLpPacketLost(lp::Sequence txSeq, bool isTimeout);
 
-  /** \brief Remove the fragment with the given sequence number from the map of unacknowledged
-   *         fragments, as well as its associated network packet (if any).
-   *  \param fragIt iterator to acknowledged fragment
+  /** \brief Remove the fragment with the given TxSequence from the unacknowledged fragments,
+   *         as well as its associated network packet (if any).
+   *  \param txSeq TxSequence of the acknowledged fragment, which must be unacknowledged
    *
-   *  If the given TxSequence marks the beginning of the send window, the window will be incremented.
    *  If the associated network packet has been fully transmitted, it will be removed.
    */
   void
-  onLpPacketAcknowledged(UnackedFrags::iterator fragIt);
+  onLpPacketAcknowledged(lp::Sequence txSeq);
 
-  /** \brief Delete a fragment from UnackedFrags and advance acknowledge window if necessary.
-   *  \param fragIt iterator to an UnackedFrag, must be dereferencable
-   *  \post fragIt is not in m_unackedFrags
-   *  \post if was equal to m_firstUnackedFrag,
-   *        m_firstUnackedFrag is set to the UnackedFrag after fragIt with consideration of
-   *        TxSequence number wraparound, or set to m_unackedFrags.end() if m_unackedFrags is empty
+  /** \brief Delete a fragment from the unacknowledged fragments.
+   *  \param txSeq TxSequence of the fragment, which must be unacknowledged
+   *  \post the window starts at the oldest remaining unacknowledged fragment
    */
   void
-  deleteUnackedFrag(UnackedFrags::iterator fragIt);
+  deleteUnackedFrag(lp::Sequence txSeq);
 
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /**
@@ -189,11 +209,121 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   public:
     lp::Packet pkt;
-    ndn::scheduler::ScopedEventId rtoTimer;
     time::steady_clock::time_point sendTime = time::steady_clock::now();
     size_t retxCount = 0;
     size_t nGreaterSeqAcks = 0; ///< Number of Acks received for sequences greater than this fragment
     shared_ptr<NetPkt> netPkt;
+    std::vector<lp::Sequence> prevTxSeqs; ///< TxSequences of earlier transmissions
+  };
+
+  /**
+   * \brief Unacknowledged fragments, in a window indexed by TxSequence.
+   *
+   * TxSequences are assigned consecutively, so the fragments in flight occupy consecutive slots,
+   * from the oldest unacknowledged fragment to the most recently sent one, in the order they were
+   * sent. Acknowledged and retransmitted fragments leave empty slots behind, which are released
+   * once they reach the front of the window. Index arithmetic wraps around with TxSequence.
+   */
+  class UnackedFrags
+  {
+  public:
+    bool
+    empty() const noexcept
+    {
+      return m_size == 0;
+    }
+
+    /** \return number of unacknowledged fragments
+     */
+    size_t
+    size() const noexcept
+    {
+      return m_size;
+    }
+
+    size_t
+    count(lp::Sequence txSeq) const noexcept
+    {
+      return find(txSeq) != nullptr ? 1 : 0;
+    }
+
+    UnackedFrag*
+    find(lp::Sequence txSeq) noexcept
+    {
+      lp::Sequence index = txSeq - m_firstTxSeq;
+      return index < m_slots.size() && m_slots[index] ? &*m_slots[index] : nullptr;
+    }
+
+    const UnackedFrag*
+    find(lp::Sequence txSeq) const noexcept
+    {
+      return const_cast<UnackedFrags*>(this)->find(txSeq);
+    }
+
+    /** \throw std::out_of_range \p txSeq is not unacknowledged
+     */
+    UnackedFrag&
+    at(lp::Sequence txSeq)
+    {
+      auto frag = find(txSeq);
+      if (frag == nullptr) {
+        NDN_THROW(std::out_of_range("TxSequence " + std::to_string(txSeq) +
+                                    " is not unacknowledged"));
+      }
+      return *frag;
+    }
+
+    /** \brief Returns the TxSequence of the oldest unacknowledged fragment.
+     *  \pre !empty()
+     */
+    lp::Sequence
+    getFirstTxSeq() const noexcept
+    {
+      BOOST_ASSERT(!empty());
+      return m_firstTxSeq;
+    }
+
+    /** \brief Returns the TxSequence following the most recently added fragment.
+     */
+    lp::Sequence
+    getEndTxSeq() const noexcept
+    {
+      return m_firstTxSeq + m_slots.size();
+    }
+
+    /** \brief Add a fragment at the end of the window.
+     *  \pre \p txSeq equals getEndTxSeq(), unless the window is empty
+     */
+    UnackedFrag&
+    emplace(lp::Sequence txSeq, lp::Packet pkt)
+    {
+      if (empty()) {
+        m_slots.clear();
+        m_firstTxSeq = txSeq;
+      }
+      BOOST_ASSERT(txSeq == getEndTxSeq());
+      ++m_size;
+      return m_slots.emplace_back(std::in_place, std::move(pkt)).value();
+    }
+
+    /** \pre count(txSeq) == 1
+     */
+    void
+    erase(lp::Sequence txSeq)
+    {
+      BOOST_ASSERT(count(txSeq) == 1);
+      m_slots[txSeq - m_firstTxSeq].reset();
+      --m_size;
+      while (!m_slots.empty() && !m_slots.front()) {
+        m_slots.pop_front();
+        ++m_firstTxSeq;
+      }
+    }
+
+  private:
+    std::deque<std::optional<UnackedFrag>> m_slots;
+    lp::Sequence m_firstTxSeq = 0;
+    size_t m_size = 0;
   };
 
   /**
@@ -209,26 +339,95 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
     }
 
   public:
-    std::vector<UnackedFrags::iterator> unackedFrags;
+    std::vector<lp::Sequence> unackedFrags; ///< TxSequences of unacknowledged fragments
     lp::Packet pkt;
     bool isInterest;
     bool didRetx = false;
   };
 
+  /**
+   * \brief A FIFO queue of TxSequences to acknowledge, stored as runs of consecutive numbers.
+   *
+   * A peer's fragments usually arrive in TxSequence order, so the queue needs one entry per gap
+   * rather than one per fragment.
+   */
+  class AckQueue
+  {
+  public:
+    bool
+    empty() const noexcept
+    {
+      return m_size == 0;
+    }
+
+    /** \return number of queued TxSequences
+     */
+    size_t
+    size() const noexcept
+    {
+      return m_size;
+    }
+
+    /** \pre !empty()
+     */
+    lp::Sequence
+    front() const noexcept
+    {
+      return m_ranges.front().first;
+    }
+
+    /** \pre !empty()
+     */
+    lp::Sequence
+    back() const noexcept
+    {
+      return m_ranges.back().first + m_ranges.back().second - 1;
+    }
+
+    void
+    push(lp::Sequence txSeq)
+    {
+      if (!m_ranges.empty() && txSeq == back() + 1) {
+        ++m_ranges.back().second;
+      }
+      else {
+        m_ranges.emplace_back(txSeq, 1);
+      }
+      ++m_size;
+    }
+
+    /** \pre !empty()
+     */
+    void
+    pop() noexcept
+    {
+      auto& [first, length] = m_ranges.front();
+      ++first;
+      if (--length == 0) {
+        m_ranges.pop_front();
+      }
+      --m_size;
+    }
+
+  private:
+    /// First TxSequence and length of each run
+    std::deque<std::pair<lp::Sequence, size_t>> m_ranges;
+    size_t m_size = 0;
+  };
+
   Options m_options;
   GenericLinkService* m_linkService = nullptr;
   UnackedFrags m_unackedFrags;
-  // An iterator that points to the first unacknowledged fragment in the current window. The window
-  // can wrap around so that the beginning of the window is at a TxSequence greater than other
-  // fragments in the window. When the window is moved past the last item in the iterator, the
-  // first fragment in the map will become the start of the window.
-  UnackedFrags::iterator m_firstUnackedFrag;
-  std::queue<lp::Sequence> m_ackQueue;
-  std::map<lp::Sequence, time::steady_clock::time_point> m_recentRecvSeqs;
+  /// Maps TxSequences of retransmitted fragments to their current TxSequence
+  std::unordered_map<lp::Sequence, lp::Sequence> m_retxTxSeqs;
+  TimerWheel::Timer m_rtoTimer;
+  AckQueue m_ackQueue;
+  std::unordered_map<lp::Sequence, time::steady_clock::time_point> m_recentRecvSeqs;
   std::queue<lp::Sequence> m_recentRecvSeqsQueue;
   lp::Sequence m_lastTxSeqNo;
   ndn::scheduler::ScopedEventId m_idleAckTimer;
   ndn::util::RttEstimator m_rttEst;
+  time::nanoseconds m_minRtt = time::nanoseconds::max();
 };
 
 std::ostream&
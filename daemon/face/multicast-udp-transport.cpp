@@ -47,8 +47,10 @@ NFD_LOG_MEMBER_INIT_SPECIALIZED((DatagramTransport<ip::udp, Multicast>), Multica
 MulticastUdpTransport::MulticastUdpTransport(const ip::udp::endpoint& multicastGroup,
                                              ip::udp::socket&& recvSocket,
                                              ip::udp::socket&& sendSocket,
-                                             ndn::nfd::LinkType linkType)
-  : DatagramTransport(std::move(recvSocket))
+                                             ndn::nfd::LinkType linkType,
+                                             size_t batchSize,
+                                             DatagramIoBackend ioBackend)
+  : DatagramTransport(std::move(recvSocket), batchSize, ioBackend)
   , m_multicastGroup(multicastGroup)
   , m_sendSocket(std::move(sendSocket))
 {
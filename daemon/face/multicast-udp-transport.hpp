@@ -53,11 +53,16 @@ public:
    * \param recvSocket socket used to receive multicast packets
    * \param sendSocket socket used to send to the multicast group
    * \param linkType either `ndn::nfd::LINK_TYPE_MULTI_ACCESS` or `ndn::nfd::LINK_TYPE_AD_HOC`
+   * \param batchSize maximum number of datagrams received per system call; 1 disables batched
+   *                  receive. Sending is never batched, because it uses the separate \p sendSocket.
+   * \param ioBackend how \p recvSocket receives; \p sendSocket always uses Boost.Asio
    */
   MulticastUdpTransport(const boost::asio::ip::udp::endpoint& multicastGroup,
                         boost::asio::ip::udp::socket&& recvSocket,
                         boost::asio::ip::udp::socket&& sendSocket,
-                        ndn::nfd::LinkType linkType);
+                        ndn::nfd::LinkType linkType,
+                        size_t batchSize = 1,
+                        DatagramIoBackend ioBackend = DatagramIoBackend::ASIO);
 
   ssize_t
   getSendQueueLength() final;
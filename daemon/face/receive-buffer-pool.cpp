@@ -0,0 +1,342 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "receive-buffer-pool.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace nfd::face {
+
+static_assert(ReceiveBufferPool::MIN_CLASS_SIZE << (ReceiveBufferPool::N_SIZE_CLASSES - 2) <
+              ndn::MAX_NDN_PACKET_SIZE);
+
+constexpr size_t MAX_CACHED_CONTROL_BLOCKS = 65536;
+
+static constexpr size_t
+getClassSize(size_t sizeClass)
+{
+  return sizeClass + 1 < ReceiveBufferPool::N_SIZE_CLASSES ?
+         ReceiveBufferPool::MIN_CLASS_SIZE << sizeClass : ndn::MAX_NDN_PACKET_SIZE;
+}
+
+struct ReceiveBufferPool::Deleter
+{
+  void
+  operator()(ndn::Buffer* buffer) const noexcept
+  {
+    ReceiveBufferPool::get().release(buffer);
+  }
+};
+
+template<typename T>
+struct ReceiveBufferPool::ControlBlockAllocator
+{
+  using value_type = T;
+
+  ControlBlockAllocator() = default;
+
+  template<typename U>
+  ControlBlockAllocator(const ControlBlockAllocator<U>&) noexcept
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    return static_cast<T*>(ReceiveBufferPool::get().allocateControlBlock(n * sizeof(T)));
+  }
+
+  void
+  deallocate(T* p, size_t n) noexcept
+  {
+    ReceiveBufferPool::get().releaseControlBlock(p, n * sizeof(T));
+  }
+
+  template<typename U>
+  bool
+  operator==(const ControlBlockAllocator<U>&) const noexcept
+  {
+    return true;
+  }
+
+  template<typename U>
+  bool
+  operator!=(const ControlBlockAllocator<U>&) const noexcept
+  {
+    return false;
+  }
+};
+
+/** \brief Free lists of one thread.
+ *
+ *  Each list is reserved up to MAX_THREAD_CACHED, so that releasing never allocates.
+ *  When the thread exits, the cached buffers and control blocks go back to the shared pool.
+ */
+struct ReceiveBufferPool::ThreadCache
+{
+  ThreadCache()
+  {
+    for (auto& buffers : freeBuffers) {
+      buffers.reserve(MAX_THREAD_CACHED);
+    }
+    freeControlBlocks.reserve(MAX_THREAD_CACHED);
+  }
+
+  ~ThreadCache();
+
+  std::array<std::vector<ndn::Buffer*>, N_SIZE_CLASSES> freeBuffers;
+  std::vector<void*> freeControlBlocks;
+};
+
+// trivially destructible, so it can still be read after the thread cache is destroyed
+static thread_local bool t_isThreadCacheDestroyed = false;
+
+ReceiveBufferPool::ThreadCache::~ThreadCache()
+{
+  auto& pool = ReceiveBufferPool::get();
+  for (size_t sizeClass = 0; sizeClass < N_SIZE_CLASSES; ++sizeClass) {
+    pool.returnBuffers(sizeClass, freeBuffers[sizeClass], freeBuffers[sizeClass].size());
+  }
+  pool.returnControlBlocks(freeControlBlocks, freeControlBlocks.size());
+  t_isThreadCacheDestroyed = true;
+}
+
+ReceiveBufferPool&
+ReceiveBufferPool::get()
+{
+  // never destroyed, because buffers may be released during static destruction
+  static auto* pool = new ReceiveBufferPool;
+  return *pool;
+}
+
+ReceiveBufferPool::ReceiveBufferPool()
+{
+  // reserve the free lists up front, so that returning to the shared pool never allocates
+  for (size_t sizeClass = 0; sizeClass < N_SIZE_CLASSES; ++sizeClass) {
+    m_freeBuffers[sizeClass].reserve(MAX_CACHED_BYTES_PER_CLASS / getClassSize(sizeClass));
+  }
+  m_freeControlBlocks.reserve(MAX_CACHED_CONTROL_BLOCKS);
+}
+
+ReceiveBufferPool::ThreadCache*
+ReceiveBufferPool::getThreadCache() noexcept
+{
+  if (t_isThreadCacheDestroyed) {
+    // a buffer released by another thread-local object while the thread exits
+    return nullptr;
+  }
+  static thread_local ThreadCache cache;
+  return &cache;
+}
+
+size_t
+ReceiveBufferPool::getSizeClass(size_t size)
+{
+  BOOST_ASSERT(size <= ndn::MAX_NDN_PACKET_SIZE);
+  size_t sizeClass = 0;
+  while (getClassSize(sizeClass) < size) {
+    ++sizeClass;
+  }
+  return sizeClass;
+}
+
+/** \brief Move up to TRANSFER_BATCH_SIZE elements from the back of \p from to \p to.
+ */
+template<typename T>
+static void
+transferBatch(std::vector<T>& from, std::vector<T>& to)
+{
+  size_t n = std::min(from.size(), ReceiveBufferPool::TRANSFER_BATCH_SIZE);
+  to.insert(to.end(), from.end() - n, from.end());
+  from.resize(from.size() - n);
+}
+
+/** \brief Move the last \p n elements of \p src to \p pool, up to \p maxPoolSize.
+ *  \return number of elements that did not fit, which remain at the back of \p src
+ */
+template<typename T>
+static size_t
+transferToPool(std::vector<T>& src, size_t n, std::vector<T>& pool, size_t maxPoolSize) noexcept
+{
+  size_t nMoved = std::min(n, maxPoolSize - std::min(maxPoolSize, pool.size()));
+  // pool is reserved up to maxPoolSize, so neither call allocates
+  pool.insert(pool.end(), src.end() - nMoved, src.end());
+  src.resize(src.size() - nMoved);
+  return n - nMoved;
+}
+
+void
+ReceiveBufferPool::takeBuffers(size_t sizeClass, std::vector<ndn::Buffer*>& dest)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  transferBatch(m_freeBuffers[sizeClass], dest);
+}
+
+void
+ReceiveBufferPool::returnBuffers(size_t sizeClass, std::vector<ndn::Buffer*>& src, size_t n) noexcept
+{
+  size_t nExcess = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    nExcess = transferToPool(src, n, m_freeBuffers[sizeClass],
+                             MAX_CACHED_BYTES_PER_CLASS / getClassSize(sizeClass));
+  }
+  for (; nExcess > 0; --nExcess) {
+    delete src.back();
+    src.pop_back();
+  }
+}
+
+void
+ReceiveBufferPool::takeControlBlocks(std::vector<void*>& dest)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  transferBatch(m_freeControlBlocks, dest);
+}
+
+void
+ReceiveBufferPool::returnControlBlocks(std::vector<void*>& src, size_t n) noexcept
+{
+  size_t nExcess = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    nExcess = transferToPool(src, n, m_freeControlBlocks, MAX_CACHED_CONTROL_BLOCKS);
+  }
+  for (; nExcess > 0; --nExcess) {
+    ::operator delete(src.back());
+    src.pop_back();
+  }
+}
+
+shared_ptr<ndn::Buffer>
+ReceiveBufferPool::allocate(size_t size)
+{
+  size_t sizeClass = getSizeClass(size);
+  ndn::Buffer* buffer = nullptr;
+  if (auto* cache = getThreadCache(); cache != nullptr) {
+    auto& freeBuffers = cache->freeBuffers[sizeClass];
+    if (freeBuffers.empty()) {
+      takeBuffers(sizeClass, freeBuffers);
+    }
+    if (!freeBuffers.empty()) {
+      buffer = freeBuffers.back();
+      freeBuffers.pop_back();
+    }
+  }
+
+  if (buffer != nullptr) {
+    m_nRecycled.fetch_add(1, std::memory_order_relaxed);
+  }
+  else {
+    m_nAllocated.fetch_add(1, std::memory_order_relaxed);
+    buffer = new ndn::Buffer(getClassSize(sizeClass));
+  }
+  buffer->resize(size); // within capacity, never reallocates
+  return {buffer, Deleter{}, ControlBlockAllocator<ndn::Buffer>{}};
+}
+
+ndn::ConstBufferPtr
+ReceiveBufferPool::copy(span<const uint8_t> bytes)
+{
+  auto buffer = allocate(bytes.size());
+  std::memcpy(buffer->data(), bytes.data(), bytes.size());
+  return buffer;
+}
+
+ndn::ConstBufferPtr
+ReceiveBufferPool::adopt(shared_ptr<ndn::Buffer>& receiveBuffer, size_t size)
+{
+  BOOST_ASSERT(receiveBuffer != nullptr && size <= receiveBuffer->size());
+
+  if (getSizeClass(size) != getSizeClass(receiveBuffer->capacity())) {
+    return copy(ndn::make_span(*receiveBuffer).first(size));
+  }
+
+  receiveBuffer->resize(size);
+  ndn::ConstBufferPtr adopted = std::move(receiveBuffer);
+  receiveBuffer = allocateReceiveBuffer();
+  return adopted;
+}
+
+void
+ReceiveBufferPool::release(ndn::Buffer* buffer) noexcept
+{
+  auto* cache = getThreadCache();
+  if (cache == nullptr) {
+    delete buffer;
+    return;
+  }
+
+  size_t sizeClass = getSizeClass(buffer->capacity());
+  auto& freeBuffers = cache->freeBuffers[sizeClass];
+  if (freeBuffers.size() >= MAX_THREAD_CACHED) {
+    returnBuffers(sizeClass, freeBuffers, TRANSFER_BATCH_SIZE);
+  }
+  freeBuffers.push_back(buffer);
+}
+
+void*
+ReceiveBufferPool::allocateControlBlock(size_t size)
+{
+  auto* cache = getThreadCache();
+  if (cache != nullptr && size == m_controlBlockSize.load(std::memory_order_relaxed)) {
+    auto& freeBlocks = cache->freeControlBlocks;
+    if (freeBlocks.empty()) {
+      takeControlBlocks(freeBlocks);
+    }
+    if (!freeBlocks.empty()) {
+      void* block = freeBlocks.back();
+      freeBlocks.pop_back();
+      return block;
+    }
+  }
+  return ::operator new(size);
+}
+
+void
+ReceiveBufferPool::releaseControlBlock(void* block, size_t size) noexcept
+{
+  size_t blockSize = 0;
+  // the first released block determines which size is recycled
+  m_controlBlockSize.compare_exchange_strong(blockSize, size, std::memory_order_relaxed);
+  if (blockSize == 0) {
+    blockSize = size;
+  }
+
+  auto* cache = getThreadCache();
+  if (cache == nullptr || size != blockSize) {
+    ::operator delete(block);
+    return;
+  }
+
+  auto& freeBlocks = cache->freeControlBlocks;
+  if (freeBlocks.size() >= MAX_THREAD_CACHED) {
+    returnControlBlocks(freeBlocks, TRANSFER_BATCH_SIZE);
+  }
+  freeBlocks.push_back(block);
+}
+
+} // namespace nfd::face
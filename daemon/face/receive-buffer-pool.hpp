@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_RECEIVE_BUFFER_POOL_HPP
+#define NFD_DAEMON_FACE_RECEIVE_BUFFER_POOL_HPP
+
+#include "core/common.hpp"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace nfd::face {
+
+/** \brief A pool of recycled buffers for received packets.
+ *
+ *  Buffers are grouped into size classes: powers of two from 256 bytes, and a last class
+ *  of ndn::MAX_NDN_PACKET_SIZE bytes. A buffer returns to the pool of its class when the last
+ *  reference to it is dropped, e.g., when the Interest or Data decoded from it leaves the PIT
+ *  or the Content Store. The reference count of each buffer is also allocated from the pool,
+ *  so that a recycled buffer is handed out without any heap allocation.
+ *
+ *  A datagram transport receives into a buffer of the largest class. adopt() hands that buffer
+ *  over to the Block only if the packet needs a buffer of the largest class anyway, i.e., if it
+ *  is larger than 4096 bytes. Smaller packets, which include nearly all Interests, are copied
+ *  once into a buffer of their own class, so that a small packet does not pin a large buffer
+ *  for as long as it is stored in a table.
+ *
+ *  Each thread keeps its own free lists, so that allocating and releasing do not take a lock.
+ *  A thread exchanges buffers with a shared pool in batches when its free lists run empty or
+ *  full; in particular, a buffer may be released on a thread other than the one that allocated
+ *  it, and finds its way back to the allocating thread through the shared pool.
+ */
+class ReceiveBufferPool : noncopyable
+{
+public:
+  /** \brief Return the process-wide pool.
+   */
+  static ReceiveBufferPool&
+  get();
+
+  /** \brief Return a buffer of \p size bytes, \p size being at most ndn::MAX_NDN_PACKET_SIZE.
+   */
+  shared_ptr<ndn::Buffer>
+  allocate(size_t size);
+
+  /** \brief Return a buffer of ndn::MAX_NDN_PACKET_SIZE bytes to receive into.
+   */
+  shared_ptr<ndn::Buffer>
+  allocateReceiveBuffer()
+  {
+    return allocate(ndn::MAX_NDN_PACKET_SIZE);
+  }
+
+  /** \brief Return a buffer holding a copy of \p bytes.
+   */
+  ndn::ConstBufferPtr
+  copy(span<const uint8_t> bytes);
+
+  /** \brief Return a buffer holding the first \p size bytes of \p receiveBuffer.
+   *
+   *  If no smaller size class fits \p size, \p receiveBuffer itself is truncated and returned
+   *  without copying, and \p receiveBuffer is replaced by a new receive buffer. Otherwise,
+   *  the bytes are copied into a buffer of the smallest fitting class.
+   */
+  ndn::ConstBufferPtr
+  adopt(shared_ptr<ndn::Buffer>& receiveBuffer, size_t size);
+
+  /** \return number of buffers handed out without allocating a new one
+   */
+  uint64_t
+  getNRecycled() const noexcept
+  {
+    return m_nRecycled.load(std::memory_order_relaxed);
+  }
+
+  /** \return number of buffers allocated because the pool of their class was empty
+   */
+  uint64_t
+  getNAllocated() const noexcept
+  {
+    return m_nAllocated.load(std::memory_order_relaxed);
+  }
+
+private:
+  ReceiveBufferPool();
+
+  static size_t
+  getSizeClass(size_t size);
+
+  void
+  release(ndn::Buffer* buffer) noexcept;
+
+  void*
+  allocateControlBlock(size_t size);
+
+  void
+  releaseControlBlock(void* block, size_t size) noexcept;
+
+  struct ThreadCache;
+
+  /** \return free lists of the calling thread, or nullptr if the thread is exiting
+   */
+  static ThreadCache*
+  getThreadCache() noexcept;
+
+  /** \brief Move up to one batch of free buffers of \p sizeClass from the shared pool to \p dest.
+   */
+  void
+  takeBuffers(size_t sizeClass, std::vector<ndn::Buffer*>& dest);
+
+  /** \brief Move the last \p n buffers of \p src to the shared pool, deleting those that do not fit.
+   */
+  void
+  returnBuffers(size_t sizeClass, std::vector<ndn::Buffer*>& src, size_t n) noexcept;
+
+  void
+  takeControlBlocks(std::vector<void*>& dest);
+
+  void
+  returnControlBlocks(std::vector<void*>& src, size_t n) noexcept;
+
+  struct Deleter;
+
+  template<typename T>
+  struct ControlBlockAllocator;
+
+public:
+  static constexpr size_t MIN_CLASS_SIZE = 256;
+  static constexpr size_t N_SIZE_CLASSES = 6; // 256, 512, ..., 4096, MAX_NDN_PACKET_SIZE
+  /// maximum number of bytes cached in each size class of the shared pool
+  static constexpr size_t MAX_CACHED_BYTES_PER_CLASS = 8 * 1024 * 1024;
+  /// number of buffers or control blocks moved between a thread and the shared pool at once
+  static constexpr size_t TRANSFER_BATCH_SIZE = 32;
+  /// maximum number of buffers of each class, and of control blocks, cached by a thread
+  static constexpr size_t MAX_THREAD_CACHED = 2 * TRANSFER_BATCH_SIZE;
+
+private:
+  // the shared pool, only accessed in batches
+  std::mutex m_mutex;
+  std::array<std::vector<ndn::Buffer*>, N_SIZE_CLASSES> m_freeBuffers;
+  std::vector<void*> m_freeControlBlocks;
+
+  std::atomic<size_t> m_controlBlockSize{0};
+  std::atomic<uint64_t> m_nRecycled{0};
+  std::atomic<uint64_t> m_nAllocated{0};
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_RECEIVE_BUFFER_POOL_HPP
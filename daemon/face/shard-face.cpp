@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shard-face.hpp"
+
+namespace nfd::face {
+
+ShardLinkService::ShardLinkService(SendCallback send)
+  : m_send(std::move(send))
+{
+}
+
+void
+ShardLinkService::deliver(const ShardPacket& packet)
+{
+  switch (packet.type) {
+    case ShardPacket::INTEREST:
+      receiveInterest(*packet.interest, packet.endpointId);
+      break;
+    case ShardPacket::DATA:
+      receiveData(*packet.data, packet.endpointId);
+      break;
+    case ShardPacket::NACK:
+      receiveNack(*packet.nack, packet.endpointId);
+      break;
+    case ShardPacket::DROPPED_INTEREST:
+      notifyDroppedInterest(*packet.interest);
+      break;
+  }
+}
+
+void
+ShardLinkService::doSendInterest(const Interest& interest)
+{
+  ShardPacket packet;
+  packet.type = ShardPacket::INTEREST;
+  packet.faceId = getFace()->getId();
+  packet.interest = make_shared<Interest>(interest);
+  m_send(std::move(packet));
+}
+
+void
+ShardLinkService::doSendData(const Data& data)
+{
+  ShardPacket packet;
+  packet.type = ShardPacket::DATA;
+  packet.faceId = getFace()->getId();
+  packet.data = make_shared<Data>(data);
+  m_send(std::move(packet));
+}
+
+void
+ShardLinkService::doSendNack(const lp::Nack& nack)
+{
+  ShardPacket packet;
+  packet.type = ShardPacket::NACK;
+  packet.faceId = getFace()->getId();
+  packet.nack = make_shared<lp::Nack>(nack);
+  m_send(std::move(packet));
+}
+
+ShardTransport::ShardTransport(const Face& face)
+{
+  this->setLocalUri(face.getLocalUri());
+  this->setRemoteUri(face.getRemoteUri());
+  this->setScope(face.getScope());
+  this->setPersistency(face.getPersistency());
+  this->setLinkType(face.getLinkType());
+  this->setMtu(face.getTransport()->getMtu());
+  this->updateState(face.getState());
+  this->setSendQueueCongested(face.isSendQueueCongested());
+}
+
+void
+ShardTransport::updateState(TransportState newState)
+{
+  auto isUpOrDown = [] (TransportState state) {
+    return state == TransportState::UP || state == TransportState::DOWN;
+  };
+  if (isUpOrDown(newState) && isUpOrDown(this->getState())) {
+    this->setState(newState);
+  }
+}
+
+shared_ptr<Face>
+makeShardFace(const Face& face, ShardLinkService::SendCallback send)
+{
+  return make_shared<Face>(make_unique<ShardLinkService>(std::move(send)),
+                           make_unique<ShardTransport>(face));
+}
+
+} // namespace nfd::face
@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_SHARD_FACE_HPP
+#define NFD_DAEMON_FACE_SHARD_FACE_HPP
+
+#include "face.hpp"
+#include "link-service.hpp"
+#include "transport.hpp"
+
+namespace nfd::face {
+
+/**
+ * \brief A network layer packet passed between the main thread and a forwarding shard
+ *        or an I/O worker.
+ */
+struct ShardPacket
+{
+  enum Type : uint8_t {
+    INTEREST,
+    DATA,
+    NACK,
+    DROPPED_INTEREST, ///< an Interest dropped by the reliability system of the face
+  };
+
+  Type type = INTEREST;
+  FaceId faceId = INVALID_FACEID;
+  EndpointId endpointId;
+  shared_ptr<const Interest> interest; ///< for INTEREST and DROPPED_INTEREST
+  shared_ptr<const Data> data;         ///< for DATA
+  shared_ptr<const lp::Nack> nack;     ///< for NACK
+};
+
+/**
+ * \brief Share ownership of \p pkt if a shared_ptr owns it, otherwise copy it.
+ *
+ * Link services normally emit packets that they decoded into a shared_ptr, but nothing requires
+ * the argument of a signal to be owned, and a packet queued to another thread must outlive the
+ * signal.
+ */
+template<typename Packet>
+shared_ptr<const Packet>
+shareOrCopy(const Packet& pkt)
+{
+  if (auto owned = pkt.weak_from_this().lock(); owned != nullptr) {
+    return owned;
+  }
+  return make_shared<Packet>(pkt);
+}
+
+/**
+ * \brief The LinkService of a shard face.
+ *
+ * Packets received by the corresponding face in the main thread are delivered to forwarding
+ * with deliver(). Packets sent by forwarding are copied and passed to a callback, which hands
+ * them to the main thread; a copy is needed because forwarding may modify the packet later.
+ *
+ * The face that stands for a face of an I/O worker in the main thread uses the same LinkService,
+ * with the main thread in the place of the shard and the I/O worker in the place of the main thread.
+ */
+class ShardLinkService final : public LinkService
+{
+public:
+  using SendCallback = std::function<void(ShardPacket&&)>;
+
+  explicit
+  ShardLinkService(SendCallback send);
+
+  /**
+   * \brief Deliver a packet received by the corresponding face to forwarding.
+   */
+  void
+  deliver(const ShardPacket& packet);
+
+private:
+  void
+  doSendInterest(const Interest& interest) final;
+
+  void
+  doSendData(const Data& data) final;
+
+  void
+  doSendNack(const lp::Nack& nack) final;
+
+  void
+  doReceivePacket(const Block&, const EndpointId&) final
+  {
+    // ShardTransport never receives
+  }
+
+private:
+  SendCallback m_send;
+};
+
+/**
+ * \brief The Transport of a shard face, which has the properties of the corresponding face.
+ *
+ * Dynamic properties of the corresponding face are not observed directly, because that face
+ * lives in the main thread; instead, the owner of the shard face forwards each change with
+ * updateState(), setPersistency(), and updateSendQueueCongested().
+ */
+class ShardTransport final : public Transport
+{
+public:
+  explicit
+  ShardTransport(const Face& face);
+
+  /**
+   * \brief Follow a state change of the corresponding face.
+   *
+   * Only UP and DOWN are followed; the shard face is closed separately when the corresponding
+   * face is removed from the FaceTable.
+   */
+  void
+  updateState(TransportState newState);
+
+  /**
+   * \brief Follow a send queue congestion change of the corresponding face.
+   */
+  void
+  updateSendQueueCongested(bool isCongested)
+  {
+    setSendQueueCongested(isCongested);
+  }
+
+private:
+  bool
+  canChangePersistencyToImpl(ndn::nfd::FacePersistency) const final
+  {
+    // the corresponding face has validated the change
+    return true;
+  }
+
+  void
+  doClose() final
+  {
+    setState(TransportState::CLOSED);
+  }
+
+  void
+  doSend(const Block&) final
+  {
+    // ShardLinkService never sends through the transport
+  }
+};
+
+/**
+ * \brief Create a face that stands for \p face in a forwarding shard.
+ * \param face a face in the main thread; its properties are copied, so this function must
+ *             be called in the main thread
+ * \param send invoked in the shard thread with each packet sent on the shard face
+ *
+ * The shard face should be added to the FaceTable of the shard with the FaceId of \p face.
+ * It is closed by the shard when \p face is removed.
+ */
+shared_ptr<Face>
+makeShardFace(const Face& face, ShardLinkService::SendCallback send);
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_SHARD_FACE_HPP
@@ -30,6 +30,18 @@
 
 namespace nfd::face {
 
+/** \brief Socket buffer sizes of a stream face.
+ *
+ *  A zero size leaves the kernel default in place. On Linux, this also keeps the kernel's
+ *  own buffer auto-tuning for TCP, which is disabled on a socket once its size is set.
+ */
+struct SocketBufferOptions
+{
+  size_t receiveBufferSize = 0; ///< SO_RCVBUF
+  size_t sendBufferSize = 0; ///< initial SO_SNDBUF
+  size_t maxSendBufferSize = 0; ///< limit of SO_SNDBUF auto-tuning, none if not above sendBufferSize
+};
+
 /** \brief Obtain send queue length from a specified system socket.
  *  \param fd file descriptor of the socket
  *  \retval QUEUE_UNSUPPORTED this operation is unsupported on the current platform
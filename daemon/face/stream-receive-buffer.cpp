@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "stream-receive-buffer.hpp"
+#include "receive-buffer-pool.hpp"
+
+#include <cstring>
+
+namespace nfd::face {
+
+/// maximum size of a TLV-TYPE that fits in uint32_t, plus the maximum size of a TLV-LENGTH
+constexpr size_t MAX_TLV_HEADER_SIZE = 5 + 9;
+
+static shared_ptr<ndn::Buffer>
+allocateRing(size_t capacity)
+{
+  if (capacity <= ndn::MAX_NDN_PACKET_SIZE) {
+    return ReceiveBufferPool::get().allocate(capacity);
+  }
+  return make_shared<ndn::Buffer>(capacity);
+}
+
+StreamReceiveBuffer::StreamReceiveBuffer(size_t minCapacity, size_t maxCapacity)
+  : m_buffer(allocateRing(minCapacity))
+  , m_minCapacity(minCapacity)
+  , m_maxCapacity(maxCapacity)
+{
+  BOOST_ASSERT(minCapacity >= ndn::MAX_NDN_PACKET_SIZE);
+  BOOST_ASSERT(maxCapacity >= minCapacity);
+}
+
+std::array<boost::asio::mutable_buffer, 2>
+StreamReceiveBuffer::prepare()
+{
+  if (m_nSmallReceives >= SHRINK_AFTER_N_RECEIVES && capacity() > m_minCapacity &&
+      m_size <= capacity() / 2) {
+    resize(std::max(capacity() / 2, m_minCapacity));
+    m_nSmallReceives = 0;
+  }
+  else if (m_buffer.use_count() > 1) {
+    // the free space holds elements that were extracted in place and are still in use
+    resize(capacity());
+  }
+
+  BOOST_ASSERT(m_size < capacity());
+  uint8_t* ring = m_buffer->data();
+  size_t end = (m_begin + m_size) % capacity();
+  if (end < m_begin) {
+    return {boost::asio::buffer(ring + end, m_begin - end), boost::asio::mutable_buffer()};
+  }
+  return {boost::asio::buffer(ring + end, capacity() - end), boost::asio::buffer(ring, m_begin)};
+}
+
+void
+StreamReceiveBuffer::commit(size_t nBytes)
+{
+  BOOST_ASSERT(nBytes <= capacity() - m_size);
+  m_size += nBytes;
+
+  if (nBytes < capacity() / 4) {
+    ++m_nSmallReceives;
+  }
+  else {
+    m_nSmallReceives = 0;
+  }
+
+  // a large receive that leaves the ring nearly full suggests that more bytes are waiting
+  // in the socket; filling a free space that was small to begin with does not
+  if (nBytes >= capacity() / 4 && capacity() - m_size < capacity() / GROW_FREE_DIVISOR &&
+      capacity() < m_maxCapacity) {
+    resize(std::min(capacity() * 2, m_maxCapacity));
+  }
+}
+
+std::optional<Block>
+StreamReceiveBuffer::extract()
+{
+  if (m_size == 0) {
+    return std::nullopt;
+  }
+
+  std::array<uint8_t, MAX_TLV_HEADER_SIZE> header;
+  size_t nHeaderBytes = std::min(m_size, header.size());
+  copyOut({header.data(), nHeaderBytes});
+
+  auto pos = header.cbegin();
+  auto end = pos + nHeaderBytes;
+  uint32_t type = 0;
+  uint64_t length = 0;
+  if (!ndn::tlv::readType(pos, end, type) || !ndn::tlv::readVarNumber(pos, end, length)) {
+    if (nHeaderBytes < header.size()) {
+      // the header may be incomplete
+      return std::nullopt;
+    }
+    NDN_THROW(Error("Invalid TLV header"));
+  }
+
+  size_t headerSize = static_cast<size_t>(pos - header.cbegin());
+  if (length > ndn::MAX_NDN_PACKET_SIZE - headerSize) {
+    NDN_THROW(Error("TLV-LENGTH " + std::to_string(length) + " of TLV-TYPE " + std::to_string(type) +
+                    " exceeds the maximum packet size"));
+  }
+  size_t elementSize = headerSize + static_cast<size_t>(length);
+  if (elementSize > m_size) {
+    return std::nullopt;
+  }
+
+  std::optional<Block> element;
+  if (m_begin + elementSize <= capacity()) {
+    auto first = m_buffer->cbegin() + static_cast<ptrdiff_t>(m_begin);
+    element.emplace(m_buffer, first, first + static_cast<ptrdiff_t>(elementSize));
+  }
+  else {
+    auto wire = ReceiveBufferPool::get().allocate(elementSize);
+    copyOut(*wire);
+    element.emplace(std::move(wire));
+  }
+
+  m_begin = (m_begin + elementSize) % capacity();
+  m_size -= elementSize;
+  if (m_size == 0) {
+    // keep the next receive contiguous
+    m_begin = 0;
+  }
+  return element;
+}
+
+void
+StreamReceiveBuffer::copyOut(span<uint8_t> dest) const
+{
+  BOOST_ASSERT(dest.size() <= m_size);
+  size_t nFirst = std::min(dest.size(), capacity() - m_begin);
+  std::memcpy(dest.data(), m_buffer->data() + m_begin, nFirst);
+  std::memcpy(dest.data() + nFirst, m_buffer->data(), dest.size() - nFirst);
+}
+
+void
+StreamReceiveBuffer::resize(size_t newCapacity)
+{
+  BOOST_ASSERT(newCapacity >= m_size);
+  auto newBuffer = allocateRing(newCapacity);
+  copyOut({newBuffer->data(), m_size});
+  m_buffer = std::move(newBuffer);
+  m_begin = 0;
+}
+
+} // namespace nfd::face
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_STREAM_RECEIVE_BUFFER_HPP
+#define NFD_DAEMON_FACE_STREAM_RECEIVE_BUFFER_HPP
+
+#include "core/common.hpp"
+
+#include <array>
+
+#include <boost/asio/buffer.hpp>
+
+namespace nfd::face {
+
+/** \brief A ring buffer that reassembles TLV elements received from a byte stream.
+ *
+ *  Bytes are received directly into the free space of the ring, which may be split in two
+ *  where the ring wraps around. A complete element that is contiguous in the ring is handed
+ *  over to its Block in place, which then shares the ring; only an element that wraps around
+ *  is copied, into a buffer from ReceiveBufferPool. Before the next receive, a ring that is
+ *  still shared with a Block is replaced by a new one, into which the bytes of the incomplete
+ *  element, if any, are moved.
+ *
+ *  The capacity adapts to the incoming rate: it doubles, up to a maximum, whenever a large
+ *  receive leaves the ring nearly full, and it halves, down to a minimum, after a run of
+ *  receives that used less than a quarter of it. The minimum capacity must be at least
+ *  ndn::MAX_NDN_PACKET_SIZE, so that the largest valid element always fits.
+ */
+class StreamReceiveBuffer : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  explicit
+  StreamReceiveBuffer(size_t minCapacity = ndn::MAX_NDN_PACKET_SIZE,
+                      size_t maxCapacity = 8 * ndn::MAX_NDN_PACKET_SIZE);
+
+  /** \brief Return the free space to receive into, as up to two buffers.
+   *  \pre all complete elements have been extracted
+   */
+  std::array<boost::asio::mutable_buffer, 2>
+  prepare();
+
+  /** \brief Append \p nBytes that have been received into the buffers returned by prepare().
+   */
+  void
+  commit(size_t nBytes);
+
+  /** \brief Remove the first element from the buffer.
+   *  \return the element, or std::nullopt if it has not been received in full
+   *  \throw Error the buffered bytes do not start with a valid TLV header, or the element
+   *               is larger than ndn::MAX_NDN_PACKET_SIZE
+   */
+  std::optional<Block>
+  extract();
+
+  /** \brief Discard all buffered bytes.
+   */
+  void
+  clear() noexcept
+  {
+    m_begin = 0;
+    m_size = 0;
+  }
+
+  /** \return number of buffered bytes
+   */
+  size_t
+  size() const noexcept
+  {
+    return m_size;
+  }
+
+  size_t
+  capacity() const noexcept
+  {
+    return m_buffer->size();
+  }
+
+private:
+  /** \brief Copy the buffered bytes starting at the front into \p dest.
+   */
+  void
+  copyOut(span<uint8_t> dest) const;
+
+  void
+  resize(size_t newCapacity);
+
+public:
+  /// number of consecutive small receives after which the capacity is halved
+  static constexpr size_t SHRINK_AFTER_N_RECEIVES = 64;
+  /// the capacity is doubled when a receive leaves less than 1/GROW_FREE_DIVISOR of it free
+  static constexpr size_t GROW_FREE_DIVISOR = 8;
+
+private:
+  shared_ptr<ndn::Buffer> m_buffer;
+  size_t m_begin = 0; ///< offset of the first buffered byte
+  size_t m_size = 0;
+  const size_t m_minCapacity;
+  const size_t m_maxCapacity;
+  size_t m_nSmallReceives = 0;
+};
+
+} // namespace nfd::face
+
+#endif // NFD_DAEMON_FACE_STREAM_RECEIVE_BUFFER_HPP
@@ -28,13 +28,15 @@
 
 #include "transport.hpp"
 #include "socket-utils.hpp"
+#include "stream-receive-buffer.hpp"
 #include "common/global.hpp"
 
-#include <array>
-#include <queue>
+#include <deque>
+#include <numeric>
 
 #include <boost/asio/defer.hpp>
 #include <boost/asio/write.hpp>
+#include <boost/container/static_vector.hpp>
 
 namespace nfd::face {
 
@@ -42,6 +44,12 @@ namespace nfd::face {
  * \brief Implements a Transport for stream-based protocols.
  *
  * \tparam Protocol a stream-based protocol in Boost.Asio
+ *
+ * Packets queued while a write is in progress are written together by the next write,
+ * which passes up to MAX_SEND_BATCH packets to a single gather-write system call.
+ * Received bytes are reassembled into packets in a StreamReceiveBuffer.
+ *
+ * The send queue is unbounded unless setSendQueueLimit() is called.
  */
 template<class Protocol>
 class StreamTransport : public Transport
@@ -60,7 +68,41 @@ public:
   ssize_t
   getSendQueueLength() override;
 
+  /**
+   * \brief Set the socket buffer sizes of this transport.
+   *
+   * If \p options.maxSendBufferSize exceeds \p options.sendBufferSize, the send buffer is
+   * doubled, up to that limit, whenever a write completes while more packets are queued
+   * and the kernel send queue occupies at least three quarters of the send buffer.
+   */
+  void
+  setSocketBufferOptions(const SocketBufferOptions& options);
+
+  /**
+   * \brief Bound the send queue to \p capacity bytes; zero makes it unbounded.
+   *
+   * A packet is dropped, and counted in nOutDrops, if queuing it would exceed the capacity,
+   * unless the queue is empty.
+   * The queue is congested (see Transport::isSendQueueCongested) from when it exceeds half
+   * of the capacity until it drains to a quarter of it. The capacity is also reported by
+   * getSendQueueCapacity(), so that GenericLinkService starts congestion marking at half of it.
+   */
+  void
+  setSendQueueLimit(size_t capacity);
+
 protected:
+  /**
+   * \brief Apply the socket buffer sizes to the current socket.
+   */
+  void
+  applySocketBufferOptions();
+
+  /**
+   * \brief Grow the send buffer if the kernel send queue is nearly full.
+   */
+  void
+  autoTuneSendBuffer();
+
   void
   doClose() override;
 
@@ -70,6 +112,9 @@ protected:
   void
   doSend(const Block& packet) override;
 
+  /**
+   * \brief Write up to MAX_SEND_BATCH packets from the front of the send queue.
+   */
   void
   sendFromQueue();
 
@@ -99,16 +144,25 @@ protected:
   size_t
   getSendQueueBytes() const;
 
+  void
+  updateSendQueueCongestion();
+
 protected:
   typename protocol::socket m_socket;
 
   NFD_LOG_MEMBER_DECL();
 
 private:
+  /// maximum number of packets in one write, within the IOV_MAX of all supported platforms
+  static constexpr size_t MAX_SEND_BATCH = 64;
+
   size_t m_sendQueueBytes = 0;
-  std::queue<Block> m_sendQueue;
-  size_t m_receiveBufferSize = 0;
-  std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> m_receiveBuffer;
+  size_t m_sendQueueLimit = 0;
+  std::deque<Block> m_sendQueue;
+  size_t m_nPacketsInFlight = 0; ///< number of packets at the front of m_sendQueue being written
+  StreamReceiveBuffer m_receiveBuffer;
+  SocketBufferOptions m_socketBufferOptions;
+  size_t m_sendBufferSize = 0; ///< send buffer size set on the socket, 0 if left to the kernel
 };
 
 
@@ -116,9 +170,8 @@ template<class T>
 StreamTransport<T>::StreamTransport(typename StreamTransport::protocol::socket&& socket)
   : m_socket(std::move(socket))
 {
-  // No queue capacity is set because there is no theoretical limit to the size of m_sendQueue.
-  // Therefore, protecting against send queue overflows is less critical than in other transport
-  // types. Instead, we use the default threshold specified in the GenericLinkService options.
+  // No queue capacity is set until setSendQueueLimit() is called. Until then, GenericLinkService
+  // uses the default congestion threshold specified in its options.
 
   startReceive();
 }
@@ -134,6 +187,73 @@ StreamTransport<T>::getSendQueueLength()
   return getSendQueueBytes() + std::max<ssize_t>(0, queueLength);
 }
 
+template<class T>
+void
+StreamTransport<T>::setSocketBufferOptions(const SocketBufferOptions& options)
+{
+  m_socketBufferOptions = options;
+  applySocketBufferOptions();
+}
+
+template<class T>
+void
+StreamTransport<T>::setSendQueueLimit(size_t capacity)
+{
+  m_sendQueueLimit = capacity;
+  this->setSendQueueCapacity(capacity == 0 ? QUEUE_UNSUPPORTED : static_cast<ssize_t>(capacity));
+  updateSendQueueCongestion();
+}
+
+template<class T>
+void
+StreamTransport<T>::applySocketBufferOptions()
+{
+  boost::system::error_code error;
+  if (m_socketBufferOptions.receiveBufferSize > 0) {
+    m_socket.set_option(boost::asio::socket_base::receive_buffer_size(
+                          static_cast<int>(m_socketBufferOptions.receiveBufferSize)), error);
+    if (error) {
+      NFD_LOG_FACE_WARN("Failed to set socket receive buffer size: " << error.message());
+    }
+  }
+
+  m_sendBufferSize = 0;
+  if (m_socketBufferOptions.sendBufferSize > 0) {
+    m_socket.set_option(boost::asio::socket_base::send_buffer_size(
+                          static_cast<int>(m_socketBufferOptions.sendBufferSize)), error);
+    if (error) {
+      NFD_LOG_FACE_WARN("Failed to set socket send buffer size: " << error.message());
+    }
+    else {
+      m_sendBufferSize = m_socketBufferOptions.sendBufferSize;
+    }
+  }
+}
+
+template<class T>
+void
+StreamTransport<T>::autoTuneSendBuffer()
+{
+  if (m_sendBufferSize == 0 || m_sendBufferSize >= m_socketBufferOptions.maxSendBufferSize)
+    return;
+
+  ssize_t queueLength = getTxQueueLength(m_socket.native_handle());
+  if (queueLength < 0 || static_cast<size_t>(queueLength) < m_sendBufferSize / 4 * 3)
+    return;
+
+  size_t newSize = std::min(m_sendBufferSize * 2, m_socketBufferOptions.maxSendBufferSize);
+  boost::system::error_code error;
+  m_socket.set_option(boost::asio::socket_base::send_buffer_size(static_cast<int>(newSize)), error);
+  if (error) {
+    NFD_LOG_FACE_WARN("Failed to grow socket send buffer: " << error.message());
+    // do not try again
+    m_sendBufferSize = m_socketBufferOptions.maxSendBufferSize;
+    return;
+  }
+  NFD_LOG_FACE_DEBUG("Socket send buffer grown to " << newSize << " bytes, kernel queue " << queueLength);
+  m_sendBufferSize = newSize;
+}
+
 template<class T>
 void
 StreamTransport<T>::doClose()
@@ -191,8 +311,15 @@ StreamTransport<T>::doSend(const Block& packet)
     return;
 
   bool wasQueueEmpty = m_sendQueue.empty();
-  m_sendQueue.push(packet);
+  if (m_sendQueueLimit > 0 && !wasQueueEmpty && m_sendQueueBytes + packet.size() > m_sendQueueLimit) {
+    ++this->nOutDrops;
+    NFD_LOG_FACE_DEBUG("Send queue full, dropping packet of " << packet.size() << " bytes");
+    return;
+  }
+
+  m_sendQueue.push_back(packet);
   m_sendQueueBytes += packet.size();
+  updateSendQueueCongestion();
 
   if (wasQueueEmpty)
     sendFromQueue();
@@ -202,7 +329,18 @@ template<class T>
 void
 StreamTransport<T>::sendFromQueue()
 {
-  boost::asio::async_write(m_socket, boost::asio::buffer(m_sendQueue.front()),
+  BOOST_ASSERT(m_nPacketsInFlight == 0 && !m_sendQueue.empty());
+
+  // copied into the write operation without heap allocation
+  boost::container::static_vector<boost::asio::const_buffer, MAX_SEND_BATCH> buffers;
+  for (const auto& packet : m_sendQueue) {
+    if (buffers.size() == buffers.capacity())
+      break;
+    buffers.emplace_back(packet.data(), packet.size());
+  }
+  m_nPacketsInFlight = buffers.size();
+
+  boost::asio::async_write(m_socket, buffers,
                            [this] (auto&&... args) { this->handleSend(std::forward<decltype(args)>(args)...); });
 }
 
@@ -214,15 +352,21 @@ StreamTransport<T>::handleSend(const boost::system::error_code& error,
   if (error)
     return processErrorCode(error);
 
-  NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes");
+  NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes in " << m_nPacketsInFlight << " packets");
 
-  BOOST_ASSERT(!m_sendQueue.empty());
-  BOOST_ASSERT(m_sendQueue.front().size() == nBytesSent);
+  BOOST_ASSERT(m_nPacketsInFlight > 0 && m_nPacketsInFlight <= m_sendQueue.size());
+  BOOST_ASSERT(std::accumulate(m_sendQueue.begin(), m_sendQueue.begin() + m_nPacketsInFlight, size_t(0),
+                               [] (size_t sum, const Block& packet) { return sum + packet.size(); })
+               == nBytesSent);
   m_sendQueueBytes -= nBytesSent;
-  m_sendQueue.pop();
+  m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + m_nPacketsInFlight);
+  m_nPacketsInFlight = 0;
+  updateSendQueueCongestion();
 
-  if (!m_sendQueue.empty())
+  if (!m_sendQueue.empty()) {
+    autoTuneSendBuffer();
     sendFromQueue();
+  }
 }
 
 template<class T>
@@ -231,8 +375,7 @@ StreamTransport<T>::startReceive()
 {
   BOOST_ASSERT(getState() == TransportState::UP);
 
-  m_socket.async_receive(boost::asio::buffer(m_receiveBuffer.data() + m_receiveBufferSize,
-                                             m_receiveBuffer.size() - m_receiveBufferSize),
+  m_socket.async_receive(m_receiveBuffer.prepare(),
                          [this] (auto&&... args) { this->handleReceive(std::forward<decltype(args)>(args)...); });
 }
 
@@ -246,28 +389,14 @@ StreamTransport<T>::handleReceive(const boost::system::error_code& error,
 
   NFD_LOG_FACE_TRACE("Received: " << nBytesReceived << " bytes");
 
-  m_receiveBufferSize += nBytesReceived;
-  auto unparsedBytes = ndn::make_span(m_receiveBuffer).first(m_receiveBufferSize);
-  while (!unparsedBytes.empty()) {
-    auto [isOk, element] = Block::fromBuffer(unparsedBytes);
-    if (!isOk)
-      break;
-
-    unparsedBytes = unparsedBytes.subspan(element.size());
-    this->receive(element);
-  }
-
-  if (unparsedBytes.empty()) {
-    // nothing left in the receive buffer
-    m_receiveBufferSize = 0;
+  m_receiveBuffer.commit(nBytesReceived);
+  try {
+    while (auto element = m_receiveBuffer.extract()) {
+      this->receive(std::move(*element));
+    }
   }
-  else if (unparsedBytes.data() != m_receiveBuffer.data()) {
-    // move remaining unparsed bytes to the beginning of the receive buffer
-    std::copy(unparsedBytes.begin(), unparsedBytes.end(), m_receiveBuffer.begin());
-    m_receiveBufferSize = unparsedBytes.size();
-  }
-  else if (unparsedBytes.size() == m_receiveBuffer.size()) {
-    NFD_LOG_FACE_ERROR("Failed to parse incoming packet or packet too large to process");
+  catch (const StreamReceiveBuffer::Error& e) {
+    NFD_LOG_FACE_ERROR("Failed to parse incoming packet or packet too large to process: " << e.what());
     this->setState(TransportState::FAILED);
     doClose();
     return;
@@ -311,16 +440,18 @@ template<class T>
 void
 StreamTransport<T>::resetReceiveBuffer()
 {
-  m_receiveBufferSize = 0;
+  m_receiveBuffer.clear();
 }
 
 template<class T>
 void
 StreamTransport<T>::resetSendQueue()
 {
-  std::queue<Block> emptyQueue;
+  std::deque<Block> emptyQueue;
   std::swap(emptyQueue, m_sendQueue);
   m_sendQueueBytes = 0;
+  m_nPacketsInFlight = 0;
+  updateSendQueueCongestion();
 }
 
 template<class T>
@@ -330,6 +461,21 @@ StreamTransport<T>::getSendQueueBytes() const
   return m_sendQueueBytes;
 }
 
+template<class T>
+void
+StreamTransport<T>::updateSendQueueCongestion()
+{
+  if (m_sendQueueLimit == 0) {
+    this->setSendQueueCongested(false);
+  }
+  else if (m_sendQueueBytes > m_sendQueueLimit / 2) {
+    this->setSendQueueCongested(true);
+  }
+  else if (m_sendQueueBytes <= m_sendQueueLimit / 4) {
+    this->setSendQueueCongested(false);
+  }
+}
+
 } // namespace nfd::face
 
 #endif // NFD_DAEMON_FACE_STREAM_TRANSPORT_HPP
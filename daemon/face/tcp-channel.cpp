@@ -26,9 +26,11 @@
 #include "tcp-channel.hpp"
 #include "face.hpp"
 #include "generic-link-service.hpp"
+#include "io-worker.hpp"
 #include "tcp-transport.hpp"
 #include "common/global.hpp"
 
+#include <boost/asio/bind_executor.hpp>
 #include <boost/asio/ip/v6_only.hpp>
 
 namespace nfd::face {
@@ -84,19 +86,25 @@ TcpChannel::connect(const tcp::Endpoint& remoteEndpoint,
     return;
   }
 
-  auto clientSocket = make_shared<ip::tcp::socket>(getGlobalIoService());
+  // the socket is opened on the io_context of the I/O worker that will own the face
+  IoWorker* worker = m_ioWorkers == nullptr ? nullptr : &m_ioWorkers->next();
+  auto clientSocket = make_shared<ip::tcp::socket>(worker == nullptr ? getGlobalIoService() : worker->getIo());
   auto timeoutEvent = getScheduler().schedule(timeout, [=] {
     handleConnectTimeout(remoteEndpoint, clientSocket, onConnectFailed);
   });
 
   NFD_LOG_CHAN_TRACE("Connecting to " << remoteEndpoint);
-  clientSocket->async_connect(remoteEndpoint, [=] (const auto& e) {
-    this->handleConnect(e, remoteEndpoint, clientSocket, params, timeoutEvent, onFaceCreated, onConnectFailed);
-  });
+  // the handler runs in this thread, even if the socket belongs to an I/O worker
+  clientSocket->async_connect(remoteEndpoint, boost::asio::bind_executor(getGlobalIoService(),
+    [=] (const auto& e) {
+      this->handleConnect(e, remoteEndpoint, clientSocket, worker, params, timeoutEvent,
+                          onFaceCreated, onConnectFailed);
+    }));
 }
 
 void
 TcpChannel::createFace(ip::tcp::socket&& socket,
+                       IoWorker* worker,
                        const FaceParams& params,
                        const FaceCreatedCallback& onFaceCreated,
                        const FaceCreationFailedCallback& onFaceCreationFailed)
@@ -133,11 +141,37 @@ TcpChannel::createFace(ip::tcp::socket&& socket,
       options.defaultCongestionThreshold = *params.defaultCongestionThreshold;
     }
 
-    auto linkService = make_unique<GenericLinkService>(options);
     auto faceScope = m_determineFaceScope(socket.local_endpoint().address(),
                                           socket.remote_endpoint().address());
-    auto transport = make_unique<TcpTransport>(std::move(socket), params.persistency, faceScope);
-    face = make_shared<Face>(std::move(linkService), std::move(transport));
+    auto makeFace = [options, persistency = params.persistency, faceScope,
+                     socketBufferOptions = m_socketBufferOptions, sendQueueLimit = m_sendQueueLimit,
+                     socket = std::move(socket)] () mutable {
+      auto linkService = make_unique<GenericLinkService>(options);
+      auto transport = make_unique<TcpTransport>(std::move(socket), persistency, faceScope);
+      transport->setSocketBufferOptions(socketBufferOptions);
+      transport->setSendQueueLimit(sendQueueLimit);
+      return make_shared<Face>(std::move(linkService), std::move(transport));
+    };
+
+    if (worker != nullptr) {
+      // the face is served by the worker; the channel keeps the face that stands for it
+      worker->createFace(std::move(makeFace),
+                         [this, remoteEndpoint, onFaceCreated] (const shared_ptr<Face>& newFace) {
+        auto [pos, isNew] = m_channelFaces.try_emplace(remoteEndpoint, newFace);
+        if (isNew) {
+          newFace->setChannel(weak_from_this());
+          connectFaceClosedSignal(*newFace, [this, remoteEndpoint] { m_channelFaces.erase(remoteEndpoint); });
+        }
+        else {
+          // another face for this endpoint was created meanwhile
+          newFace->close();
+        }
+        onFaceCreated(pos->second);
+      });
+      return;
+    }
+
+    face = makeFace();
     face->setChannel(weak_from_this());
 
     m_channelFaces[remoteEndpoint] = face;
@@ -162,7 +196,10 @@ void
 TcpChannel::accept(const FaceCreatedCallback& onFaceCreated,
                    const FaceCreationFailedCallback& onAcceptFailed)
 {
-  m_acceptor.async_accept([=] (const boost::system::error_code& error, ip::tcp::socket socket) {
+  // the connection is accepted into a socket of the I/O worker that will own the face
+  IoWorker* worker = m_ioWorkers == nullptr ? nullptr : &m_ioWorkers->next();
+  auto& socketIo = worker == nullptr ? getGlobalIoService() : worker->getIo();
+  m_acceptor.async_accept(socketIo, [=] (const boost::system::error_code& error, ip::tcp::socket socket) {
     if (error) {
       if (error != boost::asio::error::operation_aborted) {
         NFD_LOG_CHAN_DEBUG("Accept failed: " << error.message());
@@ -176,7 +213,7 @@ TcpChannel::accept(const FaceCreatedCallback& onFaceCreated,
 
     FaceParams params;
     params.persistency = ndn::nfd::FACE_PERSISTENCY_ON_DEMAND;
-    createFace(std::move(socket), params, onFaceCreated, onAcceptFailed);
+    createFace(std::move(socket), worker, params, onFaceCreated, onAcceptFailed);
 
     // prepare accepting the next connection
     accept(onFaceCreated, onAcceptFailed);
@@ -187,6 +224,7 @@ void
 TcpChannel::handleConnect(const boost::system::error_code& error,
                           const tcp::Endpoint& remoteEndpoint,
                           const shared_ptr<ip::tcp::socket>& socket,
+                          IoWorker* worker,
                           const FaceParams& params,
                           const ndn::scheduler::EventId& connectTimeoutEvent,
                           const FaceCreatedCallback& onFaceCreated,
@@ -204,7 +242,7 @@ TcpChannel::handleConnect(const boost::system::error_code& error,
   }
 
   NFD_LOG_CHAN_TRACE("Connected to " << socket->remote_endpoint());
-  createFace(std::move(*socket), params, onFaceCreated, onConnectFailed);
+  createFace(std::move(*socket), worker, params, onFaceCreated, onConnectFailed);
 }
 
 void
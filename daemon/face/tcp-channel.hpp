@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FACE_TCP_CHANNEL_HPP
 
 #include "channel.hpp"
+#include "socket-utils.hpp"
 
 #include <ndn-cxx/util/scheduler.hpp>
 
@@ -40,6 +41,9 @@ using Endpoint = boost::asio::ip::tcp::endpoint;
 
 namespace nfd::face {
 
+class IoWorker;
+class IoWorkerPool;
+
 using DetermineFaceScopeFromAddress = std::function<ndn::nfd::FaceScope(const boost::asio::ip::address& local,
                                                                         const boost::asio::ip::address& remote)>;
 
@@ -73,6 +77,49 @@ public:
     return m_channelFaces.size();
   }
 
+  const SocketBufferOptions&
+  getSocketBufferOptions() const noexcept
+  {
+    return m_socketBufferOptions;
+  }
+
+  /**
+   * \brief Set the socket buffer sizes of faces created afterwards.
+   */
+  void
+  setSocketBufferOptions(const SocketBufferOptions& options)
+  {
+    m_socketBufferOptions = options;
+  }
+
+  size_t
+  getSendQueueLimit() const noexcept
+  {
+    return m_sendQueueLimit;
+  }
+
+  /**
+   * \brief Set the send queue capacity, in bytes, of faces created afterwards.
+   * \sa StreamTransport::setSendQueueLimit
+   */
+  void
+  setSendQueueLimit(size_t capacity) noexcept
+  {
+    m_sendQueueLimit = capacity;
+  }
+
+  /**
+   * \brief Create the faces of this channel in the threads of \p workers.
+   *
+   * This applies to faces created afterwards. If \p workers is nullptr, faces are created in the
+   * calling thread. Connections are always accepted and established in the calling thread.
+   */
+  void
+  setIoWorkers(IoWorkerPool* workers) noexcept
+  {
+    m_ioWorkers = workers;
+  }
+
   /**
    * \brief Enable listening on the local endpoint, accept connections,
    *        and create faces when remote host makes a connection.
@@ -98,8 +145,12 @@ public:
           time::nanoseconds timeout = 8_s);
 
 private:
+  /**
+   * \param worker the I/O worker whose io_context \p socket was opened on, or nullptr
+   */
   void
   createFace(boost::asio::ip::tcp::socket&& socket,
+             IoWorker* worker,
              const FaceParams& params,
              const FaceCreatedCallback& onFaceCreated,
              const FaceCreationFailedCallback& onFaceCreationFailed);
@@ -112,6 +163,7 @@ private:
   handleConnect(const boost::system::error_code& error,
                 const tcp::Endpoint& remoteEndpoint,
                 const shared_ptr<boost::asio::ip::tcp::socket>& socket,
+                IoWorker* worker,
                 const FaceParams& params,
                 const ndn::scheduler::EventId& connectTimeoutEvent,
                 const FaceCreatedCallback& onFaceCreated,
@@ -128,6 +180,9 @@ private:
   boost::asio::ip::tcp::acceptor m_acceptor;
   std::map<tcp::Endpoint, shared_ptr<Face>> m_channelFaces;
   DetermineFaceScopeFromAddress m_determineFaceScope;
+  SocketBufferOptions m_socketBufferOptions;
+  size_t m_sendQueueLimit = 0;
+  IoWorkerPool* m_ioWorkers = nullptr;
 };
 
 } // namespace nfd::face
@@ -34,6 +34,9 @@ namespace ip = boost::asio::ip;
 NFD_LOG_INIT(TcpFactory);
 NFD_REGISTER_PROTOCOL_FACTORY(TcpFactory);
 
+/// socket buffer sizes are passed to setsockopt() as int, and doubled by the Linux kernel
+constexpr size_t MAX_SOCKET_BUFFER_SIZE = 1 << 30;
+
 const std::string&
 TcpFactory::getId() noexcept
 {
@@ -51,6 +54,10 @@ TcpFactory::doProcessConfig(OptionalConfigSection configSection,
   //   port 6363
   //   enable_v4 yes
   //   enable_v6 yes
+  //   socket_receive_buffer 0
+  //   socket_send_buffer 0
+  //   socket_send_buffer_max 0
+  //   send_queue_capacity 0
   // }
 
   m_wantCongestionMarking = context.generalConfig.wantCongestionMarking;
@@ -66,6 +73,8 @@ TcpFactory::doProcessConfig(OptionalConfigSection configSection,
   uint16_t port = 6363;
   bool enableV4 = true;
   bool enableV6 = true;
+  SocketBufferOptions socketBufferOptions;
+  size_t sendQueueLimit = 0;
   IpAddressPredicate local;
   bool isLocalConfigured = false;
 
@@ -84,6 +93,24 @@ TcpFactory::doProcessConfig(OptionalConfigSection configSection,
     else if (key == "enable_v6") {
       enableV6 = ConfigFile::parseYesNo(pair, "face_system.tcp");
     }
+    else if (key == "socket_receive_buffer") {
+      socketBufferOptions.receiveBufferSize = ConfigFile::parseNumber<size_t>(pair, "face_system.tcp");
+      ConfigFile::checkRange(socketBufferOptions.receiveBufferSize, size_t{0}, MAX_SOCKET_BUFFER_SIZE,
+                             key, "face_system.tcp");
+    }
+    else if (key == "socket_send_buffer") {
+      socketBufferOptions.sendBufferSize = ConfigFile::parseNumber<size_t>(pair, "face_system.tcp");
+      ConfigFile::checkRange(socketBufferOptions.sendBufferSize, size_t{0}, MAX_SOCKET_BUFFER_SIZE,
+                             key, "face_system.tcp");
+    }
+    else if (key == "socket_send_buffer_max") {
+      socketBufferOptions.maxSendBufferSize = ConfigFile::parseNumber<size_t>(pair, "face_system.tcp");
+      ConfigFile::checkRange(socketBufferOptions.maxSendBufferSize, size_t{0}, MAX_SOCKET_BUFFER_SIZE,
+                             key, "face_system.tcp");
+    }
+    else if (key == "send_queue_capacity") {
+      sendQueueLimit = ConfigFile::parseNumber<size_t>(pair, "face_system.tcp");
+    }
     else if (key == "local") {
       isLocalConfigured = true;
       for (const auto& localPair : pair.second) {
@@ -107,6 +134,16 @@ TcpFactory::doProcessConfig(OptionalConfigSection configSection,
     local.assign({{"subnet", "127.0.0.0/8"}, {"subnet", "::1/128"}}, {});
   }
 
+  if (socketBufferOptions.maxSendBufferSize > 0 &&
+      socketBufferOptions.maxSendBufferSize < socketBufferOptions.sendBufferSize) {
+    NDN_THROW(ConfigFile::Error("face_system.tcp.socket_send_buffer_max must not be smaller than "
+                                "face_system.tcp.socket_send_buffer"));
+  }
+  if (socketBufferOptions.maxSendBufferSize > 0 && socketBufferOptions.sendBufferSize == 0) {
+    NDN_THROW(ConfigFile::Error("face_system.tcp.socket_send_buffer_max requires "
+                                "face_system.tcp.socket_send_buffer"));
+  }
+
   if (!enableV4 && !enableV6) {
     NDN_THROW(ConfigFile::Error(
       "IPv4 and IPv6 TCP channels have been disabled. Remove face_system.tcp section to disable "
@@ -119,6 +156,18 @@ TcpFactory::doProcessConfig(OptionalConfigSection configSection,
 
   providedSchemes.insert("tcp");
 
+  // the I/O workers are created at the first configuration and never change
+  m_ioWorkers = context.ioWorkers;
+
+  // socket buffer sizes and send queue capacity apply to faces created after this point,
+  // including on existing channels
+  m_socketBufferOptions = socketBufferOptions;
+  m_sendQueueLimit = sendQueueLimit;
+  for (const auto& [endpoint, channel] : m_channels) {
+    channel->setSocketBufferOptions(m_socketBufferOptions);
+    channel->setSendQueueLimit(m_sendQueueLimit);
+  }
+
   if (enableV4) {
     tcp::Endpoint endpoint(ip::tcp::v4(), port);
     auto v4Channel = this->createChannel(endpoint);
@@ -204,6 +253,9 @@ TcpFactory::createChannel(const tcp::Endpoint& endpoint)
   auto channel = make_shared<TcpChannel>(endpoint, m_wantCongestionMarking, [this] (auto&&... args) {
     return determineFaceScopeFromAddresses(std::forward<decltype(args)>(args)...);
   });
+  channel->setSocketBufferOptions(m_socketBufferOptions);
+  channel->setSendQueueLimit(m_sendQueueLimit);
+  channel->setIoWorkers(m_ioWorkers);
   m_channels[endpoint] = channel;
   return channel;
 }
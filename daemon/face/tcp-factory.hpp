@@ -76,6 +76,9 @@ private:
 
 private:
   bool m_wantCongestionMarking = false;
+  SocketBufferOptions m_socketBufferOptions;
+  size_t m_sendQueueLimit = 0;
+  IoWorkerPool* m_ioWorkers = nullptr;
   std::map<tcp::Endpoint, shared_ptr<TcpChannel>> m_channels;
 
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
@@ -161,6 +161,7 @@ TcpTransport::handleReconnect(const boost::system::error_code& error)
   m_nextReconnectWait = INITIAL_RECONNECT_DELAY;
 
   this->setLocalUri(FaceUri(m_socket.local_endpoint()));
+  this->applySocketBufferOptions();
   NFD_LOG_FACE_TRACE("TCP connection reestablished");
   this->setState(TransportState::UP);
   this->startReceive();
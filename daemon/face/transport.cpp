@@ -163,6 +163,7 @@ Transport::setPersistency(ndn::nfd::FacePersistency newPersistency)
   if (oldPersistency != ndn::nfd::FACE_PERSISTENCY_NONE) {
     NFD_LOG_FACE_INFO("setPersistency " << oldPersistency << " -> " << newPersistency);
     this->afterChangePersistency(oldPersistency);
+    afterPersistencyChange(oldPersistency, newPersistency);
   }
 }
 
@@ -211,6 +212,18 @@ Transport::setState(TransportState newState)
   // the Transport may be deallocated in the signal handler if newState is CLOSED
 }
 
+void
+Transport::setSendQueueCongested(bool isCongested)
+{
+  if (m_isSendQueueCongested == isCongested) {
+    return;
+  }
+
+  NFD_LOG_FACE_DEBUG("send queue " << (isCongested ? "congested" : "no longer congested"));
+  m_isSendQueueCongested = isCongested;
+  afterSendQueueCongestionChange(isCongested);
+}
+
 std::ostream&
 operator<<(std::ostream& os, const FaceLogHelper<Transport>& flh)
 {
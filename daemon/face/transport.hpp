@@ -93,6 +93,14 @@ public:
    * This counter is increased only when the transport is UP.
    */
   ByteCounter nOutBytes;
+
+  /**
+   * \brief Count of outgoing packets dropped by the transport.
+   *
+   * A packet is dropped when the send queue or transmit ring of the transport has no room
+   * for it. Such a packet is still counted in nOutPackets.
+   */
+  PacketCounter nOutDrops;
 };
 
 /**
@@ -256,6 +264,12 @@ public: // static properties
   void
   setPersistency(ndn::nfd::FacePersistency newPersistency);
 
+  /**
+   * \brief Called when the persistency setting changes.
+   */
+  signal::Signal<Transport, ndn::nfd::FacePersistency /*old*/,
+                 ndn::nfd::FacePersistency /*new*/> afterPersistencyChange;
+
   /**
    * \brief Returns the link type of the transport.
    */
@@ -328,6 +342,24 @@ public: // dynamic properties
     return QUEUE_UNSUPPORTED;
   }
 
+  /**
+   * \brief Returns whether the send queue is congested.
+   *
+   * A transport with a bounded send queue enters this state when the queue grows above its
+   * high watermark, and leaves it when the queue drains below its low watermark.
+   * Other transports are never congested.
+   */
+  bool
+  isSendQueueCongested() const noexcept
+  {
+    return m_isSendQueueCongested;
+  }
+
+  /**
+   * \brief Called when the send queue enters or leaves the congested state.
+   */
+  signal::Signal<Transport, bool /*isCongested*/> afterSendQueueCongestionChange;
+
 protected: // upper interface to be invoked by subclass
   /**
    * \brief Pass a received link-layer packet to the upper layer for further processing.
@@ -372,6 +404,12 @@ protected: // properties to be set by subclass
     m_sendQueueCapacity = sendQueueCapacity;
   }
 
+  /** \brief Set whether the send queue is congested, notifying afterSendQueueCongestionChange
+   *         if this changes.
+   */
+  void
+  setSendQueueCongested(bool isCongested);
+
   /** \brief Set transport state.
    *
    *  Only the following transitions are valid:
@@ -436,6 +474,7 @@ private:
   ndn::nfd::LinkType m_linkType = ndn::nfd::LINK_TYPE_NONE;
   ssize_t m_mtu = MTU_INVALID;
   ssize_t m_sendQueueCapacity = QUEUE_UNSUPPORTED;
+  bool m_isSendQueueCongested = false;
   TransportState m_state = TransportState::UP;
   time::steady_clock::time_point m_expirationTime = time::steady_clock::time_point::max();
 };
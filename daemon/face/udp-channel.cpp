@@ -24,13 +24,23 @@
  */
 
 #include "udp-channel.hpp"
+#include "datagram-batch.hpp"
 #include "face.hpp"
 #include "generic-link-service.hpp"
+#include "io-worker.hpp"
+#include "receive-buffer-pool.hpp"
 #include "unicast-udp-transport.hpp"
 #include "common/global.hpp"
 
+#include <cstring>
+
 #include <boost/asio/ip/v6_only.hpp>
 
+#ifdef __linux__
+#include <linux/filter.h>
+#include <sys/socket.h>
+#endif
+
 namespace nfd::face {
 
 namespace ip = boost::asio::ip;
@@ -40,23 +50,74 @@ NFD_LOG_INIT(UdpChannel);
 UdpChannel::UdpChannel(const udp::Endpoint& localEndpoint,
                        time::nanoseconds idleTimeout,
                        bool wantCongestionMarking,
-                       size_t defaultMtu)
+                       size_t defaultMtu,
+                       size_t batchSize,
+                       DatagramIoBackend ioBackend)
   : m_localEndpoint(localEndpoint)
-  , m_socket(getGlobalIoService())
   , m_idleFaceTimeout(idleTimeout)
   , m_wantCongestionMarking(wantCongestionMarking)
+  , m_batchSize(batchSize)
+  , m_ioBackend(ioBackend)
 {
+  BOOST_ASSERT(m_batchSize >= 1 && m_batchSize <= MAX_DATAGRAM_BATCH_SIZE);
   setUri(FaceUri(m_localEndpoint));
   setDefaultMtu(defaultMtu);
   NFD_LOG_CHAN_INFO("Creating channel");
 }
 
+void
+UdpChannel::setIoWorkers(IoWorkerPool* workers)
+{
+  BOOST_ASSERT(!isListening() && m_channelFaces.empty());
+
+  m_ioWorkers = workers;
+  m_workerStates.clear();
+  if (workers == nullptr) {
+    return;
+  }
+
+  for (size_t i = 0; i < workers->size(); ++i) {
+    auto state = make_shared<WorkerState>();
+    (*workers)[i].atStop([state] {
+      state->listenSockets.clear();
+      state->faces.clear();
+    });
+    m_workerStates.push_back(std::move(state));
+  }
+}
+
 void
 UdpChannel::connect(const udp::Endpoint& remoteEndpoint,
                     const FaceParams& params,
                     const FaceCreatedCallback& onFaceCreated,
                     const FaceCreationFailedCallback& onConnectFailed)
 {
+  if (m_ioWorkers != nullptr) {
+    if (auto it = m_channelFaces.find(remoteEndpoint); it != m_channelFaces.end()) {
+      onFaceCreated(it->second);
+      return;
+    }
+
+    IoWorker& worker = m_ioWorkers->next();
+    worker.createFace([this, &worker, remoteEndpoint, params, onConnectFailed] () -> shared_ptr<Face> {
+      try {
+        return createWorkerFace(worker, remoteEndpoint, params).second;
+      }
+      catch (const boost::system::system_error& e) {
+        NFD_LOG_CHAN_DEBUG("Face creation for " << remoteEndpoint << " failed: " << e.what());
+        worker.postToMain([onConnectFailed, what = std::string(e.what())] (IoWorker&) {
+          if (onConnectFailed)
+            onConnectFailed(504, "Face creation failed: " + what);
+        });
+        return nullptr;
+      }
+    },
+    [this, remoteEndpoint, onFaceCreated] (const shared_ptr<Face>& proxy) {
+      onFaceCreated(addProxyFace(remoteEndpoint, proxy).second);
+    });
+    return;
+  }
+
   shared_ptr<Face> face;
   try {
     face = createFace(remoteEndpoint, params).second;
@@ -73,37 +134,149 @@ UdpChannel::connect(const udp::Endpoint& remoteEndpoint,
   onFaceCreated(face);
 }
 
+UdpChannel::ListenSocket::ListenSocket(boost::asio::io_context& io)
+  : socket(io)
+  , receiveBuffer(ReceiveBufferPool::get().allocateReceiveBuffer())
+{
+}
+
 void
 UdpChannel::listen(const FaceCreatedCallback& onFaceCreated,
-                   const FaceCreationFailedCallback& onFaceCreationFailed)
+                   const FaceCreationFailedCallback& onFaceCreationFailed,
+                   size_t nSockets,
+                   Steering steering)
 {
+  BOOST_ASSERT(nSockets >= 1 && nSockets <= MAX_UDP_LISTEN_SOCKETS);
+
   if (isListening()) {
     NFD_LOG_CHAN_WARN("Already listening");
     return;
   }
 
-  m_socket.open(m_localEndpoint.protocol());
-  m_socket.set_option(boost::asio::socket_base::reuse_address(true));
-  if (m_localEndpoint.address().is_v6()) {
-    m_socket.set_option(ip::v6_only(true));
+#ifndef __linux__
+  if (nSockets > 1) {
+    NFD_LOG_CHAN_WARN("Multiple listening sockets require Linux, using one socket");
+    nSockets = 1;
   }
-  m_socket.bind(m_localEndpoint);
+#endif
 
-  waitForNewPeer(onFaceCreated, onFaceCreationFailed);
-  NFD_LOG_CHAN_DEBUG("Started listening");
+  std::vector<unique_ptr<ListenSocket>> sockets;
+  for (size_t i = 0; i < nSockets; ++i) {
+    // the sockets are spread among the I/O workers, if any
+    IoWorker* worker = m_ioWorkers == nullptr ? nullptr : &(*m_ioWorkers)[i % m_ioWorkers->size()];
+    auto sock = make_unique<ListenSocket>(worker == nullptr ? getGlobalIoService() : worker->getIo());
+    sock->worker = worker;
+    sock->socket.open(m_localEndpoint.protocol());
+    sock->socket.set_option(boost::asio::socket_base::reuse_address(true));
+#ifdef __linux__
+    if (nSockets > 1) {
+      // the on-demand faces bind without SO_REUSEPORT, so they stay out of the
+      // reuseport group and, being connected, take precedence over these sockets
+      int one = 1;
+      if (::setsockopt(sock->socket.native_handle(), SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) < 0) {
+        NDN_THROW(boost::system::system_error(errno, boost::system::system_category(),
+                                              "setsockopt(SO_REUSEPORT)"));
+      }
+    }
+#endif
+    if (m_localEndpoint.address().is_v6()) {
+      sock->socket.set_option(ip::v6_only(true));
+    }
+    // the position of each socket in the reuseport group follows the order of bind()
+    sock->socket.bind(m_localEndpoint);
+    sockets.push_back(std::move(sock));
+  }
+
+  if (nSockets > 1 && steering != Steering::HASH) {
+    attachSteeringProgram(sockets, steering);
+  }
+
+  m_nListenSockets = nSockets;
+  for (auto& sock : sockets) {
+    IoWorker* worker = sock->worker;
+    if (worker == nullptr) {
+      waitForNewPeer(*sock, onFaceCreated, onFaceCreationFailed);
+      m_listenSockets.push_back(std::move(sock));
+      continue;
+    }
+
+    // receive failures are reported in this thread, and so are on-demand faces by dispatchDatagram()
+    auto onFailed = [worker, onFaceCreationFailed] (uint32_t status, const std::string& reason) {
+      worker->postToMain([=] (IoWorker&) {
+        if (onFaceCreationFailed)
+          onFaceCreationFailed(status, reason);
+      });
+    };
+    auto& workerSockets = m_workerStates[worker->getIndex()]->listenSockets;
+    workerSockets.push_back(std::move(sock));
+    boost::asio::post(worker->getIo(), [this, &sock = *workerSockets.back(), onFaceCreated, onFailed] {
+      waitForNewPeer(sock, onFaceCreated, onFailed);
+    });
+  }
+  NFD_LOG_CHAN_DEBUG("Started listening on " << nSockets << " socket(s)");
+}
+
+void
+UdpChannel::attachSteeringProgram(const std::vector<unique_ptr<ListenSocket>>& sockets, Steering steering)
+{
+  BOOST_ASSERT(steering == Steering::SOURCE);
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+  // The program returns the index of the socket in the reuseport group. The packet data
+  // starts at the UDP payload, so the source address is loaded relative to the network header.
+  auto loadNetWord = [] (int offset) {
+    return sock_filter BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_NET_OFF + offset));
+  };
+  std::vector<sock_filter> code;
+  if (m_localEndpoint.address().is_v4()) {
+    code.push_back(loadNetWord(12)); // A = source address
+  }
+  else {
+    // A = XOR of the four words of the source address
+    code.push_back(loadNetWord(8));
+    for (int offset = 12; offset <= 20; offset += 4) {
+      code.push_back(BPF_STMT(BPF_MISC | BPF_TAX, 0));
+      code.push_back(loadNetWord(offset));
+      code.push_back(BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0));
+    }
+  }
+  code.push_back(BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, static_cast<uint32_t>(sockets.size())));
+  code.push_back(BPF_STMT(BPF_RET | BPF_A, 0));
+
+  sock_fprog prog{static_cast<unsigned short>(code.size()), code.data()};
+  // the program applies to the whole group, so attaching it to one socket suffices
+  if (::setsockopt(sockets.front()->socket.native_handle(), SOL_SOCKET,
+                   SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) < 0) {
+    NFD_LOG_CHAN_WARN("setsockopt(SO_ATTACH_REUSEPORT_CBPF) failed: " << std::strerror(errno)
+                      << ", steering by hash");
+    return;
+  }
+  NFD_LOG_CHAN_DEBUG("Steering new peers by source address");
+#else
+  NFD_LOG_CHAN_WARN("Steering by source address is not supported on this platform, steering by hash");
+#endif
 }
 
 void
-UdpChannel::waitForNewPeer(const FaceCreatedCallback& onFaceCreated,
+UdpChannel::waitForNewPeer(ListenSocket& sock,
+                           const FaceCreatedCallback& onFaceCreated,
                            const FaceCreationFailedCallback& onReceiveFailed)
 {
-  m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_remoteEndpoint, [=] (auto&&... args) {
-    handleNewPeer(std::forward<decltype(args)>(args)..., onFaceCreated, onReceiveFailed);
+  if (m_batchSize > 1) {
+    sock.socket.async_wait(boost::asio::socket_base::wait_read, [=, &sock] (const auto& error) {
+      handleReadable(sock, error, onFaceCreated, onReceiveFailed);
+    });
+    return;
+  }
+
+  sock.socket.async_receive_from(boost::asio::buffer(*sock.receiveBuffer), sock.remoteEndpoint,
+                                 [=, &sock] (auto&&... args) {
+    handleNewPeer(sock, std::forward<decltype(args)>(args)..., onFaceCreated, onReceiveFailed);
   });
 }
 
 void
-UdpChannel::handleNewPeer(const boost::system::error_code& error,
+UdpChannel::handleNewPeer(ListenSocket& sock,
+                          const boost::system::error_code& error,
                           size_t nBytesReceived,
                           const FaceCreatedCallback& onFaceCreated,
                           const FaceCreationFailedCallback& onReceiveFailed)
@@ -117,7 +290,55 @@ UdpChannel::handleNewPeer(const boost::system::error_code& error,
     return;
   }
 
-  NFD_LOG_CHAN_TRACE("New peer " << m_remoteEndpoint);
+  if (dispatchDatagram(sock.worker, sock.remoteEndpoint,
+                       ReceiveBufferPool::get().adopt(sock.receiveBuffer, nBytesReceived),
+                       onFaceCreated, onReceiveFailed))
+    waitForNewPeer(sock, onFaceCreated, onReceiveFailed);
+}
+
+void
+UdpChannel::handleReadable(ListenSocket& sock,
+                           const boost::system::error_code& error,
+                           const FaceCreatedCallback& onFaceCreated,
+                           const FaceCreationFailedCallback& onReceiveFailed)
+{
+  auto& receiver = DatagramBatchReceiver::getThreadInstance();
+  boost::system::error_code recvError = error;
+  size_t nReceived = 0;
+  if (!recvError) {
+    nReceived = receiver.receive(sock.socket.native_handle(), m_batchSize, recvError);
+    if (recvError == boost::asio::error::would_block)
+      recvError.clear();
+  }
+
+  if (recvError) {
+    if (recvError != boost::asio::error::operation_aborted) {
+      NFD_LOG_CHAN_DEBUG("Receive failed: " << recvError.message());
+      if (onReceiveFailed)
+        onReceiveFailed(500, "Receive failed: " + recvError.message());
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < nReceived; ++i) {
+    std::memcpy(sock.remoteEndpoint.data(), receiver.getSource(i), receiver.getSourceLength(i));
+    sock.remoteEndpoint.resize(receiver.getSourceLength(i));
+    if (!dispatchDatagram(sock.worker, sock.remoteEndpoint, receiver.takePayload(i),
+                          onFaceCreated, onReceiveFailed))
+      return;
+  }
+
+  waitForNewPeer(sock, onFaceCreated, onReceiveFailed);
+}
+
+bool
+UdpChannel::dispatchDatagram(IoWorker* worker,
+                             const udp::Endpoint& remoteEndpoint,
+                             ndn::ConstBufferPtr payload,
+                             const FaceCreatedCallback& onFaceCreated,
+                             const FaceCreationFailedCallback& onReceiveFailed)
+{
+  NFD_LOG_CHAN_TRACE("New peer " << remoteEndpoint);
 
   bool isCreated = false;
   shared_ptr<Face> face;
@@ -125,40 +346,39 @@ UdpChannel::handleNewPeer(const boost::system::error_code& error,
     FaceParams params;
     params.persistency = ndn::nfd::FACE_PERSISTENCY_ON_DEMAND;
     params.mtu = getDefaultMtu();
-    std::tie(isCreated, face) = createFace(m_remoteEndpoint, params);
+    std::tie(isCreated, face) = worker == nullptr ? createFace(remoteEndpoint, params) :
+                                                    createWorkerFace(*worker, remoteEndpoint, params);
   }
   catch (const boost::system::system_error& e) {
-    NFD_LOG_CHAN_DEBUG("Face creation for " << m_remoteEndpoint << " failed: " << e.what());
+    NFD_LOG_CHAN_DEBUG("Face creation for " << remoteEndpoint << " failed: " << e.what());
     if (onReceiveFailed)
       onReceiveFailed(504, "Face creation failed: "s + e.what());
-    return;
+    return false;
   }
 
-  if (isCreated)
+  if (isCreated && worker != nullptr) {
+    worker->adoptFace(face, [this, remoteEndpoint, onFaceCreated] (const shared_ptr<Face>& proxy) {
+      if (addProxyFace(remoteEndpoint, proxy).first)
+        onFaceCreated(proxy);
+    });
+  }
+  else if (isCreated)
     onFaceCreated(face);
   else
     NFD_LOG_CHAN_DEBUG("Received datagram for existing face");
 
   // dispatch the datagram to the face for processing
   auto* transport = static_cast<UnicastUdpTransport*>(face->getTransport());
-  transport->receiveDatagram(ndn::span(m_receiveBuffer).first(nBytesReceived), error);
-
-  waitForNewPeer(onFaceCreated, onReceiveFailed);
+  transport->receiveDatagram(std::move(payload), {});
+  return true;
 }
 
-std::pair<bool, shared_ptr<Face>>
-UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
-                       const FaceParams& params)
+shared_ptr<Face>
+UdpChannel::makeFace(boost::asio::io_context& io,
+                     const udp::Endpoint& remoteEndpoint,
+                     const FaceParams& params) const
 {
-  auto it = m_channelFaces.find(remoteEndpoint);
-  if (it != m_channelFaces.end()) {
-    // we already have a face for this endpoint, so reuse it
-    NFD_LOG_CHAN_TRACE("Reusing existing face for " << remoteEndpoint);
-    return {false, it->second};
-  }
-
-  // else, create a new face
-  ip::udp::socket socket(getGlobalIoService(), m_localEndpoint.protocol());
+  ip::udp::socket socket(io, m_localEndpoint.protocol());
   socket.set_option(boost::asio::socket_base::reuse_address(true));
   socket.bind(m_localEndpoint);
   socket.connect(remoteEndpoint);
@@ -187,8 +407,23 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
 
   auto linkService = make_unique<GenericLinkService>(options);
   auto transport = make_unique<UnicastUdpTransport>(std::move(socket), params.persistency,
-                                                    m_idleFaceTimeout);
-  auto face = make_shared<Face>(std::move(linkService), std::move(transport));
+                                                    m_idleFaceTimeout, m_batchSize, m_ioBackend);
+  return make_shared<Face>(std::move(linkService), std::move(transport));
+}
+
+std::pair<bool, shared_ptr<Face>>
+UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
+                       const FaceParams& params)
+{
+  auto it = m_channelFaces.find(remoteEndpoint);
+  if (it != m_channelFaces.end()) {
+    // we already have a face for this endpoint, so reuse it
+    NFD_LOG_CHAN_TRACE("Reusing existing face for " << remoteEndpoint);
+    return {false, it->second};
+  }
+
+  // else, create a new face
+  auto face = makeFace(getGlobalIoService(), remoteEndpoint, params);
   face->setChannel(weak_from_this());
 
   m_channelFaces[remoteEndpoint] = face;
@@ -197,4 +432,41 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint,
   return {true, face};
 }
 
+std::pair<bool, shared_ptr<Face>>
+UdpChannel::createWorkerFace(IoWorker& worker,
+                             const udp::Endpoint& remoteEndpoint,
+                             const FaceParams& params)
+{
+  // the kernel steers the datagrams of a peer to the same listening socket, hence the same
+  // worker; a face created by connect() in another worker is deduplicated by addProxyFace()
+  auto& faces = m_workerStates[worker.getIndex()]->faces;
+  auto it = faces.find(remoteEndpoint);
+  if (it != faces.end()) {
+    NFD_LOG_CHAN_TRACE("Reusing existing face for " << remoteEndpoint);
+    return {false, it->second};
+  }
+
+  auto face = makeFace(worker.getIo(), remoteEndpoint, params);
+  faces[remoteEndpoint] = face;
+  connectFaceClosedSignal(*face, [&faces, remoteEndpoint] { faces.erase(remoteEndpoint); });
+
+  return {true, face};
+}
+
+std::pair<bool, shared_ptr<Face>>
+UdpChannel::addProxyFace(const udp::Endpoint& remoteEndpoint, const shared_ptr<Face>& proxy)
+{
+  auto [pos, isNew] = m_channelFaces.try_emplace(remoteEndpoint, proxy);
+  if (isNew) {
+    proxy->setChannel(weak_from_this());
+    connectFaceClosedSignal(*proxy, [this, remoteEndpoint] { m_channelFaces.erase(remoteEndpoint); });
+  }
+  else if (pos->second != proxy) {
+    // another face for this endpoint was created meanwhile, in another worker
+    NFD_LOG_CHAN_DEBUG("Closing duplicate face for " << remoteEndpoint);
+    proxy->close();
+  }
+  return {isNew, pos->second};
+}
+
 } // namespace nfd::face
@@ -27,34 +27,57 @@
 #define NFD_DAEMON_FACE_UDP_CHANNEL_HPP
 
 #include "channel.hpp"
+#include "datagram-transport.hpp"
 #include "udp-protocol.hpp"
 
-#include <array>
 #include <map>
 
 namespace nfd::face {
 
+class IoWorker;
+class IoWorkerPool;
+
+/**
+ * \brief Maximum number of listening sockets of a UdpChannel.
+ */
+inline constexpr size_t MAX_UDP_LISTEN_SOCKETS = 64;
+
 /**
  * \brief Class implementing a UDP-based channel to create faces.
  */
 class UdpChannel final : public Channel
 {
 public:
+  /**
+   * \brief How the kernel distributes datagrams from new peers among the listening sockets.
+   */
+  enum class Steering {
+    HASH,   ///< by the kernel's hash of the source and destination addresses and ports
+    SOURCE, ///< by the source address only, with a BPF program attached to the sockets
+  };
+
   /**
    * \brief Create a UDP channel on the given \p localEndpoint.
    *
    * To enable the creation of faces upon incoming connections, one needs to
    * explicitly call listen(). The created socket is bound to \p localEndpoint.
+   *
+   * If \p batchSize is greater than one, the listening socket and the faces created by
+   * this channel receive and send up to that many datagrams per system call.
+   * \p ioBackend applies to the faces created by this channel; the listening socket
+   * always uses Boost.Asio.
    */
   UdpChannel(const udp::Endpoint& localEndpoint,
              time::nanoseconds idleTimeout,
              bool wantCongestionMarking,
-             size_t defaultMtu);
+             size_t defaultMtu,
+             size_t batchSize = 1,
+             DatagramIoBackend ioBackend = DatagramIoBackend::ASIO);
 
   bool
   isListening() const final
   {
-    return m_socket.is_open();
+    return m_nListenSockets > 0;
   }
 
   size_t
@@ -63,6 +86,17 @@ public:
     return m_channelFaces.size();
   }
 
+  /**
+   * \brief Serve the listening sockets and the faces of this channel in the threads of \p workers.
+   *
+   * Each listening socket belongs to a worker, in round-robin order, and so do the faces it
+   * creates; faces created by connect() belong to the next worker of the pool. size() counts the
+   * faces that stand for them in the calling thread. This must be called before listen() or
+   * connect(), and the channel must be destroyed after the pool.
+   */
+  void
+  setIoWorkers(IoWorkerPool* workers);
+
   /**
    * \brief Create a unicast UDP face toward \p remoteEndpoint.
    */
@@ -80,36 +114,132 @@ public:
    *
    * Faces created in this way will have on-demand persistency.
    *
+   * If \p nSockets is greater than one, that many sockets are bound to the local endpoint
+   * with SO_REUSEPORT, and the kernel distributes the datagrams from peers that do not have
+   * a face yet among them according to \p steering. Each socket has its own receive queue,
+   * so that datagrams received on different CPUs do not contend for a single socket.
+   * This requires Linux.
+   *
    * \param onFaceCreated Callback to notify successful creation of a face
    * \param onFaceCreationFailed Callback to notify errors
+   * \param nSockets Number of listening sockets, between 1 and MAX_UDP_LISTEN_SOCKETS
+   * \param steering How datagrams are distributed among the listening sockets
    */
   void
   listen(const FaceCreatedCallback& onFaceCreated,
-         const FaceCreationFailedCallback& onFaceCreationFailed);
+         const FaceCreationFailedCallback& onFaceCreationFailed,
+         size_t nSockets = 1,
+         Steering steering = Steering::HASH);
+
+  /**
+   * \brief Return the number of listening sockets.
+   */
+  size_t
+  getNListenSockets() const noexcept
+  {
+    return m_nListenSockets;
+  }
 
 private:
+  /**
+   * \brief A socket used to "accept" new peers.
+   */
+  struct ListenSocket
+  {
+    explicit
+    ListenSocket(boost::asio::io_context& io);
+
+    boost::asio::ip::udp::socket socket;
+    shared_ptr<ndn::Buffer> receiveBuffer; ///< from ReceiveBufferPool
+    udp::Endpoint remoteEndpoint; ///< The latest peer that started communicating with us
+    IoWorker* worker = nullptr; ///< The I/O worker that serves this socket, if any
+  };
+
+  /**
+   * \brief The listening sockets and the faces of this channel that belong to an I/O worker.
+   *
+   * Accessed only in the thread of that worker, which destroys them when it stops.
+   */
+  struct WorkerState
+  {
+    std::vector<unique_ptr<ListenSocket>> listenSockets;
+    std::map<udp::Endpoint, shared_ptr<Face>> faces;
+  };
+
   void
-  waitForNewPeer(const FaceCreatedCallback& onFaceCreated,
+  attachSteeringProgram(const std::vector<unique_ptr<ListenSocket>>& sockets, Steering steering);
+
+  void
+  waitForNewPeer(ListenSocket& sock,
+                 const FaceCreatedCallback& onFaceCreated,
                  const FaceCreationFailedCallback& onReceiveFailed);
 
   void
-  handleNewPeer(const boost::system::error_code& error,
+  handleNewPeer(ListenSocket& sock,
+                const boost::system::error_code& error,
                 size_t nBytesReceived,
                 const FaceCreatedCallback& onFaceCreated,
                 const FaceCreationFailedCallback& onReceiveFailed);
 
+  void
+  handleReadable(ListenSocket& sock,
+                 const boost::system::error_code& error,
+                 const FaceCreatedCallback& onFaceCreated,
+                 const FaceCreationFailedCallback& onReceiveFailed);
+
+  /**
+   * \brief Dispatch a datagram from \p remoteEndpoint to its face, creating the face if needed.
+   * \return false if the face cannot be created
+   */
+  bool
+  dispatchDatagram(IoWorker* worker,
+                   const udp::Endpoint& remoteEndpoint,
+                   ndn::ConstBufferPtr payload,
+                   const FaceCreatedCallback& onFaceCreated,
+                   const FaceCreationFailedCallback& onReceiveFailed);
+
+  /**
+   * \brief Create a face whose socket is opened on \p io, without adding it to the channel.
+   */
+  shared_ptr<Face>
+  makeFace(boost::asio::io_context& io,
+           const udp::Endpoint& remoteEndpoint,
+           const FaceParams& params) const;
+
   std::pair<bool, shared_ptr<Face>>
   createFace(const udp::Endpoint& remoteEndpoint,
              const FaceParams& params);
 
+  /**
+   * \brief Find or create the face toward \p remoteEndpoint that belongs to \p worker.
+   *
+   * Must be called in the thread of \p worker.
+   */
+  std::pair<bool, shared_ptr<Face>>
+  createWorkerFace(IoWorker& worker,
+                   const udp::Endpoint& remoteEndpoint,
+                   const FaceParams& params);
+
+  /**
+   * \brief Add \p proxy, which stands for a face of an I/O worker, to the channel.
+   * \return whether \p proxy was added, and the face of the channel toward \p remoteEndpoint
+   *
+   * If the channel has another face toward \p remoteEndpoint, \p proxy is closed.
+   */
+  std::pair<bool, shared_ptr<Face>>
+  addProxyFace(const udp::Endpoint& remoteEndpoint, const shared_ptr<Face>& proxy);
+
 private:
   const udp::Endpoint m_localEndpoint;
-  udp::Endpoint m_remoteEndpoint; ///< The latest peer that started communicating with us
-  boost::asio::ip::udp::socket m_socket; ///< Socket used to "accept" new peers
-  std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> m_receiveBuffer;
+  std::vector<unique_ptr<ListenSocket>> m_listenSockets; ///< served by the calling thread
+  size_t m_nListenSockets = 0;
   std::map<udp::Endpoint, shared_ptr<Face>> m_channelFaces;
+  IoWorkerPool* m_ioWorkers = nullptr;
+  std::vector<shared_ptr<WorkerState>> m_workerStates; ///< indexed by IoWorker::getIndex()
   const time::nanoseconds m_idleFaceTimeout; ///< Timeout for automatic closure of idle on-demand faces
   const bool m_wantCongestionMarking;
+  const size_t m_batchSize;
+  const DatagramIoBackend m_ioBackend;
 };
 
 } // namespace nfd::face
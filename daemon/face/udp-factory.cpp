@@ -24,6 +24,7 @@
  */
 
 #include "udp-factory.hpp"
+#include "datagram-batch.hpp"
 #include "generic-link-service.hpp"
 #include "multicast-udp-transport.hpp"
 #include "common/global.hpp"
@@ -63,11 +64,15 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
   // udp
   // {
   //   listen yes
+  //   listen_sockets 1
+  //   listen_steering hash
   //   port 6363
   //   enable_v4 yes
   //   enable_v6 yes
   //   idle_timeout 600
   //   unicast_mtu 8800
+  //   io_batch_size 1
+  //   io_backend asio
   //   mcast yes
   //   mcast_group 224.0.23.170
   //   mcast_port 56363
@@ -86,11 +91,15 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
   m_wantCongestionMarking = context.generalConfig.wantCongestionMarking;
 
   bool wantListen = true;
+  size_t nListenSockets = 1;
+  UdpChannel::Steering listenSteering = UdpChannel::Steering::HASH;
   uint16_t port = 6363;
   bool enableV4 = false;
   bool enableV6 = false;
   uint32_t idleTimeout = 600;
   size_t unicastMtu = ndn::MAX_NDN_PACKET_SIZE;
+  size_t ioBatchSize = 1;
+  DatagramIoBackend ioBackend = DatagramIoBackend::ASIO;
   MulticastConfig mcastConfig;
 
   if (configSection) {
@@ -104,6 +113,29 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
       if (key == "listen") {
         wantListen = ConfigFile::parseYesNo(pair, "face_system.udp");
       }
+      else if (key == "listen_sockets") {
+        nListenSockets = ConfigFile::parseNumber<size_t>(pair, "face_system.udp");
+        ConfigFile::checkRange(nListenSockets, size_t{1}, MAX_UDP_LISTEN_SOCKETS,
+                               "listen_sockets", "face_system.udp");
+#ifndef __linux__
+        if (nListenSockets > 1) {
+          NDN_THROW(ConfigFile::Error("face_system.udp.listen_sockets: multiple sockets require Linux"));
+        }
+#endif
+      }
+      else if (key == "listen_steering") {
+        const std::string& valueStr = value.get_value<std::string>();
+        if (valueStr == "hash") {
+          listenSteering = UdpChannel::Steering::HASH;
+        }
+        else if (valueStr == "source") {
+          listenSteering = UdpChannel::Steering::SOURCE;
+        }
+        else {
+          NDN_THROW(ConfigFile::Error("face_system.udp.listen_steering: '" + valueStr +
+                                      "' is not a valid steering mode"));
+        }
+      }
       else if (key == "port") {
         port = ConfigFile::parseNumber<uint16_t>(pair, "face_system.udp");
       }
@@ -121,6 +153,28 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
         ConfigFile::checkRange(unicastMtu, static_cast<size_t>(MIN_MTU), ndn::MAX_NDN_PACKET_SIZE,
                                "unicast_mtu", "face_system.udp");
       }
+      else if (key == "io_batch_size") {
+        ioBatchSize = ConfigFile::parseNumber<size_t>(pair, "face_system.udp");
+        ConfigFile::checkRange(ioBatchSize, size_t{1}, MAX_DATAGRAM_BATCH_SIZE,
+                               "io_batch_size", "face_system.udp");
+      }
+      else if (key == "io_backend") {
+        const std::string& valueStr = value.get_value<std::string>();
+        if (valueStr == "asio") {
+          ioBackend = DatagramIoBackend::ASIO;
+        }
+        else if (valueStr == "io_uring") {
+#ifdef NFD_HAVE_IO_URING
+          ioBackend = DatagramIoBackend::IO_URING;
+#else
+          NDN_THROW(ConfigFile::Error("face_system.udp.io_backend: 'io_uring' is not supported by this build"));
+#endif
+        }
+        else {
+          NDN_THROW(ConfigFile::Error("face_system.udp.io_backend: '" + valueStr +
+                                      "' is not a valid I/O backend"));
+        }
+      }
       else if (key == "keep_alive_interval") {
         // ignored
       }
@@ -185,13 +239,40 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
     return;
   }
 
+  // the I/O workers are created at the first configuration and never change
+  m_ioWorkers = context.ioWorkers;
+
   m_defaultUnicastMtu = unicastMtu;
+  if (m_ioBatchSize != ioBatchSize && !m_channels.empty()) {
+    NFD_LOG_WARN("I/O batch size change applies only to new channels and multicast faces");
+  }
+  m_ioBatchSize = ioBatchSize;
+
+#ifdef NFD_HAVE_IO_URING
+  if (ioBackend == DatagramIoBackend::IO_URING && IoUring::get(getGlobalIoService()) == nullptr) {
+    NFD_LOG_WARN("io_uring is not available, UDP faces will use the asio I/O backend");
+  }
+#endif
+  if (m_ioBackend != ioBackend) {
+    if (!m_channels.empty() || !m_mcastFaces.empty()) {
+      NFD_LOG_WARN("I/O backend change applies only to new channels and multicast faces");
+    }
+    NFD_LOG_INFO("using " << ioBackend << " I/O backend");
+  }
+  m_ioBackend = ioBackend;
+
+  if ((m_nListenSockets != nListenSockets || m_listenSteering != listenSteering) &&
+      !m_channels.empty()) {
+    NFD_LOG_WARN("Listening socket count and steering changes apply only to new channels");
+  }
+  m_nListenSockets = nListenSockets;
+  m_listenSteering = listenSteering;
 
   if (enableV4) {
     udp::Endpoint endpoint(ip::udp::v4(), port);
     shared_ptr<UdpChannel> v4Channel = this->createChannel(endpoint, time::seconds(idleTimeout));
     if (wantListen && !v4Channel->isListening()) {
-      v4Channel->listen(this->addFace, nullptr);
+      v4Channel->listen(this->addFace, nullptr, m_nListenSockets, m_listenSteering);
     }
     providedSchemes.insert("udp");
     providedSchemes.insert("udp4");
@@ -204,7 +285,7 @@ UdpFactory::doProcessConfig(OptionalConfigSection configSection,
     udp::Endpoint endpoint(ip::udp::v6(), port);
     shared_ptr<UdpChannel> v6Channel = this->createChannel(endpoint, time::seconds(idleTimeout));
     if (wantListen && !v6Channel->isListening()) {
-      v6Channel->listen(this->addFace, nullptr);
+      v6Channel->listen(this->addFace, nullptr, m_nListenSockets, m_listenSteering);
     }
     providedSchemes.insert("udp");
     providedSchemes.insert("udp6");
@@ -312,8 +393,9 @@ UdpFactory::createChannel(const udp::Endpoint& localEndpoint,
                     ", endpoint already allocated to a UDP multicast face"));
   }
 
-  auto channel = std::make_shared<UdpChannel>(localEndpoint, idleTimeout,
-                                              m_wantCongestionMarking, m_defaultUnicastMtu);
+  auto channel = std::make_shared<UdpChannel>(localEndpoint, idleTimeout, m_wantCongestionMarking,
+                                              m_defaultUnicastMtu, m_ioBatchSize, m_ioBackend);
+  channel->setIoWorkers(m_ioWorkers);
   m_channels[localEndpoint] = channel;
   return channel;
 }
@@ -367,7 +449,7 @@ UdpFactory::createMulticastFace(const net::NetworkInterface& netif,
   options.allowCongestionMarking = m_wantCongestionMarking;
   auto linkService = make_unique<GenericLinkService>(options);
   auto transport = make_unique<MulticastUdpTransport>(mcastEp, std::move(rxSock), std::move(txSock),
-                                                      m_mcastConfig.linkType);
+                                                      m_mcastConfig.linkType, m_ioBatchSize, m_ioBackend);
   auto face = make_shared<Face>(std::move(linkService), std::move(transport));
 
   m_mcastFaces[localEp] = face;
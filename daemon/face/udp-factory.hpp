@@ -125,6 +125,11 @@ private:
 private:
   bool m_wantCongestionMarking = false;
   size_t m_defaultUnicastMtu = ndn::MAX_NDN_PACKET_SIZE;
+  size_t m_ioBatchSize = 1;
+  DatagramIoBackend m_ioBackend = DatagramIoBackend::ASIO;
+  size_t m_nListenSockets = 1;
+  UdpChannel::Steering m_listenSteering = UdpChannel::Steering::HASH;
+  IoWorkerPool* m_ioWorkers = nullptr;
   std::map<udp::Endpoint, shared_ptr<UdpChannel>> m_channels;
 
   struct MulticastConfig
@@ -35,8 +35,9 @@ NFD_LOG_INIT(UnicastEthernetTransport);
 UnicastEthernetTransport::UnicastEthernetTransport(const ndn::net::NetworkInterface& localEndpoint,
                                                    const ethernet::Address& remoteEndpoint,
                                                    ndn::nfd::FacePersistency persistency,
-                                                   time::nanoseconds idleTimeout)
-  : EthernetTransport(localEndpoint, remoteEndpoint)
+                                                   time::nanoseconds idleTimeout,
+                                                   EthernetIoBackend backend)
+  : EthernetTransport(localEndpoint, remoteEndpoint, backend)
   , m_idleTimeout(idleTimeout)
 {
   this->setLocalUri(FaceUri::fromDev(m_interfaceName));
@@ -56,7 +57,7 @@ UnicastEthernetTransport::UnicastEthernetTransport(const ndn::net::NetworkInterf
                 ethernet::ETHERTYPE_NDN,
                 m_destAddress.toString().data(),
                 m_srcAddress.toString().data());
-  m_pcap.setPacketFilter(filter);
+  setPacketFilter(filter);
 
   if (getPersistency() == ndn::nfd::FACE_PERSISTENCY_ON_DEMAND &&
       m_idleTimeout > time::nanoseconds::zero()) {
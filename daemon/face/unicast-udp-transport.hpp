@@ -42,9 +42,18 @@ NFD_LOG_MEMBER_DECL_SPECIALIZED((DatagramTransport<boost::asio::ip::udp, Unicast
 class UnicastUdpTransport final : public DatagramTransport<boost::asio::ip::udp, Unicast>
 {
 public:
+  /**
+   * \param socket connected UDP socket
+   * \param persistency initial face persistency
+   * \param idleTimeout inactivity period after which an on-demand face is closed
+   * \param batchSize maximum number of datagrams per system call; 1 disables batched I/O
+   * \param ioBackend how socket I/O is performed
+   */
   UnicastUdpTransport(boost::asio::ip::udp::socket&& socket,
                       ndn::nfd::FacePersistency persistency,
-                      time::nanoseconds idleTimeout);
+                      time::nanoseconds idleTimeout,
+                      size_t batchSize = 1,
+                      DatagramIoBackend ioBackend = DatagramIoBackend::ASIO);
 
 protected:
   bool
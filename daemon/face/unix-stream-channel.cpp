@@ -147,6 +147,7 @@ UnixStreamChannel::accept(const FaceCreatedCallback& onFaceCreated,
     options.allowCongestionMarking = m_wantCongestionMarking;
     auto linkService = make_unique<GenericLinkService>(options);
     auto transport = make_unique<UnixStreamTransport>(std::move(socket));
+    transport->setSendQueueLimit(m_sendQueueLimit);
     auto face = make_shared<Face>(std::move(linkService), std::move(transport));
     face->setChannel(weak_from_this());
 
@@ -67,6 +67,22 @@ public:
     return m_size;
   }
 
+  size_t
+  getSendQueueLimit() const noexcept
+  {
+    return m_sendQueueLimit;
+  }
+
+  /**
+   * \brief Set the send queue capacity, in bytes, of faces created afterwards.
+   * \sa StreamTransport::setSendQueueLimit
+   */
+  void
+  setSendQueueLimit(size_t capacity) noexcept
+  {
+    m_sendQueueLimit = capacity;
+  }
+
   /**
    * \brief Start listening.
    *
@@ -98,6 +114,7 @@ private:
   bool m_isListening = false;
   boost::asio::local::stream_protocol::acceptor m_acceptor;
   size_t m_size = 0;
+  size_t m_sendQueueLimit = 0;
 };
 
 } // namespace nfd::face
@@ -47,6 +47,7 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
   // {
   //   path /run/nfd/nfd.sock       ; on Linux
   //   path /var/run/nfd/nfd.sock   ; on other platforms
+  //   send_queue_capacity 0
   // }
 
   m_wantCongestionMarking = context.generalConfig.wantCongestionMarking;
@@ -63,10 +64,15 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
 #else
   std::string path = "/var/run/nfd/nfd.sock";
 #endif // __linux__
+  size_t sendQueueLimit = 0;
 
-  for (const auto& [key, value] : *configSection) {
+  for (const auto& pair : *configSection) {
+    const std::string& key = pair.first;
     if (key == "path") {
-      path = value.get_value<std::string>();
+      path = pair.second.get_value<std::string>();
+    }
+    else if (key == "send_queue_capacity") {
+      sendQueueLimit = ConfigFile::parseNumber<size_t>(pair, "face_system.unix");
     }
     else {
       NDN_THROW(ConfigFile::Error("Unrecognized option face_system.unix." + key));
@@ -78,6 +84,7 @@ UnixStreamFactory::doProcessConfig(OptionalConfigSection configSection,
   }
 
   auto channel = this->createChannel(path);
+  channel->setSendQueueLimit(sendQueueLimit);
   if (!channel->isListening()) {
     channel->listen(this->addFace, nullptr);
   }
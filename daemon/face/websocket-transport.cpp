@@ -24,6 +24,7 @@
  */
 
 #include "websocket-transport.hpp"
+#include "receive-buffer-pool.hpp"
 #include "common/global.hpp"
 
 namespace nfd::face {
@@ -96,9 +97,9 @@ WebSocketTransport::receiveMessage(const std::string& msg)
 {
   NFD_LOG_FACE_TRACE("Received: " << msg.size() << " bytes");
 
-  bool isOk = false;
-  Block element;
-  std::tie(isOk, element) = Block::fromBuffer({reinterpret_cast<const uint8_t*>(msg.data()), msg.size()});
+  // a valid element is at most MAX_NDN_PACKET_SIZE octets; any bytes after it are ignored
+  auto [isOk, element] = Block::fromBuffer(ReceiveBufferPool::get().copy(
+    {reinterpret_cast<const uint8_t*>(msg.data()), std::min(msg.size(), ndn::MAX_NDN_PACKET_SIZE)}));
   if (!isOk) {
     NFD_LOG_FACE_WARN("Failed to parse message payload");
     return;
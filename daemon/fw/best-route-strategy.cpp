@@ -72,10 +72,16 @@ BestRouteStrategy::afterReceiveInterest(const Interest& interest, const FaceEndp
   auto it = nexthops.end();
 
   if (suppression == RetxSuppressionResult::NEW) {
-    // forward to nexthop with lowest cost except downstream
-    it = std::find_if(nexthops.begin(), nexthops.end(), [&] (const auto& nexthop) {
+    // forward to nexthop with lowest cost except downstream, avoiding congested send queues
+    auto isEligible = [&] (const auto& nexthop) {
       return isNextHopEligible(ingress.face, interest, nexthop, pitEntry);
+    };
+    it = std::find_if(nexthops.begin(), nexthops.end(), [&] (const auto& nexthop) {
+      return isEligible(nexthop) && !nexthop.getFace().isSendQueueCongested();
     });
+    if (it == nexthops.end()) {
+      it = std::find_if(nexthops.begin(), nexthops.end(), isEligible);
+    }
 
     if (it == nexthops.end()) {
       NFD_LOG_INTEREST_FROM(interest, ingress, "new no-nexthop");
@@ -36,6 +36,8 @@ namespace nfd::fw {
  * \brief "Best route" forwarding strategy.
  *
  * This strategy forwards a new Interest to the lowest-cost nexthop (except downstream).
+ * Nexthops whose send queue is congested (see Face::isSendQueueCongested) are skipped,
+ * unless all eligible nexthops are congested.
  * After that, if consumer retransmits the Interest (and is not suppressed according to
  * exponential backoff algorithm), the strategy forwards the Interest again to
  * the lowest-cost nexthop (except downstream) that is not previously used.
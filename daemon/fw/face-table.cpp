@@ -68,6 +68,15 @@ FaceTable::addReserved(shared_ptr<Face> face, FaceId faceId)
   this->addImpl(std::move(face), faceId);
 }
 
+void
+FaceTable::addMirrored(shared_ptr<Face> face, FaceId faceId)
+{
+  BOOST_ASSERT(face->getId() == face::INVALID_FACEID);
+  BOOST_ASSERT(faceId != face::INVALID_FACEID);
+  m_lastFaceId = std::max(m_lastFaceId, faceId);
+  this->addImpl(std::move(face), faceId);
+}
+
 void
 FaceTable::addImpl(shared_ptr<Face> facePtr, FaceId faceId)
 {
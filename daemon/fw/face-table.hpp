@@ -54,6 +54,14 @@ public:
   void
   addReserved(shared_ptr<Face> face, FaceId faceId);
 
+  /** \brief Add a face with a FaceId assigned by another FaceTable.
+   *
+   *  This is used to mirror the faces of the main FaceTable in a forwarding shard.
+   *  \pre \p faceId is not in use in this FaceTable.
+   */
+  void
+  addMirrored(shared_ptr<Face> face, FaceId faceId);
+
   /** \brief Get face by FaceId.
    *  \return A pointer to the face if found, nullptr otherwise;
    *          `face->shared_from_this()` can be used if a `shared_ptr` is desired.
@@ -31,6 +31,7 @@
 #include "strategy.hpp"
 #include "common/global.hpp"
 #include "common/logger.hpp"
+#include "common/timer-wheel.hpp"
 #include "table/cleanup.hpp"
 
 #include <ndn-cxx/lp/pit-token.hpp>
@@ -41,6 +42,7 @@ namespace nfd {
 NFD_LOG_INIT(Forwarder);
 
 const std::string CFG_FORWARDER = "forwarder";
+constexpr size_t MAX_FORWARDING_THREADS = 64;
 
 static Name
 getDefaultStrategyName()
@@ -51,6 +53,7 @@ getDefaultStrategyName()
 Forwarder::Forwarder(FaceTable& faceTable)
   : m_faceTable(faceTable)
   , m_unsolicitedDataPolicy(make_unique<fw::DefaultUnsolicitedDataPolicy>())
+  , m_nameTree(1024, boost::intrusive_ptr<SlabPoolSet>(new SlabPoolSet))
   , m_fib(m_nameTree)
   , m_pit(m_nameTree)
   , m_measurements(m_nameTree)
@@ -59,19 +62,23 @@ Forwarder::Forwarder(FaceTable& faceTable)
   m_faceTable.afterAdd.connect([this] (const Face& face) {
     face.afterReceiveInterest.connect(
       [this, &face] (const Interest& interest, const EndpointId& endpointId) {
-        this->onIncomingInterest(interest, FaceEndpoint(const_cast<Face&>(face), endpointId));
+        if (m_isFaceIngressEnabled)
+          this->onIncomingInterest(interest, FaceEndpoint(const_cast<Face&>(face), endpointId));
       });
     face.afterReceiveData.connect(
       [this, &face] (const Data& data, const EndpointId& endpointId) {
-        this->onIncomingData(data, FaceEndpoint(const_cast<Face&>(face), endpointId));
+        if (m_isFaceIngressEnabled)
+          this->onIncomingData(data, FaceEndpoint(const_cast<Face&>(face), endpointId));
       });
     face.afterReceiveNack.connect(
       [this, &face] (const lp::Nack& nack, const EndpointId& endpointId) {
-        this->onIncomingNack(nack, FaceEndpoint(const_cast<Face&>(face), endpointId));
+        if (m_isFaceIngressEnabled)
+          this->onIncomingNack(nack, FaceEndpoint(const_cast<Face&>(face), endpointId));
       });
     face.onDroppedInterest.connect(
       [this, &face] (const Interest& interest) {
-        this->onDroppedInterest(interest, const_cast<Face&>(face));
+        if (m_isFaceIngressEnabled)
+          this->onDroppedInterest(interest, const_cast<Face&>(face));
       });
   });
 
@@ -122,6 +129,10 @@ Forwarder::onIncomingInterest(const Interest& interest, const FaceEndpoint& ingr
     return;
   }
 
+  // compute name prefix hashes once, for the PIT, FIB, StrategyChoice, and Measurements lookups
+  // made by this pipeline and by the strategy
+  NameTree::PacketScope packet(m_nameTree, interest.getName());
+
   // detect duplicate Nonce with Dead Nonce List
   bool hasDuplicateNonceInDnl = m_deadNonceList.has(interest.getName(), nonce);
   if (hasDuplicateNonceInDnl) {
@@ -139,7 +150,7 @@ Forwarder::onIncomingInterest(const Interest& interest, const FaceEndpoint& ingr
   }
 
   // PIT insert
-  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest).first;
+  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest, packet.getHashes()).first;
 
   // detect duplicate Nonce in PIT entry
   int dnw = fw::findDuplicateNonce(*pitEntry, nonce, ingress.face);
@@ -310,8 +321,12 @@ Forwarder::onIncomingData(const Data& data, const FaceEndpoint& ingress)
     return;
   }
 
+  // compute name prefix hashes once, for the PIT, FIB, StrategyChoice, and Measurements lookups
+  // made by this pipeline and by the strategy
+  NameTree::PacketScope packet(m_nameTree, data.getName());
+
   // PIT match
-  pit::DataMatchResult pitMatches = m_pit.findAllDataMatches(data);
+  pit::DataMatchResult pitMatches = m_pit.findAllDataMatches(data, packet.getHashes());
   if (pitMatches.size() == 0) {
     // go to Data unsolicited pipeline
     this->onDataUnsolicited(data, ingress);
@@ -563,8 +578,7 @@ Forwarder::setExpiryTimer(const shared_ptr<pit::Entry>& pitEntry, time::millisec
   BOOST_ASSERT(pitEntry);
   duration = std::max(duration, 0_ms);
 
-  pitEntry->expiryTimer.cancel();
-  pitEntry->expiryTimer = getScheduler().schedule(duration, [=] { onInterestFinalize(pitEntry); });
+  getTimerWheel().schedule(pitEntry->expiryTimer, duration, [=] { onInterestFinalize(pitEntry); });
 }
 
 void
@@ -616,6 +630,17 @@ Forwarder::processConfig(const ConfigSection& configSection, bool isDryRun, cons
     if (key == "default_hop_limit") {
       config.defaultHopLimit = ConfigFile::parseNumber<uint8_t>(pair, CFG_FORWARDER);
     }
+    else if (key == "threads") {
+      config.nThreads = ConfigFile::parseNumber<size_t>(pair, CFG_FORWARDER);
+      ConfigFile::checkRange(config.nThreads, size_t{1}, MAX_FORWARDING_THREADS, key, CFG_FORWARDER);
+    }
+    else if (key == "shard_prefix_length") {
+      config.shardPrefixLength = ConfigFile::parseNumber<size_t>(pair, CFG_FORWARDER);
+      ConfigFile::checkRange(config.shardPrefixLength, size_t{1}, NameTree::getMaxDepth(), key, CFG_FORWARDER);
+    }
+    else if (key == "offload_forwarding") {
+      config.wantForwardingOffload = ConfigFile::parseYesNo(pair, CFG_FORWARDER);
+    }
     else {
       NDN_THROW(ConfigFile::Error("Unrecognized option " + CFG_FORWARDER + "." + key));
     }
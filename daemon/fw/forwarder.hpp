@@ -42,6 +42,7 @@
 namespace nfd {
 
 namespace fw {
+class ShardedForwarder;
 class Strategy;
 } // namespace fw
 
@@ -133,6 +134,47 @@ public:
   void
   setConfigFile(ConfigFile& configFile);
 
+  /**
+   * \brief Configuration options from the `forwarder` section.
+   */
+  struct Config
+  {
+    /// Initial value of HopLimit that should be added to Interests that don't have one.
+    /// A value of zero disables the feature.
+    uint8_t defaultHopLimit = 0;
+
+    /// Number of forwarding threads; if greater than one, packets are processed by
+    /// fw::ShardedForwarder. This option takes effect only at startup.
+    size_t nThreads = 1;
+
+    /// Number of leading name components that select the forwarding thread of a packet.
+    size_t shardPrefixLength = 1;
+
+    /// Whether forwarding is offloaded to a dedicated thread even if nThreads is one, so that
+    /// the main thread only performs face I/O, NDNLP processing, and management.
+    /// Face I/O itself always stays in the main thread.
+    /// This option takes effect only at startup.
+    bool wantForwardingOffload = false;
+  };
+
+  const Config&
+  getConfig() const noexcept
+  {
+    return m_config;
+  }
+
+  /** \brief Enable or disable the pipelines for packets received on faces in the FaceTable.
+   *
+   *  When disabled, this instance does not process packets received on faces. This is used when
+   *  fw::ShardedForwarder processes them in forwarding threads, and this instance only holds the
+   *  tables that are changed through management and configuration.
+   */
+  void
+  setFaceIngressEnabled(bool isEnabled) noexcept
+  {
+    m_isFaceIngressEnabled = isEnabled;
+  }
+
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   /** \brief Incoming Interest pipeline.
    *  \param interest the incoming Interest, must be well-formed and created with make_shared
@@ -226,18 +268,10 @@ private:
                 const std::string& filename);
 
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
-  /**
-   * \brief Configuration options from the `forwarder` section.
-   */
-  struct Config
-  {
-    /// Initial value of HopLimit that should be added to Interests that don't have one.
-    /// A value of zero disables the feature.
-    uint8_t defaultHopLimit = 0;
-  };
   Config m_config;
 
 private:
+  bool m_isFaceIngressEnabled = true;
   ForwarderCounters m_counters;
 
   FaceTable& m_faceTable;
@@ -254,6 +288,8 @@ private:
 
   // allow Strategy (base class) to enter pipelines
   friend ::nfd::fw::Strategy;
+  // allow ShardedForwarder to copy the configuration to forwarding shards
+  friend ::nfd::fw::ShardedForwarder;
 };
 
 } // namespace nfd
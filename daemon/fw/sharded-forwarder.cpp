@@ -0,0 +1,831 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sharded-forwarder.hpp"
+#include "common/global.hpp"
+#include "common/logger.hpp"
+#include "common/spsc-queue.hpp"
+#include "table/cs-policy.hpp"
+#include "table/name-tree-hashtable.hpp"
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+
+#include <future>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <typeinfo>
+
+namespace nfd::fw {
+
+NFD_LOG_INIT(ShardedForwarder);
+
+/** \brief Content Store settings of the main Forwarder.
+ */
+struct ShardedForwarder::CsSettings
+{
+  explicit
+  CsSettings(const Cs& cs)
+    : limit(cs.getLimit())
+    , byteLimit(cs.getByteLimit())
+    , policyName(cs.getPolicy()->getName())
+    , engine(cs.getEngine())
+    , shouldAdmit(cs.shouldAdmit())
+    , shouldServe(cs.shouldServe())
+  {
+    if (const cs::DiskStore* store = cs.getDiskStore(); store != nullptr) {
+      diskPath = store->getPath();
+      diskOptions = store->getOptions();
+    }
+  }
+
+  bool
+  operator!=(const CsSettings& other) const
+  {
+    return std::tie(limit, byteLimit, policyName, engine, shouldAdmit, shouldServe, diskPath,
+                    diskOptions.segmentSize, diskOptions.maxSegments) !=
+           std::tie(other.limit, other.byteLimit, other.policyName, other.engine, other.shouldAdmit,
+                    other.shouldServe, other.diskPath, other.diskOptions.segmentSize,
+                    other.diskOptions.maxSegments);
+  }
+
+  /** \brief Apply the settings to the Content Store of shard \p shardIndex.
+   *
+   *  The capacity is divided among \p nShards shards. Each shard has its own disk store
+   *  in a subdirectory of the configured path.
+   */
+  void
+  apply(Cs& cs, size_t nShards, size_t shardIndex) const
+  {
+    auto divide = [nShards] (size_t n) {
+      return n == std::numeric_limits<size_t>::max() ? n : (n + nShards - 1) / nShards;
+    };
+    cs.setLimit(divide(limit));
+    cs.setByteLimit(divide(byteLimit));
+    if (cs.size() == 0 && cs.getPolicy()->getName() != policyName) {
+      cs.setPolicy(cs::Policy::create(policyName));
+    }
+    cs.setEngine(engine);
+    cs.enableAdmit(shouldAdmit);
+    cs.enableServe(shouldServe);
+
+    std::optional<std::filesystem::path> shardDiskPath;
+    if (diskPath) {
+      shardDiskPath = *diskPath / ("shard-" + std::to_string(shardIndex));
+    }
+    auto shardDiskOptions = diskOptions;
+    shardDiskOptions.maxSegments = std::max<size_t>(divide(diskOptions.maxSegments), 1);
+
+    const cs::DiskStore* current = cs.getDiskStore();
+    if (current == nullptr ? !shardDiskPath :
+        shardDiskPath && current->getPath() == *shardDiskPath &&
+        current->getOptions().segmentSize == shardDiskOptions.segmentSize &&
+        current->getOptions().maxSegments == shardDiskOptions.maxSegments) {
+      return;
+    }
+
+    cs.setDiskStore(nullptr);
+    if (shardDiskPath) {
+      try {
+        cs.setDiskStore(make_unique<cs::DiskStore>(*shardDiskPath, shardDiskOptions));
+      }
+      catch (const cs::DiskStore::Error& e) {
+        NFD_LOG_ERROR("Cannot open disk store of shard " << shardIndex << ": " << e.what());
+      }
+    }
+  }
+
+  size_t limit;
+  size_t byteLimit;
+  std::string policyName;
+  cs::TableEngine engine;
+  bool shouldAdmit;
+  bool shouldServe;
+  std::optional<std::filesystem::path> diskPath;
+  cs::DiskStore::Options diskOptions;
+};
+
+/** \brief A forwarding thread with its own Forwarder and FaceTable.
+ */
+class ShardedForwarder::Shard : public std::enable_shared_from_this<Shard>, noncopyable
+{
+public:
+  Shard(ShardedForwarder& parent, size_t index, size_t queueCapacity)
+    : m_parent(parent)
+    , m_index(index)
+    , m_mainIo(getGlobalIoService())
+    , m_ingress(queueCapacity)
+    , m_egress(queueCapacity)
+  {
+  }
+
+  ~Shard()
+  {
+    if (m_thread.joinable()) {
+      m_io->stop();
+      m_thread.join();
+    }
+  }
+
+  /** \brief Start the thread, and wait until its io_context is available.
+   */
+  void
+  start()
+  {
+    std::promise<boost::asio::io_context*> ioPromise;
+    auto ioFuture = ioPromise.get_future();
+    m_thread = std::thread([this, ioPromise = std::move(ioPromise)] () mutable { run(ioPromise); });
+    m_io = ioFuture.get();
+  }
+
+  boost::asio::io_context&
+  getIo() const noexcept
+  {
+    return *m_io;
+  }
+
+public: // main thread
+  /** \brief Pass a packet received on a face to the shard.
+   *  \retval false the queue is full, and the packet is dropped
+   */
+  bool
+  pushIngress(face::ShardPacket&& packet)
+  {
+    if (!m_ingress.push(std::move(packet))) {
+      return false;
+    }
+    if (!m_hasIngressWakeup.exchange(true, std::memory_order_acq_rel)) {
+      boost::asio::post(*m_io, [this] { drainIngress(); });
+    }
+    return true;
+  }
+
+  /** \brief Add a shard face to the FaceTable of the shard.
+   *
+   *  The face is added before any packet passed to pushIngress() afterwards is processed.
+   */
+  void
+  addFace(shared_ptr<Face> face, FaceId faceId)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_pendingFacesMutex);
+      m_pendingFaces.emplace_back(faceId, std::move(face));
+    }
+    boost::asio::post(*m_io, [this] { addPendingFaces(); });
+  }
+
+  /** \brief Close the shard face with \p faceId, removing it from the FaceTable of the shard.
+   */
+  void
+  removeFace(FaceId faceId)
+  {
+    boost::asio::post(*m_io, [this, faceId] {
+      addPendingFaces();
+      Face* face = m_faceTable->get(faceId);
+      if (face != nullptr) {
+        face->close();
+      }
+    });
+  }
+
+  /** \brief Apply \p f to the ShardTransport of the shard face with \p faceId in the shard thread.
+   *
+   *  Nothing happens if the shard face has been closed.
+   */
+  void
+  updateFace(FaceId faceId, std::function<void(face::ShardTransport&)> f)
+  {
+    boost::asio::post(*m_io, [this, faceId, f = std::move(f)] {
+      addPendingFaces();
+      Face* face = m_faceTable->get(faceId);
+      if (face != nullptr) {
+        f(static_cast<face::ShardTransport&>(*face->getTransport()));
+      }
+    });
+  }
+
+public: // shard thread
+  FaceTable&
+  getFaceTable() noexcept
+  {
+    return *m_faceTable;
+  }
+
+  Forwarder&
+  getForwarder() noexcept
+  {
+    return *m_forwarder;
+  }
+
+  uint64_t
+  getNEgressDrops() const noexcept
+  {
+    return m_nEgressDrops;
+  }
+
+  /** \brief Pass a packet sent by the shard to the main thread.
+   */
+  void
+  pushEgress(face::ShardPacket&& packet)
+  {
+    if (!m_egress.push(std::move(packet))) {
+      ++m_nEgressDrops;
+      NFD_LOG_DEBUG("shard=" << m_index << " egress queue full, dropping packet");
+      return;
+    }
+    if (!m_hasEgressWakeup.exchange(true, std::memory_order_acq_rel)) {
+      boost::asio::post(m_mainIo, [self = weak_from_this()] {
+        if (auto shard = self.lock(); shard != nullptr) {
+          shard->drainEgress();
+        }
+      });
+    }
+  }
+
+private:
+  void
+  run(std::promise<boost::asio::io_context*>& ioPromise)
+  {
+    auto& io = getGlobalIoService();
+    auto workGuard = boost::asio::make_work_guard(io);
+    m_faceTable = make_unique<FaceTable>();
+    m_forwarder = make_unique<Forwarder>(*m_faceTable);
+    ioPromise.set_value(&io);
+
+    // run until stopped by the destructor, which needs the io_context to be alive
+    while (!io.stopped()) {
+      try {
+        io.run();
+      }
+      catch (const std::exception& e) {
+        NFD_LOG_FATAL("shard=" << m_index << ": " << boost::diagnostic_information(e));
+        // let the main thread terminate as it would if forwarding failed there
+        boost::asio::post(m_mainIo, [e = std::current_exception()] { std::rethrow_exception(e); });
+      }
+    }
+
+    // the tables must be destroyed in this thread, before its io_context and Scheduler
+    m_forwarder.reset();
+    m_faceTable.reset();
+  }
+
+  void
+  addPendingFaces()
+  {
+    std::vector<std::pair<FaceId, shared_ptr<Face>>> faces;
+    {
+      std::lock_guard<std::mutex> lock(m_pendingFacesMutex);
+      faces.swap(m_pendingFaces);
+    }
+    for (auto& [faceId, face] : faces) {
+      m_faceTable->addMirrored(std::move(face), faceId);
+    }
+  }
+
+  void
+  drainIngress()
+  {
+    m_hasIngressWakeup.exchange(false, std::memory_order_acq_rel);
+    m_ingress.consumeAll([this] (face::ShardPacket&& packet) {
+      Face* face = m_faceTable->get(packet.faceId);
+      if (face == nullptr) {
+        addPendingFaces();
+        face = m_faceTable->get(packet.faceId);
+        if (face == nullptr) {
+          return; // the face has been removed
+        }
+      }
+      static_cast<face::ShardLinkService*>(face->getLinkService())->deliver(packet);
+    });
+  }
+
+  void
+  drainEgress()
+  {
+    m_hasEgressWakeup.exchange(false, std::memory_order_acq_rel);
+    m_egress.consumeAll([this] (face::ShardPacket&& packet) {
+      m_parent.sendToFace(std::move(packet));
+    });
+  }
+
+private:
+  ShardedForwarder& m_parent;
+  const size_t m_index;
+  boost::asio::io_context& m_mainIo;
+  boost::asio::io_context* m_io = nullptr;
+  std::thread m_thread;
+
+  // owned by the shard thread
+  unique_ptr<FaceTable> m_faceTable;
+  unique_ptr<Forwarder> m_forwarder;
+  uint64_t m_nEgressDrops = 0;
+
+  SpscQueue<face::ShardPacket> m_ingress; ///< main thread to shard
+  SpscQueue<face::ShardPacket> m_egress;  ///< shard to main thread
+  std::atomic<bool> m_hasIngressWakeup{false};
+  std::atomic<bool> m_hasEgressWakeup{false};
+
+  std::mutex m_pendingFacesMutex;
+  std::vector<std::pair<FaceId, shared_ptr<Face>>> m_pendingFaces;
+};
+
+namespace {
+
+/** \brief A copy of a FIB entry; \p nextHops is std::nullopt if the entry does not exist.
+ */
+struct FibEntryCopy
+{
+  Name prefix;
+  std::optional<std::vector<std::pair<FaceId, uint64_t>>> nextHops;
+};
+
+/** \brief A copy of a Strategy Choice entry; \p strategy is std::nullopt if the entry does not exist.
+ */
+struct StrategyChoiceCopy
+{
+  Name prefix;
+  std::optional<Name> strategy;
+};
+
+} // namespace
+
+static FibEntryCopy
+copyFibEntry(const fib::Entry* entry, const Name& prefix)
+{
+  FibEntryCopy copy{prefix, std::nullopt};
+  if (entry != nullptr) {
+    copy.nextHops.emplace();
+    for (const auto& nh : entry->getNextHops()) {
+      copy.nextHops->emplace_back(nh.getFace().getId(), nh.getCost());
+    }
+  }
+  return copy;
+}
+
+static void
+applyFibEntry(Fib& fib, const FaceTable& faceTable, const FibEntryCopy& copy)
+{
+  if (!copy.nextHops) {
+    fib.erase(copy.prefix);
+    return;
+  }
+
+  fib::Entry* entry = fib.insert(copy.prefix).first;
+  for (const auto& [faceId, cost] : *copy.nextHops) {
+    Face* face = faceTable.get(faceId);
+    if (face != nullptr) {
+      fib.addOrUpdateNextHop(*entry, *face, cost);
+    }
+  }
+
+  std::vector<const Face*> staleFaces;
+  for (const auto& nh : entry->getNextHops()) {
+    FaceId faceId = nh.getFace().getId();
+    if (std::none_of(copy.nextHops->begin(), copy.nextHops->end(),
+                     [faceId] (const auto& nh) { return nh.first == faceId; })) {
+      staleFaces.push_back(&nh.getFace());
+    }
+  }
+  for (const Face* face : staleFaces) {
+    if (fib.removeNextHop(*entry, *face) == Fib::RemoveNextHopResult::FIB_ENTRY_REMOVED) {
+      // the entry exists without nexthops in the main FIB
+      entry = fib.insert(copy.prefix).first;
+    }
+  }
+}
+
+static void
+applyStrategyChoice(StrategyChoice& sc, const StrategyChoiceCopy& copy)
+{
+  if (copy.strategy) {
+    auto res = sc.insert(copy.prefix, *copy.strategy);
+    if (!res) {
+      NFD_LOG_WARN("Cannot set strategy of " << copy.prefix << " in shard: " << res);
+    }
+  }
+  else if (!copy.prefix.empty()) {
+    sc.erase(copy.prefix);
+  }
+}
+
+static std::string
+getUnsolicitedDataPolicyName(const UnsolicitedDataPolicy& policy)
+{
+  for (const auto& policyName : UnsolicitedDataPolicy::getPolicyNames()) {
+    auto candidate = UnsolicitedDataPolicy::create(policyName);
+    if (candidate == nullptr) {
+      continue;
+    }
+    const auto& candidateRef = *candidate;
+    if (typeid(candidateRef) == typeid(policy)) {
+      return policyName;
+    }
+  }
+  return "";
+}
+
+ShardedForwarder::ShardedForwarder(FaceTable& faceTable, Forwarder& forwarder, const Options& options)
+  : m_faceTable(faceTable)
+  , m_forwarder(forwarder)
+  , m_options(options)
+{
+  BOOST_ASSERT(m_options.nShards >= 1);
+  BOOST_ASSERT(m_options.shardPrefixLength >= 1);
+
+  for (size_t i = 0; i < m_options.nShards; ++i) {
+    auto shard = make_shared<Shard>(*this, i, m_options.queueCapacity);
+    shard->start();
+    m_shards.push_back(std::move(shard));
+  }
+
+  for (const Face& face : m_faceTable) {
+    addFace(face);
+  }
+  m_afterAddFaceConn = m_faceTable.afterAdd.connect([this] (const Face& face) { addFace(face); });
+  m_beforeRemoveFaceConn = m_faceTable.beforeRemove.connect([this] (const Face& face) { removeFace(face); });
+
+  m_afterFibChangeConn = m_forwarder.getFib().afterChange.connect([this] (const Name& prefix) {
+    m_changedFibPrefixes.insert(prefix);
+    scheduleFlush();
+  });
+  m_afterStrategyChoiceChangeConn = m_forwarder.getStrategyChoice().afterChange.connect(
+    [this] (const Name& prefix) {
+      m_changedStrategyChoicePrefixes.insert(prefix);
+      scheduleFlush();
+    });
+  m_afterCsConfigChangeConn = m_forwarder.getCs().afterConfigChange.connect([this] {
+    m_isCsConfigChanged = true;
+    scheduleFlush();
+  });
+
+  syncTables();
+  m_forwarder.setFaceIngressEnabled(false);
+
+  NFD_LOG_INFO("Forwarding in " << m_shards.size() << " threads, shard-prefix-length="
+               << m_options.shardPrefixLength);
+}
+
+ShardedForwarder::~ShardedForwarder()
+{
+  m_forwarder.setFaceIngressEnabled(true);
+  // stop the forwarding threads while the faces are still connected
+  m_shards.clear();
+}
+
+size_t
+ShardedForwarder::getShardIndex(const Name& name) const
+{
+  size_t prefixLen = name.size();
+  if (prefixLen > 0 && name[-1].isImplicitSha256Digest()) {
+    --prefixLen;
+  }
+  prefixLen = std::min(prefixLen, m_options.shardPrefixLength);
+  return name_tree::computeHash(name, prefixLen) % m_shards.size();
+}
+
+void
+ShardedForwarder::runInShards(const std::function<void(size_t, Forwarder&)>& f) const
+{
+  std::vector<std::future<void>> results;
+  results.reserve(m_shards.size());
+  for (size_t i = 0; i < m_shards.size(); ++i) {
+    Shard* shard = m_shards[i].get();
+    auto task = make_shared<std::packaged_task<void()>>([&f, i, shard] { f(i, shard->getForwarder()); });
+    results.push_back(task->get_future());
+    boost::asio::post(shard->getIo(), [task] { (*task)(); });
+  }
+
+  // wait for every shard before rethrowing, because the tasks refer to f
+  for (const auto& result : results) {
+    result.wait();
+  }
+  for (auto& result : results) {
+    result.get();
+  }
+}
+
+void
+ShardedForwarder::syncTables()
+{
+  // the full copy supersedes pending changes
+  m_changedFibPrefixes.clear();
+  m_changedStrategyChoicePrefixes.clear();
+  m_isCsConfigChanged = false;
+
+  m_csSettings = make_unique<CsSettings>(m_forwarder.getCs());
+  const Forwarder::Config& config = m_forwarder.getConfig();
+  const std::string unsolicitedDataPolicyName =
+    getUnsolicitedDataPolicyName(m_forwarder.getUnsolicitedDataPolicy());
+  const NetworkRegionTable& networkRegions = m_forwarder.getNetworkRegionTable();
+  DeadNonceList& dnl = m_forwarder.getDeadNonceList();
+  const name_tree::HashtableOptions& htOptions = m_forwarder.getNameTree().getHashtableOptions();
+
+  std::vector<StrategyChoiceCopy> strategyChoices;
+  for (const auto& entry : m_forwarder.getStrategyChoice()) {
+    strategyChoices.push_back({entry.getPrefix(), entry.getStrategyInstanceName()});
+  }
+  std::vector<FibEntryCopy> fibEntries;
+  for (const auto& entry : m_forwarder.getFib()) {
+    fibEntries.push_back(copyFibEntry(&entry, entry.getPrefix()));
+  }
+
+  runInShards([&] (size_t i, Forwarder& shardForwarder) {
+    shardForwarder.m_config = config;
+    m_csSettings->apply(shardForwarder.getCs(), m_shards.size(), i);
+    auto unsolicitedDataPolicy = UnsolicitedDataPolicy::create(unsolicitedDataPolicyName);
+    if (unsolicitedDataPolicy != nullptr) {
+      shardForwarder.setUnsolicitedDataPolicy(std::move(unsolicitedDataPolicy));
+    }
+    shardForwarder.getNetworkRegionTable() = networkRegions;
+    shardForwarder.getDeadNonceList().setEngine(dnl.getEngine(), dnl.getFalsePositiveRate());
+    shardForwarder.getNameTree().setHashtableEngine(htOptions.engine, htOptions.incrementalResize);
+
+    StrategyChoice& sc = shardForwarder.getStrategyChoice();
+    std::vector<Name> staleChoices;
+    for (const auto& entry : sc) {
+      if (std::none_of(strategyChoices.begin(), strategyChoices.end(),
+                       [&] (const auto& copy) { return copy.prefix == entry.getPrefix(); })) {
+        staleChoices.push_back(entry.getPrefix());
+      }
+    }
+    for (const Name& prefix : staleChoices) {
+      applyStrategyChoice(sc, {prefix, std::nullopt});
+    }
+    for (const auto& copy : strategyChoices) {
+      applyStrategyChoice(sc, copy);
+    }
+
+    Fib& fib = shardForwarder.getFib();
+    std::set<Name> mainPrefixes;
+    for (const auto& copy : fibEntries) {
+      mainPrefixes.insert(copy.prefix);
+    }
+    std::vector<Name> staleEntries;
+    for (const auto& entry : fib) {
+      if (mainPrefixes.count(entry.getPrefix()) == 0) {
+        staleEntries.push_back(entry.getPrefix());
+      }
+    }
+    for (const Name& prefix : staleEntries) {
+      fib.erase(prefix);
+    }
+    const FaceTable& shardFaceTable = m_shards[i]->getFaceTable();
+    for (const auto& copy : fibEntries) {
+      applyFibEntry(fib, shardFaceTable, copy);
+    }
+  });
+
+  NFD_LOG_DEBUG("Synchronized " << fibEntries.size() << " FIB entries and " << strategyChoices.size()
+                << " strategy choices to " << m_shards.size() << " shards");
+}
+
+ShardedForwarder::Status
+ShardedForwarder::collectStatus() const
+{
+  std::vector<Status> shardStatus(m_shards.size());
+  runInShards([&] (size_t i, Forwarder& shardForwarder) {
+    Status& status = shardStatus[i];
+    status.nNameTreeEntries = shardForwarder.getNameTree().size();
+    status.nPitEntries = shardForwarder.getPit().size();
+    status.nMeasurementsEntries = shardForwarder.getMeasurements().size();
+    status.nCsEntries = shardForwarder.getCs().size();
+
+    const ForwarderCounters& counters = shardForwarder.getCounters();
+    status.nInInterests = counters.nInInterests;
+    status.nOutInterests = counters.nOutInterests;
+    status.nInData = counters.nInData;
+    status.nOutData = counters.nOutData;
+    status.nInNacks = counters.nInNacks;
+    status.nOutNacks = counters.nOutNacks;
+    status.nSatisfiedInterests = counters.nSatisfiedInterests;
+    status.nUnsatisfiedInterests = counters.nUnsatisfiedInterests;
+    status.nUnsolicitedData = counters.nUnsolicitedData;
+    status.nCsHits = counters.nCsHits;
+    status.nCsMisses = counters.nCsMisses;
+    status.nQueueDrops = m_shards[i]->getNEgressDrops();
+  });
+
+  Status total;
+  total.nQueueDrops = m_nIngressDrops;
+  for (const Status& status : shardStatus) {
+    total.nNameTreeEntries += status.nNameTreeEntries;
+    total.nPitEntries += status.nPitEntries;
+    total.nMeasurementsEntries += status.nMeasurementsEntries;
+    total.nCsEntries += status.nCsEntries;
+    total.nInInterests += status.nInInterests;
+    total.nOutInterests += status.nOutInterests;
+    total.nInData += status.nInData;
+    total.nOutData += status.nOutData;
+    total.nInNacks += status.nInNacks;
+    total.nOutNacks += status.nOutNacks;
+    total.nSatisfiedInterests += status.nSatisfiedInterests;
+    total.nUnsatisfiedInterests += status.nUnsatisfiedInterests;
+    total.nUnsolicitedData += status.nUnsolicitedData;
+    total.nCsHits += status.nCsHits;
+    total.nCsMisses += status.nCsMisses;
+    total.nQueueDrops += status.nQueueDrops;
+  }
+  return total;
+}
+
+static face::ShardPacket
+makeShardPacket(face::ShardPacket::Type type, FaceId faceId, const EndpointId& endpointId = {})
+{
+  face::ShardPacket packet;
+  packet.type = type;
+  packet.faceId = faceId;
+  packet.endpointId = endpointId;
+  return packet;
+}
+
+void
+ShardedForwarder::addFace(const Face& face)
+{
+  FaceId faceId = face.getId();
+  auto& connections = m_faceConnections[faceId];
+  connections.emplace_back(face.afterReceiveInterest.connect(
+    [this, faceId] (const Interest& interest, const EndpointId& endpointId) {
+      auto packet = makeShardPacket(face::ShardPacket::INTEREST, faceId, endpointId);
+      packet.interest = face::shareOrCopy(interest);
+      dispatch(std::move(packet), interest.getName());
+    }));
+  connections.emplace_back(face.afterReceiveData.connect(
+    [this, faceId] (const Data& data, const EndpointId& endpointId) {
+      auto packet = makeShardPacket(face::ShardPacket::DATA, faceId, endpointId);
+      packet.data = face::shareOrCopy(data);
+      dispatch(std::move(packet), data.getName());
+    }));
+  connections.emplace_back(face.afterReceiveNack.connect(
+    [this, faceId] (const lp::Nack& nack, const EndpointId& endpointId) {
+      auto packet = makeShardPacket(face::ShardPacket::NACK, faceId, endpointId);
+      packet.nack = make_shared<lp::Nack>(nack);
+      dispatch(std::move(packet), nack.getInterest().getName());
+    }));
+  connections.emplace_back(face.onDroppedInterest.connect(
+    [this, faceId] (const Interest& interest) {
+      auto packet = makeShardPacket(face::ShardPacket::DROPPED_INTEREST, faceId);
+      // LpReliability emits a temporary
+      packet.interest = make_shared<Interest>(interest);
+      dispatch(std::move(packet), interest.getName());
+    }));
+  connections.emplace_back(face.afterStateChange.connect(
+    [this, faceId] (face::FaceState, face::FaceState newState) {
+      updateShardFaces(faceId, [newState] (face::ShardTransport& transport) {
+        transport.updateState(newState);
+      });
+    }));
+  connections.emplace_back(face.afterPersistencyChange.connect(
+    [this, faceId] (ndn::nfd::FacePersistency, ndn::nfd::FacePersistency newPersistency) {
+      updateShardFaces(faceId, [newPersistency] (face::ShardTransport& transport) {
+        transport.setPersistency(newPersistency);
+      });
+    }));
+  connections.emplace_back(face.afterSendQueueCongestionChange.connect(
+    [this, faceId] (bool isCongested) {
+      updateShardFaces(faceId, [isCongested] (face::ShardTransport& transport) {
+        transport.updateSendQueueCongested(isCongested);
+      });
+    }));
+
+  for (const auto& shard : m_shards) {
+    auto shardFace = face::makeShardFace(face, [shard = shard.get()] (face::ShardPacket&& packet) {
+      shard->pushEgress(std::move(packet));
+    });
+    shard->addFace(std::move(shardFace), faceId);
+  }
+}
+
+void
+ShardedForwarder::removeFace(const Face& face)
+{
+  m_faceConnections.erase(face.getId());
+  for (const auto& shard : m_shards) {
+    shard->removeFace(face.getId());
+  }
+}
+
+void
+ShardedForwarder::updateShardFaces(FaceId faceId,
+                                   const std::function<void(face::ShardTransport&)>& f)
+{
+  for (const auto& shard : m_shards) {
+    shard->updateFace(faceId, f);
+  }
+}
+
+void
+ShardedForwarder::dispatch(face::ShardPacket&& packet, const Name& name)
+{
+  size_t shardIndex = getShardIndex(name);
+  if (!m_shards[shardIndex]->pushIngress(std::move(packet))) {
+    ++m_nIngressDrops;
+    NFD_LOG_DEBUG("shard=" << shardIndex << " ingress queue full, dropping " << name);
+  }
+}
+
+void
+ShardedForwarder::sendToFace(face::ShardPacket&& packet)
+{
+  Face* face = m_faceTable.get(packet.faceId);
+  if (face == nullptr) {
+    return; // the face has been removed
+  }
+
+  switch (packet.type) {
+    case face::ShardPacket::INTEREST:
+      face->sendInterest(*packet.interest);
+      break;
+    case face::ShardPacket::DATA:
+      face->sendData(*packet.data);
+      break;
+    case face::ShardPacket::NACK:
+      face->sendNack(*packet.nack);
+      break;
+    case face::ShardPacket::DROPPED_INTEREST:
+      // never sent by a shard
+      break;
+  }
+}
+
+void
+ShardedForwarder::scheduleFlush()
+{
+  if (m_isFlushScheduled) {
+    return;
+  }
+  // coalesce the changes made while processing the current event
+  m_isFlushScheduled = true;
+  m_flushEvent = getScheduler().schedule(0_ns, [this] { flushTableChanges(); });
+}
+
+void
+ShardedForwarder::flushTableChanges()
+{
+  m_isFlushScheduled = false;
+
+  auto fibEntries = make_shared<std::vector<FibEntryCopy>>();
+  for (const Name& prefix : m_changedFibPrefixes) {
+    fibEntries->push_back(copyFibEntry(m_forwarder.getFib().findExactMatch(prefix), prefix));
+  }
+  auto strategyChoices = make_shared<std::vector<StrategyChoiceCopy>>();
+  for (const Name& prefix : m_changedStrategyChoicePrefixes) {
+    auto [hasEntry, strategy] = m_forwarder.getStrategyChoice().get(prefix);
+    strategyChoices->push_back({prefix, hasEntry ? std::make_optional(strategy) : std::nullopt});
+  }
+  m_changedFibPrefixes.clear();
+  m_changedStrategyChoicePrefixes.clear();
+
+  shared_ptr<CsSettings> csSettings;
+  if (m_isCsConfigChanged) {
+    m_isCsConfigChanged = false;
+    CsSettings current(m_forwarder.getCs());
+    if (current != *m_csSettings) {
+      NFD_LOG_DEBUG("Content Store settings changed");
+      *m_csSettings = current;
+      csSettings = make_shared<CsSettings>(current);
+    }
+  }
+
+  for (size_t i = 0; i < m_shards.size(); ++i) {
+    boost::asio::post(m_shards[i]->getIo(),
+                      [shard = m_shards[i].get(), i, nShards = m_shards.size(),
+                       fibEntries, strategyChoices, csSettings] {
+      Forwarder& shardForwarder = shard->getForwarder();
+      if (csSettings != nullptr) {
+        csSettings->apply(shardForwarder.getCs(), nShards, i);
+      }
+      for (const auto& copy : *strategyChoices) {
+        applyStrategyChoice(shardForwarder.getStrategyChoice(), copy);
+      }
+      for (const auto& copy : *fibEntries) {
+        applyFibEntry(shardForwarder.getFib(), shard->getFaceTable(), copy);
+      }
+    });
+  }
+}
+
+} // namespace nfd::fw
@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_SHARDED_FORWARDER_HPP
+#define NFD_DAEMON_FW_SHARDED_FORWARDER_HPP
+
+#include "forwarder.hpp"
+#include "face/shard-face.hpp"
+
+#include <set>
+
+namespace nfd::fw {
+
+/**
+ * \brief Processes packets in several forwarding threads, each owning a shard of the tables.
+ *
+ * Each shard runs a Forwarder in its own thread, with its own io_context and Scheduler, and
+ * its own NameTree, PIT, Content Store, Measurements, and Dead Nonce List. A packet is processed
+ * by the shard selected by a hash of the first `shardPrefixLength` components of its name
+ * (ignoring an implicit digest), so that an Interest and the Data or Nack that answers it
+ * are processed by the same shard without locking.
+ *
+ * Faces stay in the main thread; a face served by an I/O worker is represented there by the face
+ * that stands for it (see face::IoWorker). Each shard has a FaceTable of shard faces that mirror
+ * the faces of the main FaceTable with the same FaceIds (see face::makeShardFace). Packets received
+ * on a face are passed to a shard, and packets sent by a shard are passed back to the main
+ * thread, through bounded single-producer single-consumer queues; the consuming thread is woken
+ * up at most once per batch of packets. A packet is dropped if the queue is full.
+ * With a single shard, this only offloads forwarding from the main thread, which keeps the face
+ * I/O and NDNLP processing that is not done by I/O workers.
+ *
+ * The Forwarder of the main thread no longer processes packets received on faces; it holds the
+ * tables changed by management and configuration. Changes to its FIB and Strategy Choice table
+ * and the Content Store settings are replicated to the shards as they happen. The other settings
+ * (unsolicited Data policy, network region table, Dead Nonce List engine, name tree engine, and
+ * forwarder options) are copied by syncTables(); the Content Store capacity is divided among
+ * the shards.
+ *
+ * \note Routes that a strategy adds in a shard, such as those of the self-learning strategy,
+ *       are not replicated to the other shards or to the main FIB.
+ * \note An Interest whose name is shorter than `shardPrefixLength` components is processed by the
+ *       shard of its whole name, and can only be satisfied by Data that hashes to the same shard.
+ */
+class ShardedForwarder : noncopyable
+{
+public:
+  struct Options
+  {
+    /// Number of forwarding threads; must be at least one.
+    size_t nShards = 2;
+
+    /// Number of leading name components that select the shard of a packet; must be at least one.
+    size_t shardPrefixLength = 1;
+
+    /// Capacity of each queue between the main thread and a shard, in packets.
+    size_t queueCapacity = 16384;
+  };
+
+  /** \brief Start the forwarding threads and take over packet processing from \p forwarder.
+   *
+   *  \p faceTable and \p forwarder must belong to the calling thread, which becomes the main
+   *  thread, and must outlive this instance.
+   */
+  ShardedForwarder(FaceTable& faceTable, Forwarder& forwarder, const Options& options);
+
+  /** \brief Stop the forwarding threads and give packet processing back to the main Forwarder.
+   */
+  ~ShardedForwarder();
+
+  size_t
+  getNShards() const noexcept
+  {
+    return m_shards.size();
+  }
+
+  /** \brief Return the index of the shard that processes packets with \p name.
+   */
+  size_t
+  getShardIndex(const Name& name) const;
+
+  /** \brief Copy the tables and settings of the main Forwarder to all shards.
+   *
+   *  This should be called after the configuration file is reloaded.
+   *  It blocks until every shard has applied the copy.
+   */
+  void
+  syncTables();
+
+  /** \brief Aggregated status of the shards.
+   */
+  struct Status
+  {
+    uint64_t nNameTreeEntries = 0;
+    uint64_t nPitEntries = 0;
+    uint64_t nMeasurementsEntries = 0;
+    uint64_t nCsEntries = 0;
+
+    uint64_t nInInterests = 0;
+    uint64_t nOutInterests = 0;
+    uint64_t nInData = 0;
+    uint64_t nOutData = 0;
+    uint64_t nInNacks = 0;
+    uint64_t nOutNacks = 0;
+    uint64_t nSatisfiedInterests = 0;
+    uint64_t nUnsatisfiedInterests = 0;
+    uint64_t nUnsolicitedData = 0;
+    uint64_t nCsHits = 0;
+    uint64_t nCsMisses = 0;
+
+    /// Packets dropped because a queue between the main thread and a shard was full.
+    uint64_t nQueueDrops = 0;
+  };
+
+  /** \brief Collect counters and table sizes from all shards.
+   *
+   *  This blocks until every shard has reported.
+   */
+  Status
+  collectStatus() const;
+
+  /** \brief Invoke \p f in each forwarding thread, with the shard index and the shard Forwarder.
+   *
+   *  This blocks until \p f has returned in every shard. An exception thrown by \p f is
+   *  rethrown in the calling thread.
+   */
+  void
+  runInShards(const std::function<void(size_t, Forwarder&)>& f) const;
+
+private:
+  class Shard;
+
+  void
+  addFace(const Face& face);
+
+  void
+  removeFace(const Face& face);
+
+  /** \brief Apply \p f to the shard faces standing for the face with \p faceId in every shard.
+   */
+  void
+  updateShardFaces(FaceId faceId, const std::function<void(face::ShardTransport&)>& f);
+
+  void
+  dispatch(face::ShardPacket&& packet, const Name& name);
+
+  void
+  sendToFace(face::ShardPacket&& packet);
+
+  void
+  scheduleFlush();
+
+  void
+  flushTableChanges();
+
+private:
+  FaceTable& m_faceTable;
+  Forwarder& m_forwarder;
+  const Options m_options;
+  std::vector<shared_ptr<Shard>> m_shards;
+  uint64_t m_nIngressDrops = 0;
+
+  std::map<FaceId, std::vector<signal::ScopedConnection>> m_faceConnections;
+  signal::ScopedConnection m_afterAddFaceConn;
+  signal::ScopedConnection m_beforeRemoveFaceConn;
+  signal::ScopedConnection m_afterFibChangeConn;
+  signal::ScopedConnection m_afterStrategyChoiceChangeConn;
+  signal::ScopedConnection m_afterCsConfigChangeConn;
+
+  std::set<Name> m_changedFibPrefixes;
+  std::set<Name> m_changedStrategyChoicePrefixes;
+  bool m_isCsConfigChanged = false;
+  bool m_isFlushScheduled = false;
+  ndn::scheduler::ScopedEventId m_flushEvent;
+
+  struct CsSettings;
+  unique_ptr<CsSettings> m_csSettings;
+};
+
+} // namespace nfd::fw
+
+#endif // NFD_DAEMON_FW_SHARDED_FORWARDER_HPP
@@ -27,6 +27,7 @@
 #include "fw/forwarder-counters.hpp"
 #include "table/cs.hpp"
 
+#include <ndn-cxx/encoding/block-helpers.hpp>
 #include <ndn-cxx/mgmt/nfd/cs-info.hpp>
 
 #include <limits>
@@ -114,7 +115,15 @@ CsManager::serveInfo(ndn::mgmt::StatusDatasetContext& context) const
   info.setNHits(m_fwCounters.nCsHits);
   info.setNMisses(m_fwCounters.nCsMisses);
 
-  context.append(info.wireEncode());
+  Block wire = info.wireEncode();
+  wire.parse();
+  wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::CsNBytes, m_cs.getNBytes()));
+  if (m_cs.getByteLimit() != std::numeric_limits<size_t>::max()) {
+    wire.push_back(ndn::encoding::makeNonNegativeIntegerBlock(tlv::CsByteCapacity, m_cs.getByteLimit()));
+  }
+  wire.encode();
+
+  context.append(wire);
   context.end();
 }
 
@@ -36,6 +36,22 @@ class Cs;
 
 class ForwarderCounters;
 
+namespace tlv {
+
+/**
+ * \brief TLV-TYPE numbers of NFD-specific fields appended to CsInfo.
+ *
+ * These numbers are taken from the top of the application-specific range of the NDN packet
+ * format, next to those appended to FaceStatus, and are even, i.e., non-critical,
+ * so that CsInfo decoders unaware of them ignore them.
+ */
+enum : uint32_t {
+  CsNBytes       = 32730, ///< total wire size of cached packets
+  CsByteCapacity = 32732, ///< capacity in bytes, omitted if unlimited
+};
+
+} // namespace tlv
+
 /**
  * \brief Implements the CS Management of NFD Management Protocol.
  * \sa https://redmine.named-data.net/projects/nfd/wiki/CsMgmt
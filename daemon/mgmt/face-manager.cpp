@@ -403,13 +403,41 @@ makeFaceStatus(const Face& face, const time::steady_clock::time_point& now)
   return status;
 }
 
+/**
+ * @brief Encode the FaceStatus of @p face, followed by NFD-specific counters.
+ */
+static Block
+encodeFaceStatus(const Face& face, const time::steady_clock::time_point& now)
+{
+  using ndn::encoding::makeNonNegativeIntegerBlock;
+
+  Block wire = makeFaceStatus(face, now).wireEncode();
+  wire.parse();
+  wire.push_back(makeNonNegativeIntegerBlock(tlv::FaceNOutDrops, face.getCounters().nOutDrops));
+
+  auto linkService = dynamic_cast<const face::GenericLinkService*>(face.getLinkService());
+  if (linkService != nullptr) {
+    const auto& counters = linkService->getCounters();
+    wire.push_back(makeNonNegativeIntegerBlock(tlv::FaceNSpuriousRetx, counters.nSpuriousRetx));
+
+    if (linkService->getOptions().allowReassembly) {
+      const auto& reassembler = linkService->getLpReassembler();
+      wire.push_back(makeNonNegativeIntegerBlock(tlv::FaceReassemblyP50,
+                                                 reassembler.getLatencyPercentile(50).count()));
+      wire.push_back(makeNonNegativeIntegerBlock(tlv::FaceReassemblyP99,
+                                                 reassembler.getLatencyPercentile(99).count()));
+    }
+  }
+  wire.encode();
+  return wire;
+}
+
 void
 FaceManager::listFaces(ndn::mgmt::StatusDatasetContext& context)
 {
   auto now = time::steady_clock::now();
   for (const auto& face : m_faceTable) {
-    ndn::nfd::FaceStatus status = makeFaceStatus(face, now);
-    context.append(status.wireEncode());
+    context.append(encodeFaceStatus(face, now));
   }
   context.end();
 }
@@ -486,8 +514,7 @@ FaceManager::queryFaces(const Interest& interest,
   auto now = time::steady_clock::now();
   for (const auto& face : m_faceTable) {
     if (matchFilter(faceFilter, face)) {
-      ndn::nfd::FaceStatus status = makeFaceStatus(face, now);
-      context.append(status.wireEncode());
+      context.append(encodeFaceStatus(face, now));
     }
   }
   context.end();
@@ -34,6 +34,26 @@
 
 namespace nfd {
 
+namespace tlv {
+
+/**
+ * @brief TLV-TYPE numbers of NFD-specific fields appended to FaceStatus.
+ *
+ * These numbers are taken from the top of the application-specific range of the NDN packet
+ * format, next to those of the `status/memory` dataset, and are even, i.e., non-critical,
+ * so that FaceStatus decoders unaware of them ignore them. FaceNSpuriousRetx is present only
+ * for a GenericLinkService, and the reassembly latencies only if it has reassembly enabled
+ * (see LpReassembler::getLatencyPercentile).
+ */
+enum : uint32_t {
+  FaceNOutDrops     = 32720, ///< outgoing packets dropped by the transport
+  FaceNSpuriousRetx = 32722, ///< unnecessary NDNLPv2 retransmissions
+  FaceReassemblyP50 = 32724, ///< bound of the median reassembly latency, in nanoseconds
+  FaceReassemblyP99 = 32726, ///< bound of the 99th percentile reassembly latency, in nanoseconds
+};
+
+} // namespace tlv
+
 /**
  * @brief Implements the Face Management of NFD Management Protocol.
  * @sa https://redmine.named-data.net/projects/nfd/wiki/FaceMgmt
@@ -25,8 +25,11 @@
 
 #include "forwarder-status-manager.hpp"
 #include "fw/forwarder.hpp"
+#include "fw/sharded-forwarder.hpp"
 #include "core/version.hpp"
 
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
 namespace nfd {
 
 ForwarderStatusManager::ForwarderStatusManager(Forwarder& forwarder, Dispatcher& dispatcher)
@@ -36,6 +39,8 @@ ForwarderStatusManager::ForwarderStatusManager(Forwarder& forwarder, Dispatcher&
 {
   m_dispatcher.addStatusDataset("status/general", ndn::mgmt::makeAcceptAllAuthorization(),
     [this] (auto&&, auto&&, auto&& ctx) { listGeneralStatus(std::forward<decltype(ctx)>(ctx)); });
+  m_dispatcher.addStatusDataset("status/memory", ndn::mgmt::makeAcceptAllAuthorization(),
+    [this] (auto&&, auto&&, auto&& ctx) { listMemoryStatus(std::forward<decltype(ctx)>(ctx)); });
 }
 
 ndn::nfd::ForwarderStatus
@@ -47,6 +52,25 @@ ForwarderStatusManager::collectGeneralStatus()
   status.setStartTimestamp(m_startTimestamp);
   status.setCurrentTimestamp(time::system_clock::now());
 
+  if (m_shardedForwarder != nullptr) {
+    // the FIB is replicated in every shard; the other tables are partitioned among the shards
+    auto shardStatus = m_shardedForwarder->collectStatus();
+    status.setNNameTreeEntries(shardStatus.nNameTreeEntries)
+          .setNFibEntries(m_forwarder.getFib().size())
+          .setNPitEntries(shardStatus.nPitEntries)
+          .setNMeasurementsEntries(shardStatus.nMeasurementsEntries)
+          .setNCsEntries(shardStatus.nCsEntries)
+          .setNInInterests(shardStatus.nInInterests)
+          .setNOutInterests(shardStatus.nOutInterests)
+          .setNInData(shardStatus.nInData)
+          .setNOutData(shardStatus.nOutData)
+          .setNInNacks(shardStatus.nInNacks)
+          .setNOutNacks(shardStatus.nOutNacks)
+          .setNSatisfiedInterests(shardStatus.nSatisfiedInterests)
+          .setNUnsatisfiedInterests(shardStatus.nUnsatisfiedInterests);
+    return status;
+  }
+
   status.setNNameTreeEntries(m_forwarder.getNameTree().size());
   status.setNFibEntries(m_forwarder.getFib().size());
   status.setNPitEntries(m_forwarder.getPit().size());
@@ -78,4 +102,24 @@ ForwarderStatusManager::listGeneralStatus(ndn::mgmt::StatusDatasetContext& conte
   context.end();
 }
 
+void
+ForwarderStatusManager::listMemoryStatus(ndn::mgmt::StatusDatasetContext& context)
+{
+  const auto& pools = m_forwarder.getNameTree().getSlabPools();
+  if (pools != nullptr) {
+    pools->forEach([&context] (const SlabPool& pool) {
+      using ndn::encoding::makeNonNegativeIntegerBlock;
+      Block block(tlv::SlabPoolStatus);
+      block.push_back(makeNonNegativeIntegerBlock(tlv::SlabBlockSize, pool.getBlockSize()));
+      block.push_back(makeNonNegativeIntegerBlock(tlv::NSlabs, pool.getNSlabs()));
+      block.push_back(makeNonNegativeIntegerBlock(tlv::NSlabBytes, pool.getNBytesReserved()));
+      block.push_back(makeNonNegativeIntegerBlock(tlv::NBlocksInUse, pool.getNBlocksInUse()));
+      block.push_back(makeNonNegativeIntegerBlock(tlv::NAllocations, pool.getNAllocations()));
+      block.encode();
+      context.append(block);
+    });
+  }
+  context.end();
+}
+
 } // namespace nfd
@@ -34,6 +34,31 @@ namespace nfd {
 
 class Forwarder;
 
+namespace fw {
+class ShardedForwarder;
+} // namespace fw
+
+namespace tlv {
+
+/**
+ * @brief TLV-TYPE numbers of the NFD-specific `status/memory` dataset.
+ *
+ * This dataset is separate from ForwarderStatus and is not part of the NFD Management Protocol.
+ * Its numbers are taken from the top of the application-specific range 253-32767 of the NDN
+ * packet format, away from the numbers assigned to NFD Management, and are even, i.e.,
+ * non-critical, so that a consumer may skip fields it does not know.
+ */
+enum : uint32_t {
+  SlabPoolStatus = 32700,
+  SlabBlockSize  = 32702,
+  NSlabs         = 32704,
+  NSlabBytes     = 32706,
+  NBlocksInUse   = 32708,
+  NAllocations   = 32710,
+};
+
+} // namespace tlv
+
 /**
  * @brief Implements the Forwarder Status of NFD Management Protocol.
  * @sa https://redmine.named-data.net/projects/nfd/wiki/ForwarderStatus
@@ -43,6 +68,16 @@ class ForwarderStatusManager : noncopyable
 public:
   ForwarderStatusManager(Forwarder& forwarder, Dispatcher& dispatcher);
 
+  /**
+   * \brief Report the tables and counters of \p shardedForwarder instead of those of the Forwarder.
+   * \param shardedForwarder the ShardedForwarder that processes packets, or nullptr
+   */
+  void
+  setShardedForwarder(const fw::ShardedForwarder* shardedForwarder) noexcept
+  {
+    m_shardedForwarder = shardedForwarder;
+  }
+
 private:
   ndn::nfd::ForwarderStatus
   collectGeneralStatus();
@@ -53,8 +88,27 @@ private:
   void
   listGeneralStatus(ndn::mgmt::StatusDatasetContext& context);
 
+  /**
+   * \brief Provides the memory pool status dataset.
+   *
+   * The dataset, published under `/localhost/nfd/status/memory`, contains one SlabPoolStatus
+   * element for each size class of the slab pools used by the forwarding tables:
+   *
+   *     SlabPoolStatus = SLAB-POOL-STATUS-TYPE TLV-LENGTH
+   *                        SlabBlockSize
+   *                        NSlabs
+   *                        NSlabBytes
+   *                        NBlocksInUse
+   *                        NAllocations
+   *
+   * Each field is a NonNegativeInteger.
+   */
+  void
+  listMemoryStatus(ndn::mgmt::StatusDatasetContext& context);
+
 private:
   Forwarder& m_forwarder;
+  const fw::ShardedForwarder* m_shardedForwarder = nullptr;
   Dispatcher& m_dispatcher;
   time::system_clock::time_point m_startTimestamp;
 };
@@ -26,11 +26,14 @@
 #include "tables-config-section.hpp"
 #include "fw/strategy.hpp"
 
+#include <limits>
 #include <map>
 
 namespace nfd {
 
 constexpr size_t DEFAULT_CS_MAX_PACKETS = 65536;
+constexpr size_t DEFAULT_CS_DISK_MAX_BYTES = 1024 * 1024 * 1024;
+constexpr size_t MIN_CS_DISK_MAX_BYTES = 8192;
 
 TablesConfigSection::TablesConfigSection(Forwarder& forwarder)
   : m_forwarder(forwarder)
@@ -69,6 +72,12 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun,
     nCsMaxPackets = ConfigFile::parseNumber<size_t>(*csMaxPacketsNode, "cs_max_packets", "tables");
   }
 
+  size_t nCsMaxBytes = std::numeric_limits<size_t>::max();
+  OptionalConfigSection csMaxBytesNode = section.get_child_optional("cs_max_bytes");
+  if (csMaxBytesNode) {
+    nCsMaxBytes = ConfigFile::parseNumber<size_t>(*csMaxBytesNode, "cs_max_bytes", "tables");
+  }
+
   unique_ptr<cs::Policy> csPolicy;
   OptionalConfigSection csPolicyNode = section.get_child_optional("cs_policy");
   if (csPolicyNode) {
@@ -79,6 +88,81 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun,
     }
   }
 
+  cs::TableEngine csEngine = cs::TableEngine::ORDERED;
+  OptionalConfigSection csEngineNode = section.get_child_optional("cs_engine");
+  if (csEngineNode) {
+    std::string engineName = csEngineNode->get_value<std::string>();
+    if (engineName == "hashed") {
+      csEngine = cs::TableEngine::HASHED;
+    }
+    else if (engineName != "ordered") {
+      NDN_THROW(ConfigFile::Error("Unknown cs_engine '" + engineName + "' in section 'tables'"));
+    }
+  }
+
+  std::optional<std::filesystem::path> csDiskPath;
+  cs::DiskStore::Options csDiskOptions;
+  OptionalConfigSection csDiskPathNode = section.get_child_optional("cs_disk_path");
+  if (csDiskPathNode) {
+    csDiskPath = csDiskPathNode->get_value<std::string>();
+    if (csDiskPath->empty()) {
+      NDN_THROW(ConfigFile::Error("Invalid value for option 'cs_disk_path' in section 'tables'"));
+    }
+
+    size_t nCsDiskMaxBytes = DEFAULT_CS_DISK_MAX_BYTES;
+    OptionalConfigSection csDiskMaxBytesNode = section.get_child_optional("cs_disk_max_bytes");
+    if (csDiskMaxBytesNode) {
+      nCsDiskMaxBytes = ConfigFile::parseNumber<size_t>(*csDiskMaxBytesNode, "cs_disk_max_bytes", "tables");
+      ConfigFile::checkRange(nCsDiskMaxBytes, MIN_CS_DISK_MAX_BYTES, std::numeric_limits<size_t>::max(),
+                             "cs_disk_max_bytes", "tables");
+    }
+    // keep at least two segments, so that dropping the oldest one does not empty the store
+    csDiskOptions.segmentSize = std::min(csDiskOptions.segmentSize, nCsDiskMaxBytes / 2);
+    csDiskOptions.maxSegments = nCsDiskMaxBytes / csDiskOptions.segmentSize;
+  }
+
+  auto dnlEngine = DeadNonceList::Engine::EXACT;
+  OptionalConfigSection dnlEngineNode = section.get_child_optional("dnl_engine");
+  if (dnlEngineNode) {
+    std::string engineName = dnlEngineNode->get_value<std::string>();
+    if (engineName == "filter") {
+      dnlEngine = DeadNonceList::Engine::FILTER;
+    }
+    else if (engineName != "exact") {
+      NDN_THROW(ConfigFile::Error("Unknown dnl_engine '" + engineName + "' in section 'tables'"));
+    }
+  }
+
+  double dnlFalsePositiveRate = DeadNonceList::DEFAULT_FALSE_POSITIVE_RATE;
+  OptionalConfigSection dnlFalsePositiveRateNode = section.get_child_optional("dnl_false_positive_rate");
+  if (dnlFalsePositiveRateNode) {
+    dnlFalsePositiveRate = ConfigFile::parseNumber<double>(*dnlFalsePositiveRateNode,
+                                                           "dnl_false_positive_rate", "tables");
+    if (!(dnlFalsePositiveRate > 0.0 && dnlFalsePositiveRate < 1.0)) {
+      NDN_THROW(ConfigFile::Error("Invalid value for option 'dnl_false_positive_rate' in section 'tables': "
+                                  "must be between 0 and 1 exclusive"));
+    }
+  }
+
+  auto nameTreeEngine = name_tree::HashtableEngine::CHAINED;
+  OptionalConfigSection nameTreeEngineNode = section.get_child_optional("name_tree_engine");
+  if (nameTreeEngineNode) {
+    std::string engineName = nameTreeEngineNode->get_value<std::string>();
+    if (engineName == "open_addressing") {
+      nameTreeEngine = name_tree::HashtableEngine::OPEN_ADDRESSING;
+    }
+    else if (engineName != "chained") {
+      NDN_THROW(ConfigFile::Error("Unknown name_tree_engine '" + engineName + "' in section 'tables'"));
+    }
+  }
+
+  bool isNameTreeResizeIncremental = false;
+  OptionalConfigSection nameTreeResizeNode = section.get_child_optional("name_tree_incremental_resize");
+  if (nameTreeResizeNode) {
+    isNameTreeResizeIncremental = ConfigFile::parseYesNo(*nameTreeResizeNode,
+                                                         "name_tree_incremental_resize", "tables");
+  }
+
   unique_ptr<fw::UnsolicitedDataPolicy> unsolicitedDataPolicy;
   OptionalConfigSection unsolicitedDataPolicyNode = section.get_child_optional("cs_unsolicited_policy");
   if (unsolicitedDataPolicyNode) {
@@ -108,15 +192,49 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun,
 
   Cs& cs = m_forwarder.getCs();
   cs.setLimit(nCsMaxPackets);
+  cs.setByteLimit(nCsMaxBytes);
   if (cs.size() == 0 && csPolicy != nullptr) {
     cs.setPolicy(std::move(csPolicy));
   }
+  cs.setEngine(csEngine);
+  this->applyCsDiskStore(csDiskPath, csDiskOptions);
+
+  m_forwarder.getDeadNonceList().setEngine(dnlEngine, dnlFalsePositiveRate);
+
+  m_forwarder.getNameTree().setHashtableEngine(nameTreeEngine, isNameTreeResizeIncremental);
 
   m_forwarder.setUnsolicitedDataPolicy(std::move(unsolicitedDataPolicy));
 
   m_isConfigured = true;
 }
 
+void
+TablesConfigSection::applyCsDiskStore(const std::optional<std::filesystem::path>& path,
+                                      const cs::DiskStore::Options& options)
+{
+  Cs& cs = m_forwarder.getCs();
+  const cs::DiskStore* current = cs.getDiskStore();
+  if (path && current != nullptr && current->getPath() == *path &&
+      current->getOptions().segmentSize == options.segmentSize &&
+      current->getOptions().maxSegments == options.maxSegments) {
+    return;
+  }
+
+  // close the current store first, in case the new one uses the same directory
+  cs.setDiskStore(nullptr);
+  if (!path) {
+    return;
+  }
+
+  try {
+    cs.setDiskStore(make_unique<cs::DiskStore>(*path, options));
+  }
+  catch (const cs::DiskStore::Error& e) {
+    NDN_THROW_NESTED(ConfigFile::Error("Cannot open cs_disk_path '" + path->string() +
+                                       "' in section 'tables': " + e.what()));
+  }
+}
+
 void
 TablesConfigSection::processStrategyChoiceSection(const ConfigSection& section, bool isDryRun)
 {
@@ -38,8 +38,14 @@ namespace nfd {
  *  tables
  *  {
  *    cs_max_packets 65536
+ *    cs_max_bytes 536870912
  *    cs_policy lru
+ *    cs_engine ordered
+ *    cs_disk_path /var/cache/ndn/nfd-cs
+ *    cs_disk_max_bytes 1073741824
  *    cs_unsolicited_policy drop-all
+ *    dnl_engine exact
+ *    dnl_false_positive_rate 0.001
  *
  *    strategy_choice
  *    {
@@ -58,8 +64,12 @@ namespace nfd {
  *  \endcode
  *
  *  During a configuration reload,
- *  \li cs_max_packets, cs_policy, and cs_unsolicited_policy are applied;
+ *  \li cs_max_packets, cs_max_bytes, cs_policy, cs_engine, and cs_unsolicited_policy are applied;
  *      defaults are used if an option is omitted.
+ *  \li cs_disk_path and cs_disk_max_bytes are applied; the disk store is reopened only if they
+ *      change, and detached if cs_disk_path is omitted.
+ *  \li dnl_engine and dnl_false_positive_rate are applied; the Dead Nonce List is emptied only if
+ *      they change, and the defaults are used if an option is omitted.
  *  \li strategy_choice entries are inserted, but old entries are not deleted.
  *  \li network_region is applied; it's kept unchanged if the section is omitted.
  *
@@ -86,6 +96,10 @@ private:
   void
   processConfig(const ConfigSection& section, bool isDryRun, const std::string& filename);
 
+  void
+  applyCsDiskStore(const std::optional<std::filesystem::path>& path,
+                   const cs::DiskStore::Options& options);
+
   void
   processStrategyChoiceSection(const ConfigSection& section, bool isDryRun);
 
@@ -32,6 +32,7 @@
 #include "face/null-face.hpp"
 #include "fw/face-table.hpp"
 #include "fw/forwarder.hpp"
+#include "fw/sharded-forwarder.hpp"
 #include "mgmt/cs-manager.hpp"
 #include "mgmt/face-manager.hpp"
 #include "mgmt/fib-manager.hpp"
@@ -175,6 +176,23 @@ Nfd::initializeManagement()
   fib::Entry* entry = m_forwarder->getFib().insert(topPrefix).first;
   m_forwarder->getFib().addOrUpdateNextHop(*entry, *m_internalFace, 0);
   m_dispatcher->addTopPrefix(topPrefix, false);
+
+  startShardedForwarder();
+}
+
+void
+Nfd::startShardedForwarder()
+{
+  const auto& fwConfig = m_forwarder->getConfig();
+  if (fwConfig.nThreads <= 1 && !fwConfig.wantForwardingOffload) {
+    return;
+  }
+
+  fw::ShardedForwarder::Options options;
+  options.nShards = fwConfig.nThreads;
+  options.shardPrefixLength = fwConfig.shardPrefixLength;
+  m_shardedForwarder = make_unique<fw::ShardedForwarder>(*m_faceTable, *m_forwarder, options);
+  m_forwarderStatusManager->setShardedForwarder(m_shardedForwarder.get());
 }
 
 void
@@ -199,6 +217,17 @@ Nfd::reloadConfigFile()
   else {
     config.parse(m_configSection, false, INTERNAL_CONFIG);
   }
+
+  const auto& fwConfig = m_forwarder->getConfig();
+  bool isSharded = m_shardedForwarder != nullptr;
+  size_t nThreads = isSharded ? m_shardedForwarder->getNShards() : 1;
+  if (fwConfig.nThreads != nThreads ||
+      (fwConfig.nThreads <= 1 && fwConfig.wantForwardingOffload != isSharded)) {
+    NFD_LOG_WARN("Changing forwarder.threads or forwarder.offload_forwarding requires a restart");
+  }
+  if (m_shardedForwarder != nullptr) {
+    m_shardedForwarder->syncTables();
+  }
 }
 
 void
@@ -39,6 +39,10 @@ namespace nfd {
 class FaceTable;
 class Forwarder;
 
+namespace fw {
+class ShardedForwarder;
+} // namespace fw
+
 class CommandAuthenticator;
 class ForwarderStatusManager;
 class FaceManager;
@@ -107,6 +111,9 @@ private:
   void
   reloadConfigFileFaceSection();
 
+  void
+  startShardedForwarder();
+
 private:
   std::string m_configFile;
   ConfigSection m_configSection;
@@ -114,6 +121,7 @@ private:
   unique_ptr<FaceTable> m_faceTable;
   unique_ptr<face::FaceSystem> m_faceSystem;
   unique_ptr<Forwarder> m_forwarder;
+  unique_ptr<fw::ShardedForwarder> m_shardedForwarder;
 
   ndn::KeyChain& m_keyChain;
   shared_ptr<face::Face> m_internalFace;
@@ -0,0 +1,359 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2023,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-disk-store.hpp"
+#include "common/logger.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <set>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nfd::cs {
+
+NFD_LOG_INIT(CsDiskStore);
+
+namespace fs = std::filesystem;
+
+/** \brief Header preceding each packet in a segment.
+ *
+ *  A segment is zero-filled when created, so a zero magic marks the end of the log in a segment.
+ */
+struct RecordHeader
+{
+  uint32_t magic;
+  uint32_t wireSize;
+  int64_t freshUntil; ///< milliseconds since system_clock epoch
+};
+
+constexpr uint32_t RECORD_MAGIC = 0x4e444353; // "NDCS"
+constexpr size_t RECORD_ALIGNMENT = alignof(RecordHeader);
+const std::string SEGMENT_EXTENSION = ".seg";
+
+#ifdef __APPLE__
+using MincoreVecType = char;
+#else
+using MincoreVecType = unsigned char;
+#endif
+
+static size_t
+computeRecordSize(size_t wireSize)
+{
+  return (sizeof(RecordHeader) + wireSize + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT * RECORD_ALIGNMENT;
+}
+
+static size_t
+hashName(const Name& name)
+{
+  return std::hash<Name>{}(name);
+}
+
+/** \brief Determine whether all pages in [addr, addr+len) are resident; if not,
+ *         request an asynchronous read-ahead of them.
+ */
+static bool
+ensureResident(const uint8_t* addr, size_t len)
+{
+  static const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  auto first = reinterpret_cast<uintptr_t>(addr) / pageSize * pageSize;
+  auto last = reinterpret_cast<uintptr_t>(addr) + len;
+  size_t nPages = (last - first + pageSize - 1) / pageSize;
+
+  std::vector<MincoreVecType> residency(nPages);
+  if (::mincore(reinterpret_cast<void*>(first), last - first, residency.data()) != 0) {
+    return false;
+  }
+  bool isResident = std::all_of(residency.begin(), residency.end(), [] (auto v) { return (v & 1) != 0; });
+  if (!isResident) {
+    ::madvise(reinterpret_cast<void*>(first), last - first, MADV_WILLNEED);
+  }
+  return isResident;
+}
+
+DiskStore::DiskStore(fs::path dir, const Options& options)
+  : m_dir(std::move(dir))
+  , m_options(options)
+{
+  BOOST_ASSERT(m_options.maxSegments >= 1);
+  BOOST_ASSERT(m_options.segmentSize > sizeof(RecordHeader));
+
+  std::error_code ec;
+  fs::create_directories(m_dir, ec);
+  if (ec) {
+    NDN_THROW(Error("Cannot create " + m_dir.string() + ": " + ec.message()));
+  }
+
+  std::set<uint64_t> ids;
+  for (const auto& file : fs::directory_iterator(m_dir, ec)) {
+    if (file.path().extension() != SEGMENT_EXTENSION) {
+      continue;
+    }
+    try {
+      ids.insert(std::stoull(file.path().stem().string()));
+    }
+    catch (const std::logic_error&) {
+      NFD_LOG_WARN("Ignoring " << file.path());
+    }
+  }
+  if (ec) {
+    NDN_THROW(Error("Cannot list " + m_dir.string() + ": " + ec.message()));
+  }
+
+  // segment ids may have gaps, e.g., if a segment was deleted by hand or could not be opened
+  for (uint64_t id : ids) {
+    try {
+      m_segments.push_back(mapSegment(id, false));
+    }
+    catch (const Error& e) {
+      NFD_LOG_WARN("Skipping segment " << id << ": " << e.what());
+      continue;
+    }
+    scanSegment(m_segments.back());
+  }
+  while (m_segments.size() > m_options.maxSegments) {
+    dropOldestSegment();
+  }
+
+  NFD_LOG_INFO("Opened " << m_dir << " with " << m_segments.size() << " segments and "
+               << m_index.size() << " packets");
+}
+
+DiskStore::~DiskStore()
+{
+  for (const auto& segment : m_segments) {
+    ::msync(segment.base, segment.used, MS_ASYNC);
+    ::munmap(segment.base, segment.size);
+  }
+}
+
+fs::path
+DiskStore::makeSegmentPath(uint64_t id) const
+{
+  return m_dir / (std::to_string(id) + SEGMENT_EXTENSION);
+}
+
+DiskStore::Segment
+DiskStore::mapSegment(uint64_t id, bool isNew) const
+{
+  auto path = makeSegmentPath(id);
+  int fd = ::open(path.c_str(), isNew ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0644);
+  if (fd < 0) {
+    NDN_THROW_ERRNO(Error("Cannot open " + path.string()));
+  }
+
+  size_t size = m_options.segmentSize;
+  struct stat st;
+  if (isNew ? ::ftruncate(fd, static_cast<off_t>(size)) != 0 : ::fstat(fd, &st) != 0) {
+    int errNum = errno;
+    ::close(fd);
+    errno = errNum;
+    NDN_THROW_ERRNO(Error("Cannot size " + path.string()));
+  }
+  if (!isNew) {
+    size = static_cast<size_t>(st.st_size);
+    if (size < sizeof(RecordHeader)) {
+      // nothing can be recovered from it, and it would be skipped again on every restart
+      ::close(fd);
+      std::error_code ec;
+      fs::remove(path, ec);
+      NDN_THROW(Error("Segment " + path.string() + " is truncated and has been removed"));
+    }
+  }
+
+  void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int errNum = errno;
+  ::close(fd); // the mapping stays valid
+  if (base == MAP_FAILED) {
+    errno = errNum;
+    NDN_THROW_ERRNO(Error("Cannot map " + path.string()));
+  }
+
+  return {id, static_cast<uint8_t*>(base), size, 0, {}};
+}
+
+void
+DiskStore::scanSegment(Segment& segment)
+{
+  size_t offset = 0;
+  while (offset + sizeof(RecordHeader) <= segment.size) {
+    RecordHeader header;
+    std::memcpy(&header, segment.base + offset, sizeof(header));
+    if (header.magic != RECORD_MAGIC || header.wireSize == 0 ||
+        offset + computeRecordSize(header.wireSize) > segment.size) {
+      break;
+    }
+
+    auto [isOk, block] = Block::fromBuffer({segment.base + offset + sizeof(header), header.wireSize});
+    if (!isOk || block.type() != tlv::Data || block.size() != header.wireSize) {
+      NFD_LOG_WARN("Truncated log in " << makeSegmentPath(segment.id) << " at offset " << offset);
+      break;
+    }
+    try {
+      Data data(block);
+      addToIndex(segment, hashName(data.getName()), offset, header.wireSize);
+    }
+    catch (const tlv::Error& e) {
+      NFD_LOG_WARN("Malformed Data in " << makeSegmentPath(segment.id) << " at offset " << offset
+                   << ": " << e.what());
+      break;
+    }
+    offset += computeRecordSize(header.wireSize);
+  }
+  segment.used = offset;
+}
+
+void
+DiskStore::appendSegment()
+{
+  uint64_t id = m_segments.empty() ? 0 : m_segments.back().id + 1;
+  m_segments.push_back(mapSegment(id, true));
+  while (m_segments.size() > m_options.maxSegments) {
+    dropOldestSegment();
+  }
+}
+
+void
+DiskStore::dropOldestSegment()
+{
+  BOOST_ASSERT(!m_segments.empty());
+  const Segment& segment = m_segments.front();
+
+  for (size_t nameHash : segment.nameHashes) {
+    auto range = m_index.equal_range(nameHash);
+    for (auto it = range.first; it != range.second;) {
+      it = it->second.segmentId == segment.id ? m_index.erase(it) : std::next(it);
+    }
+  }
+
+  ::munmap(segment.base, segment.size);
+  std::error_code ec;
+  fs::remove(makeSegmentPath(segment.id), ec);
+  NFD_LOG_DEBUG("Dropped segment " << segment.id);
+  m_segments.pop_front();
+}
+
+void
+DiskStore::addToIndex(Segment& segment, size_t nameHash, size_t offset, size_t wireSize)
+{
+  m_index.emplace(nameHash, Location{segment.id, offset, wireSize});
+  segment.nameHashes.push_back(nameHash);
+}
+
+void
+DiskStore::insert(const Data& data, time::system_clock::time_point freshUntil)
+{
+  const Block& wire = data.wireEncode();
+  size_t recordSize = computeRecordSize(wire.size());
+  if (recordSize > m_options.segmentSize) {
+    NFD_LOG_DEBUG("insert " << data.getName() << " too-large");
+    return;
+  }
+
+  if (m_segments.empty() || m_segments.back().used + recordSize > m_segments.back().size) {
+    try {
+      appendSegment();
+    }
+    catch (const Error& e) {
+      NFD_LOG_ERROR("Cannot add segment: " << e.what());
+      return;
+    }
+  }
+
+  Segment& segment = m_segments.back();
+  uint8_t* record = segment.base + segment.used;
+  RecordHeader header{0, static_cast<uint32_t>(wire.size()),
+                      time::duration_cast<time::milliseconds>(freshUntil.time_since_epoch()).count()};
+  std::memcpy(record, &header, sizeof(header));
+  std::memcpy(record + sizeof(header), wire.data(), wire.size());
+  // write the magic last, so that a partially written record ends the log
+  std::memcpy(record, &RECORD_MAGIC, sizeof(RECORD_MAGIC));
+
+  NFD_LOG_DEBUG("insert " << data.getName() << " segment=" << segment.id << " offset=" << segment.used);
+  addToIndex(segment, hashName(data.getName()), segment.used, wire.size());
+  segment.used += recordSize;
+}
+
+shared_ptr<const Data>
+DiskStore::find(const Interest& interest) const
+{
+  if (interest.getCanBePrefix()) {
+    return nullptr;
+  }
+
+  // without CanBePrefix, the Interest name equals either the Data name or the Data full name
+  const Name& name = interest.getName();
+  auto findByName = [&] (const Name& dataName) -> shared_ptr<const Data> {
+    auto range = m_index.equal_range(hashName(dataName));
+    for (auto it = range.first; it != range.second; ++it) {
+      auto data = readRecord(it->second, interest);
+      if (data != nullptr) {
+        return data;
+      }
+    }
+    return nullptr;
+  };
+
+  auto data = findByName(name);
+  if (data == nullptr && !name.empty() && name[-1].isImplicitSha256Digest()) {
+    data = findByName(name.getPrefix(-1));
+  }
+  return data;
+}
+
+shared_ptr<const Data>
+DiskStore::readRecord(const Location& loc, const Interest& interest) const
+{
+  auto it = std::lower_bound(m_segments.begin(), m_segments.end(), loc.segmentId,
+                             [] (const Segment& segment, uint64_t id) { return segment.id < id; });
+  BOOST_ASSERT(it != m_segments.end() && it->id == loc.segmentId);
+  const Segment& segment = *it;
+  const uint8_t* record = segment.base + loc.offset;
+
+  if (!ensureResident(record, sizeof(RecordHeader) + loc.wireSize)) {
+    ++m_nDeferredLookups;
+    NFD_LOG_DEBUG("find " << interest.getName() << " deferred segment=" << segment.id);
+    return nullptr;
+  }
+
+  RecordHeader header;
+  std::memcpy(&header, record, sizeof(header));
+  if (interest.getMustBeFresh() &&
+      time::system_clock::now().time_since_epoch() > time::milliseconds(header.freshUntil)) {
+    return nullptr;
+  }
+
+  auto data = make_shared<Data>(Block(ndn::make_span(record + sizeof(header), loc.wireSize)));
+  if (!interest.matchesData(*data)) {
+    return nullptr;
+  }
+  return data;
+}
+
+} // namespace nfd::cs
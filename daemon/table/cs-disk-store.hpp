@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2023,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_DISK_STORE_HPP
+#define NFD_DAEMON_TABLE_CS_DISK_STORE_HPP
+
+#include "core/common.hpp"
+
+#include <deque>
+#include <filesystem>
+#include <unordered_map>
+
+namespace nfd::cs {
+
+/** \brief A disk-backed second tier of the Content Store.
+ *
+ *  Data packets are appended in wire format to a log of fixed-size segment files in a directory.
+ *  Each segment is memory-mapped. When the number of segments exceeds a limit, the oldest segment
+ *  is deleted together with the packets in it. An in-memory index maps the hash of each Data name
+ *  to the location of the packet, so that the store serves Interests without CanBePrefix.
+ *  The segments are kept when the store is closed, and are indexed again when it is reopened.
+ *
+ *  A lookup never blocks on disk I/O: if the pages holding a candidate packet are not resident
+ *  in memory, an asynchronous read-ahead of those pages is requested and the lookup misses.
+ *  A later lookup of the same name is then served from the page cache.
+ *
+ *  \note Erasure by prefix is not supported; packets leave the store only with their segment.
+ */
+class DiskStore : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  struct Options
+  {
+    /** \brief Size of each segment file, in bytes.
+     */
+    size_t segmentSize = 64 * 1024 * 1024;
+
+    /** \brief Maximum number of segment files; must be at least 1.
+     */
+    size_t maxSegments = 16;
+  };
+
+  /** \brief Open the store in \p dir, creating the directory if necessary.
+   *  \throw Error the directory cannot be created or listed
+   *
+   *  An existing segment that cannot be opened is logged and skipped; a segment too short to
+   *  hold any packet is also deleted.
+   */
+  explicit
+  DiskStore(std::filesystem::path dir, const Options& options);
+
+  /** \brief Unmaps all segments; segment files are kept on disk.
+   */
+  ~DiskStore();
+
+  /** \brief Append a Data packet to the log.
+   *  \param data the Data, which must have a wire encoding
+   *  \param freshUntil when the Data becomes non-fresh
+   *
+   *  Failures to create a new segment are logged and the packet is dropped.
+   */
+  void
+  insert(const Data& data, time::system_clock::time_point freshUntil);
+
+  /** \brief Find a Data packet that can satisfy \p interest.
+   *  \return the Data, or nullptr if none is found or its pages are not resident in memory
+   *  \note Interests with CanBePrefix are not served.
+   */
+  shared_ptr<const Data>
+  find(const Interest& interest) const;
+
+  const std::filesystem::path&
+  getPath() const noexcept
+  {
+    return m_dir;
+  }
+
+  const Options&
+  getOptions() const noexcept
+  {
+    return m_options;
+  }
+
+  /** \return number of indexed packets
+   */
+  size_t
+  size() const noexcept
+  {
+    return m_index.size();
+  }
+
+  /** \return number of lookups that missed because the candidate pages were not resident
+   */
+  uint64_t
+  getNDeferredLookups() const noexcept
+  {
+    return m_nDeferredLookups;
+  }
+
+private:
+  struct Segment
+  {
+    uint64_t id;
+    uint8_t* base;
+    size_t size;
+    size_t used;
+    std::vector<size_t> nameHashes; ///< index keys of packets in this segment
+  };
+
+  struct Location
+  {
+    uint64_t segmentId;
+    size_t offset;
+    size_t wireSize;
+  };
+
+  std::filesystem::path
+  makeSegmentPath(uint64_t id) const;
+
+  /** \brief Map segment file \p id.
+   *  \param isNew whether to create a new zero-filled file, replacing any existing one
+   *  \throw Error the file cannot be opened or mapped, or an existing file is truncated,
+   *               in which case it is deleted
+   */
+  Segment
+  mapSegment(uint64_t id, bool isNew) const;
+
+  /** \brief Index the packets in \p segment, setting `segment.used` to the end of the last one.
+   */
+  void
+  scanSegment(Segment& segment);
+
+  /** \brief Add a new segment at the end of the log, deleting the oldest one if necessary.
+   *  \throw Error
+   */
+  void
+  appendSegment();
+
+  void
+  dropOldestSegment();
+
+  void
+  addToIndex(Segment& segment, size_t nameHash, size_t offset, size_t wireSize);
+
+  /** \return the packet at \p loc, or nullptr if its pages are not resident or it cannot satisfy
+   *          \p interest
+   */
+  shared_ptr<const Data>
+  readRecord(const Location& loc, const Interest& interest) const;
+
+private:
+  std::filesystem::path m_dir;
+  Options m_options;
+  std::deque<Segment> m_segments; ///< ordered by id, which may have gaps
+  std::unordered_multimap<size_t, Location> m_index;
+  mutable uint64_t m_nDeferredLookups = 0;
+};
+
+} // namespace nfd::cs
+
+#endif // NFD_DAEMON_TABLE_CS_DISK_STORE_HPP
@@ -28,13 +28,34 @@
 
 #include "core/common.hpp"
 
-#include <set>
+#include <boost/container/set.hpp>
+#include <boost/intrusive/list.hpp>
+#include <ndn-cxx/util/scheduler.hpp>
 
 namespace nfd::cs {
 
+class Entry;
+
+/** \brief An ordered container of ContentStore entries.
+ *
+ *  This container uses std::less<> comparator to enable lookup with queryName.
+ *  Unlike std::set, boost::container::set supports an incomplete value type,
+ *  so that each Entry can hold an iterator to itself.
+ */
+using Table = boost::container::set<Entry, std::less<>>;
+
+struct PolicyHookTag;
+
+/** \brief Hook that links a ContentStore entry into a queue of the replacement policy.
+ */
+using PolicyHook = boost::intrusive::list_base_hook<boost::intrusive::tag<PolicyHookTag>>;
+
 /** \brief A ContentStore entry.
+ *
+ *  The replacement policy keeps entries in intrusive queues through the PolicyHook base,
+ *  together with PolicyData, so that it needs neither allocation nor lookup per operation.
  */
-class Entry
+class Entry : public PolicyHook
 {
 public: // exposed through ContentStore enumeration
   /** \brief Return the stored Data.
@@ -87,6 +108,14 @@ public: // used by ContentStore implementation
   void
   updateFreshUntil();
 
+  /** \brief Return when the stored Data becomes non-fresh.
+   */
+  time::steady_clock::time_point
+  getFreshUntil() const
+  {
+    return m_freshUntil;
+  }
+
   /** \brief Clear 'unsolicited' flag.
    */
   void
@@ -95,10 +124,43 @@ public: // used by ContentStore implementation
     m_isUnsolicited = false;
   }
 
+  /** \brief Record the position of this entry in the Table.
+   */
+  void
+  setIterator(Table::const_iterator it)
+  {
+    m_self = it;
+  }
+
+public: // used by replacement policy
+  /** \brief Per-entry state owned by the replacement policy.
+   */
+  struct PolicyData
+  {
+    uint8_t queue = 0; ///< policy-defined queue identifier
+    ndn::scheduler::ScopedEventId timer; ///< policy-defined timer, cancelled with the entry
+  };
+
+  /** \brief Return the position of this entry in the Table.
+   */
+  Table::const_iterator
+  getIterator() const
+  {
+    return m_self;
+  }
+
+  PolicyData&
+  getPolicyData() const
+  {
+    return m_policyData;
+  }
+
 private:
   shared_ptr<const Data> m_data;
   bool m_isUnsolicited;
   time::steady_clock::time_point m_freshUntil;
+  Table::const_iterator m_self;
+  mutable PolicyData m_policyData;
 };
 
 bool
@@ -110,11 +172,9 @@ operator<(const Name& queryName, const Entry& entry);
 bool
 operator<(const Entry& lhs, const Entry& rhs);
 
-/** \brief An ordered container of ContentStore entries.
- *
- *  This container uses std::less<> comparator to enable lookup with queryName.
+/** \brief An intrusive queue of ContentStore entries, linked through their PolicyHook.
  */
-using Table = std::set<Entry, std::less<>>;
+using PolicyQueue = boost::intrusive::list<Entry, boost::intrusive::base_hook<PolicyHook>>;
 
 inline bool
 operator<(Table::const_iterator lhs, Table::const_iterator rhs)
@@ -51,7 +51,7 @@ LruPolicy::doAfterRefresh(EntryRef i)
 void
 LruPolicy::doBeforeErase(EntryRef i)
 {
-  m_queue.get<1>().erase(i);
+  m_queue.erase(m_queue.iterator_to(getEntry(i)));
 }
 
 void
@@ -64,9 +64,9 @@ void
 LruPolicy::evictEntries()
 {
   BOOST_ASSERT(this->getCs() != nullptr);
-  while (this->getCs()->size() > this->getLimit()) {
+  while (this->isOverLimit()) {
     BOOST_ASSERT(!m_queue.empty());
-    EntryRef i = m_queue.front();
+    EntryRef i = m_queue.front().getIterator();
     m_queue.pop_front();
     emitSignal(beforeEvict, i);
   }
@@ -75,12 +75,13 @@ LruPolicy::evictEntries()
 void
 LruPolicy::insertToQueue(EntryRef i, bool isNewEntry)
 {
-  // push_back only if i does not exist
-  auto [it, isNew] = m_queue.push_back(i);
-
-  BOOST_ASSERT(isNew == isNewEntry);
-  if (!isNewEntry) {
-    m_queue.relocate(m_queue.end(), it);
+  Entry& entry = getEntry(i);
+  BOOST_ASSERT(entry.is_linked() != isNewEntry);
+  if (isNewEntry) {
+    m_queue.push_back(entry);
+  }
+  else {
+    m_queue.splice(m_queue.end(), m_queue, m_queue.iterator_to(entry));
   }
 }
 
@@ -28,20 +28,12 @@
 
 #include "cs-policy.hpp"
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/sequenced_index.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-
 namespace nfd::cs {
 namespace lru {
 
-using Queue = boost::multi_index_container<
-                Policy::EntryRef,
-                boost::multi_index::indexed_by<
-                  boost::multi_index::sequenced<>,
-                  boost::multi_index::ordered_unique<boost::multi_index::identity<Policy::EntryRef>>
-                >
-              >;
+/** \brief Queue of entries, from least recently used to most recently used.
+ */
+using Queue = PolicyQueue;
 
 /**
  * \brief Least-Recently-Used (LRU) replacement policy.
@@ -36,13 +36,6 @@ PriorityFifoPolicy::PriorityFifoPolicy()
 {
 }
 
-PriorityFifoPolicy::~PriorityFifoPolicy()
-{
-  for (auto entryInfoMapPair : m_entryInfoMap) {
-    delete entryInfoMapPair.second;
-  }
-}
-
 void
 PriorityFifoPolicy::doAfterInsert(EntryRef i)
 {
@@ -66,7 +59,7 @@ PriorityFifoPolicy::doBeforeErase(EntryRef i)
 void
 PriorityFifoPolicy::doBeforeUse(EntryRef i)
 {
-  BOOST_ASSERT(m_entryInfoMap.find(i) != m_entryInfoMap.end());
+  BOOST_ASSERT(i->is_linked());
 }
 
 void
@@ -74,7 +67,7 @@ PriorityFifoPolicy::evictEntries()
 {
   BOOST_ASSERT(this->getCs() != nullptr);
 
-  while (this->getCs()->size() > this->getLimit()) {
+  while (this->isOverLimit()) {
     this->evictOne();
   }
 }
@@ -88,13 +81,13 @@ PriorityFifoPolicy::evictOne()
 
   EntryRef i;
   if (!m_queues[QUEUE_UNSOLICITED].empty()) {
-    i = m_queues[QUEUE_UNSOLICITED].front();
+    i = m_queues[QUEUE_UNSOLICITED].front().getIterator();
   }
   else if (!m_queues[QUEUE_STALE].empty()) {
-    i = m_queues[QUEUE_STALE].front();
+    i = m_queues[QUEUE_STALE].front().getIterator();
   }
   else if (!m_queues[QUEUE_FIFO].empty()) {
-    i = m_queues[QUEUE_FIFO].front();
+    i = m_queues[QUEUE_FIFO].front().getIterator();
   }
 
   this->detachQueue(i);
@@ -104,55 +97,53 @@ PriorityFifoPolicy::evictOne()
 void
 PriorityFifoPolicy::attachQueue(EntryRef i)
 {
-  BOOST_ASSERT(m_entryInfoMap.find(i) == m_entryInfoMap.end());
+  Entry& entry = getEntry(i);
+  BOOST_ASSERT(!entry.is_linked());
 
-  EntryInfo* entryInfo = new EntryInfo();
+  auto& info = entry.getPolicyData();
   if (i->isUnsolicited()) {
-    entryInfo->queueType = QUEUE_UNSOLICITED;
+    info.queue = QUEUE_UNSOLICITED;
   }
   else if (!i->isFresh()) {
-    entryInfo->queueType = QUEUE_STALE;
+    info.queue = QUEUE_STALE;
   }
   else {
-    entryInfo->queueType = QUEUE_FIFO;
-    entryInfo->moveStaleEventId = getScheduler().schedule(i->getData().getFreshnessPeriod(),
-                                                          [=] { moveToStaleQueue(i); });
+    info.queue = QUEUE_FIFO;
+    info.timer = getScheduler().schedule(i->getData().getFreshnessPeriod(),
+                                         [=] { moveToStaleQueue(i); });
   }
 
-  Queue& queue = m_queues[entryInfo->queueType];
-  entryInfo->queueIt = queue.insert(queue.end(), i);
-  m_entryInfoMap[i] = entryInfo;
+  m_queues[info.queue].push_back(entry);
 }
 
 void
 PriorityFifoPolicy::detachQueue(EntryRef i)
 {
-  BOOST_ASSERT(m_entryInfoMap.find(i) != m_entryInfoMap.end());
+  Entry& entry = getEntry(i);
+  BOOST_ASSERT(entry.is_linked());
 
-  EntryInfo* entryInfo = m_entryInfoMap[i];
-  if (entryInfo->queueType == QUEUE_FIFO) {
-    entryInfo->moveStaleEventId.cancel();
+  auto& info = entry.getPolicyData();
+  if (info.queue == QUEUE_FIFO) {
+    info.timer.cancel();
   }
 
-  m_queues[entryInfo->queueType].erase(entryInfo->queueIt);
-  m_entryInfoMap.erase(i);
-  delete entryInfo;
+  Queue& queue = m_queues[info.queue];
+  queue.erase(queue.iterator_to(entry));
 }
 
 void
 PriorityFifoPolicy::moveToStaleQueue(EntryRef i)
 {
-  BOOST_ASSERT(m_entryInfoMap.find(i) != m_entryInfoMap.end());
+  Entry& entry = getEntry(i);
+  BOOST_ASSERT(entry.is_linked());
 
-  EntryInfo* entryInfo = m_entryInfoMap[i];
-  BOOST_ASSERT(entryInfo->queueType == QUEUE_FIFO);
+  auto& info = entry.getPolicyData();
+  BOOST_ASSERT(info.queue == QUEUE_FIFO);
 
-  m_queues[QUEUE_FIFO].erase(entryInfo->queueIt);
+  m_queues[QUEUE_FIFO].erase(m_queues[QUEUE_FIFO].iterator_to(entry));
 
-  entryInfo->queueType = QUEUE_STALE;
-  Queue& queue = m_queues[QUEUE_STALE];
-  entryInfo->queueIt = queue.insert(queue.end(), i);
-  m_entryInfoMap[i] = entryInfo;
+  info.queue = QUEUE_STALE;
+  m_queues[QUEUE_STALE].push_back(entry);
 }
 
 } // namespace nfd::cs::priority_fifo
@@ -28,14 +28,10 @@
 
 #include "cs-policy.hpp"
 
-#include <ndn-cxx/util/scheduler.hpp>
-
-#include <list>
-
 namespace nfd::cs {
 namespace priority_fifo {
 
-using Queue = std::list<Policy::EntryRef>;
+using Queue = PolicyQueue;
 
 enum QueueType {
   QUEUE_UNSOLICITED,
@@ -44,22 +40,17 @@ enum QueueType {
   QUEUE_MAX
 };
 
-struct EntryInfo
-{
-  QueueType queueType;
-  Queue::iterator queueIt;
-  ndn::scheduler::EventId moveStaleEventId;
-};
-
 /** \brief Priority First-In-First-Out (FIFO) replacement policy.
  *
  *  This policy maintains a set of cleanup queues to decide the eviction order of CS entries.
- *  The cleanup queues are three doubly linked lists that store EntryRefs.
+ *  The cleanup queues are three intrusive doubly linked lists of entries.
  *  The three queues keep track of unsolicited, stale, and fresh Data packet, respectively.
- *  EntryRef is placed into, removed from, and moved between suitable queues
- *  whenever an Entry is added, removed, or has other attribute changes.
+ *  An entry is placed into, removed from, and moved between suitable queues
+ *  whenever it is added, removed, or has other attribute changes.
+ *  The queue type and the timer that moves a fresh entry to the stale queue
+ *  are kept in Entry::PolicyData.
  *  Each Entry should be in exactly one queue at any moment.
- *  Within each queue, the EntryRefs are kept in first-in-first-out order.
+ *  Within each queue, the entries are kept in first-in-first-out order.
  *  Eviction procedure exhausts the first queue before moving onto the next queue,
  *  in the order of unsolicited, stale, and fresh queue.
  */
@@ -68,8 +59,6 @@ class PriorityFifoPolicy final : public Policy
 public:
   PriorityFifoPolicy();
 
-  ~PriorityFifoPolicy() final;
-
 private:
   void
   doAfterInsert(EntryRef i) final;
@@ -115,7 +104,6 @@ public:
 
 private:
   Queue m_queues[QUEUE_MAX];
-  std::map<EntryRef, EntryInfo*> m_entryInfoMap;
 };
 
 } // namespace priority_fifo
@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2023,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-tinylfu.hpp"
+#include "cs.hpp"
+
+namespace nfd::cs::tinylfu {
+
+NFD_REGISTER_CS_POLICY(TinyLfuPolicy);
+
+static size_t
+computeWidth(size_t n)
+{
+  n = std::clamp<size_t>(n, 64, TinyLfuPolicy::MAX_SKETCH_WIDTH);
+  size_t width = 1;
+  while (width < n) {
+    width <<= 1;
+  }
+  return width;
+}
+
+static size_t
+hashEntry(Policy::EntryRef i)
+{
+  return std::hash<Name>{}(i->getName());
+}
+
+FrequencySketch::FrequencySketch(size_t width)
+  : m_counters(DEPTH * computeWidth(width))
+  , m_mask(computeWidth(width) - 1)
+  , m_sampleSize(10 * computeWidth(width))
+{
+}
+
+/** \brief Yields the counter index in each row, by double hashing a well-mixed key.
+ */
+template<typename F>
+static void
+forEachIndex(uint64_t key, size_t mask, F&& f)
+{
+  // finalizer of SplitMix64
+  key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+  key ^= key >> 31;
+
+  uint64_t h1 = key;
+  uint64_t h2 = (key >> 32) | 1;
+  for (size_t row = 0; row < FrequencySketch::DEPTH; ++row) {
+    f(row, static_cast<size_t>(h1 + row * h2) & mask);
+  }
+}
+
+void
+FrequencySketch::increment(size_t key)
+{
+  bool isIncremented = false;
+  size_t width = getWidth();
+  forEachIndex(key, m_mask, [&] (size_t row, size_t index) {
+    uint8_t& counter = m_counters[row * width + index];
+    if (counter < MAX_COUNT) {
+      ++counter;
+      isIncremented = true;
+    }
+  });
+
+  if (isIncremented && ++m_nIncrements >= m_sampleSize) {
+    age();
+  }
+}
+
+uint8_t
+FrequencySketch::estimate(size_t key) const
+{
+  uint8_t count = MAX_COUNT;
+  size_t width = getWidth();
+  forEachIndex(key, m_mask, [&] (size_t row, size_t index) {
+    count = std::min(count, m_counters[row * width + index]);
+  });
+  return count;
+}
+
+void
+FrequencySketch::age()
+{
+  for (uint8_t& counter : m_counters) {
+    counter >>= 1;
+  }
+  m_nIncrements /= 2;
+}
+
+TinyLfuPolicy::TinyLfuPolicy()
+  : Policy(POLICY_NAME)
+{
+}
+
+void
+TinyLfuPolicy::doAfterInsert(EntryRef i)
+{
+  this->recordAccess(i);
+  this->insertToQueue(i, true);
+
+  // the new entry competes with each LRU victim; once rejected or evicted, it is gone
+  bool isCandidatePresent = true;
+  uint8_t candidateFreq = m_sketch.estimate(hashEntry(i));
+  while (this->isOverLimit()) {
+    BOOST_ASSERT(!m_queue.empty());
+    EntryRef victim = m_queue.front().getIterator();
+    if (isCandidatePresent && victim != i && candidateFreq <= m_sketch.estimate(hashEntry(victim))) {
+      m_queue.erase(m_queue.iterator_to(getEntry(i)));
+      isCandidatePresent = false;
+      emitSignal(beforeReject, i);
+      continue;
+    }
+
+    if (isCandidatePresent && victim == i) {
+      isCandidatePresent = false;
+    }
+    m_queue.pop_front();
+    emitSignal(beforeEvict, victim);
+  }
+}
+
+void
+TinyLfuPolicy::doAfterRefresh(EntryRef i)
+{
+  this->recordAccess(i);
+  this->insertToQueue(i, false);
+}
+
+void
+TinyLfuPolicy::doBeforeErase(EntryRef i)
+{
+  m_queue.erase(m_queue.iterator_to(getEntry(i)));
+}
+
+void
+TinyLfuPolicy::doBeforeUse(EntryRef i)
+{
+  this->recordAccess(i);
+  this->insertToQueue(i, false);
+}
+
+void
+TinyLfuPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+  while (this->isOverLimit()) {
+    BOOST_ASSERT(!m_queue.empty());
+    EntryRef i = m_queue.front().getIterator();
+    m_queue.pop_front();
+    emitSignal(beforeEvict, i);
+  }
+}
+
+void
+TinyLfuPolicy::recordAccess(EntryRef i)
+{
+  size_t width = computeWidth(this->getLimit());
+  if (width != m_sketch.getWidth()) {
+    m_sketch = FrequencySketch(width);
+  }
+  m_sketch.increment(hashEntry(i));
+}
+
+void
+TinyLfuPolicy::insertToQueue(EntryRef i, bool isNewEntry)
+{
+  Entry& entry = getEntry(i);
+  BOOST_ASSERT(entry.is_linked() != isNewEntry);
+  if (isNewEntry) {
+    m_queue.push_back(entry);
+  }
+  else {
+    m_queue.splice(m_queue.end(), m_queue, m_queue.iterator_to(entry));
+  }
+}
+
+} // namespace nfd::cs::tinylfu
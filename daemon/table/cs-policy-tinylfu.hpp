@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2023,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_TINYLFU_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_TINYLFU_HPP
+
+#include "cs-policy-lru.hpp"
+
+namespace nfd::cs {
+namespace tinylfu {
+
+/**
+ * \brief A count-min sketch estimating how often each key has been seen recently.
+ *
+ * Each of the DEPTH rows holds saturating 4-bit counters, stored one per byte.
+ * After every getSampleSize() increments, all counters are halved, so that the estimates
+ * reflect recent popularity rather than all-time popularity.
+ */
+class FrequencySketch
+{
+public:
+  static constexpr size_t DEPTH = 4;
+  static constexpr uint8_t MAX_COUNT = 15;
+
+  /** \param width number of counters per row, will be rounded up to a power of two
+   */
+  explicit
+  FrequencySketch(size_t width = 64);
+
+  /** \brief Record one occurrence of \p key.
+   */
+  void
+  increment(size_t key);
+
+  /** \brief Return the estimated number of recent occurrences of \p key.
+   */
+  uint8_t
+  estimate(size_t key) const;
+
+  size_t
+  getWidth() const noexcept
+  {
+    return m_mask + 1;
+  }
+
+  /** \brief Return the number of increments between two agings.
+   */
+  size_t
+  getSampleSize() const noexcept
+  {
+    return m_sampleSize;
+  }
+
+private:
+  void
+  age();
+
+private:
+  std::vector<uint8_t> m_counters; ///< DEPTH rows of getWidth() counters
+  size_t m_mask;
+  size_t m_sampleSize;
+  size_t m_nIncrements = 0;
+};
+
+/**
+ * \brief Least-Recently-Used replacement with TinyLFU admission.
+ *
+ * Entries are kept in LRU order. When a new entry would push the CS over its limit, it is
+ * admitted only if its estimated access frequency is higher than that of the LRU victim;
+ * otherwise the new entry itself is evicted. Access frequencies of Data names are estimated
+ * by a FrequencySketch sized according to the entry limit, which is updated whenever an entry
+ * is inserted, refreshed, or used. This keeps popular Data in the CS when it is swept by Data
+ * that is requested only once, such as a long sequential fetch.
+ */
+class TinyLfuPolicy final : public Policy
+{
+public:
+  TinyLfuPolicy();
+
+  const FrequencySketch&
+  getSketch() const noexcept
+  {
+    return m_sketch;
+  }
+
+private:
+  void
+  doAfterInsert(EntryRef i) final;
+
+  void
+  doAfterRefresh(EntryRef i) final;
+
+  void
+  doBeforeErase(EntryRef i) final;
+
+  void
+  doBeforeUse(EntryRef i) final;
+
+  void
+  evictEntries() final;
+
+  /**
+   * \brief Records an access to an entry in the sketch, resizing the sketch if the limit changed.
+   */
+  void
+  recordAccess(EntryRef i);
+
+  /**
+   * \brief Moves an entry to the end of queue.
+   */
+  void
+  insertToQueue(EntryRef i, bool isNewEntry);
+
+public:
+  static constexpr std::string_view POLICY_NAME{"tinylfu"};
+
+  /** \brief Upper bound of sketch width, limiting sketch memory to DEPTH * 4 MiB.
+   */
+  static constexpr size_t MAX_SKETCH_WIDTH = 1 << 22;
+
+private:
+  lru::Queue m_queue;
+  FrequencySketch m_sketch;
+};
+
+} // namespace tinylfu
+
+using tinylfu::TinyLfuPolicy;
+
+} // namespace nfd::cs
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_TINYLFU_HPP
@@ -29,6 +29,7 @@
 #include "cs-entry.hpp"
 
 #include <functional>
+#include <limits>
 #include <map>
 #include <set>
 
@@ -110,6 +111,25 @@ public:
   void
   setLimit(size_t nMaxEntries);
 
+  /**
+   * \brief Gets hard limit (in total wire size of stored Data, in bytes).
+   */
+  size_t
+  getByteLimit() const noexcept
+  {
+    return m_byteLimit;
+  }
+
+  /** \brief Sets hard limit (in total wire size of stored Data, in bytes).
+   *  \post getByteLimit() == nMaxBytes
+   *  \post cs.getNBytes() <= getByteLimit()
+   *
+   *  The policy may evict entries if necessary.
+   *  By default, there is no byte limit.
+   */
+  void
+  setByteLimit(size_t nMaxBytes);
+
 public:
   /** \brief A reference to a CS entry.
    *  \note `operator<` of EntryRef compares the Data name enclosed in the Entry.
@@ -123,6 +143,13 @@ public:
    */
   signal::Signal<Policy, EntryRef> beforeEvict;
 
+  /** \brief %Signal emitted when a newly inserted entry is refused by admission control.
+   *
+   *  CS should erase the entry upon signal emission, as with \p beforeEvict. Unlike an evicted
+   *  entry, a refused entry has been judged not worth caching, so it is not kept in any other tier.
+   */
+  signal::Signal<Policy, EntryRef> beforeReject;
+
   /** \brief Invoked by CS after a new entry is inserted.
    *  \post cs.size() <= getLimit()
    *
@@ -190,16 +217,32 @@ protected:
   doBeforeUse(EntryRef i) = 0;
 
   /** \brief Evicts zero or more entries.
-   *  \post CS size does not exceed hard limit
+   *  \post CS size and CS bytes do not exceed hard limits, i.e., isOverLimit() is false
    */
   virtual void
   evictEntries() = 0;
 
+  /** \brief Returns whether CS exceeds either the entry limit or the byte limit.
+   */
+  bool
+  isOverLimit() const;
+
+  /** \brief Returns the entry referred to by \p i, for linking it into a PolicyQueue.
+   *
+   *  Linking does not change the key of the entry, so it is safe on an entry in the Table.
+   */
+  static Entry&
+  getEntry(EntryRef i)
+  {
+    return const_cast<Entry&>(*i);
+  }
+
 protected:
   explicit
   Policy(std::string_view policyName);
 
   DECLARE_SIGNAL_EMIT(beforeEvict)
+  DECLARE_SIGNAL_EMIT(beforeReject)
 
 private: // registry
   using CreateFunc = std::function<unique_ptr<Policy>()>;
@@ -211,6 +254,7 @@ private: // registry
 private:
   const std::string m_policyName;
   size_t m_limit;
+  size_t m_byteLimit = std::numeric_limits<size_t>::max();
   Cs* m_cs;
 };
 
@@ -33,6 +33,24 @@ namespace nfd::cs {
 
 NFD_LOG_INIT(ContentStore);
 
+std::ostream&
+operator<<(std::ostream& os, TableEngine engine)
+{
+  switch (engine) {
+    case TableEngine::ORDERED:
+      return os << "ordered";
+    case TableEngine::HASHED:
+      return os << "hashed";
+  }
+  return os << static_cast<int>(engine);
+}
+
+static size_t
+hashName(const Name& name)
+{
+  return std::hash<Name>{}(name);
+}
+
 static unique_ptr<Policy>
 makeDefaultPolicy()
 {
@@ -75,6 +93,11 @@ Cs::insert(const Data& data, bool isUnsolicited)
     m_policy->afterRefresh(it);
   }
   else {
+    entry.setIterator(it);
+    m_nBytes += entry.getData().wireEncode().size();
+    if (m_engine == TableEngine::HASHED) {
+      this->addToHashIndex(it);
+    }
     m_policy->afterInsert(it);
   }
 }
@@ -99,7 +122,7 @@ Cs::eraseImpl(const Name& prefix, size_t limit)
   size_t nErased = 0;
   while (i != last && nErased < limit) {
     m_policy->beforeErase(i);
-    i = m_table.erase(i);
+    i = this->eraseEntry(i);
     ++nErased;
   }
   return nErased;
@@ -113,11 +136,20 @@ Cs::findImpl(const Interest& interest) const
   }
 
   const Name& prefix = interest.getName();
-  auto range = findPrefixRange(prefix);
-  auto match = std::find_if(range.first, range.second,
-                            [&interest] (const auto& entry) { return entry.canSatisfy(interest); });
+  auto match = m_table.end();
+  if (m_engine == TableEngine::HASHED && !interest.getCanBePrefix()) {
+    match = findInHashIndex(interest);
+  }
+  else {
+    auto range = findPrefixRange(prefix);
+    match = std::find_if(range.first, range.second,
+                         [&interest] (const auto& entry) { return entry.canSatisfy(interest); });
+    if (match == range.second) {
+      match = m_table.end();
+    }
+  }
 
-  if (match == range.second) {
+  if (match == m_table.end()) {
     NFD_LOG_DEBUG("find " << prefix << " no-match");
     return m_table.end();
   }
@@ -126,6 +158,62 @@ Cs::findImpl(const Interest& interest) const
   return match;
 }
 
+shared_ptr<const Data>
+Cs::findInDiskStore(const Interest& interest) const
+{
+  if (m_diskStore == nullptr || !m_shouldServe || m_policy->getLimit() == 0) {
+    return nullptr;
+  }
+
+  auto data = m_diskStore->find(interest);
+  NFD_LOG_DEBUG("find " << interest.getName() << (data == nullptr ? " disk-no-match" : " disk-match"));
+  return data;
+}
+
+Cs::const_iterator
+Cs::findInHashIndex(const Interest& interest) const
+{
+  BOOST_ASSERT(m_engine == TableEngine::HASHED && !interest.getCanBePrefix());
+
+  auto match = m_table.end();
+  auto findInBucket = [&] (const Name& dataName) {
+    auto range = m_hashIndex.equal_range(hashName(dataName));
+    for (auto it = range.first; it != range.second; ++it) {
+      // pick the first match in Table order, as the ORDERED engine would
+      if (it->second->canSatisfy(interest) && (match == m_table.end() || it->second < match)) {
+        match = it->second;
+      }
+    }
+  };
+
+  // without CanBePrefix, the Interest name equals either the Data name or the Data full name
+  const Name& name = interest.getName();
+  findInBucket(name);
+  if (!name.empty() && name[-1].isImplicitSha256Digest()) {
+    findInBucket(name.getPrefix(-1));
+  }
+  return match;
+}
+
+void
+Cs::addToHashIndex(const_iterator it)
+{
+  m_hashIndex.emplace(hashName(it->getName()), it);
+}
+
+Cs::const_iterator
+Cs::eraseEntry(const_iterator it)
+{
+  if (m_engine == TableEngine::HASHED) {
+    auto range = m_hashIndex.equal_range(hashName(it->getName()));
+    auto pos = std::find_if(range.first, range.second, [it] (const auto& p) { return p.second == it; });
+    BOOST_ASSERT(pos != range.second);
+    m_hashIndex.erase(pos);
+  }
+  m_nBytes -= it->getData().wireEncode().size();
+  return m_table.erase(it);
+}
+
 void
 Cs::dump()
 {
@@ -141,8 +229,11 @@ Cs::setPolicy(unique_ptr<Policy> policy)
   BOOST_ASSERT(policy != nullptr);
   BOOST_ASSERT(m_policy != nullptr);
   size_t limit = m_policy->getLimit();
+  size_t byteLimit = m_policy->getByteLimit();
   this->setPolicyImpl(std::move(policy));
   m_policy->setLimit(limit);
+  m_policy->setByteLimit(byteLimit);
+  afterConfigChange();
 }
 
 void
@@ -150,30 +241,71 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
 {
   NFD_LOG_DEBUG("set-policy " << policy->getName());
   m_policy = std::move(policy);
-  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) { m_table.erase(it); });
+  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) {
+    if (m_diskStore != nullptr && !it->isUnsolicited()) {
+      auto freshUntil = time::system_clock::now() +
+        time::duration_cast<time::system_clock::duration>(it->getFreshUntil() - time::steady_clock::now());
+      m_diskStore->insert(it->getData(), freshUntil);
+    }
+    eraseEntry(it);
+  });
+  m_beforeRejectConnection = m_policy->beforeReject.connect([this] (auto it) {
+    eraseEntry(it);
+  });
 
   m_policy->setCs(this);
   BOOST_ASSERT(m_policy->getCs() == this);
 }
 
 void
-Cs::enableAdmit(bool shouldAdmit) noexcept
+Cs::setDiskStore(unique_ptr<DiskStore> store)
+{
+  m_diskStore = std::move(store);
+  if (m_diskStore != nullptr) {
+    NFD_LOG_INFO("Using disk store " << m_diskStore->getPath());
+  }
+  afterConfigChange();
+}
+
+void
+Cs::enableAdmit(bool shouldAdmit)
 {
   if (m_shouldAdmit == shouldAdmit) {
     return;
   }
   m_shouldAdmit = shouldAdmit;
   NFD_LOG_INFO((shouldAdmit ? "Enabling" : "Disabling") << " Data admittance");
+  afterConfigChange();
 }
 
 void
-Cs::enableServe(bool shouldServe) noexcept
+Cs::enableServe(bool shouldServe)
 {
   if (m_shouldServe == shouldServe) {
     return;
   }
   m_shouldServe = shouldServe;
   NFD_LOG_INFO((shouldServe ? "Enabling" : "Disabling") << " Data serving");
+  afterConfigChange();
+}
+
+void
+Cs::setEngine(TableEngine engine)
+{
+  if (m_engine == engine) {
+    return;
+  }
+  m_engine = engine;
+  NFD_LOG_INFO("Using " << engine << " table engine");
+
+  decltype(m_hashIndex)().swap(m_hashIndex);
+  if (m_engine == TableEngine::HASHED) {
+    m_hashIndex.reserve(m_table.size());
+    for (auto it = m_table.begin(); it != m_table.end(); ++it) {
+      this->addToHashIndex(it);
+    }
+  }
+  afterConfigChange();
 }
 
 } // namespace nfd::cs
@@ -26,20 +26,44 @@
 #ifndef NFD_DAEMON_TABLE_CS_HPP
 #define NFD_DAEMON_TABLE_CS_HPP
 
+#include "cs-disk-store.hpp"
 #include "cs-policy.hpp"
 
+#include <unordered_map>
+
 namespace nfd {
 namespace cs {
 
+/** \brief Selects how the Content Store looks up Interests.
+ */
+enum class TableEngine {
+  /** \brief All lookups search the Table.
+   */
+  ORDERED,
+  /** \brief Lookups of Interests without CanBePrefix use a hash index keyed by Data name;
+   *         the Table still serves CanBePrefix lookups, erasure by prefix, and enumeration.
+   */
+  HASHED,
+};
+
+std::ostream&
+operator<<(std::ostream& os, TableEngine engine);
+
 /** \brief Implements the Content Store.
  *
  *  This Content Store implementation consists of a Table and a replacement policy.
  *
- *  The Table is a container ( \c std::set ) sorted by full Names of stored Data packets.
+ *  The Table is an ordered container ( \c boost::container::set ) sorted by full Names of stored
+ *  Data packets.
  *  Data packets are wrapped in Entry objects. Each Entry contains the Data packet itself,
  *  and a few additional attributes such as when the Data becomes non-fresh.
+ *  With \c TableEngine::HASHED, a hash index on Data names is maintained alongside the Table,
+ *  so that exact-name lookups take constant time instead of O(log n) Name comparisons.
  *
  *  The replacement policy is implemented in a subclass of \c Policy.
+ *
+ *  Optionally, a \c DiskStore serves as a second tier: solicited entries evicted by the policy
+ *  are appended to it, and Interests without CanBePrefix that miss in memory are looked up in it.
  */
 class Cs : noncopyable
 {
@@ -81,11 +105,16 @@ public:
   find(const Interest& interest, HitCallback&& hit, MissCallback&& miss) const
   {
     auto match = findImpl(interest);
-    if (match == m_table.end()) {
-      miss(interest);
+    if (match != m_table.end()) {
+      hit(interest, match->getData());
+      return;
+    }
+    auto data = findInDiskStore(interest);
+    if (data != nullptr) {
+      hit(interest, *data);
       return;
     }
-    hit(interest, match->getData());
+    miss(interest);
   }
 
   /** \brief Get number of stored packets.
@@ -96,6 +125,14 @@ public:
     return m_table.size();
   }
 
+  /** \brief Get total wire size of stored packets, in bytes.
+   */
+  size_t
+  getNBytes() const noexcept
+  {
+    return m_nBytes;
+  }
+
 public: // configuration
   /** \brief Get capacity (in number of packets).
    */
@@ -110,7 +147,27 @@ public: // configuration
   void
   setLimit(size_t nMaxPackets)
   {
-    return m_policy->setLimit(nMaxPackets);
+    m_policy->setLimit(nMaxPackets);
+    afterConfigChange();
+  }
+
+  /** \brief Get capacity (in total wire size of stored packets, in bytes).
+   */
+  size_t
+  getByteLimit() const noexcept
+  {
+    return m_policy->getByteLimit();
+  }
+
+  /** \brief Change capacity (in total wire size of stored packets, in bytes).
+   *
+   *  Entries are evicted when either this limit or the limit in number of packets is exceeded.
+   */
+  void
+  setByteLimit(size_t nMaxBytes)
+  {
+    m_policy->setByteLimit(nMaxBytes);
+    afterConfigChange();
   }
 
   /** \brief Get replacement policy.
@@ -140,7 +197,7 @@ public: // configuration
    *  \sa https://redmine.named-data.net/projects/nfd/wiki/CsMgmt#Update-config
    */
   void
-  enableAdmit(bool shouldAdmit) noexcept;
+  enableAdmit(bool shouldAdmit);
 
   /** \brief Get CS_ENABLE_SERVE flag.
    *  \sa https://redmine.named-data.net/projects/nfd/wiki/CsMgmt#Update-config
@@ -155,7 +212,45 @@ public: // configuration
    *  \sa https://redmine.named-data.net/projects/nfd/wiki/CsMgmt#Update-config
    */
   void
-  enableServe(bool shouldServe) noexcept;
+  enableServe(bool shouldServe);
+
+  /** \brief Get table engine.
+   */
+  TableEngine
+  getEngine() const noexcept
+  {
+    return m_engine;
+  }
+
+  /** \brief Change table engine.
+   *
+   *  Stored entries are kept; the hash index is built or released as needed.
+   */
+  void
+  setEngine(TableEngine engine);
+
+  /** \brief Get second-tier disk store.
+   *  \return the store, or nullptr if none is attached
+   */
+  DiskStore*
+  getDiskStore() const noexcept
+  {
+    return m_diskStore.get();
+  }
+
+  /** \brief Attach a second-tier disk store, replacing any existing one.
+   *  \param store the store, or nullptr to detach
+   */
+  void
+  setDiskStore(unique_ptr<DiskStore> store);
+
+public: // signal
+  /** \brief Signals after a configuration setting is changed.
+   *
+   *  The settings are the capacity limits, the replacement policy, the admit and serve flags,
+   *  the table engine, and the disk store.
+   */
+  signal::Signal<Cs> afterConfigChange;
 
 public: // enumeration
   using const_iterator = Table::const_iterator;
@@ -182,6 +277,29 @@ private:
   const_iterator
   findImpl(const Interest& interest) const;
 
+  /** \brief Look up \p interest in the disk store after a miss in memory.
+   *  \return the Data, or nullptr if there is no disk store or no match
+   */
+  shared_ptr<const Data>
+  findInDiskStore(const Interest& interest) const;
+
+  /** \brief Find the first entry in Table order that can satisfy \p interest, using the hash index.
+   *  \pre m_engine == TableEngine::HASHED && !interest.getCanBePrefix()
+   */
+  const_iterator
+  findInHashIndex(const Interest& interest) const;
+
+  /** \brief Add the entry at \p it to the hash index.
+   */
+  void
+  addToHashIndex(const_iterator it);
+
+  /** \brief Erase the entry at \p it from the Table and the hash index, and update byte count.
+   *  \return iterator to the entry after \p it in the Table
+   */
+  const_iterator
+  eraseEntry(const_iterator it);
+
   void
   setPolicyImpl(unique_ptr<Policy> policy);
 
@@ -191,8 +309,14 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
 private:
   Table m_table;
+  /// maps the hash of a Data name to the entries with that name, if engine is HASHED
+  std::unordered_multimap<size_t, const_iterator> m_hashIndex;
+  TableEngine m_engine = TableEngine::ORDERED;
+  size_t m_nBytes = 0; ///< total wire size of Data in m_table
   unique_ptr<Policy> m_policy;
+  unique_ptr<DiskStore> m_diskStore;
   signal::ScopedConnection m_beforeEvictConnection;
+  signal::ScopedConnection m_beforeRejectConnection;
 
   bool m_shouldAdmit = true; ///< if false, no Data will be admitted
   bool m_shouldServe = true; ///< if false, all lookups will miss
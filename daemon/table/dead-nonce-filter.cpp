@@ -0,0 +1,289 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dead-nonce-filter.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace nfd {
+
+/// Maximum fraction of the slots that a filter is sized to fill
+constexpr double MAX_LOAD = 0.9;
+
+/// Maximum number of relocations when inserting into a filter
+constexpr size_t MAX_KICKS = 500;
+
+DeadNonceFilter::Filter::Filter(size_t capacity, size_t fingerprintBytes)
+  : m_fingerprintBytes(fingerprintBytes)
+{
+  m_nBuckets = std::max<size_t>(static_cast<size_t>(capacity / (BUCKET_SIZE * MAX_LOAD)), 2);
+  BOOST_ASSERT(m_nBuckets <= std::numeric_limits<uint32_t>::max());
+  m_slots.resize(m_nBuckets * BUCKET_SIZE * m_fingerprintBytes);
+}
+
+uint32_t
+DeadNonceFilter::Filter::makeFingerprint(uint64_t entry) const
+{
+  // the low bits of the entry select the bucket, the high bits make the fingerprint
+  auto fingerprint = static_cast<uint32_t>(entry >> 32);
+  if (m_fingerprintBytes < sizeof(uint32_t)) {
+    fingerprint &= (uint32_t{1} << (m_fingerprintBytes * 8)) - 1;
+  }
+  // zero marks an empty slot
+  return fingerprint == 0 ? 1 : fingerprint;
+}
+
+size_t
+DeadNonceFilter::Filter::mapToBucket(uint32_t hash) const
+{
+  // multiply-shift range reduction, cheaper than a modulo
+  return static_cast<size_t>((uint64_t{hash} * m_nBuckets) >> 32);
+}
+
+size_t
+DeadNonceFilter::Filter::getAltBucket(size_t bucket, uint32_t fingerprint) const
+{
+  // an involution, so that either bucket of a fingerprint gives the other one,
+  // which does not require the number of buckets to be a power of two
+  size_t alt = mapToBucket(fingerprint * 0x5bd1e995U) + m_nBuckets - bucket;
+  return alt >= m_nBuckets ? alt - m_nBuckets : alt;
+}
+
+uint32_t
+DeadNonceFilter::Filter::getSlot(size_t bucket, size_t i) const
+{
+  const uint8_t* slot = &m_slots[(bucket * BUCKET_SIZE + i) * m_fingerprintBytes];
+  switch (m_fingerprintBytes) {
+    case 1:
+      return *slot;
+    case 2: {
+      uint16_t v;
+      std::memcpy(&v, slot, sizeof(v));
+      return v;
+    }
+    default: {
+      uint32_t v;
+      std::memcpy(&v, slot, sizeof(v));
+      return v;
+    }
+  }
+}
+
+void
+DeadNonceFilter::Filter::setSlot(size_t bucket, size_t i, uint32_t fingerprint)
+{
+  uint8_t* slot = &m_slots[(bucket * BUCKET_SIZE + i) * m_fingerprintBytes];
+  switch (m_fingerprintBytes) {
+    case 1:
+      *slot = static_cast<uint8_t>(fingerprint);
+      break;
+    case 2: {
+      auto v = static_cast<uint16_t>(fingerprint);
+      std::memcpy(slot, &v, sizeof(v));
+      break;
+    }
+    default:
+      std::memcpy(slot, &fingerprint, sizeof(fingerprint));
+      break;
+  }
+}
+
+bool
+DeadNonceFilter::Filter::bucketContains(size_t bucket, uint32_t fingerprint) const
+{
+  for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+    if (getSlot(bucket, i) == fingerprint) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+DeadNonceFilter::Filter::tryPut(size_t bucket, uint32_t fingerprint)
+{
+  for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+    if (getSlot(bucket, i) == 0) {
+      setSlot(bucket, i, fingerprint);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+DeadNonceFilter::Filter::contains(uint64_t entry) const
+{
+  uint32_t fingerprint = makeFingerprint(entry);
+  size_t bucket1 = mapToBucket(static_cast<uint32_t>(entry));
+  size_t bucket2 = getAltBucket(bucket1, fingerprint);
+  if (m_victim == fingerprint && (m_victimBucket == bucket1 || m_victimBucket == bucket2)) {
+    return true;
+  }
+  return bucketContains(bucket1, fingerprint) || bucketContains(bucket2, fingerprint);
+}
+
+void
+DeadNonceFilter::Filter::insert(uint64_t entry)
+{
+  BOOST_ASSERT(!isFull());
+
+  uint32_t fingerprint = makeFingerprint(entry);
+  size_t bucket = mapToBucket(static_cast<uint32_t>(entry));
+  if (tryPut(bucket, fingerprint)) {
+    return;
+  }
+  bucket = getAltBucket(bucket, fingerprint);
+  if (tryPut(bucket, fingerprint)) {
+    return;
+  }
+
+  for (size_t n = 0; n < MAX_KICKS; ++n) {
+    // xorshift32
+    m_kickState ^= m_kickState << 13;
+    m_kickState ^= m_kickState >> 17;
+    m_kickState ^= m_kickState << 5;
+
+    size_t i = m_kickState % BUCKET_SIZE;
+    uint32_t evicted = getSlot(bucket, i);
+    setSlot(bucket, i, fingerprint);
+    fingerprint = evicted;
+    bucket = getAltBucket(bucket, fingerprint);
+    if (tryPut(bucket, fingerprint)) {
+      return;
+    }
+  }
+
+  // keep the homeless fingerprint aside, so that there is no false negative
+  m_victim = fingerprint;
+  m_victimBucket = bucket;
+}
+
+DeadNonceFilter::DeadNonceFilter(size_t nSlices, double falsePositiveRate,
+                                 size_t sliceCapacity, size_t maxEntries)
+  : m_nSlices(nSlices)
+  , m_maxEntries(maxEntries)
+  , m_sliceCapacity(std::max(sliceCapacity, MIN_SLICE_CAPACITY))
+{
+  BOOST_ASSERT(m_nSlices > 0);
+  BOOST_ASSERT(falsePositiveRate > 0.0 && falsePositiveRate < 1.0);
+
+  // a lookup compares against two buckets and the victim of the first filter of each live slice;
+  // overflow filters use 32-bit fingerprints, and their share is documented in the class
+  double nComparisons = static_cast<double>((2 * Filter::BUCKET_SIZE + 1) * m_nSlices);
+  m_fingerprintBytes = 4;
+  for (size_t nBytes : {1, 2}) {
+    if (nComparisons / static_cast<double>(uint64_t{1} << (nBytes * 8)) <= falsePositiveRate) {
+      m_fingerprintBytes = nBytes;
+      break;
+    }
+  }
+
+  addSlice();
+}
+
+DeadNonceFilter::~DeadNonceFilter() = default;
+
+bool
+DeadNonceFilter::has(uint64_t entry) const
+{
+  return std::any_of(m_slices.rbegin(), m_slices.rend(), [entry] (const Slice& slice) {
+    return std::any_of(slice.filters.begin(), slice.filters.end(),
+                       [entry] (const Filter& filter) { return filter.contains(entry); });
+  });
+}
+
+void
+DeadNonceFilter::add(uint64_t entry)
+{
+  const Slice& last = m_slices.back();
+  if (std::any_of(last.filters.begin(), last.filters.end(),
+                  [entry] (const Filter& filter) { return filter.contains(entry); })) {
+    return;
+  }
+
+  // expire the oldest entries early, as the exact Dead Nonce List does at its capacity limit;
+  // the slice that receives the entry is never dropped, so that it is not lost right away
+  if (last.nEntries >= m_maxEntries) {
+    addSlice();
+  }
+  while (m_nEntries >= m_maxEntries && m_slices.size() > 1) {
+    dropOldestSlice();
+  }
+
+  Slice& current = m_slices.back();
+  if (current.filters.back().isFull()) {
+    // overflow filters are not counted in the fingerprint length, so they use the longest one
+    current.filters.emplace_back(m_sliceCapacity, sizeof(uint32_t));
+  }
+  current.filters.back().insert(entry);
+  ++current.nEntries;
+  ++m_nEntries;
+}
+
+void
+DeadNonceFilter::rotate()
+{
+  // size the new slice for the number of entries in the last one, with some headroom
+  size_t lastCount = m_slices.back().nEntries;
+  m_sliceCapacity = std::clamp(lastCount + lastCount / 4, MIN_SLICE_CAPACITY,
+                               std::max(m_maxEntries / m_nSlices, MIN_SLICE_CAPACITY));
+
+  addSlice();
+  while (m_slices.size() > m_nSlices) {
+    dropOldestSlice();
+  }
+}
+
+size_t
+DeadNonceFilter::getMemoryUsage() const noexcept
+{
+  size_t nBytes = 0;
+  for (const auto& slice : m_slices) {
+    for (const auto& filter : slice.filters) {
+      nBytes += filter.getMemoryUsage();
+    }
+  }
+  return nBytes;
+}
+
+void
+DeadNonceFilter::addSlice()
+{
+  m_slices.emplace_back();
+  m_slices.back().filters.emplace_back(m_sliceCapacity, m_fingerprintBytes);
+}
+
+void
+DeadNonceFilter::dropOldestSlice()
+{
+  BOOST_ASSERT(!m_slices.empty());
+  m_nEntries -= m_slices.front().nEntries;
+  m_slices.pop_front();
+}
+
+} // namespace nfd
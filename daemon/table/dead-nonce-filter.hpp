@@ -0,0 +1,204 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
+#define NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
+
+#include "core/common.hpp"
+
+#include <deque>
+
+namespace nfd {
+
+/**
+ * \brief A compact, probabilistic store of Dead Nonce List entries.
+ *
+ * Entries are 64-bit hashes, as computed by the Dead Nonce List. They are kept in a ring of
+ * time slices; each slice is a cuckoo filter holding a short fingerprint of every entry added
+ * while the slice was current. rotate() starts a new slice and drops the oldest one, so that all
+ * entries of a slice expire together in constant time.
+ *
+ * has() may return a false positive, but never a false negative for an entry in a live slice.
+ * The fingerprints of the first filter of each slice are sized so that these filters together
+ * produce false positives with at most the probability given to the constructor. A slice that
+ * outgrows its filter gets overflow filters, whose fingerprints are always 32 bits long; each
+ * overflow filter adds at most (2 &times; BUCKET_SIZE + 1) / 2<sup>32</sup>, i.e., about 2e-9,
+ * to the false positive probability. The capacity of new slices follows the number of entries
+ * added to the previous one, so that overflow filters are normally rare.
+ *
+ * \warning This class is not thread-safe.
+ */
+class DeadNonceFilter : noncopyable
+{
+public:
+  /**
+   * \param nSlices number of live slices, including the current one; must be positive
+   * \param falsePositiveRate upper bound of the false positive probability of has(),
+   *                          in (0, 1); the fingerprints are at most 32 bits long
+   * \param sliceCapacity initial number of entries expected in each slice
+   * \param maxEntries when exceeded, the oldest slices are dropped before their time
+   */
+  DeadNonceFilter(size_t nSlices, double falsePositiveRate, size_t sliceCapacity, size_t maxEntries);
+
+  ~DeadNonceFilter();
+
+  bool
+  has(uint64_t entry) const;
+
+  /** \brief Add \p entry to the current slice, unless it is already there.
+   */
+  void
+  add(uint64_t entry);
+
+  /** \brief Start a new slice, dropping the oldest one if all slices are live.
+   */
+  void
+  rotate();
+
+  /** \return number of entries in live slices; an entry added in several slices is counted
+   *          in each of them
+   */
+  size_t
+  size() const noexcept
+  {
+    return m_nEntries;
+  }
+
+  size_t
+  getNSlices() const noexcept
+  {
+    return m_nSlices;
+  }
+
+  /** \return number of bits in each fingerprint
+   */
+  size_t
+  getFingerprintBits() const noexcept
+  {
+    return m_fingerprintBytes * 8;
+  }
+
+  /** \return number of bytes allocated for the filters
+   */
+  size_t
+  getMemoryUsage() const noexcept;
+
+private:
+  /**
+   * \brief A cuckoo filter with buckets of BUCKET_SIZE fingerprints.
+   */
+  class Filter
+  {
+  public:
+    Filter(size_t capacity, size_t fingerprintBytes);
+
+    bool
+    contains(uint64_t entry) const;
+
+    /** \brief Insert the fingerprint of \p entry.
+     *  \pre !isFull()
+     */
+    void
+    insert(uint64_t entry);
+
+    /** \brief Whether the last insertion could not place all fingerprints in buckets.
+     */
+    bool
+    isFull() const noexcept
+    {
+      return m_victim != 0;
+    }
+
+    size_t
+    getMemoryUsage() const noexcept
+    {
+      return m_slots.size();
+    }
+
+  private:
+    uint32_t
+    makeFingerprint(uint64_t entry) const;
+
+    /** \brief Map a 32-bit hash uniformly onto a bucket index.
+     */
+    size_t
+    mapToBucket(uint32_t hash) const;
+
+    size_t
+    getAltBucket(size_t bucket, uint32_t fingerprint) const;
+
+    uint32_t
+    getSlot(size_t bucket, size_t i) const;
+
+    void
+    setSlot(size_t bucket, size_t i, uint32_t fingerprint);
+
+    bool
+    bucketContains(size_t bucket, uint32_t fingerprint) const;
+
+    bool
+    tryPut(size_t bucket, uint32_t fingerprint);
+
+  public:
+    static constexpr size_t BUCKET_SIZE = 4;
+
+  private:
+    std::vector<uint8_t> m_slots;
+    size_t m_fingerprintBytes;
+    size_t m_nBuckets;
+    uint32_t m_victim = 0; ///< fingerprint that could not be placed, 0 if none
+    size_t m_victimBucket = 0;
+    uint32_t m_kickState = 1;
+  };
+
+  struct Slice
+  {
+    std::vector<Filter> filters;
+    size_t nEntries = 0;
+  };
+
+  /** \brief Append an empty slice with one filter of m_sliceCapacity.
+   */
+  void
+  addSlice();
+
+  void
+  dropOldestSlice();
+
+public:
+  static constexpr size_t MIN_SLICE_CAPACITY = 1 << 8;
+
+private:
+  const size_t m_nSlices;
+  const size_t m_maxEntries;
+  size_t m_fingerprintBytes;
+  size_t m_sliceCapacity;
+  std::deque<Slice> m_slices; ///< oldest first
+  size_t m_nEntries = 0;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
@@ -42,9 +42,7 @@ DeadNonceList::DeadNonceList(time::nanoseconds lifetime)
     NDN_THROW(std::invalid_argument("lifetime is less than MIN_LIFETIME"));
   }
 
-  for (size_t i = 0; i < EXPECTED_MARK_COUNT; ++i) {
-    m_queue.push_back(MARK);
-  }
+  resetIndex();
 
   m_markEvent = getScheduler().schedule(m_markInterval, [this] { mark(); });
   m_adjustCapacityEvent = getScheduler().schedule(m_adjustCapacityInterval, [this] { adjustCapacity(); });
@@ -61,9 +59,45 @@ DeadNonceList::DeadNonceList(time::nanoseconds lifetime)
   static_assert(EVICT_LIMIT >= 1);
 }
 
+void
+DeadNonceList::setEngine(Engine engine, double falsePositiveRate)
+{
+  BOOST_ASSERT(falsePositiveRate > 0.0 && falsePositiveRate < 1.0);
+  if (engine == getEngine() && (engine == Engine::EXACT || falsePositiveRate == m_falsePositiveRate)) {
+    m_falsePositiveRate = falsePositiveRate;
+    return;
+  }
+
+  m_falsePositiveRate = falsePositiveRate;
+  resetIndex();
+  if (engine == Engine::FILTER) {
+    // one slice per MARK interval of the lifetime, plus the current one
+    m_filter = make_unique<DeadNonceFilter>(EXPECTED_MARK_COUNT + 1, m_falsePositiveRate,
+                                            m_capacity / EXPECTED_MARK_COUNT, MAX_CAPACITY);
+  }
+  else {
+    m_filter.reset();
+  }
+  NFD_LOG_DEBUG("engine=" << (engine == Engine::FILTER ? "filter" : "exact")
+                << " falsePositiveRate=" << m_falsePositiveRate);
+}
+
+void
+DeadNonceList::resetIndex()
+{
+  m_index.clear();
+  m_actualMarkCounts.clear();
+  for (size_t i = 0; i < EXPECTED_MARK_COUNT; ++i) {
+    m_queue.push_back(MARK);
+  }
+}
+
 size_t
 DeadNonceList::size() const
 {
+  if (m_filter != nullptr) {
+    return m_filter->size();
+  }
   return m_queue.size() - countMarks();
 }
 
@@ -71,6 +105,9 @@ bool
 DeadNonceList::has(const Name& name, Interest::Nonce nonce) const
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
+  if (m_filter != nullptr) {
+    return m_filter->has(entry);
+  }
   return m_ht.find(entry) != m_ht.end();
 }
 
@@ -78,6 +115,12 @@ void
 DeadNonceList::add(const Name& name, Interest::Nonce nonce)
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
+  if (m_filter != nullptr) {
+    NFD_LOG_TRACE("adding " << name << " nonce=" << nonce);
+    m_filter->add(entry);
+    return;
+  }
+
   const auto iter = m_ht.find(entry);
   bool isDuplicate = iter != m_ht.end();
 
@@ -110,6 +153,13 @@ DeadNonceList::countMarks() const
 void
 DeadNonceList::mark()
 {
+  if (m_filter != nullptr) {
+    m_filter->rotate();
+    NFD_LOG_TRACE("mark size=" << m_filter->size() << " memory=" << m_filter->getMemoryUsage());
+    m_markEvent = getScheduler().schedule(m_markInterval, [this] { mark(); });
+    return;
+  }
+
   m_queue.push_back(MARK);
   size_t nMarks = countMarks();
   m_actualMarkCounts.insert(nMarks);
@@ -122,6 +172,12 @@ DeadNonceList::mark()
 void
 DeadNonceList::adjustCapacity()
 {
+  if (m_filter != nullptr) {
+    // the filter sizes each slice by itself
+    m_adjustCapacityEvent = getScheduler().schedule(m_adjustCapacityInterval, [this] { adjustCapacity(); });
+    return;
+  }
+
   auto oldCapacity = m_capacity;
   auto equalRange = m_actualMarkCounts.equal_range(EXPECTED_MARK_COUNT);
   if (equalRange.second == m_actualMarkCounts.begin()) {
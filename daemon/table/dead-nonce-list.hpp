@@ -27,6 +27,7 @@
 #define NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
 
 #include "core/common.hpp"
+#include "dead-nonce-filter.hpp"
 
 #include <ndn-cxx/util/scheduler.hpp>
 
@@ -52,10 +53,22 @@ namespace nfd {
  * At fixed intervals, a MARK (an entry with a special value) is inserted into the container.
  * The number of MARKs stored in the container reflects the lifetime of the entries,
  * because MARKs are inserted at fixed intervals.
+ *
+ * With Engine::FILTER, entries are instead kept in a DeadNonceFilter, which needs a few bytes
+ * per entry at the cost of a bounded false positive rate. Each MARK then starts a new time slice
+ * of the filter, and the slices older than the lifetime are dropped as a whole.
  */
 class DeadNonceList : noncopyable
 {
 public:
+  /**
+   * \brief How entries are stored.
+   */
+  enum class Engine {
+    EXACT,  ///< 64-bit hashes in a container, capacity adjusted with MARKs
+    FILTER, ///< fingerprints in a ring of time-sliced cuckoo filters
+  };
+
   /**
    * \brief Constructs the Dead Nonce List
    * \param lifetime expected lifetime of each nonce, must be no less than #MIN_LIFETIME.
@@ -86,6 +99,34 @@ public:
   size_t
   size() const;
 
+  /**
+   * \brief Returns the storage engine.
+   */
+  Engine
+  getEngine() const noexcept
+  {
+    return m_filter == nullptr ? Engine::EXACT : Engine::FILTER;
+  }
+
+  /**
+   * \brief Returns the false positive bound of Engine::FILTER.
+   */
+  double
+  getFalsePositiveRate() const noexcept
+  {
+    return m_falsePositiveRate;
+  }
+
+  /**
+   * \brief Changes the storage engine.
+   * \param engine the new engine
+   * \param falsePositiveRate false positive bound of Engine::FILTER, in (0, 1)
+   *
+   * All entries are dropped, unless neither the engine nor the applicable rate changes.
+   */
+  void
+  setEngine(Engine engine, double falsePositiveRate = DEFAULT_FALSE_POSITIVE_RATE);
+
   /**
    * \brief Returns the expected nonce lifetime
    */
@@ -124,11 +165,18 @@ private:
   void
   evictEntries();
 
+  /** \brief Empty the index, leaving the initial MARKs, and forget the recorded MARK counts.
+   */
+  void
+  resetIndex();
+
 public:
   /// Default entry lifetime
   static constexpr time::nanoseconds DEFAULT_LIFETIME = 6_s;
   /// Minimum entry lifetime
   static constexpr time::nanoseconds MIN_LIFETIME = 50_ms;
+  /// Default false positive bound of Engine::FILTER
+  static constexpr double DEFAULT_FALSE_POSITIVE_RATE = 0.001;
 
 private:
   const time::nanoseconds m_lifetime;
@@ -148,6 +196,10 @@ private:
   Container::index<Queue>::type& m_queue = m_index.get<Queue>();
   Container::index<Hashtable>::type& m_ht = m_index.get<Hashtable>();
 
+  /// replaces m_index if the engine is FILTER
+  unique_ptr<DeadNonceFilter> m_filter;
+  double m_falsePositiveRate = DEFAULT_FALSE_POSITIVE_RATE;
+
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   // ---- current capacity and hard limits
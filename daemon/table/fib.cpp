@@ -59,6 +59,16 @@ Fib::findLongestPrefixMatch(const Name& prefix) const
   return this->findLongestPrefixMatchImpl(prefix);
 }
 
+const Entry&
+Fib::findLongestPrefixMatch(const Name& prefix, const name_tree::HashSequence& hashes) const
+{
+  name_tree::Entry* nte = m_nameTree.findLongestPrefixMatch(prefix, hashes, &nteHasFibEntry);
+  if (nte != nullptr) {
+    return *nte->getFibEntry();
+  }
+  return *s_emptyEntry;
+}
+
 const Entry&
 Fib::findLongestPrefixMatch(const pit::Entry& pitEntry) const
 {
@@ -92,6 +102,7 @@ Fib::insert(const Name& prefix)
 
   nte.setFibEntry(make_unique<Entry>(prefix));
   ++m_nItems;
+  this->afterChange(prefix);
   return {nte.getFibEntry(), true};
 }
 
@@ -100,11 +111,13 @@ Fib::erase(name_tree::Entry* nte, bool canDeleteNte)
 {
   BOOST_ASSERT(nte != nullptr);
 
+  Name prefix = nte->getName();
   nte->setFibEntry(nullptr);
   if (canDeleteNte) {
     m_nameTree.eraseIfEmpty(nte);
   }
   --m_nItems;
+  this->afterChange(prefix);
 }
 
 void
@@ -133,6 +146,7 @@ Fib::addOrUpdateNextHop(Entry& entry, Face& face, uint64_t cost)
   auto [it, isNew] = entry.addOrUpdateNextHop(face, cost);
   if (isNew)
     this->afterNewNextHop(entry.getPrefix(), *it);
+  this->afterChange(entry.getPrefix());
 }
 
 Fib::RemoveNextHopResult
@@ -149,6 +163,7 @@ Fib::removeNextHop(Entry& entry, const Face& face)
     return RemoveNextHopResult::FIB_ENTRY_REMOVED;
   }
   else {
+    this->afterChange(entry.getPrefix());
     return RemoveNextHopResult::NEXTHOP_REMOVED;
   }
 }
@@ -65,6 +65,15 @@ public: // lookup
   const Entry&
   findLongestPrefixMatch(const Name& prefix) const;
 
+  /** \brief Performs a longest prefix match, reusing precomputed name hashes.
+   *
+   *  This is equivalent to `findLongestPrefixMatch(prefix)`.
+   *  \param hashes a prefix of `name_tree::computeHashes(prefix)`, covering at least
+   *                `min(prefix.size(), NameTree::getMaxDepth())` components
+   */
+  const Entry&
+  findLongestPrefixMatch(const Name& prefix, const name_tree::HashSequence& hashes) const;
+
   /** \brief Performs a longest prefix match.
    *
    *  This is equivalent to `findLongestPrefixMatch(pitEntry.getName())`
@@ -153,6 +162,13 @@ public: // signal
    */
   signal::Signal<Fib, Name, NextHop> afterNewNextHop;
 
+  /** \brief Signals after an entry is inserted or erased, or its nexthops are changed.
+   *
+   *  The parameter is the entry prefix. When an entry is erased, the signal is emitted
+   *  after the entry has been removed from the FIB.
+   */
+  signal::Signal<Fib, Name> afterChange;
+
 private:
   /** \tparam K a parameter acceptable to NameTree::findLongestPrefixMatch
    */
@@ -28,6 +28,7 @@
 #include "pit-entry.hpp"
 #include "fib-entry.hpp"
 #include "common/global.hpp"
+#include "common/timer-wheel.hpp"
 
 namespace nfd::measurements {
 
@@ -49,7 +50,7 @@ Measurements::get(name_tree::Entry& nte)
   entry = nte.getMeasurementsEntry();
 
   entry->m_expiry = time::steady_clock::now() + getInitialLifetime();
-  entry->m_cleanup = getScheduler().schedule(getInitialLifetime(), [=] { cleanup(*entry); });
+  getTimerWheel().schedule(entry->m_cleanup, getInitialLifetime(), [=] { cleanup(*entry); });
 
   return *entry;
 }
@@ -133,9 +134,8 @@ Measurements::extendLifetime(Entry& entry, const time::nanoseconds& lifetime)
     return;
   }
 
-  entry.m_cleanup.cancel();
   entry.m_expiry = expiry;
-  entry.m_cleanup = getScheduler().schedule(lifetime, [&] { cleanup(entry); });
+  getTimerWheel().schedule(entry.m_cleanup, lifetime, [&] { cleanup(entry); });
 }
 
 void
@@ -115,8 +115,222 @@ HashtableOptions::HashtableOptions(size_t size)
 {
 }
 
-Hashtable::Hashtable(const Options& options)
+// Each control byte is either a fingerprint (0xxxxxxx) of an occupied slot,
+// CTRL_EMPTY (10000000), or CTRL_DELETED (11111110).
+// The last control byte of a group does not correspond to any slot and is always CTRL_DELETED.
+constexpr uint64_t CTRL_EMPTY = 0x80;
+constexpr uint64_t CTRL_DELETED = 0xFE;
+constexpr uint64_t CTRL_LSBS = 0x0101010101010101;
+constexpr uint64_t CTRL_MSBS = 0x8080808080808080;
+constexpr uint64_t CTRL_SLOT_MSBS = CTRL_MSBS >> (8 * (8 - GroupTable::GROUP_SIZE));
+constexpr uint64_t CTRL_INIT = (CTRL_LSBS * CTRL_EMPTY & ~(uint64_t{0xFF} << 56)) | (CTRL_DELETED << 56);
+static_assert(GroupTable::GROUP_SIZE < 8, "control word must have a byte for each slot");
+
+/** \brief Returns the fingerprint of \p h stored in control bytes.
+ */
+static uint64_t
+getFingerprint(HashValue h)
+{
+  return h & 0x7F;
+}
+
+/** \brief Returns the index of the first group in the probe sequence of \p h.
+ */
+static size_t
+getProbeStart(HashValue h, size_t mask)
+{
+  return (h >> 7) & mask;
+}
+
+/** \return a mask that has the most significant bit set in each control byte equal to \p fp
+ */
+static uint64_t
+matchFingerprint(uint64_t ctrl, uint64_t fp)
+{
+  uint64_t x = ctrl ^ (CTRL_LSBS * fp);
+  // sets the most significant bit of each byte that is zero in x, without borrow across bytes
+  return ~(((x & ~CTRL_MSBS) + ~CTRL_MSBS) | x | ~CTRL_MSBS);
+}
+
+/** \return a mask that has the most significant bit set in each empty control byte
+ */
+static uint64_t
+matchEmpty(uint64_t ctrl)
+{
+  // CTRL_EMPTY is the only control byte with the most significant bit set and bit 1 cleared
+  return ctrl & ~(ctrl << 6) & CTRL_MSBS;
+}
+
+/** \return a mask that has the most significant bit set in each empty or deleted control byte
+ */
+static uint64_t
+matchFree(uint64_t ctrl)
+{
+  return ctrl & CTRL_SLOT_MSBS;
+}
+
+/** \return slot index of the lowest bit set in a mask returned by the match functions
+ */
+static size_t
+getMatchedSlot(uint64_t mask)
+{
+  BOOST_ASSERT(mask != 0);
+  return static_cast<size_t>(__builtin_ctzll(mask)) / 8;
+}
+
+static void
+setCtrl(uint64_t& ctrl, size_t slot, uint64_t value)
+{
+  ctrl = (ctrl & ~(uint64_t{0xFF} << (8 * slot))) | (value << (8 * slot));
+}
+
+GroupTable::Group::Group()
+  : ctrl(CTRL_INIT)
+{
+}
+
+GroupTable::GroupTable(size_t nGroups)
+  : m_groups(nGroups)
+  , m_mask(nGroups - 1)
+{
+  BOOST_ASSERT(nGroups > 0);
+  BOOST_ASSERT((nGroups & m_mask) == 0);
+}
+
+template<typename Pred>
+size_t
+GroupTable::findSlot(HashValue h, const Pred& pred) const
+{
+  uint64_t fp = getFingerprint(h);
+  size_t i = getProbeStart(h, m_mask);
+
+  // triangular probing visits every group once when the number of groups is a power of two
+  for (size_t step = 1; step <= m_groups.size(); ++step) {
+    const Group& group = m_groups[i];
+    for (uint64_t match = matchFingerprint(group.ctrl, fp); match != 0; match &= match - 1) {
+      size_t slot = getMatchedSlot(match);
+      if (pred(group.slots[slot])) {
+        return i * GROUP_SIZE + slot;
+      }
+    }
+    if (matchEmpty(group.ctrl) != 0) {
+      break;
+    }
+    i = (i + step) & m_mask;
+  }
+  return NPOS;
+}
+
+template<typename Pred>
+Node*
+GroupTable::find(HashValue h, const Pred& pred) const
+{
+  size_t index = this->findSlot(h, pred);
+  return index == NPOS ? nullptr : m_groups[index / GROUP_SIZE].slots[index % GROUP_SIZE];
+}
+
+size_t
+GroupTable::locate(const Node* node) const
+{
+  return this->findSlot(node->hash, [node] (const Node* other) { return other == node; });
+}
+
+void
+GroupTable::insert(Node* node)
+{
+  BOOST_ASSERT(m_nOccupied < this->getNSlots());
+  size_t i = getProbeStart(node->hash, m_mask);
+
+  for (size_t step = 1; ; ++step) {
+    BOOST_ASSERT(step <= m_groups.size());
+    Group& group = m_groups[i];
+    uint64_t match = matchFree(group.ctrl);
+    if (match != 0) {
+      size_t slot = getMatchedSlot(match);
+      if (((group.ctrl >> (8 * slot)) & 0xFF) == CTRL_DELETED) {
+        --m_nDeleted;
+      }
+      setCtrl(group.ctrl, slot, getFingerprint(node->hash));
+      group.slots[slot] = node;
+      ++m_nOccupied;
+      return;
+    }
+    i = (i + step) & m_mask;
+  }
+}
+
+void
+GroupTable::clearSlot(size_t index)
+{
+  Group& group = m_groups[index / GROUP_SIZE];
+  size_t slot = index % GROUP_SIZE;
+  BOOST_ASSERT(group.slots[slot] != nullptr);
+
+  // a deleted (rather than empty) slot keeps probe sequences that pass through this group intact
+  setCtrl(group.ctrl, slot, CTRL_DELETED);
+  group.slots[slot] = nullptr;
+  --m_nOccupied;
+  ++m_nDeleted;
+}
+
+bool
+GroupTable::erase(const Node* node)
+{
+  size_t index = this->locate(node);
+  if (index == NPOS) {
+    return false;
+  }
+  this->clearSlot(index);
+  return true;
+}
+
+void
+GroupTable::moveGroup(size_t i, GroupTable& dest)
+{
+  BOOST_ASSERT(i < m_groups.size());
+  for (size_t slot = 0; slot < GROUP_SIZE; ++slot) {
+    Node* node = m_groups[i].slots[slot];
+    if (node != nullptr) {
+      this->clearSlot(i * GROUP_SIZE + slot);
+      dest.insert(node);
+    }
+  }
+}
+
+Node*
+GroupTable::getNext(const Node* node) const
+{
+  size_t index = 0;
+  if (node != nullptr) {
+    index = this->locate(node);
+    BOOST_ASSERT(index != NPOS);
+    ++index;
+  }
+
+  for (size_t nSlots = this->getNSlots(); index < nSlots; ++index) {
+    Node* next = m_groups[index / GROUP_SIZE].slots[index % GROUP_SIZE];
+    if (next != nullptr) {
+      return next;
+    }
+  }
+  return nullptr;
+}
+
+/** \return number of groups, a power of two, that provides at least \p nBuckets slots
+ */
+static size_t
+computeNGroups(size_t nBuckets)
+{
+  size_t nGroups = 1;
+  while (nGroups * GroupTable::GROUP_SIZE < nBuckets) {
+    nGroups <<= 1;
+  }
+  return nGroups;
+}
+
+Hashtable::Hashtable(const Options& options, boost::intrusive_ptr<SlabPoolSet> pools)
   : m_options(options)
+  , m_nodeAllocator(std::move(pools))
   , m_size(0)
 {
   BOOST_ASSERT(m_options.minSize > 0);
@@ -128,45 +342,128 @@ Hashtable::Hashtable(const Options& options)
   BOOST_ASSERT(m_options.shrinkLoadFactor < 1.0);
   BOOST_ASSERT(m_options.shrinkFactor > 0.0);
   BOOST_ASSERT(m_options.shrinkFactor < 1.0);
+  BOOST_ASSERT(!m_options.incrementalResize || m_options.migrationBatchSize > 0);
 
-  m_buckets.resize(options.initialSize);
+  if (m_options.engine == HashtableEngine::OPEN_ADDRESSING) {
+    BOOST_ASSERT(m_options.expandLoadFactor < 1.0);
+    BOOST_ASSERT(m_options.migrationBatchSize > 0);
+    m_groups = make_unique<GroupTable>(computeNGroups(options.initialSize));
+  }
+  else {
+    m_buckets.resize(options.initialSize);
+  }
   this->computeThresholds();
 }
 
 Hashtable::~Hashtable()
 {
-  for (size_t i = 0; i < m_buckets.size(); ++i) {
-    foreachNode(m_buckets[i], [] (Node* node) {
-      node->prev = node->next = nullptr;
-      delete node;
-    });
+  for (const auto& buckets : {&m_buckets, &m_oldBuckets}) {
+    for (Node* head : *buckets) {
+      foreachNode(head, [this] (Node* node) {
+        node->prev = node->next = nullptr;
+        this->destroyNode(node);
+      });
+    }
+  }
+
+  for (const auto& table : {m_groups.get(), m_oldGroups.get()}) {
+    if (table != nullptr) {
+      table->forEach([this] (Node* node) { this->destroyNode(node); });
+    }
+  }
+}
+
+void
+Hashtable::setEngine(HashtableEngine engine, bool incrementalResize)
+{
+  if (engine == m_options.engine && incrementalResize == m_options.incrementalResize) {
+    return;
+  }
+
+  std::vector<Node*> nodes;
+  nodes.reserve(m_size);
+  for (const Node* node = this->getNext(nullptr); node != nullptr; node = this->getNext(node)) {
+    nodes.push_back(const_cast<Node*>(node));
+  }
+  BOOST_ASSERT(nodes.size() == m_size);
+
+  m_options.engine = engine;
+  m_options.incrementalResize = incrementalResize;
+  BOOST_ASSERT(engine != HashtableEngine::OPEN_ADDRESSING || m_options.expandLoadFactor < 1.0);
+  BOOST_ASSERT(!incrementalResize || m_options.migrationBatchSize > 0);
+  std::vector<Node*>().swap(m_buckets);
+  std::vector<Node*>().swap(m_oldBuckets);
+  m_groups.reset();
+  m_oldGroups.reset();
+  m_nMigrated = 0;
+
+  // large enough to hold every node without crossing the expand threshold
+  size_t nBuckets = std::max(m_options.initialSize,
+                             static_cast<size_t>(m_size / m_options.expandLoadFactor) + 1);
+  if (engine == HashtableEngine::OPEN_ADDRESSING) {
+    m_groups = make_unique<GroupTable>(computeNGroups(nBuckets));
+  }
+  else {
+    m_buckets.resize(nBuckets);
+  }
+  this->computeThresholds();
+
+  for (Node* node : nodes) {
+    node->prev = node->next = nullptr;
+    if (m_groups != nullptr) {
+      m_groups->insert(node);
+    }
+    else {
+      attach(m_buckets[this->computeBucketIndex(node->hash)], node);
+    }
+  }
+  NFD_LOG_DEBUG("rebuilt nBuckets=" << this->getNBuckets() << " nNodes=" << m_size);
+}
+
+Node*
+Hashtable::allocateNode(HashValue h, const Name& name)
+{
+  Node* node = m_nodeAllocator.allocate(1);
+  try {
+    return new (node) Node(h, name);
+  }
+  catch (...) {
+    m_nodeAllocator.deallocate(node, 1);
+    throw;
   }
 }
 
 void
-Hashtable::attach(size_t bucket, Node* node)
+Hashtable::destroyNode(Node* node) noexcept
+{
+  node->~Node();
+  m_nodeAllocator.deallocate(node, 1);
+}
+
+void
+Hashtable::attach(Node*& head, Node* node)
 {
   node->prev = nullptr;
-  node->next = m_buckets[bucket];
+  node->next = head;
 
   if (node->next != nullptr) {
     BOOST_ASSERT(node->next->prev == nullptr);
     node->next->prev = node;
   }
 
-  m_buckets[bucket] = node;
+  head = node;
 }
 
 void
-Hashtable::detach(size_t bucket, Node* node)
+Hashtable::detach(Node*& head, Node* node)
 {
   if (node->prev != nullptr) {
     BOOST_ASSERT(node->prev->next == node);
     node->prev->next = node->next;
   }
   else {
-    BOOST_ASSERT(m_buckets[bucket] == node);
-    m_buckets[bucket] = node->next;
+    BOOST_ASSERT(head == node);
+    head = node->next;
   }
 
   if (node->next != nullptr) {
@@ -177,16 +474,68 @@ Hashtable::detach(size_t bucket, Node* node)
   node->prev = node->next = nullptr;
 }
 
+bool
+Hashtable::isInOldBuckets(const Node* node) const
+{
+  if (m_oldBuckets.empty()) {
+    return false;
+  }
+
+  const Node* head = node;
+  while (head->prev != nullptr) {
+    head = head->prev;
+  }
+  return m_oldBuckets[node->hash % m_oldBuckets.size()] == head;
+}
+
+const Node*
+Hashtable::findImpl(const Name& name, size_t prefixLen, HashValue h) const
+{
+  auto isMatch = [&] (const Node* node) {
+    return node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0;
+  };
+
+  if (m_groups != nullptr) {
+    const Node* node = m_groups->find(h, isMatch);
+    if (node == nullptr && m_oldGroups != nullptr) {
+      node = m_oldGroups->find(h, isMatch);
+    }
+    return node;
+  }
+
+  auto findInBucket = [&] (const Node* head) -> const Node* {
+    for (const Node* node = head; node != nullptr; node = node->next) {
+      if (isMatch(node)) {
+        return node;
+      }
+    }
+    return nullptr;
+  };
+
+  const Node* node = findInBucket(m_buckets[this->computeBucketIndex(h)]);
+  if (node == nullptr && !m_oldBuckets.empty()) {
+    // an old bucket that has been migrated is empty
+    node = findInBucket(m_oldBuckets[h % m_oldBuckets.size()]);
+  }
+  return node;
+}
+
 std::pair<const Node*, bool>
 Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
 {
-  size_t bucket = this->computeBucketIndex(h);
+  if (m_groups != nullptr) {
+    return this->findOrInsertInGroups(name, prefixLen, h, allowInsert);
+  }
 
-  for (const Node* node = m_buckets[bucket]; node != nullptr; node = node->next) {
-    if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
-      NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " bucket=" << bucket);
-      return {node, false};
-    }
+  if (!m_oldBuckets.empty()) {
+    this->migrateBuckets(m_options.migrationBatchSize);
+  }
+
+  size_t bucket = this->computeBucketIndex(h);
+  const Node* found = this->findImpl(name, prefixLen, h);
+  if (found != nullptr) {
+    NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " bucket=" << bucket);
+    return {found, false};
   }
 
   if (!allowInsert) {
@@ -194,30 +543,26 @@ Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool al
     return {nullptr, false};
   }
 
-  Node* node = new Node(h, name.getPrefix(prefixLen));
-  this->attach(bucket, node);
+  Node* node = this->allocateNode(h, name.getPrefix(prefixLen));
+  attach(m_buckets[bucket], node);
   NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h << " bucket=" << bucket);
   ++m_size;
 
-  if (m_size > m_expandThreshold) {
-    this->resize(static_cast<size_t>(m_options.expandFactor * this->getNBuckets()));
-  }
-
+  this->resizeIfNeeded();
   return {node, true};
 }
 
 const Node*
 Hashtable::find(const Name& name, size_t prefixLen) const
 {
-  HashValue h = computeHash(name, prefixLen);
-  return const_cast<Hashtable*>(this)->findOrInsert(name, prefixLen, h, false).first;
+  return this->findImpl(name, prefixLen, computeHash(name, prefixLen));
 }
 
 const Node*
 Hashtable::find(const Name& name, size_t prefixLen, const HashSequence& hashes) const
 {
   BOOST_ASSERT(hashes.at(prefixLen) == computeHash(name, prefixLen));
-  return const_cast<Hashtable*>(this)->findOrInsert(name, prefixLen, hashes[prefixLen], false).first;
+  return this->findImpl(name, prefixLen, hashes[prefixLen]);
 }
 
 std::pair<const Node*, bool>
@@ -233,18 +578,74 @@ Hashtable::erase(Node* node)
   BOOST_ASSERT(node != nullptr);
   BOOST_ASSERT(node->entry.getParent() == nullptr);
 
+  if (m_groups != nullptr) {
+    this->eraseFromGroups(node);
+    return;
+  }
+
+  if (!m_oldBuckets.empty()) {
+    this->migrateBuckets(m_options.migrationBatchSize);
+  }
+
   size_t bucket = this->computeBucketIndex(node->hash);
   NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
 
-  this->detach(bucket, node);
-  delete node;
+  if (this->isInOldBuckets(node)) {
+    detach(m_oldBuckets[node->hash % m_oldBuckets.size()], node);
+  }
+  else {
+    detach(m_buckets[bucket], node);
+  }
+  this->destroyNode(node);
   --m_size;
+  this->resizeIfNeeded();
+}
+
+const Node*
+Hashtable::getNext(const Node* node) const
+{
+  if (m_groups != nullptr) {
+    // nodes remaining in the old table are enumerated before nodes in the current table
+    if (m_oldGroups != nullptr && (node == nullptr || m_oldGroups->contains(node))) {
+      const Node* next = m_oldGroups->getNext(node);
+      if (next != nullptr) {
+        return next;
+      }
+      node = nullptr;
+    }
+    return m_groups->getNext(node);
+  }
+
+  // nodes remaining in the old buckets are enumerated before nodes in the current buckets
+  bool isOld = false;
+  size_t bucket = 0;
+  if (node == nullptr) {
+    isOld = !m_oldBuckets.empty();
+    bucket = isOld ? m_nMigrated : 0;
+  }
+  else {
+    if (node->next != nullptr) {
+      return node->next;
+    }
+    isOld = this->isInOldBuckets(node);
+    bucket = (isOld ? node->hash % m_oldBuckets.size() : this->computeBucketIndex(node->hash)) + 1;
+  }
 
-  if (m_size < m_shrinkThreshold) {
-    size_t newNBuckets = std::max(m_options.minSize,
-      static_cast<size_t>(m_options.shrinkFactor * this->getNBuckets()));
-    this->resize(newNBuckets);
+  if (isOld) {
+    for (; bucket < m_oldBuckets.size(); ++bucket) {
+      if (m_oldBuckets[bucket] != nullptr) {
+        return m_oldBuckets[bucket];
+      }
+    }
+    bucket = 0;
   }
+
+  for (; bucket < m_buckets.size(); ++bucket) {
+    if (m_buckets[bucket] != nullptr) {
+      return m_buckets[bucket];
+    }
+  }
+  return nullptr;
 }
 
 void
@@ -255,9 +656,47 @@ Hashtable::computeThresholds()
   NFD_LOG_TRACE("thresholds expand=" << m_expandThreshold << " shrink=" << m_shrinkThreshold);
 }
 
+void
+Hashtable::resizeIfNeeded()
+{
+  if (this->getNPendingMigrations() > 0) {
+    // a table is resized again only after the previous migration completes, which checks
+    // the thresholds again; until then, the current table absorbs the difference
+    return;
+  }
+
+  if (m_groups != nullptr) {
+    if (m_size > m_expandThreshold) {
+      size_t newNBuckets = static_cast<size_t>(m_options.expandFactor * this->getNBuckets());
+      this->resizeGroups(computeNGroups(newNBuckets));
+    }
+    else if (m_size < m_shrinkThreshold) {
+      size_t newNGroups = computeNGroups(std::max(m_options.minSize,
+        static_cast<size_t>(m_options.shrinkFactor * this->getNBuckets())));
+      if (newNGroups < m_groups->getNGroups()) {
+        this->resizeGroups(newNGroups);
+      }
+    }
+    else if (m_groups->getNUsedSlots() > m_expandThreshold) {
+      // too many deleted slots: rehash into a table of the same size
+      this->resizeGroups(m_groups->getNGroups());
+    }
+    return;
+  }
+
+  if (m_size > m_expandThreshold) {
+    this->resize(static_cast<size_t>(m_options.expandFactor * this->getNBuckets()));
+  }
+  else if (m_size < m_shrinkThreshold) {
+    this->resize(std::max(m_options.minSize,
+                          static_cast<size_t>(m_options.shrinkFactor * this->getNBuckets())));
+  }
+}
+
 void
 Hashtable::resize(size_t newNBuckets)
 {
+  BOOST_ASSERT(m_oldBuckets.empty());
   if (this->getNBuckets() == newNBuckets) {
     return;
   }
@@ -266,15 +705,122 @@ Hashtable::resize(size_t newNBuckets)
   std::vector<Node*> oldBuckets;
   oldBuckets.swap(m_buckets);
   m_buckets.resize(newNBuckets);
+  this->computeThresholds();
+
+  if (m_options.incrementalResize) {
+    m_oldBuckets = std::move(oldBuckets);
+    m_nMigrated = 0;
+    return;
+  }
 
   for (Node* head : oldBuckets) {
     foreachNode(head, [this] (Node* node) {
-      size_t bucket = this->computeBucketIndex(node->hash);
-      this->attach(bucket, node);
+      attach(m_buckets[this->computeBucketIndex(node->hash)], node);
+    });
+  }
+}
+
+void
+Hashtable::migrateBuckets(size_t nBuckets)
+{
+  BOOST_ASSERT(!m_oldBuckets.empty());
+
+  size_t end = std::min(m_nMigrated + nBuckets, m_oldBuckets.size());
+  for (; m_nMigrated < end; ++m_nMigrated) {
+    foreachNode(std::exchange(m_oldBuckets[m_nMigrated], nullptr), [this] (Node* node) {
+      attach(m_buckets[this->computeBucketIndex(node->hash)], node);
     });
   }
 
+  if (m_nMigrated == m_oldBuckets.size()) {
+    NFD_LOG_DEBUG("resize complete nBuckets=" << this->getNBuckets());
+    std::vector<Node*>().swap(m_oldBuckets);
+    m_nMigrated = 0;
+    // start the next resize, if the size crossed a threshold during the migration
+    this->resizeIfNeeded();
+  }
+}
+
+std::pair<const Node*, bool>
+Hashtable::findOrInsertInGroups(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
+{
+  if (m_oldGroups != nullptr) {
+    // the current table must have room for every node when the migration completes;
+    // this takes effect only if expandFactor is too small for the migration to keep up
+    size_t batchSize = m_size + 1 < m_groups->getNSlots() ? m_options.migrationBatchSize
+                                                           : m_oldGroups->getNGroups();
+    this->migrateGroups(batchSize);
+  }
+
+  const Node* node = this->findImpl(name, prefixLen, h);
+  if (node != nullptr) {
+    NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h);
+    return {node, false};
+  }
+
+  if (!allowInsert) {
+    NFD_LOG_TRACE("not-found " << name.getPrefix(prefixLen) << " hash=" << h);
+    return {nullptr, false};
+  }
+
+  Node* newNode = this->allocateNode(h, name.getPrefix(prefixLen));
+  m_groups->insert(newNode);
+  NFD_LOG_TRACE("insert " << newNode->entry.getName() << " hash=" << h);
+  ++m_size;
+
+  this->resizeIfNeeded();
+  return {newNode, true};
+}
+
+void
+Hashtable::eraseFromGroups(Node* node)
+{
+  NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash);
+
+  if (m_oldGroups != nullptr) {
+    this->migrateGroups(m_options.migrationBatchSize);
+  }
+
+  bool isErased = m_groups->erase(node);
+  if (!isErased) {
+    BOOST_ASSERT(m_oldGroups != nullptr);
+    isErased = m_oldGroups->erase(node);
+  }
+  BOOST_ASSERT(isErased);
+  this->destroyNode(node);
+  --m_size;
+  this->resizeIfNeeded();
+}
+
+void
+Hashtable::resizeGroups(size_t newNGroups)
+{
+  BOOST_ASSERT(m_oldGroups == nullptr);
+  NFD_LOG_DEBUG("resize from=" << this->getNBuckets() << " to=" << newNGroups * GroupTable::GROUP_SIZE);
+
+  m_oldGroups = std::exchange(m_groups, make_unique<GroupTable>(newNGroups));
+  m_nMigrated = 0;
   this->computeThresholds();
 }
 
+void
+Hashtable::migrateGroups(size_t nGroups)
+{
+  BOOST_ASSERT(m_oldGroups != nullptr);
+
+  size_t end = std::min(m_nMigrated + nGroups, m_oldGroups->getNGroups());
+  for (; m_nMigrated < end; ++m_nMigrated) {
+    m_oldGroups->moveGroup(m_nMigrated, *m_groups);
+  }
+
+  if (m_nMigrated == m_oldGroups->getNGroups()) {
+    BOOST_ASSERT(m_oldGroups->size() == 0);
+    NFD_LOG_DEBUG("resize complete nBuckets=" << this->getNBuckets());
+    m_oldGroups.reset();
+    m_nMigrated = 0;
+    // start the next resize, if the size crossed a threshold during the migration
+    this->resizeIfNeeded();
+  }
+}
+
 } // namespace nfd::name_tree
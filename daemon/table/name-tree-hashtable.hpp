@@ -27,9 +27,12 @@
 #define NFD_DAEMON_TABLE_NAME_TREE_HASHTABLE_HPP
 
 #include "name-tree-entry.hpp"
+#include "common/slab-pool.hpp"
 
 #include <limits>
 
+#include <boost/container/small_vector.hpp>
+
 namespace nfd::name_tree {
 
 class Entry;
@@ -38,10 +41,22 @@ class Entry;
  */
 using HashValue = size_t;
 
+/** \brief Number of hash values that a HashSequence can hold without heap allocation.
+ *
+ *  This must be greater than NameTree::getMaxDepth(), so that the hash sequence of any
+ *  name tree lookup (which also contains the hash of the root prefix) is stored inline.
+ */
+inline constexpr size_t HASH_SEQUENCE_INLINE_CAPACITY = 33;
+
 /** \brief A sequence of hash values.
+ *
+ *  The i-th element is the hash value of the name prefix of length i.
+ *  Since a HashSequence is typically computed once per packet and discarded shortly after,
+ *  it is stored in a small inline buffer to avoid a heap allocation in the common case.
+ *
  *  \sa computeHashes
  */
-using HashSequence = std::vector<HashValue>;
+using HashSequence = boost::container::small_vector<HashValue, HASH_SEQUENCE_INLINE_CAPACITY>;
 
 /** \brief Computes hash value of \p name.getPrefix(prefixLen).
  */
@@ -58,6 +73,7 @@ computeHashes(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::
  *
  *  Zero or more nodes can be added to a hashtable bucket. They are organized as
  *  a doubly linked list through prev and next pointers.
+ *  When the hashtable uses open addressing, prev and next are unused.
  */
 class Node : noncopyable
 {
@@ -102,6 +118,19 @@ foreachNode(N* head, const F& func)
   }
 }
 
+/**
+ * \brief Selects the data structure underlying a Hashtable.
+ */
+enum class HashtableEngine {
+  /** \brief Buckets of doubly linked node lists, resized all at once.
+   */
+  CHAINED,
+  /** \brief Open addressing over cache-line-sized groups of slots, resized incrementally.
+   *  \sa GroupTable
+   */
+  OPEN_ADDRESSING,
+};
+
 /**
  * \brief Provides options for Hashtable.
  */
@@ -137,6 +166,171 @@ struct HashtableOptions
   /** \brief When the hashtable is shrunk, its new size will be `max(nBuckets*shrinkFactor, minSize)`.
    */
   float shrinkFactor = 0.5f;
+
+  /** \brief Data structure of the hashtable.
+   *
+   *  With \c HashtableEngine::OPEN_ADDRESSING, \c expandLoadFactor must be less than 1,
+   *  and bucket counts are rounded up to a power-of-two number of groups.
+   */
+  HashtableEngine engine = HashtableEngine::CHAINED;
+
+  /** \brief Whether a \c HashtableEngine::CHAINED hashtable is resized incrementally.
+   *
+   *  If true, a resize allocates the new bucket array and keeps the old one alongside it.
+   *  Nodes are then migrated a few buckets at a time by subsequent insert and erase operations,
+   *  which bounds the latency that table growth adds to any single operation. A lookup searches
+   *  both tables and does not migrate, so that it does not modify the hashtable.
+   *  A \c HashtableEngine::OPEN_ADDRESSING hashtable is always resized incrementally.
+   */
+  bool incrementalResize = false;
+
+  /** \brief Maximum number of old buckets (or groups, with \c HashtableEngine::OPEN_ADDRESSING)
+   *         moved into the new table by each insert or erase operation while an
+   *         incremental resize is in progress.
+   */
+  size_t migrationBatchSize = 2;
+};
+
+/**
+ * \brief An open-addressing table of nodes, organized in cache-line-sized groups.
+ *
+ * Each group holds GROUP_SIZE slots of node pointers, along with a control word that contains
+ * one control byte per slot: either a 7-bit fingerprint of the hash value of the node in that
+ * slot, or a marker of an empty or deleted slot. A lookup compares the fingerprint against all
+ * control bytes of a group with a few word-wide bitwise operations, and dereferences only the
+ * nodes whose fingerprint matches. Groups are probed quadratically.
+ *
+ * \note This class is for Hashtable internal use.
+ */
+class GroupTable : noncopyable
+{
+public:
+  /** \brief Number of slots in a group.
+   *
+   *  One control word and seven pointers occupy exactly one 64-byte cache line.
+   */
+  static constexpr size_t GROUP_SIZE = 7;
+
+  /** \pre nGroups is a power of two
+   */
+  explicit
+  GroupTable(size_t nGroups);
+
+  size_t
+  getNGroups() const
+  {
+    return m_groups.size();
+  }
+
+  /** \return number of slots
+   */
+  size_t
+  getNSlots() const
+  {
+    return m_groups.size() * GROUP_SIZE;
+  }
+
+  /** \return number of slots occupied by a node
+   */
+  size_t
+  size() const
+  {
+    return m_nOccupied;
+  }
+
+  /** \return number of slots occupied by a node or marked as deleted
+   */
+  size_t
+  getNUsedSlots() const
+  {
+    return m_nOccupied + m_nDeleted;
+  }
+
+  /** \brief Find a node with hash value \p h that satisfies \p pred.
+   *  \tparam Pred a functor with signature bool Pred(const Node*)
+   */
+  template<typename Pred>
+  Node*
+  find(HashValue h, const Pred& pred) const;
+
+  /** \return whether \p node is stored in this table
+   */
+  bool
+  contains(const Node* node) const
+  {
+    return this->locate(node) != NPOS;
+  }
+
+  /** \brief Store \p node in the first free slot of its probe sequence.
+   *  \pre no node with the same name is stored in this table
+   *  \pre size() < getNSlots()
+   */
+  void
+  insert(Node* node);
+
+  /** \brief Remove \p node from this table.
+   *  \return whether \p node was stored in this table
+   */
+  bool
+  erase(const Node* node);
+
+  /** \brief Move all nodes stored in the i-th group into \p dest.
+   *
+   *  The vacated slots are marked as deleted, so that probe sequences through this group remain
+   *  intact for nodes that have not been moved yet.
+   */
+  void
+  moveGroup(size_t i, GroupTable& dest);
+
+  /** \return the node stored in the slot after that of \p node, or the first node in this table
+   *          if \p node is nullptr; nullptr if there is no such node
+   *  \pre node == nullptr || contains(node)
+   */
+  Node*
+  getNext(const Node* node) const;
+
+  /** \brief Invoke a function for each stored node.
+   *  \tparam F a functor with signature void F(Node*)
+   */
+  template<typename F>
+  void
+  forEach(const F& func) const
+  {
+    for (const Group& group : m_groups) {
+      for (size_t slot = 0; slot < GROUP_SIZE; ++slot) {
+        if (group.slots[slot] != nullptr) {
+          func(group.slots[slot]);
+        }
+      }
+    }
+  }
+
+private:
+  static constexpr size_t NPOS = std::numeric_limits<size_t>::max();
+
+  template<typename Pred>
+  size_t
+  findSlot(HashValue h, const Pred& pred) const;
+
+  size_t
+  locate(const Node* node) const;
+
+  void
+  clearSlot(size_t index);
+
+private:
+  struct alignas(64) Group
+  {
+    uint64_t ctrl;
+    Node* slots[GROUP_SIZE] = {};
+
+    Group();
+  };
+
+  std::vector<Group> m_groups;
+  size_t m_mask;
+  size_t m_nOccupied = 0;
+  size_t m_nDeleted = 0;
 };
 
 /**
@@ -144,21 +338,43 @@ struct HashtableOptions
  *
  * The Hashtable contains a number of buckets.
  * Each node is placed into a bucket determined by a hash value computed from its name.
- * Hash collision is resolved through a doubly linked list in each bucket.
- * The number of buckets is adjusted according to how many nodes are stored.
+ * With the default \c HashtableEngine::CHAINED, hash collision is resolved through a doubly
+ * linked list in each bucket.
+ * With \c HashtableEngine::OPEN_ADDRESSING, each bucket is a slot in a GroupTable, and hash
+ * collision is resolved by probing other groups.
+ * The number of buckets is adjusted according to how many nodes are stored. With an incremental
+ * resize, the old table is kept until all its nodes are migrated into the new table a few buckets
+ * at a time, during subsequent operations; in the meantime, getNBuckets() refers to the new table.
  */
 class Hashtable
 {
 public:
   using Options = HashtableOptions;
 
+  /** \param options hashtable options
+   *  \param pools if not nullptr, nodes are allocated from these pools
+   */
   explicit
-  Hashtable(const Options& options);
+  Hashtable(const Options& options, boost::intrusive_ptr<SlabPoolSet> pools = nullptr);
 
   /** \brief Deallocates all nodes.
    */
   ~Hashtable();
 
+  const Options&
+  getOptions() const noexcept
+  {
+    return m_options;
+  }
+
+  /** \brief Change the engine and the resize mode, moving every node into a new table.
+   *
+   *  Nodes keep their addresses, so that entries attached to them remain valid;
+   *  the enumeration order changes. Nothing happens if neither setting changes.
+   */
+  void
+  setEngine(HashtableEngine engine, bool incrementalResize);
+
   /** \return number of nodes
    */
   size_t
@@ -172,10 +388,23 @@ public:
   size_t
   getNBuckets() const
   {
-    return m_buckets.size();
+    return m_groups != nullptr ? m_groups->getNSlots() : m_buckets.size();
+  }
+
+  /** \return number of buckets (or groups) in the old table that are yet to be migrated,
+   *          or zero if no incremental resize is in progress
+   */
+  size_t
+  getNPendingMigrations() const
+  {
+    if (m_oldGroups != nullptr) {
+      return m_oldGroups->getNGroups() - m_nMigrated;
+    }
+    return m_oldBuckets.size() - m_nMigrated;
   }
 
   /** \return bucket index for hash value h
+   *  \pre the hashtable uses \c HashtableEngine::CHAINED
    */
   size_t
   computeBucketIndex(HashValue h) const
@@ -184,7 +413,9 @@ public:
   }
 
   /** \return i-th bucket
+   *  \pre the hashtable uses \c HashtableEngine::CHAINED
    *  \pre bucket < getNBuckets()
+   *  \note During an incremental resize, some nodes may still be in the old buckets.
    */
   const Node*
   getBucket(size_t bucket) const
@@ -201,14 +432,16 @@ public:
 
   /** \brief Find node for name.getPrefix(prefixLen).
    *  \pre name.size() > prefixLen
-   *  \pre hashes == computeHashes(name)
+   *  \pre hashes.size() > prefixLen
+   *  \pre hashes is a prefix of computeHashes(name)
    */
   const Node*
   find(const Name& name, size_t prefixLen, const HashSequence& hashes) const;
 
   /** \brief Find or insert node for name.getPrefix(prefixLen).
    *  \pre name.size() > prefixLen
-   *  \pre hashes == computeHashes(name)
+   *  \pre hashes.size() > prefixLen
+   *  \pre hashes is a prefix of computeHashes(name)
    */
   std::pair<const Node*, bool>
   insert(const Name& name, size_t prefixLen, const HashSequence& hashes);
@@ -219,16 +452,40 @@ public:
   void
   erase(Node* node);
 
+  /** \return the node after \p node in enumeration order, or the first node if \p node is nullptr;
+   *          nullptr if there is no such node
+   *  \pre node == nullptr || node exists in this hashtable
+   */
+  const Node*
+  getNext(const Node* node) const;
+
 private:
-  /** \brief Attach node to bucket.
+  /** \brief Attach node to the bucket whose first node is \p head.
    */
+  static void
+  attach(Node*& head, Node* node);
+
+  Node*
+  allocateNode(HashValue h, const Name& name);
+
   void
-  attach(size_t bucket, Node* node);
+  destroyNode(Node* node) noexcept;
 
-  /** \brief Detach node from bucket.
+  /** \brief Detach node from the bucket whose first node is \p head.
    */
-  void
-  detach(size_t bucket, Node* node);
+  static void
+  detach(Node*& head, Node* node);
+
+  /** \return whether \p node is in a bucket of m_oldBuckets
+   */
+  bool
+  isInOldBuckets(const Node* node) const;
+
+  /** \brief Find node for name.getPrefix(prefixLen) in the current and the old table,
+   *         without migrating any bucket.
+   */
+  const Node*
+  findImpl(const Name& name, size_t prefixLen, HashValue h) const;
 
   std::pair<const Node*, bool>
   findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
@@ -236,12 +493,49 @@ private:
   void
   computeThresholds();
 
+  /** \brief Start a resize if the number of nodes crossed a threshold.
+   *
+   *  Nothing happens while an incremental resize is in progress; the thresholds are checked
+   *  again when its migration completes.
+   */
+  void
+  resizeIfNeeded();
+
+  /** \pre no incremental resize is in progress
+   */
   void
   resize(size_t newNBuckets);
 
+  /** \brief Move up to \p nBuckets buckets from m_oldBuckets into m_buckets.
+   */
+  void
+  migrateBuckets(size_t nBuckets);
+
+  std::pair<const Node*, bool>
+  findOrInsertInGroups(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
+
+  void
+  eraseFromGroups(Node* node);
+
+  /** \brief Start an incremental resize into a table of \p newNGroups groups.
+   *  \pre no incremental resize is in progress
+   */
+  void
+  resizeGroups(size_t newNGroups);
+
+  /** \brief Move up to \p nGroups groups from the old table into the current table.
+   */
+  void
+  migrateGroups(size_t nGroups);
+
 private:
   std::vector<Node*> m_buckets;
+  std::vector<Node*> m_oldBuckets;    ///< buckets being migrated from, if resize is in progress
+  unique_ptr<GroupTable> m_groups;    ///< current table, if engine is OPEN_ADDRESSING
+  unique_ptr<GroupTable> m_oldGroups; ///< table being migrated from, if resize is in progress
+  size_t m_nMigrated = 0;             ///< number of old buckets or groups already migrated
   Options m_options;
+  SlabAllocator<Node> m_nodeAllocator;
   size_t m_size;
   size_t m_expandThreshold;
   size_t m_shrinkThreshold;
@@ -34,19 +34,67 @@ namespace nfd::name_tree {
 
 NFD_LOG_INIT(NameTree);
 
-NameTree::NameTree(size_t nBuckets)
-  : m_ht(HashtableOptions(nBuckets))
+NameTree::NameTree(size_t nBuckets, boost::intrusive_ptr<SlabPoolSet> pools)
+  : NameTree(HashtableOptions(nBuckets), std::move(pools))
 {
 }
 
+NameTree::NameTree(const HashtableOptions& options, boost::intrusive_ptr<SlabPoolSet> pools)
+  : m_pools(std::move(pools))
+  , m_ht(options, m_pools)
+{
+}
+
+NameTree::PacketScope::PacketScope(NameTree& nameTree, const Name& name)
+  : m_nameTree(nameTree)
+  , m_name(name)
+  , m_hashes(computeHashes(name, getMaxDepth()))
+  , m_outer(nameTree.m_packet)
+{
+  m_nameTree.m_packet = this;
+}
+
+NameTree::PacketScope::~PacketScope()
+{
+  BOOST_ASSERT(m_nameTree.m_packet == this);
+  m_nameTree.m_packet = m_outer;
+}
+
+const HashSequence*
+NameTree::findPacketHashes(const Name& name, size_t prefixLen) const
+{
+  if (m_packet == nullptr || prefixLen >= m_packet->m_hashes.size()) {
+    return nullptr;
+  }
+
+  // PIT entries share the Interest, so the common case is decided by address;
+  // otherwise the first prefixLen components must be equal
+  const Name& packetName = m_packet->m_name;
+  if (&name == &packetName ||
+      (prefixLen <= name.size() && name.compare(0, prefixLen, packetName, 0, prefixLen) == 0)) {
+    return &m_packet->m_hashes;
+  }
+  return nullptr;
+}
+
 Entry&
 NameTree::lookup(const Name& name, size_t prefixLen)
+{
+  const HashSequence* hashes = this->findPacketHashes(name, prefixLen);
+  if (hashes != nullptr) {
+    return this->lookup(name, prefixLen, *hashes);
+  }
+  return this->lookup(name, prefixLen, computeHashes(name, prefixLen));
+}
+
+Entry&
+NameTree::lookup(const Name& name, size_t prefixLen, const HashSequence& hashes)
 {
   NFD_LOG_TRACE("lookup(" << name << ", " << prefixLen << ')');
   BOOST_ASSERT(prefixLen <= name.size());
   BOOST_ASSERT(prefixLen <= getMaxDepth());
+  BOOST_ASSERT(prefixLen < hashes.size());
 
-  HashSequence hashes = computeHashes(name, prefixLen);
   const Node* node = nullptr;
   Entry* parent = nullptr;
 
@@ -153,7 +201,9 @@ NameTree::findExactMatch(const Name& name, size_t prefixLen) const
     return nullptr;
   }
 
-  const Node* node = m_ht.find(name, prefixLen);
+  const HashSequence* hashes = this->findPacketHashes(name, prefixLen);
+  const Node* node = hashes == nullptr ? m_ht.find(name, prefixLen) :
+                                         m_ht.find(name, prefixLen, *hashes);
   return node == nullptr ? nullptr : &node->entry;
 }
 
@@ -161,7 +211,19 @@ Entry*
 NameTree::findLongestPrefixMatch(const Name& name, const EntrySelector& entrySelector) const
 {
   size_t depth = std::min(name.size(), getMaxDepth());
-  HashSequence hashes = computeHashes(name, depth);
+  const HashSequence* hashes = this->findPacketHashes(name, depth);
+  if (hashes != nullptr) {
+    return this->findLongestPrefixMatch(name, *hashes, entrySelector);
+  }
+  return this->findLongestPrefixMatch(name, computeHashes(name, depth), entrySelector);
+}
+
+Entry*
+NameTree::findLongestPrefixMatch(const Name& name, const HashSequence& hashes,
+                                 const EntrySelector& entrySelector) const
+{
+  size_t depth = std::min(name.size(), getMaxDepth());
+  BOOST_ASSERT(depth < hashes.size());
 
   for (ssize_t i = depth; i >= 0; --i) {
     const Node* node = m_ht.find(name, i, hashes);
@@ -221,6 +283,14 @@ NameTree::findAllMatches(const Name& name, const EntrySelector& entrySelector) c
   return {Iterator(make_shared<PrefixMatchImpl>(*this, entrySelector), entry), end()};
 }
 
+boost::iterator_range<NameTree::const_iterator>
+NameTree::findAllMatches(const Name& name, const HashSequence& hashes,
+                         const EntrySelector& entrySelector) const
+{
+  Entry* entry = this->findLongestPrefixMatch(name, hashes, entrySelector);
+  return {Iterator(make_shared<PrefixMatchImpl>(*this, entrySelector), entry), end()};
+}
+
 boost::iterator_range<NameTree::const_iterator>
 NameTree::fullEnumerate(const EntrySelector& entrySelector) const
 {
@@ -36,8 +36,17 @@ namespace name_tree {
 class NameTree : noncopyable
 {
 public:
+  /** \param nBuckets initial number of hashtable buckets
+   *  \param pools if not nullptr, name tree nodes are allocated from these pools,
+   *               which are also made available to tables attached to this name tree
+   */
+  explicit
+  NameTree(size_t nBuckets = 1024, boost::intrusive_ptr<SlabPoolSet> pools = nullptr);
+
+  /** \brief Constructs a name tree whose hashtable is configured with \p options
+   */
   explicit
-  NameTree(size_t nBuckets = 1024);
+  NameTree(const HashtableOptions& options, boost::intrusive_ptr<SlabPoolSet> pools = nullptr);
 
 public: // information
   /** \brief Maximum depth of the name tree
@@ -69,6 +78,31 @@ public: // information
     return m_ht.getNBuckets();
   }
 
+  /** \return number of hashtable buckets yet to be migrated by an in-progress incremental resize
+   *  \sa HashtableOptions::incrementalResize
+   */
+  size_t
+  getNPendingMigrations() const
+  {
+    return m_ht.getNPendingMigrations();
+  }
+
+  /** \return options of the hashtable
+   */
+  const HashtableOptions&
+  getHashtableOptions() const noexcept
+  {
+    return m_ht.getOptions();
+  }
+
+  /** \return memory pools used by this name tree, or nullptr if it uses the global allocator
+   */
+  const boost::intrusive_ptr<SlabPoolSet>&
+  getSlabPools() const noexcept
+  {
+    return m_pools;
+  }
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    */
@@ -79,7 +113,52 @@ public: // information
     return Entry::get(tableEntry);
   }
 
+public: // per-packet hashes
+  /** \brief Makes the hash values of a packet name available to all lookups in a name tree
+   *
+   *  The hashes are computed once, when the scope is entered. Until the scope is left, every
+   *  lookup of a prefix of the packet name reuses them, including lookups that FIB, PIT,
+   *  StrategyChoice, and Measurements perform on behalf of forwarding strategies.
+   *  Scopes may be nested; the innermost scope takes effect.
+   *
+   *  \warning \p name must remain valid and unchanged while the scope is alive.
+   */
+  class PacketScope : noncopyable
+  {
+  public:
+    PacketScope(NameTree& nameTree, const Name& name);
+
+    ~PacketScope();
+
+    /** \return `computeHashes(name, getMaxDepth())`
+     */
+    const HashSequence&
+    getHashes() const noexcept
+    {
+      return m_hashes;
+    }
+
+  private:
+    NameTree& m_nameTree;
+    const Name& m_name;
+    HashSequence m_hashes;
+    const PacketScope* m_outer;
+
+    friend NameTree;
+  };
+
 public: // mutation
+  /** \brief Change the data structure of the hashtable.
+   *
+   *  Existing entries are kept, but iterators are invalidated.
+   *  \sa Hashtable::setEngine
+   */
+  void
+  setHashtableEngine(HashtableEngine engine, bool incrementalResize)
+  {
+    m_ht.setEngine(engine, incrementalResize);
+  }
+
   /** \brief Find or insert an entry by name
    *
    *  This method seeks a name tree entry of name \c name.getPrefix(prefixLen).
@@ -92,6 +171,14 @@ public: // mutation
   Entry&
   lookup(const Name& name, size_t prefixLen);
 
+  /** \brief Equivalent to `lookup(name, prefixLen)`, but reuses precomputed hash values
+   *  \param hashes a prefix of `computeHashes(name)`, with at least `prefixLen + 1` elements
+   *  \note This overload avoids recomputing the hashes when the caller has already obtained them,
+   *        e.g., for another table lookup on the same packet.
+   */
+  Entry&
+  lookup(const Name& name, size_t prefixLen, const HashSequence& hashes);
+
   /** \brief Equivalent to `lookup(name, name.size())`
    */
   Entry&
@@ -157,6 +244,15 @@ public: // matching
   findLongestPrefixMatch(const Name& name,
                          const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Equivalent to `findLongestPrefixMatch(name, entrySelector)`, but reuses
+   *         precomputed hash values
+   *  \param hashes a prefix of `computeHashes(name)`, with at least
+   *                `min(name.size(), getMaxDepth()) + 1` elements
+   */
+  Entry*
+  findLongestPrefixMatch(const Name& name, const HashSequence& hashes,
+                         const EntrySelector& entrySelector = AnyEntry()) const;
+
   /** \brief Equivalent to `findLongestPrefixMatch(entry.getName(), entrySelector)`
    *  \note This overload is more efficient than
    *        `findLongestPrefixMatch(const Name&, const EntrySelector&)` in common cases.
@@ -213,6 +309,14 @@ public: // matching
   findAllMatches(const Name& name,
                  const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Equivalent to `findAllMatches(name, entrySelector)`, but reuses precomputed hash values
+   *  \param hashes a prefix of `computeHashes(name)`, with at least
+   *                `min(name.size(), getMaxDepth()) + 1` elements
+   */
+  Range
+  findAllMatches(const Name& name, const HashSequence& hashes,
+                 const EntrySelector& entrySelector = AnyEntry()) const;
+
 public: // enumeration
   using const_iterator = Iterator;
 
@@ -273,11 +377,23 @@ public: // enumeration
   }
 
 private:
+  /** \return hashes of the current packet if they are valid for \c name.getPrefix(prefixLen),
+   *          otherwise nullptr
+   */
+  const HashSequence*
+  findPacketHashes(const Name& name, size_t prefixLen) const;
+
+private:
+  boost::intrusive_ptr<SlabPoolSet> m_pools;
   Hashtable m_ht;
+  const PacketScope* m_packet = nullptr;
 
   friend class EnumerationImpl;
 };
 
+static_assert(NameTree::getMaxDepth() < HASH_SEQUENCE_INLINE_CAPACITY,
+              "HashSequence of a maximum-depth name must not allocate");
+
 } // namespace name_tree
 
 using name_tree::NameTree;
@@ -59,8 +59,10 @@ OutRecord::setIncomingNack(const lp::Nack& nack)
   return true;
 }
 
-Entry::Entry(const Interest& interest)
+Entry::Entry(const Interest& interest, const boost::intrusive_ptr<SlabPoolSet>& pools)
   : m_interest(interest.shared_from_this())
+  , m_inRecords(pools)
+  , m_outRecords(pools)
 {
 }
 
@@ -91,8 +93,7 @@ Entry::insertOrUpdateInRecord(Face& face, const Interest& interest)
 
   auto it = findInRecord(face);
   if (it == m_inRecords.end()) {
-    m_inRecords.emplace_front(face);
-    it = m_inRecords.begin();
+    it = m_inRecords.emplace_back(face);
   }
 
   it->update(interest);
@@ -113,8 +114,7 @@ Entry::insertOrUpdateOutRecord(Face& face, const Interest& interest)
 
   auto it = findOutRecord(face);
   if (it == m_outRecords.end()) {
-    m_outRecords.emplace_front(face);
-    it = m_outRecords.begin();
+    it = m_outRecords.emplace_back(face);
   }
 
   it->update(interest);
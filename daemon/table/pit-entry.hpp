@@ -27,10 +27,11 @@
 #define NFD_DAEMON_TABLE_PIT_ENTRY_HPP
 
 #include "strategy-info-host.hpp"
+#include "common/slab-pool.hpp"
+#include "common/timer-wheel.hpp"
 
-#include <ndn-cxx/util/scheduler.hpp>
-
-#include <list>
+#include <boost/container/small_vector.hpp>
+#include <boost/iterator/indirect_iterator.hpp>
 
 namespace nfd {
 
@@ -55,14 +56,14 @@ class FaceRecord : public StrategyInfoHost
 public:
   explicit
   FaceRecord(Face& face)
-    : m_face(face)
+    : m_face(&face)
   {
   }
 
   Face&
   getFace() const noexcept
   {
-    return m_face;
+    return *m_face;
   }
 
   Interest::Nonce
@@ -94,7 +95,7 @@ public:
   update(const Interest& interest);
 
 private:
-  Face& m_face;
+  Face* m_face;
   Interest::Nonce m_lastNonce{0, 0, 0, 0};
   time::steady_clock::time_point m_lastRenewed = time::steady_clock::time_point::min();
   time::steady_clock::time_point m_expiry = time::steady_clock::time_point::min();
@@ -172,15 +173,151 @@ private:
   unique_ptr<lp::NackHeader> m_incomingNack;
 };
 
+/**
+ * \brief An unordered collection of face records with stable addresses.
+ *
+ * Each record is allocated individually, from the name tree's slab pools when available,
+ * and the collection keeps pointers to the records in a small vector stored inline in the
+ * PIT entry. Inserting or deleting a record invalidates iterators of the collection, but
+ * pointers and references to the other records remain valid.
+ *
+ * \tparam T InRecord or OutRecord
+ * \tparam N number of record pointers stored without heap allocation
+ */
+template<typename T, size_t N>
+class RecordCollection : noncopyable
+{
+private:
+  using Pointers = boost::container::small_vector<T*, N>;
+  using AllocTraits = std::allocator_traits<SlabAllocator<T>>;
+
+public:
+  using value_type = T;
+  using iterator = boost::indirect_iterator<typename Pointers::iterator>;
+  using const_iterator = boost::indirect_iterator<typename Pointers::const_iterator, const T>;
+
+  explicit
+  RecordCollection(const boost::intrusive_ptr<SlabPoolSet>& pools = nullptr)
+    : m_alloc(pools)
+  {
+  }
+
+  ~RecordCollection()
+  {
+    clear();
+  }
+
+  iterator
+  begin() noexcept
+  {
+    return iterator(m_records.begin());
+  }
+
+  const_iterator
+  begin() const noexcept
+  {
+    return const_iterator(m_records.begin());
+  }
+
+  iterator
+  end() noexcept
+  {
+    return iterator(m_records.end());
+  }
+
+  const_iterator
+  end() const noexcept
+  {
+    return const_iterator(m_records.end());
+  }
+
+  bool
+  empty() const noexcept
+  {
+    return m_records.empty();
+  }
+
+  size_t
+  size() const noexcept
+  {
+    return m_records.size();
+  }
+
+  T&
+  front() noexcept
+  {
+    return *m_records.front();
+  }
+
+  const T&
+  front() const noexcept
+  {
+    return *m_records.front();
+  }
+
+  /** \brief Appends a new record for \p face.
+   *  \return an iterator to the new record
+   */
+  iterator
+  emplace_back(Face& face)
+  {
+    T* record = AllocTraits::allocate(m_alloc, 1);
+    try {
+      AllocTraits::construct(m_alloc, record, face);
+      m_records.push_back(record);
+    }
+    catch (...) {
+      AllocTraits::deallocate(m_alloc, record, 1);
+      throw;
+    }
+    return iterator(std::prev(m_records.end()));
+  }
+
+  /** \brief Deletes the record at \p pos.
+   *  \return an iterator to the record that followed the deleted one
+   */
+  iterator
+  erase(const_iterator pos)
+  {
+    this->destroy(*pos.base());
+    return iterator(m_records.erase(pos.base()));
+  }
+
+  void
+  clear() noexcept
+  {
+    for (T* record : m_records) {
+      this->destroy(record);
+    }
+    m_records.clear();
+  }
+
+private:
+  void
+  destroy(T* record) noexcept
+  {
+    AllocTraits::destroy(m_alloc, record);
+    AllocTraits::deallocate(m_alloc, record, 1);
+  }
+
+private:
+  SlabAllocator<T> m_alloc;
+  Pointers m_records;
+};
+
 /**
  * \brief An unordered collection of in-records.
+ *
+ * Pointers to up to two in-records are stored inline in the PIT entry.
  */
-using InRecordCollection = std::list<InRecord>;
+using InRecordCollection = RecordCollection<InRecord, 2>;
 
 /**
  * \brief An unordered collection of out-records.
+ *
+ * Pointers to up to three out-records are stored inline in the PIT entry.
  */
-using OutRecordCollection = std::list<OutRecord>;
+using OutRecordCollection = RecordCollection<OutRecord, 3>;
 
 /**
  * \brief Represents an entry in the %Interest table (PIT).
@@ -196,8 +333,11 @@ using OutRecordCollection = std::list<OutRecord>;
 class Entry : public StrategyInfoHost, noncopyable
 {
 public:
+  /** \param interest the representative Interest
+   *  \param pools if not nullptr, in-records and out-records are allocated from these pools
+   */
   explicit
-  Entry(const Interest& interest);
+  Entry(const Interest& interest, const boost::intrusive_ptr<SlabPoolSet>& pools = nullptr);
 
   /** \return the representative Interest of the PIT entry
    *  \note Every Interest in in-records and out-records should have same Name and Selectors
@@ -374,7 +514,7 @@ public:
    *
    *  This timer is used in forwarding pipelines to delete the entry
    */
-  ndn::scheduler::EventId expiryTimer;
+  TimerWheel::Timer expiryTimer;
 
   /** \brief Indicates whether this PIT entry is satisfied.
    */
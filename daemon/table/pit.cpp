@@ -47,7 +47,7 @@ Pit::Pit(NameTree& nameTree)
 }
 
 std::pair<shared_ptr<Entry>, bool>
-Pit::findOrInsert(const Interest& interest, bool allowInsert)
+Pit::findOrInsert(const Interest& interest, bool allowInsert, const name_tree::HashSequence* hashes)
 {
   // determine which NameTree entry should the PIT entry be attached onto
   const Name& name = interest.getName();
@@ -58,7 +58,8 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
   // ensure NameTree entry exists
   name_tree::Entry* nte = nullptr;
   if (allowInsert) {
-    nte = &m_nameTree.lookup(name, nteDepth);
+    nte = hashes == nullptr ? &m_nameTree.lookup(name, nteDepth) :
+                              &m_nameTree.lookup(name, nteDepth, *hashes);
   }
   else {
     nte = m_nameTree.findExactMatch(name, nteDepth);
@@ -83,7 +84,8 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
     return {nullptr, true};
   }
 
-  auto entry = make_shared<Entry>(interest);
+  const auto& pools = m_nameTree.getSlabPools();
+  auto entry = std::allocate_shared<Entry>(SlabAllocator<Entry>(pools), interest, pools);
   nte->insertPitEntry(entry);
   ++m_nItems;
   return {entry, true};
@@ -98,8 +100,19 @@ nteHasPitEntries(const name_tree::Entry& nte)
 DataMatchResult
 Pit::findAllDataMatches(const Data& data) const
 {
-  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), &nteHasPitEntries);
+  return this->collectDataMatches(data, m_nameTree.findAllMatches(data.getName(), &nteHasPitEntries));
+}
 
+DataMatchResult
+Pit::findAllDataMatches(const Data& data, const name_tree::HashSequence& hashes) const
+{
+  return this->collectDataMatches(data, m_nameTree.findAllMatches(data.getName(), hashes,
+                                                                  &nteHasPitEntries));
+}
+
+DataMatchResult
+Pit::collectDataMatches(const Data& data, const name_tree::Range& ntMatches) const
+{
   DataMatchResult matches;
   for (const auto& nte : ntMatches) {
     for (const auto& pitEntry : nte.getPitEntries()) {
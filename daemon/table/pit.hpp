@@ -117,12 +117,33 @@ public:
     return this->findOrInsert(interest, true);
   }
 
+  /** \brief Inserts a PIT entry for \p interest, reusing precomputed name hashes
+   *  \param interest the Interest; must be created with make_shared
+   *  \param hashes a prefix of `name_tree::computeHashes(interest.getName())`, covering at least
+   *                `min(interest.getName().size(), NameTree::getMaxDepth())` components
+   *  \sa insert(const Interest&)
+   */
+  std::pair<shared_ptr<Entry>, bool>
+  insert(const Interest& interest, const name_tree::HashSequence& hashes)
+  {
+    return this->findOrInsert(interest, true, &hashes);
+  }
+
   /** \brief Performs a Data match
    *  \return an iterable of all PIT entries matching \p data
    */
   DataMatchResult
   findAllDataMatches(const Data& data) const;
 
+  /** \brief Performs a Data match, reusing precomputed name hashes
+   *  \param data the Data packet
+   *  \param hashes a prefix of `name_tree::computeHashes(data.getName())`, covering at least
+   *                `min(data.getName().size(), NameTree::getMaxDepth())` components
+   *  \sa findAllDataMatches(const Data&)
+   */
+  DataMatchResult
+  findAllDataMatches(const Data& data, const name_tree::HashSequence& hashes) const;
+
   /** \brief Deletes an entry
    */
   void
@@ -163,13 +184,18 @@ private:
   /** \brief Finds or inserts a PIT entry for \p interest
    *  \param interest the Interest; must be created with make_shared if allowInsert
    *  \param allowInsert whether inserting a new entry is allowed
+   *  \param hashes precomputed name hashes of \p interest, or nullptr to compute them on demand
    *  \return if allowInsert, a new or existing entry with same Name+Selectors,
    *          and true for new entry, false for existing entry;
    *          if not allowInsert, an existing entry with same Name+Selectors and false,
    *          or `{nullptr, true}` if there's no existing entry
    */
   std::pair<shared_ptr<Entry>, bool>
-  findOrInsert(const Interest& interest, bool allowInsert);
+  findOrInsert(const Interest& interest, bool allowInsert,
+               const name_tree::HashSequence* hashes = nullptr);
+
+  DataMatchResult
+  collectDataMatches(const Data& data, const name_tree::Range& ntMatches) const;
 
 private:
   NameTree& m_nameTree;
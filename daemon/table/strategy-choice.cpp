@@ -106,6 +106,7 @@ StrategyChoice::insert(const Name& prefix, const Name& strategyName)
 
   this->changeStrategy(*entry, *oldStrategy, *strategy);
   entry->setStrategy(std::move(strategy));
+  this->afterChange(prefix);
   return InsertResult::OK;
 }
 
@@ -155,6 +156,7 @@ StrategyChoice::erase(const Name& prefix)
   nte->setStrategyChoiceEntry(nullptr);
   m_nameTree.eraseIfEmpty(nte);
   --m_nItems;
+  this->afterChange(prefix);
 }
 
 std::pair<bool, Name>
@@ -175,6 +175,13 @@ public: // enumeration
     return this->getRange().end();
   }
 
+public: // signal
+  /** \brief Signals after an entry is inserted or erased, or its strategy is changed.
+   *
+   *  The parameter is the entry prefix.
+   */
+  signal::Signal<StrategyChoice, Name> afterChange;
+
 private:
   void
   changeStrategy(Entry& entry,
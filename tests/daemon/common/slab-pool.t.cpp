@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2023,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/slab-pool.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <list>
+#include <set>
+
+namespace nfd::tests {
+
+BOOST_AUTO_TEST_SUITE(TestSlabPool)
+
+BOOST_AUTO_TEST_CASE(AllocateDeallocate)
+{
+  SlabPool pool(20);
+  BOOST_CHECK_EQUAL(pool.getBlockSize() % SlabPool::BLOCK_ALIGNMENT, 0);
+  BOOST_CHECK_GE(pool.getBlockSize(), 20);
+  BOOST_CHECK_EQUAL(pool.getNSlabs(), 0);
+
+  size_t nBlocksPerSlab = pool.getNBlocksPerSlab();
+  BOOST_CHECK_GE(nBlocksPerSlab * pool.getBlockSize(), SlabPool::SLAB_SIZE / 2);
+  std::set<void*> blocks;
+  for (size_t i = 0; i < nBlocksPerSlab + 1; ++i) {
+    void* p = pool.allocate();
+    BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(p) % SlabPool::BLOCK_ALIGNMENT, 0);
+    BOOST_CHECK(blocks.insert(p).second);
+  }
+  BOOST_CHECK_EQUAL(pool.getNSlabs(), 2);
+  BOOST_CHECK_EQUAL(pool.getNBlocksInUse(), nBlocksPerSlab + 1);
+  BOOST_CHECK_EQUAL(pool.getNBytesReserved(), 2 * SlabPool::SLAB_SIZE);
+
+  // a freed block is reused without obtaining another slab
+  void* freed = *blocks.begin();
+  pool.deallocate(freed);
+  BOOST_CHECK_EQUAL(pool.getNBlocksInUse(), nBlocksPerSlab);
+  BOOST_CHECK_EQUAL(pool.allocate(), freed);
+  BOOST_CHECK_EQUAL(pool.getNSlabs(), 2);
+  BOOST_CHECK_EQUAL(pool.getNAllocations(), nBlocksPerSlab + 2);
+
+  for (void* p : blocks) {
+    pool.deallocate(p);
+  }
+  BOOST_CHECK_EQUAL(pool.getNBlocksInUse(), 0);
+  BOOST_CHECK_EQUAL(pool.getNSlabs(), 2); // kept for reuse
+  BOOST_CHECK_EQUAL(pool.getNSlabsReleased(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ReleaseFreeSlabs)
+{
+  SlabPool pool(100, 1);
+  size_t nBlocksPerSlab = pool.getNBlocksPerSlab();
+
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < 4 * nBlocksPerSlab; ++i) {
+    blocks.push_back(pool.allocate());
+  }
+  BOOST_CHECK_EQUAL(pool.getNSlabs(), 4);
+
+  // one block per slab keeps every slab in use
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    if (i % nBlocksPerSlab != 0) {
+      pool.deallocate(blocks[i]);
+    }
+  }
+  BOOST_CHECK_EQUAL(pool.getNSlabs(), 4);
+  BOOST_CHECK_EQUAL(pool.getNBlocksInUse(), 4);
+
+  // the first free slab is kept, the others are released
+  for (size_t i = 0; i < blocks.size(); i += nBlocksPerSlab) {
+    pool.deallocate(blocks[i]);
+  }
+  BOOST_CHECK_EQUAL(pool.getNBlocksInUse(), 0);
+  BOOST_CHECK_EQUAL(pool.getNSlabs(), 1);
+  BOOST_CHECK_EQUAL(pool.getNSlabsReleased(), 3);
+  BOOST_CHECK_EQUAL(pool.getNBytesReserved(), SlabPool::SLAB_SIZE);
+
+  // the kept slab is reused
+  void* p = pool.allocate();
+  BOOST_CHECK_EQUAL(pool.getNSlabs(), 1);
+  pool.deallocate(p);
+}
+
+BOOST_AUTO_TEST_CASE(PoolSet)
+{
+  SlabPoolSet pools;
+  SlabPool* pool24 = pools.getPool(24);
+  BOOST_REQUIRE(pool24 != nullptr);
+  BOOST_CHECK_EQUAL(pools.getPool(17), pool24);
+  BOOST_CHECK_NE(pools.getPool(40), pool24);
+  BOOST_CHECK(pools.getPool(SlabPoolSet::MAX_BLOCK_SIZE) != nullptr);
+  BOOST_CHECK(pools.getPool(SlabPoolSet::MAX_BLOCK_SIZE + 1) == nullptr);
+  BOOST_CHECK(pools.getPool(8, SlabPool::BLOCK_ALIGNMENT * 2) == nullptr);
+
+  std::vector<size_t> blockSizes;
+  pools.forEach([&] (const SlabPool& pool) { blockSizes.push_back(pool.getBlockSize()); });
+  BOOST_CHECK_EQUAL(blockSizes.size(), 3);
+  BOOST_CHECK(std::is_sorted(blockSizes.begin(), blockSizes.end()));
+}
+
+BOOST_AUTO_TEST_CASE(Allocator)
+{
+  boost::intrusive_ptr<SlabPoolSet> pools(new SlabPoolSet);
+  SlabPool* pool = pools->getPool(sizeof(std::list<int>::value_type) + 2 * sizeof(void*));
+
+  {
+    std::list<int, SlabAllocator<int>> list{SlabAllocator<int>(pools)};
+    for (int i = 0; i < 100; ++i) {
+      list.push_back(i);
+    }
+    BOOST_CHECK_EQUAL(pool->getNBlocksInUse(), 100);
+    list.pop_front();
+    BOOST_CHECK_EQUAL(pool->getNBlocksInUse(), 99);
+  }
+  BOOST_CHECK_EQUAL(pool->getNBlocksInUse(), 0);
+
+  // shared_ptr control block keeps the pools alive
+  auto sp = std::allocate_shared<int>(SlabAllocator<int>(pools), 42);
+  pools.reset();
+  BOOST_CHECK_EQUAL(*sp, 42);
+  sp.reset();
+
+  // without pools, the allocator behaves like std::allocator
+  SlabAllocator<int> plain;
+  BOOST_CHECK(plain == SlabAllocator<double>());
+  BOOST_CHECK(plain != SlabAllocator<int>(boost::intrusive_ptr<SlabPoolSet>(new SlabPoolSet)));
+  std::list<int, SlabAllocator<int>> list(plain);
+  list.push_back(1);
+  BOOST_CHECK_EQUAL(list.front(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSlabPool
+
+} // namespace nfd::tests
@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/spsc-queue.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <thread>
+
+namespace nfd::tests {
+
+BOOST_AUTO_TEST_SUITE(TestSpscQueue)
+
+BOOST_AUTO_TEST_CASE(PushPop)
+{
+  SpscQueue<int> queue(3);
+  BOOST_CHECK_EQUAL(queue.capacity(), 4);
+  BOOST_CHECK(queue.empty());
+
+  for (int i = 0; i < 4; ++i) {
+    BOOST_CHECK(queue.push(int(i)));
+  }
+  BOOST_CHECK(!queue.push(4));
+  BOOST_CHECK(!queue.empty());
+
+  int item = -1;
+  BOOST_CHECK(queue.pop(item));
+  BOOST_CHECK_EQUAL(item, 0);
+  // a popped slot can be reused
+  BOOST_CHECK(queue.push(4));
+
+  std::vector<int> consumed;
+  BOOST_CHECK_EQUAL(queue.consumeAll([&] (int&& i) { consumed.push_back(i); }), 4);
+  std::vector<int> expected{1, 2, 3, 4};
+  BOOST_CHECK_EQUAL_COLLECTIONS(consumed.begin(), consumed.end(), expected.begin(), expected.end());
+  BOOST_CHECK(queue.empty());
+  BOOST_CHECK(!queue.pop(item));
+  BOOST_CHECK_EQUAL(queue.consumeAll([] (int&&) {}), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ReleaseOnPop)
+{
+  SpscQueue<shared_ptr<int>> queue(2);
+  auto p = make_shared<int>(1);
+  BOOST_CHECK(queue.push(shared_ptr<int>(p)));
+  BOOST_CHECK_EQUAL(p.use_count(), 2);
+
+  queue.consumeAll([] (shared_ptr<int>&&) {});
+  BOOST_CHECK_EQUAL(p.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(TwoThreads)
+{
+  constexpr uint64_t N_ITEMS = 200000;
+  SpscQueue<uint64_t> queue(64);
+
+  std::thread producer([&queue] {
+    for (uint64_t i = 1; i <= N_ITEMS; ++i) {
+      while (!queue.push(uint64_t(i))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint64_t expected = 1;
+  bool isOrdered = true;
+  while (expected <= N_ITEMS) {
+    size_t n = queue.consumeAll([&] (uint64_t&& i) {
+      isOrdered = isOrdered && i == expected;
+      ++expected;
+    });
+    if (n == 0) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  BOOST_CHECK(isOrdered);
+  BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestSpscQueue
+
+} // namespace nfd::tests
@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/timer-wheel.hpp"
+#include "common/global.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+#include <thread>
+
+namespace nfd::tests {
+
+class TimerWheelFixture : public GlobalIoTimeFixture
+{
+protected:
+  TimerWheel wheel{getScheduler()};
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestTimerWheel, TimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(Order)
+{
+  std::vector<int> fired;
+  TimerWheel::Timer t1, t2, t3, t4;
+  // durations fall into levels 0, 1, 2, and 3
+  wheel.schedule(t3, 70_s, [&] { fired.push_back(3); });
+  wheel.schedule(t1, 10_ms, [&] { fired.push_back(1); });
+  wheel.schedule(t4, 5_h, [&] { fired.push_back(4); });
+  wheel.schedule(t2, 300_ms, [&] { fired.push_back(2); });
+  BOOST_CHECK_EQUAL(wheel.size(), 4);
+  BOOST_CHECK(t1.isPending());
+
+  advanceClocks(1_ms, 9);
+  BOOST_CHECK(fired.empty());
+  advanceClocks(1_ms, 1);
+  BOOST_CHECK_EQUAL(fired.size(), 1);
+  BOOST_CHECK(!t1.isPending());
+
+  advanceClocks(1_ms, 289);
+  BOOST_CHECK_EQUAL(fired.size(), 1);
+  advanceClocks(1_ms, 1);
+  BOOST_CHECK_EQUAL(fired.size(), 2);
+
+  advanceClocks(1_s, 69);
+  BOOST_CHECK_EQUAL(fired.size(), 2);
+  advanceClocks(100_ms, 6);
+  BOOST_CHECK_EQUAL(fired.size(), 2);
+  advanceClocks(100_ms, 1);
+  BOOST_CHECK_EQUAL(fired.size(), 3);
+
+  advanceClocks(1_s, 5 * 3600);
+  BOOST_CHECK_EQUAL(fired.size(), 4);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+  BOOST_CHECK((fired == std::vector<int>{1, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(CancelAndReschedule)
+{
+  int nFired = 0;
+  TimerWheel::Timer t1, t2;
+  wheel.schedule(t1, 100_ms, [&] { nFired += 1; });
+  wheel.schedule(t2, 100_ms, [&] { nFired += 10; });
+  t1.cancel();
+  BOOST_CHECK(!t1.isPending());
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+  t1.cancel(); // no effect
+
+  // rescheduling replaces the callback
+  wheel.schedule(t2, 500_ms, [&] { nFired += 100; });
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+
+  advanceClocks(10_ms, 20);
+  BOOST_CHECK_EQUAL(nFired, 0);
+  advanceClocks(10_ms, 30);
+  BOOST_CHECK_EQUAL(nFired, 100);
+
+  {
+    TimerWheel::Timer t3;
+    wheel.schedule(t3, 10_ms, [&] { nFired += 1000; });
+  }
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+  advanceClocks(10_ms, 5);
+  BOOST_CHECK_EQUAL(nFired, 100);
+}
+
+BOOST_AUTO_TEST_CASE(ScheduleFromCallback)
+{
+  int nFired = 0;
+  TimerWheel::Timer t1, t2;
+  std::function<void()> rearm = [&] {
+    if (++nFired < 5) {
+      wheel.schedule(t1, 0_ms, rearm);
+    }
+    t2.cancel();
+  };
+  wheel.schedule(t1, 1_ms, rearm);
+  wheel.schedule(t2, 1_ms, [&] { nFired += 100; });
+
+  advanceClocks(1_ms, 10);
+  BOOST_CHECK_EQUAL(nFired, 5);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(CallbackOwnsTimer)
+{
+  struct Owner
+  {
+    TimerWheel::Timer timer;
+  };
+
+  auto owner = make_shared<Owner>();
+  weak_ptr<Owner> weakOwner = owner;
+  bool hasFired = false;
+  wheel.schedule(owner->timer, 10_ms, [&hasFired, owner] { hasFired = true; });
+  owner.reset();
+  BOOST_CHECK(!weakOwner.expired());
+
+  advanceClocks(10_ms);
+  BOOST_CHECK(hasFired);
+  BOOST_CHECK(weakOwner.expired());
+
+  // cancelling releases the callback as well
+  owner = make_shared<Owner>();
+  weakOwner = owner;
+  wheel.schedule(owner->timer, 10_ms, [owner] {});
+  owner->timer.cancel();
+  owner.reset();
+  BOOST_CHECK(weakOwner.expired());
+}
+
+BOOST_AUTO_TEST_CASE(BeyondRange)
+{
+  // 2^32 ticks of 1 ms are about 49.7 days
+  bool hasFired = false;
+  TimerWheel::Timer t;
+  wheel.schedule(t, 60_days, [&] { hasFired = true; });
+
+  advanceClocks(1_h, 60 * 24 - 1);
+  BOOST_CHECK(!hasFired);
+  advanceClocks(1_h);
+  BOOST_CHECK(hasFired);
+}
+
+BOOST_AUTO_TEST_CASE(Idle)
+{
+  int nFired = 0;
+  TimerWheel::Timer t;
+  wheel.schedule(t, 1_ms, [&] { ++nFired; });
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(nFired, 1);
+
+  // the wheel jumps over idle periods
+  advanceClocks(1_days);
+  wheel.schedule(t, 2_ms, [&] { ++nFired; });
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(nFired, 1);
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(nFired, 2);
+}
+
+BOOST_AUTO_TEST_CASE(Destroy)
+{
+  bool hasFired = false;
+  TimerWheel::Timer t;
+  {
+    TimerWheel localWheel(getScheduler());
+    localWheel.schedule(t, 10_ms, [&] { hasFired = true; });
+    BOOST_CHECK(t.isPending());
+  }
+  BOOST_CHECK(!t.isPending());
+  advanceClocks(10_ms, 2);
+  BOOST_CHECK(!hasFired);
+}
+
+BOOST_AUTO_TEST_CASE(ThreadLocal)
+{
+  TimerWheel* w1 = &getTimerWheel();
+  TimerWheel* w2 = nullptr;
+
+  std::thread t([&w2] { w2 = &getTimerWheel(); });
+  t.join();
+
+  BOOST_CHECK(w1 != nullptr);
+  BOOST_CHECK(w2 != nullptr);
+  BOOST_CHECK(w1 != w2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestTimerWheel
+
+} // namespace nfd::tests
@@ -48,6 +48,12 @@ DummyFace::setState(face::FaceState state)
   static_cast<DummyTransport*>(getTransport())->setState(state);
 }
 
+void
+DummyFace::setSendQueueCongested(bool isCongested)
+{
+  static_cast<DummyTransport*>(getTransport())->setSendQueueCongested(isCongested);
+}
+
 void
 DummyFace::receiveInterest(const Interest& interest, const EndpointId& endpointId)
 {
@@ -57,6 +57,11 @@ public:
   void
   setState(face::FaceState state);
 
+  /** \brief Changes whether the send queue is congested.
+   */
+  void
+  setSendQueueCongested(bool isCongested);
+
   /** \brief Causes the face to receive an Interest.
    */
   void
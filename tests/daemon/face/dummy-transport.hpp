@@ -58,6 +58,7 @@ public:
   }
 
   using NullTransport::setMtu;
+  using NullTransport::setSendQueueCongested;
   using NullTransport::setState;
 
   ssize_t
@@ -133,6 +133,29 @@ BOOST_AUTO_TEST_CASE(DisableListenAndMcast)
   BOOST_CHECK_EQUAL(this->listEtherMcastFaces().size(), 0);
 }
 
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE(PacketRingBackend)
+{
+  SKIP_IF_ETHERNET_NETIF_COUNT_LT(1);
+
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        io_backend packet_ring
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  parseConfig(CONFIG, false);
+
+  checkChannelListEqual(factory, this->listUrisOfAvailableNetifs());
+  BOOST_CHECK_EQUAL(this->listEtherMcastFaces().size(), netifs.size());
+}
+#endif // __linux__
+
 BOOST_AUTO_TEST_CASE(McastNormal)
 {
   const std::string CONFIG = R"CONFIG(
@@ -378,6 +401,22 @@ BOOST_AUTO_TEST_CASE(BadIdleTimeout)
   BOOST_CHECK_THROW(parseConfig(CONFIG2, false), ConfigFile::Error);
 }
 
+BOOST_AUTO_TEST_CASE(BadIoBackend)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      ether
+      {
+        io_backend hello
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(BadMcast)
 {
   const std::string CONFIG = R"CONFIG(
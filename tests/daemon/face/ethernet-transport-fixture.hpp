@@ -73,7 +73,7 @@ protected:
 
     localEp = netif->getName();
     remoteEp = remoteAddr;
-    transport = make_unique<face::UnicastEthernetTransport>(*netif, remoteEp, persistency, 2_s);
+    transport = make_unique<face::UnicastEthernetTransport>(*netif, remoteEp, persistency, 2_s, ioBackend);
   }
 
   /**
@@ -90,13 +90,14 @@ protected:
 
     localEp = netif->getName();
     remoteEp = mcastGroup;
-    transport = make_unique<face::MulticastEthernetTransport>(*netif, remoteEp, linkType);
+    transport = make_unique<face::MulticastEthernetTransport>(*netif, remoteEp, linkType, ioBackend);
   }
 
 protected:
   LimitedIo limitedIo;
   shared_ptr<ndn::net::NetworkInterface> defaultNetif;
   unique_ptr<face::EthernetTransport> transport;
+  face::EthernetIoBackend ioBackend = face::EthernetIoBackend::PCAP;
   std::string localEp;
   ethernet::Address remoteEp;
 };
@@ -32,6 +32,7 @@
 #include "dummy-transport.hpp"
 
 #include <ndn-cxx/lp/fields.hpp>
+#include <ndn-cxx/lp/pit-token.hpp>
 #include <ndn-cxx/lp/tags.hpp>
 
 namespace nfd::tests {
@@ -202,6 +203,21 @@ BOOST_AUTO_TEST_CASE(SendNack)
   BOOST_CHECK(!nack1pkt.has<lp::SequenceField>());
 }
 
+BOOST_AUTO_TEST_CASE(SendBareShared)
+{
+  auto interest1 = makeInterest("/localhost/test");
+  auto data1 = makeData("/localhost/test");
+  face->sendInterest(*interest1);
+  face->sendData(*data1);
+
+  // a packet without link protocol fields is sent without copying
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 2);
+  BOOST_CHECK(transport->sentPackets[0].data() == interest1->wireEncode().data());
+  BOOST_CHECK_EQUAL(transport->sentPackets[0], interest1->wireEncode());
+  BOOST_CHECK(transport->sentPackets[1].data() == data1->wireEncode().data());
+  BOOST_CHECK_EQUAL(transport->sentPackets[1], data1->wireEncode());
+}
+
 BOOST_AUTO_TEST_CASE(ReceiveBareInterest)
 {
   // Initialize with Options that disables all services
@@ -1167,6 +1183,38 @@ BOOST_AUTO_TEST_CASE(SendCongestionMarkNack)
   BOOST_CHECK_EQUAL(sent.get<lp::CongestionMarkField>(), std::numeric_limits<uint64_t>::max());
 }
 
+BOOST_AUTO_TEST_CASE(SendMultipleFields)
+{
+  GenericLinkService::Options options;
+  options.allowLocalFields = true;
+  options.allowSelfLearning = true;
+  initialize(options);
+
+  lp::Packet received("641A pit-token=6206A0A1A2A3A4A5 payload=5010 interest=050E 0706080155080130 0A0400000001"_block);
+  lp::PitToken pitToken(received.get<lp::PitTokenField>());
+  lp::Nack nack = makeNack(*makeInterest("/localhost/test", false, std::nullopt, 123),
+                           lp::NackReason::CONGESTION);
+  nack.setTag(make_shared<lp::PitToken>(pitToken));
+  nack.setTag(make_shared<lp::IncomingFaceIdTag>(1000));
+  nack.setTag(make_shared<lp::CongestionMarkTag>(3));
+
+  face->sendNack(nack);
+
+  // encoded in one pass, the LpPacket is identical to one built field by field
+  lp::Packet expected(nack.getInterest().wireEncode());
+  expected.add<lp::NackField>(nack.getHeader());
+  expected.add<lp::CongestionMarkField>(3);
+  expected.add<lp::IncomingFaceIdField>(1000);
+  expected.add<lp::PitTokenField>(pitToken);
+
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  BOOST_CHECK_EQUAL(transport->sentPackets.back(), expected.wireEncode());
+  lp::Packet sent(transport->sentPackets.back());
+  BOOST_CHECK_EQUAL(sent.get<lp::NackField>().getReason(), lp::NackReason::CONGESTION);
+  BOOST_CHECK(lp::PitToken(sent.get<lp::PitTokenField>()) == pitToken);
+  BOOST_CHECK(!sent.has<lp::SequenceField>());
+}
+
 BOOST_AUTO_TEST_CASE(ReceiveCongestionMarkInterest)
 {
   auto interest = makeInterest("/12345678");
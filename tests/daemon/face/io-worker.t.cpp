@@ -0,0 +1,223 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/io-worker.hpp"
+#include "fw/face-table.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+#include "tests/daemon/face/dummy-transport.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace nfd::tests {
+
+using face::IoWorkerPool;
+
+class IoWorkerFixture : public GlobalIoFixture
+{
+protected:
+  IoWorkerFixture()
+  {
+    pool[0].createFace(
+      [this] {
+        // runs in the worker thread
+        workerFace = make_shared<DummyFace>("dummy://local", "dummy://remote");
+        workerFace->afterSend.connect([this] (uint32_t) { ++nWorkerSent; });
+        workerFace->afterStateChange.connect([this] (face::FaceState, face::FaceState newState) {
+          workerState = newState;
+        });
+        return workerFace;
+      },
+      [this] (const shared_ptr<Face>& face) {
+        proxy = face;
+        faceTable.add(face);
+      });
+    BOOST_REQUIRE(waitUntil([this] { return proxy != nullptr; }));
+  }
+
+  /** \brief Invoke \p f in the worker thread.
+   */
+  template<typename F>
+  void
+  inWorker(F&& f)
+  {
+    boost::asio::post(pool[0].getIo(), std::forward<F>(f));
+  }
+
+  /** \brief Poll the main io_context until \p pred is satisfied, for up to 10 seconds.
+   */
+  template<typename Predicate>
+  bool
+  waitUntil(const Predicate& pred)
+  {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!pred()) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+      pollIo();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+protected:
+  FaceTable faceTable;
+  IoWorkerPool pool{1};
+  shared_ptr<DummyFace> workerFace; ///< accessed only in the worker thread
+  shared_ptr<Face> proxy;
+  std::atomic<size_t> nWorkerSent{0};
+  std::atomic<face::FaceState> workerState{face::FaceState::UP};
+  std::atomic<ndn::nfd::FacePersistency> workerPersistency{ndn::nfd::FACE_PERSISTENCY_NONE};
+};
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_FIXTURE_TEST_SUITE(TestIoWorker, IoWorkerFixture)
+
+BOOST_AUTO_TEST_CASE(Properties)
+{
+  BOOST_TEST(proxy->getId() != face::INVALID_FACEID);
+  BOOST_TEST(proxy->getLocalUri() == FaceUri("dummy://local"));
+  BOOST_TEST(proxy->getRemoteUri() == FaceUri("dummy://remote"));
+  BOOST_TEST(proxy->getScope() == ndn::nfd::FACE_SCOPE_NON_LOCAL);
+  BOOST_TEST(proxy->getPersistency() == ndn::nfd::FACE_PERSISTENCY_PERSISTENT);
+  BOOST_TEST(proxy->getLinkType() == ndn::nfd::LINK_TYPE_POINT_TO_POINT);
+  BOOST_TEST(proxy->getState() == face::FaceState::UP);
+}
+
+BOOST_AUTO_TEST_CASE(Receive)
+{
+  std::vector<Interest> interests;
+  std::vector<Data> data;
+  std::vector<lp::Nack> nacks;
+  proxy->afterReceiveInterest.connect([&] (const Interest& interest, const EndpointId&) {
+    interests.push_back(interest);
+  });
+  proxy->afterReceiveData.connect([&] (const Data& d, const EndpointId&) { data.push_back(d); });
+  proxy->afterReceiveNack.connect([&] (const lp::Nack& nack, const EndpointId&) {
+    nacks.push_back(nack);
+  });
+
+  inWorker([this] {
+    workerFace->receiveInterest(*makeInterest("/A"));
+    workerFace->receiveData(*makeData("/B"));
+    workerFace->receiveNack(makeNack(*makeInterest("/C"), lp::NackReason::NO_ROUTE));
+  });
+  BOOST_REQUIRE(waitUntil([&] { return interests.size() + data.size() + nacks.size() == 3; }));
+  BOOST_TEST(interests.at(0).getName() == "/A");
+  BOOST_TEST(data.at(0).getName() == "/B");
+  BOOST_TEST(nacks.at(0).getReason() == lp::NackReason::NO_ROUTE);
+}
+
+BOOST_AUTO_TEST_CASE(Send)
+{
+  proxy->sendInterest(*makeInterest("/A"));
+  proxy->sendData(*makeData("/B"));
+  proxy->sendNack(makeNack(*makeInterest("/C"), lp::NackReason::CONGESTION));
+  BOOST_REQUIRE(waitUntil([this] { return nWorkerSent == 3; }));
+  BOOST_TEST(pool.getNQueueDrops() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(Counters)
+{
+  inWorker([this] {
+    auto transport = static_cast<DummyTransport*>(workerFace->getTransport());
+    transport->receivePacket(makeInterest("/A")->wireEncode());
+  });
+  // refreshed every second
+  BOOST_REQUIRE(waitUntil([this] { return proxy->getTransport()->getCounters().nInPackets == 1; }));
+  BOOST_TEST(proxy->getTransport()->getCounters().nInBytes > 0);
+}
+
+BOOST_AUTO_TEST_CASE(FollowState)
+{
+  inWorker([this] {
+    workerFace->setState(face::FaceState::DOWN);
+    workerFace->setSendQueueCongested(true);
+  });
+  BOOST_REQUIRE(waitUntil([this] { return proxy->getState() == face::FaceState::DOWN; }));
+  BOOST_REQUIRE(waitUntil([this] { return proxy->isSendQueueCongested(); }));
+
+  inWorker([this] { workerFace->setState(face::FaceState::UP); });
+  BOOST_REQUIRE(waitUntil([this] { return proxy->getState() == face::FaceState::UP; }));
+
+  inWorker([this] { workerFace->close(); });
+  BOOST_REQUIRE(waitUntil([this] { return proxy->getState() == face::FaceState::CLOSED; }));
+  BOOST_REQUIRE(waitUntil([this] { return faceTable.size() == 0; }));
+}
+
+BOOST_AUTO_TEST_CASE(CloseFromMain)
+{
+  proxy->close();
+  BOOST_TEST(proxy->getState() == face::FaceState::CLOSED);
+  BOOST_REQUIRE(waitUntil([this] { return workerState == face::FaceState::CLOSED; }));
+
+  // packets sent afterwards are dropped
+  proxy->sendInterest(*makeInterest("/A"));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  pollIo();
+  BOOST_TEST(nWorkerSent == 0);
+}
+
+BOOST_AUTO_TEST_CASE(ChangePersistency)
+{
+  proxy->getTransport()->setPersistency(ndn::nfd::FACE_PERSISTENCY_PERMANENT);
+  // runs after the change is applied in the worker thread
+  inWorker([this] { workerPersistency = workerFace->getPersistency(); });
+  BOOST_REQUIRE(waitUntil([this] {
+    return workerPersistency == ndn::nfd::FACE_PERSISTENCY_PERMANENT;
+  }));
+}
+
+BOOST_AUTO_TEST_CASE(AdoptAgain)
+{
+  shared_ptr<Face> proxy2;
+  inWorker([this, &proxy2] {
+    pool[0].adoptFace(workerFace, [&proxy2] (const shared_ptr<Face>& face) { proxy2 = face; });
+  });
+  BOOST_REQUIRE(waitUntil([&] { return proxy2 != nullptr; }));
+  BOOST_TEST(proxy2 == proxy);
+}
+
+BOOST_AUTO_TEST_CASE(StopPool)
+{
+  proxy->sendInterest(*makeInterest("/A"));
+  BOOST_REQUIRE(waitUntil([this] { return nWorkerSent == 1; }));
+
+  pool[0].stop();
+  BOOST_TEST(workerState == face::FaceState::UP);
+  proxy->sendInterest(*makeInterest("/B"));
+  proxy->close();
+  pollIo();
+  BOOST_TEST(nWorkerSent == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestIoWorker
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace nfd::tests
@@ -456,6 +456,115 @@ BOOST_AUTO_TEST_CASE(OverFragCount)
   BOOST_TEST(!isComplete);
 }
 
+BOOST_AUTO_TEST_CASE(UnequalSizes)
+{
+  // fragments of unequal sizes, with the smallest one arriving first
+  ndn::Buffer data0Buffer(data, 3);
+  ndn::Buffer data1Buffer(data + 3, 5);
+  ndn::Buffer data2Buffer(data + 8, 2);
+
+  lp::Packet frag0;
+  frag0.add<lp::FragmentField>(std::make_pair(data0Buffer.begin(), data0Buffer.end()));
+  frag0.add<lp::FragIndexField>(0);
+  frag0.add<lp::FragCountField>(3);
+  frag0.add<lp::SequenceField>(1000);
+  frag0.add<lp::NextHopFaceIdField>(200);
+
+  lp::Packet frag1;
+  frag1.add<lp::FragmentField>(std::make_pair(data1Buffer.begin(), data1Buffer.end()));
+  frag1.add<lp::FragIndexField>(1);
+  frag1.add<lp::FragCountField>(3);
+  frag1.add<lp::SequenceField>(1001);
+
+  lp::Packet frag2;
+  frag2.add<lp::FragmentField>(std::make_pair(data2Buffer.begin(), data2Buffer.end()));
+  frag2.add<lp::FragIndexField>(2);
+  frag2.add<lp::FragCountField>(3);
+  frag2.add<lp::SequenceField>(1002);
+
+  bool isComplete = false;
+  Block netPacket;
+  lp::Packet packet;
+
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment({}, frag2);
+  BOOST_TEST(!isComplete);
+
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment({}, frag0);
+  BOOST_TEST(!isComplete);
+
+  std::tie(isComplete, netPacket, packet) = reassembler.receiveFragment({}, frag1);
+  BOOST_REQUIRE(isComplete);
+  BOOST_CHECK(packet.has<lp::NextHopFaceIdField>());
+  BOOST_CHECK_EQUAL_COLLECTIONS(data, data + sizeof(data), netPacket.begin(), netPacket.end());
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(TooLarge)
+{
+  ndn::Buffer fragBuffer(5000);
+
+  lp::Packet frag0;
+  frag0.add<lp::FragmentField>(std::make_pair(fragBuffer.begin(), fragBuffer.end()));
+  frag0.add<lp::FragIndexField>(0);
+  frag0.add<lp::FragCountField>(3);
+  frag0.add<lp::SequenceField>(1000);
+
+  lp::Packet frag2;
+  frag2.add<lp::FragmentField>(std::make_pair(fragBuffer.begin(), fragBuffer.begin() + 10));
+  frag2.add<lp::FragIndexField>(2);
+  frag2.add<lp::FragCountField>(3);
+  frag2.add<lp::SequenceField>(1002);
+
+  bool isComplete = false;
+
+  // 3 fragments of 5000 octets cannot be a valid network-layer packet
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment({}, frag0);
+  BOOST_TEST(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment({}, frag2);
+  BOOST_TEST(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment({}, frag0);
+  BOOST_TEST(!isComplete);
+  BOOST_CHECK_EQUAL(reassembler.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ManyPartialPackets)
+{
+  ndn::Buffer data1Buffer(data, 5);
+  ndn::Buffer data2Buffer(data + 5, 5);
+
+  auto makeFrag = [] (const ndn::Buffer& buffer, uint64_t fragIndex, lp::Sequence seq) {
+    lp::Packet frag;
+    frag.add<lp::FragmentField>(std::make_pair(buffer.begin(), buffer.end()));
+    frag.add<lp::FragIndexField>(fragIndex);
+    frag.add<lp::FragCountField>(2);
+    frag.add<lp::SequenceField>(seq);
+    return frag;
+  };
+
+  const size_t N_PACKETS = 200;
+
+  // enough partial packets to grow the table several times
+  for (size_t i = 0; i < N_PACKETS; ++i) {
+    auto [isComplete, netPacket, packet] = reassembler.receiveFragment({},
+                                                                      makeFrag(data1Buffer, 0, 2 * i));
+    BOOST_TEST(!isComplete);
+  }
+  BOOST_CHECK_EQUAL(reassembler.size(), N_PACKETS);
+
+  // complete them in reverse order, so that erasures shift other entries back
+  for (size_t i = N_PACKETS; i-- > 0;) {
+    auto [isComplete, netPacket, packet] = reassembler.receiveFragment({},
+                                                                      makeFrag(data2Buffer, 1, 2 * i + 1));
+    BOOST_REQUIRE(isComplete);
+    BOOST_CHECK_EQUAL_COLLECTIONS(data, data + sizeof(data), netPacket.begin(), netPacket.end());
+  }
+  BOOST_CHECK_EQUAL(reassembler.size(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // MultiFragment
 
 BOOST_AUTO_TEST_SUITE(MultipleRemoteEndpoints)
@@ -515,6 +624,45 @@ BOOST_AUTO_TEST_CASE(Normal)
 
 BOOST_AUTO_TEST_SUITE_END() // MultipleRemoteEndpoints
 
+BOOST_AUTO_TEST_CASE(LatencyPercentile)
+{
+  BOOST_CHECK_EQUAL(reassembler.getLatencyPercentile(50), 0_ns);
+
+  ndn::Buffer data1Buffer(data, 5);
+  ndn::Buffer data2Buffer(data + 5, 5);
+
+  lp::Packet frag1;
+  frag1.add<lp::FragmentField>(std::make_pair(data1Buffer.begin(), data1Buffer.end()));
+  frag1.add<lp::FragIndexField>(0);
+  frag1.add<lp::FragCountField>(2);
+  frag1.add<lp::SequenceField>(1000);
+
+  lp::Packet frag2;
+  frag2.add<lp::FragmentField>(std::make_pair(data2Buffer.begin(), data2Buffer.end()));
+  frag2.add<lp::FragIndexField>(1);
+  frag2.add<lp::FragCountField>(2);
+  frag2.add<lp::SequenceField>(1001);
+
+  bool isComplete = false;
+
+  // reassembled immediately
+  reassembler.receiveFragment({}, frag1);
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment({}, frag2);
+  BOOST_REQUIRE(isComplete);
+
+  // reassembled after 10ms
+  reassembler.receiveFragment({}, frag1);
+  advanceClocks(10_ms);
+  std::tie(isComplete, std::ignore, std::ignore) = reassembler.receiveFragment({}, frag2);
+  BOOST_REQUIRE(isComplete);
+
+  BOOST_CHECK_EQUAL(reassembler.getLatencyPercentile(0), 0_ns);
+  BOOST_CHECK_EQUAL(reassembler.getLatencyPercentile(50), 0_ns);
+  BOOST_CHECK_GE(reassembler.getLatencyPercentile(99), 10_ms);
+  BOOST_CHECK_LT(reassembler.getLatencyPercentile(99), 20_ms);
+  BOOST_CHECK_EQUAL(reassembler.getLatencyPercentile(100), reassembler.getLatencyPercentile(99));
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestLpReassembler
 BOOST_AUTO_TEST_SUITE_END() // Face
 
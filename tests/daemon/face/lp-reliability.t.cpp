@@ -114,7 +114,7 @@ public:
   netPktHasUnackedFrag(const shared_ptr<LpReliability::NetPkt>& netPkt, lp::Sequence txSeq)
   {
     return std::any_of(netPkt->unackedFrags.begin(), netPkt->unackedFrags.end(),
-                       [txSeq] (auto fragIt) { return fragIt->first == txSeq; });
+                       [txSeq] (auto fragTxSeq) { return fragTxSeq == txSeq; });
   }
 
   /** \brief Make an LpPacket with fragment of specified size.
@@ -205,7 +205,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
                  reliability->m_unackedFrags.at(firstTxSeq + 1).netPkt);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 1).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq);
   BOOST_CHECK_EQUAL(reliability->m_ackQueue.size(), 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -223,7 +223,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 2).retxCount, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 1), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 1).retxCount, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 1);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 3);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -242,7 +242,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 4).retxCount, 2);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 3), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 3).retxCount, 1);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 3);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -261,7 +261,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 6).retxCount, 3);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 5), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 5).retxCount, 2);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 5);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 5);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 7);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -278,7 +278,7 @@ BOOST_AUTO_TEST_CASE(SendUnfragmentedRetx)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 6), 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(firstTxSeq + 7), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(firstTxSeq + 7).retxCount, 3);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, firstTxSeq + 7);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), firstTxSeq + 7);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 8);
 
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
@@ -352,7 +352,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 2));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 3));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(reliability->m_ackQueue.size(), 0);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 3);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
@@ -387,7 +387,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(!netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 3));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 5));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 4);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -421,7 +421,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(!netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 5));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 6));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -455,7 +455,7 @@ BOOST_AUTO_TEST_CASE(SendFragmentedRetx)
   BOOST_CHECK(!netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 6));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 7));
   BOOST_CHECK(netPktHasUnackedFrag(reliability->m_unackedFrags.at(2).netPkt, 4));
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 6);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -484,7 +484,7 @@ BOOST_AUTO_TEST_CASE(AckUnknownTxSeq)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 1);
   BOOST_CHECK(reliability->m_unackedFrags.at(2).netPkt);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -498,7 +498,7 @@ BOOST_AUTO_TEST_CASE(AckUnknownTxSeq)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 1);
   BOOST_CHECK(reliability->m_unackedFrags.at(2).netPkt);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 2);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -531,7 +531,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK(reliability->m_unackedFrags.at(2).netPkt);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(3), 1); // pkt5
   BOOST_CHECK(reliability->m_unackedFrags.at(3).netPkt);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 0xFFFFFFFFFFFFFFFF);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 0xFFFFFFFFFFFFFFFF);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetxExhausted, 0);
@@ -558,7 +558,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(3), 1); // pkt5
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 0xFFFFFFFFFFFFFFFF);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 0xFFFFFFFFFFFFFFFF);
   BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 1);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -586,7 +586,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(101010), 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 0xFFFFFFFFFFFFFFFF);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 0xFFFFFFFFFFFFFFFF);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 2);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 0);
@@ -611,7 +611,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(4), 1); // pkt1 new TxSeq
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(4).retxCount, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(4).nGreaterSeqAcks, 0);
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 3);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 6);
   lp::Packet sentRetxPkt(transport->sentPackets.back());
   BOOST_REQUIRE(sentRetxPkt.has<lp::TxSequenceField>());
@@ -638,7 +638,7 @@ BOOST_AUTO_TEST_CASE(LossByGreaterAcks)
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).retxCount, 0);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(3).nGreaterSeqAcks, 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(4), 0); // pkt1 new TxSeq
-  BOOST_CHECK_EQUAL(reliability->m_firstUnackedFrag->first, 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 3);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 6);
   BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 3);
   BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 1);
@@ -663,7 +663,7 @@ BOOST_AUTO_TEST_CASE(SkipFragmentsRemovedInRtt)
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 5);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 5);
 
-  lp::Sequence firstTxSeq = reliability->m_firstUnackedFrag->first;
+  lp::Sequence firstTxSeq = reliability->m_unackedFrags.getFirstTxSeq();
 
   // Ack the last 2 packets
   lp::Packet ackPkt1;
@@ -1009,7 +1009,7 @@ BOOST_AUTO_TEST_CASE(DropDuplicateReceivedSequence)
   BOOST_CHECK_EQUAL(reliability->m_recentRecvSeqs.count(7), 1);
 }
 
-BOOST_AUTO_TEST_CASE(DropDuplicateAckForRetx)
+BOOST_AUTO_TEST_CASE(SpuriousRetx)
 {
   lp::Packet pkt1 = makeFrag(1024, 50);
   linkService->sendLpPackets({pkt1});
@@ -1017,26 +1017,105 @@ BOOST_AUTO_TEST_CASE(DropDuplicateAckForRetx)
   // Will send out a single fragment
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 1);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
-  lp::Sequence firstTxSeq = reliability->m_firstUnackedFrag->first;
+  lp::Sequence firstTxSeq = reliability->m_unackedFrags.getFirstTxSeq();
 
   // RTO is initially 1 second, so will time out and retx
   advanceClocks(1250_ms, 1);
   BOOST_CHECK_EQUAL(transport->sentPackets.size(), 2);
-  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
+  BOOST_REQUIRE_EQUAL(reliability->m_unackedFrags.size(), 1);
+  lp::Sequence retxTxSeq = reliability->m_unackedFrags.getFirstTxSeq();
+  BOOST_CHECK_EQUAL(retxTxSeq, firstTxSeq + 1);
+  BOOST_CHECK_EQUAL(reliability->m_retxTxSeqs.size(), 1);
 
   // Acknowledge first transmission (RTO underestimation)
-  // Ack will be dropped because unknown
+  // Ack will acknowledge the fragment and count a spurious retransmission
   lp::Packet ackPkt1;
   ackPkt1.add<lp::AckField>(firstTxSeq);
   reliability->processIncomingPacket(ackPkt1);
-  BOOST_REQUIRE_EQUAL(reliability->m_unackedFrags.size(), 1); // Required because collection used below
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 0);
+  BOOST_CHECK_EQUAL(reliability->m_retxTxSeqs.size(), 0);
+  BOOST_CHECK(!reliability->m_rtoTimer.isPending());
+  BOOST_CHECK_EQUAL(linkService->getCounters().nSpuriousRetx, 1);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 1);
 
   // Acknowledge second transmission
-  // Ack will acknowledge retx and remove unacked frag
+  // Ack will be dropped because unknown
   lp::Packet ackPkt2;
-  ackPkt2.add<lp::AckField>(reliability->m_firstUnackedFrag->first);
+  ackPkt2.add<lp::AckField>(retxTxSeq);
   reliability->processIncomingPacket(ackPkt2);
   BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 0);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nSpuriousRetx, 1);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nRetransmitted, 1);
+}
+
+BOOST_AUTO_TEST_CASE(LossByReorderWindow)
+{
+  linkService->sendLpPackets({makeFrag(1, 50)});
+  advanceClocks(1_ms, 100);
+  linkService->sendLpPackets({makeFrag(2, 50)});
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 2);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 2);
+
+  // Ack for 3 measures an RTT of 50ms, so the reordering window is 12.5ms. Fragment 2 was sent
+  // 100ms before fragment 3, so it is considered lost after a single greater Ack.
+  advanceClocks(1_ms, 50);
+  lp::Packet ackPkt;
+  ackPkt.add<lp::AckField>(3);
+  BOOST_CHECK(reliability->processIncomingPacket(ackPkt));
+
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.size(), 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.count(2), 0);
+  BOOST_REQUIRE_EQUAL(reliability->m_unackedFrags.count(4), 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(4).retxCount, 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.at(4).pkt.get<lp::SequenceField>(), 1);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 4);
+  BOOST_CHECK_EQUAL(linkService->getCounters().nAcknowledged, 1);
+}
+
+BOOST_AUTO_TEST_CASE(SingleRtoTimer)
+{
+  linkService->sendLpPackets({makeFrag(1, 50)});
+  advanceClocks(1_ms, 300);
+  linkService->sendLpPackets({makeFrag(2, 50)});
+  BOOST_CHECK(reliability->m_rtoTimer.isPending());
+
+  // acknowledging the oldest fragment moves the timer to the next one, sent at T+300ms
+  lp::Packet ackPkt;
+  ackPkt.add<lp::AckField>(2);
+  BOOST_CHECK(reliability->processIncomingPacket(ackPkt));
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 3);
+
+  // RTO has been measured as 300ms + 4 * 150ms
+  advanceClocks(1_ms, 899);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 2);
+  advanceClocks(1_ms, 2);
+  BOOST_CHECK_EQUAL(transport->sentPackets.size(), 3);
+  BOOST_CHECK_EQUAL(reliability->m_unackedFrags.getFirstTxSeq(), 4);
+  BOOST_CHECK(reliability->m_rtoTimer.isPending());
+}
+
+BOOST_AUTO_TEST_CASE(AckQueueRanges)
+{
+  LpReliability::AckQueue queue;
+  BOOST_CHECK(queue.empty());
+
+  for (lp::Sequence txSeq : {5, 6, 7, 10}) {
+    queue.push(txSeq);
+  }
+  queue.push(0xFFFFFFFFFFFFFFFF);
+  queue.push(0);
+  BOOST_CHECK_EQUAL(queue.size(), 6);
+  BOOST_CHECK_EQUAL(queue.front(), 5);
+  BOOST_CHECK_EQUAL(queue.back(), 0);
+
+  std::vector<lp::Sequence> popped;
+  while (!queue.empty()) {
+    popped.push_back(queue.front());
+    queue.pop();
+  }
+  std::vector<lp::Sequence> expected{5, 6, 7, 10, 0xFFFFFFFFFFFFFFFF, 0};
+  BOOST_TEST(popped == expected, boost::test_tools::per_element());
 }
 
 BOOST_AUTO_TEST_SUITE_END() // TestLpReliability
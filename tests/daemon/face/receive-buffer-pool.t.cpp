@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/receive-buffer-pool.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <thread>
+
+namespace nfd::tests {
+
+using namespace nfd::face;
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_AUTO_TEST_SUITE(TestReceiveBufferPool)
+
+BOOST_AUTO_TEST_CASE(SizeClasses)
+{
+  auto& pool = ReceiveBufferPool::get();
+
+  auto b1 = pool.allocate(1);
+  BOOST_CHECK_EQUAL(b1->size(), 1);
+  BOOST_CHECK_EQUAL(b1->capacity(), 256);
+
+  auto b2 = pool.allocate(257);
+  BOOST_CHECK_EQUAL(b2->size(), 257);
+  BOOST_CHECK_EQUAL(b2->capacity(), 512);
+
+  auto b3 = pool.allocate(4096);
+  BOOST_CHECK_EQUAL(b3->capacity(), 4096);
+
+  auto b4 = pool.allocate(4097);
+  BOOST_CHECK_EQUAL(b4->capacity(), ndn::MAX_NDN_PACKET_SIZE);
+
+  auto b5 = pool.allocateReceiveBuffer();
+  BOOST_CHECK_EQUAL(b5->size(), ndn::MAX_NDN_PACKET_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(Recycle)
+{
+  auto& pool = ReceiveBufferPool::get();
+
+  auto buffer = pool.allocate(1000);
+  const ndn::Buffer* ptr = buffer.get();
+  buffer.reset();
+
+  uint64_t nRecycled = pool.getNRecycled();
+  uint64_t nAllocated = pool.getNAllocated();
+  buffer = pool.allocate(600); // same size class
+  BOOST_CHECK_EQUAL(buffer.get(), ptr);
+  BOOST_CHECK_EQUAL(buffer->size(), 600);
+  BOOST_CHECK_EQUAL(pool.getNRecycled(), nRecycled + 1);
+  BOOST_CHECK_EQUAL(pool.getNAllocated(), nAllocated);
+}
+
+BOOST_AUTO_TEST_CASE(CrossThreadRelease)
+{
+  auto& pool = ReceiveBufferPool::get();
+  constexpr size_t nBuffers = ReceiveBufferPool::MAX_THREAD_CACHED +
+                              3 * ReceiveBufferPool::TRANSFER_BATCH_SIZE;
+
+  std::vector<shared_ptr<ndn::Buffer>> buffers;
+  for (size_t i = 0; i < nBuffers; ++i) {
+    buffers.push_back(pool.allocate(2000));
+  }
+
+  // released on another thread, whose free list overflows into the shared pool,
+  // and whose remaining free list is returned to the shared pool when it exits
+  std::thread([&buffers] { buffers.clear(); }).join();
+
+  uint64_t nAllocated = pool.getNAllocated();
+  for (size_t i = 0; i < nBuffers; ++i) {
+    buffers.push_back(pool.allocate(2000));
+  }
+  BOOST_CHECK_EQUAL(pool.getNAllocated(), nAllocated);
+}
+
+BOOST_AUTO_TEST_CASE(AdoptLarge)
+{
+  auto& pool = ReceiveBufferPool::get();
+
+  auto receiveBuffer = pool.allocateReceiveBuffer();
+  const ndn::Buffer* ptr = receiveBuffer.get();
+  std::fill_n(receiveBuffer->begin(), 5000, 0xBB);
+
+  auto adopted = pool.adopt(receiveBuffer, 5000);
+  BOOST_CHECK_EQUAL(adopted.get(), ptr); // not copied
+  BOOST_CHECK_EQUAL(adopted->size(), 5000);
+  BOOST_CHECK(std::all_of(adopted->begin(), adopted->end(), [] (uint8_t b) { return b == 0xBB; }));
+
+  BOOST_REQUIRE(receiveBuffer != nullptr);
+  BOOST_CHECK_NE(receiveBuffer.get(), ptr);
+  BOOST_CHECK_EQUAL(receiveBuffer->size(), ndn::MAX_NDN_PACKET_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(AdoptSmall)
+{
+  auto& pool = ReceiveBufferPool::get();
+
+  auto receiveBuffer = pool.allocateReceiveBuffer();
+  const ndn::Buffer* ptr = receiveBuffer.get();
+  std::fill_n(receiveBuffer->begin(), 100, 0xCC);
+
+  auto copied = pool.adopt(receiveBuffer, 100);
+  BOOST_CHECK_NE(copied.get(), ptr); // a small packet does not pin the receive buffer
+  BOOST_CHECK_EQUAL(copied->size(), 100);
+  BOOST_CHECK_EQUAL(copied->capacity(), 256);
+  BOOST_CHECK(std::all_of(copied->begin(), copied->end(), [] (uint8_t b) { return b == 0xCC; }));
+
+  BOOST_CHECK_EQUAL(receiveBuffer.get(), ptr);
+  BOOST_CHECK_EQUAL(receiveBuffer->size(), ndn::MAX_NDN_PACKET_SIZE);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestReceiveBufferPool
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace nfd::tests
@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/stream-receive-buffer.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd::tests {
+
+using face::StreamReceiveBuffer;
+
+BOOST_AUTO_TEST_SUITE(Face)
+BOOST_AUTO_TEST_SUITE(TestStreamReceiveBuffer)
+
+static size_t
+receive(StreamReceiveBuffer& buffer, span<const uint8_t> bytes)
+{
+  size_t nCopied = boost::asio::buffer_copy(buffer.prepare(), boost::asio::buffer(bytes.data(), bytes.size()));
+  buffer.commit(nCopied);
+  return nCopied;
+}
+
+static ndn::Buffer
+makeElement(uint32_t type, size_t valueSize)
+{
+  std::vector<uint8_t> value(valueSize);
+  for (size_t i = 0; i < valueSize; ++i) {
+    value[i] = static_cast<uint8_t>(i);
+  }
+  auto block = ndn::encoding::makeBinaryBlock(type, value);
+  return ndn::Buffer(block.begin(), block.end());
+}
+
+static bool
+isEqual(const Block& block, const ndn::Buffer& wire)
+{
+  return std::equal(block.begin(), block.end(), wire.begin(), wire.end());
+}
+
+BOOST_AUTO_TEST_CASE(PartialElement)
+{
+  StreamReceiveBuffer buffer;
+  auto element = makeElement(300, 1000);
+
+  BOOST_CHECK_EQUAL(receive(buffer, span(element).first(2)), 2); // header incomplete
+  BOOST_CHECK(!buffer.extract());
+  BOOST_CHECK_EQUAL(receive(buffer, span(element).subspan(2, 500)), 500);
+  BOOST_CHECK(!buffer.extract());
+  BOOST_CHECK_EQUAL(buffer.size(), 502);
+
+  receive(buffer, span(element).subspan(502));
+  auto extracted = buffer.extract();
+  BOOST_REQUIRE(extracted);
+  BOOST_CHECK(isEqual(*extracted, element));
+  BOOST_CHECK_EQUAL(buffer.size(), 0);
+  BOOST_CHECK(!buffer.extract());
+}
+
+BOOST_AUTO_TEST_CASE(Wrap)
+{
+  StreamReceiveBuffer buffer(ndn::MAX_NDN_PACKET_SIZE, ndn::MAX_NDN_PACKET_SIZE);
+  auto element1 = makeElement(300, 6000);
+  auto element2 = makeElement(301, 4000);
+
+  receive(buffer, element1);
+  receive(buffer, span(element2).subspan(0, 1000));
+  auto extracted = buffer.extract();
+  BOOST_REQUIRE(extracted);
+  BOOST_CHECK(isEqual(*extracted, element1));
+  BOOST_CHECK(!buffer.extract());
+  // element1 no longer shares the ring, so the ring is kept
+  extracted.reset();
+
+  // the rest of element2 is received across the end of the ring
+  auto freeSpace = buffer.prepare();
+  BOOST_CHECK_GT(freeSpace[0].size(), 0);
+  BOOST_CHECK_GT(freeSpace[1].size(), 0);
+  BOOST_CHECK_EQUAL(receive(buffer, span(element2).subspan(1000)), element2.size() - 1000);
+
+  extracted = buffer.extract();
+  BOOST_REQUIRE(extracted);
+  BOOST_CHECK(isEqual(*extracted, element2));
+  BOOST_CHECK_EQUAL(buffer.size(), 0);
+  BOOST_CHECK_EQUAL(buffer.capacity(), ndn::MAX_NDN_PACKET_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(InPlace)
+{
+  StreamReceiveBuffer buffer(ndn::MAX_NDN_PACKET_SIZE, ndn::MAX_NDN_PACKET_SIZE);
+  auto element1 = makeElement(300, 3000);
+  auto element2 = makeElement(301, 3000);
+  std::vector<uint8_t> stream(element1.begin(), element1.end());
+  stream.insert(stream.end(), element2.begin(), element2.begin() + 2000);
+
+  receive(buffer, stream);
+  auto extracted1 = buffer.extract();
+  BOOST_REQUIRE(extracted1);
+  BOOST_CHECK(isEqual(*extracted1, element1));
+
+  // element1 still shares the ring, so the next receive goes into a new ring,
+  // and the bytes received afterwards do not overwrite element1
+  auto element3 = makeElement(302, 5000);
+  stream.assign(element2.begin() + 2000, element2.end());
+  stream.insert(stream.end(), element3.begin(), element3.end());
+  BOOST_CHECK_EQUAL(receive(buffer, stream), stream.size());
+  auto extracted2 = buffer.extract();
+  auto extracted3 = buffer.extract();
+  BOOST_REQUIRE(extracted2);
+  BOOST_REQUIRE(extracted3);
+  BOOST_CHECK(isEqual(*extracted1, element1));
+  BOOST_CHECK(isEqual(*extracted2, element2));
+  BOOST_CHECK(isEqual(*extracted3, element3));
+  BOOST_CHECK_EQUAL(buffer.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(GrowAndShrink)
+{
+  StreamReceiveBuffer buffer(ndn::MAX_NDN_PACKET_SIZE, 4 * ndn::MAX_NDN_PACKET_SIZE);
+  auto element = makeElement(300, 1000);
+  std::vector<uint8_t> stream;
+  while (stream.size() < ndn::MAX_NDN_PACKET_SIZE) {
+    stream.insert(stream.end(), element.begin(), element.end());
+  }
+
+  // a large receive that leaves the ring nearly full doubles the capacity
+  BOOST_CHECK_EQUAL(receive(buffer, stream), ndn::MAX_NDN_PACKET_SIZE);
+  BOOST_CHECK_EQUAL(buffer.capacity(), 2 * ndn::MAX_NDN_PACKET_SIZE);
+  size_t nExtracted = 0;
+  while (auto extracted = buffer.extract()) {
+    BOOST_CHECK(isEqual(*extracted, element));
+    ++nExtracted;
+  }
+  BOOST_CHECK_EQUAL(nExtracted, ndn::MAX_NDN_PACKET_SIZE / element.size());
+  BOOST_CHECK_EQUAL(buffer.size(), ndn::MAX_NDN_PACKET_SIZE % element.size());
+  buffer.clear();
+
+  // a run of small receives halves the capacity
+  auto small = makeElement(301, 10);
+  for (size_t i = 0; i < StreamReceiveBuffer::SHRINK_AFTER_N_RECEIVES; ++i) {
+    receive(buffer, small);
+    BOOST_REQUIRE(buffer.extract());
+  }
+  BOOST_CHECK_EQUAL(buffer.capacity(), 2 * ndn::MAX_NDN_PACKET_SIZE);
+  buffer.prepare();
+  BOOST_CHECK_EQUAL(buffer.capacity(), ndn::MAX_NDN_PACKET_SIZE);
+
+  // small receives that fill the ring, the last one filling all the free space,
+  // do not grow the capacity
+  auto large = makeElement(302, ndn::MAX_NDN_PACKET_SIZE - 6);
+  BOOST_REQUIRE_EQUAL(large.size(), ndn::MAX_NDN_PACKET_SIZE);
+  for (size_t offset = 0; offset < large.size(); offset += 2000) {
+    receive(buffer, span(large).subspan(offset, std::min<size_t>(2000, large.size() - offset)));
+  }
+  BOOST_CHECK_EQUAL(buffer.capacity(), ndn::MAX_NDN_PACKET_SIZE);
+  auto extracted = buffer.extract();
+  BOOST_REQUIRE(extracted);
+  BOOST_CHECK(isEqual(*extracted, large));
+}
+
+BOOST_AUTO_TEST_CASE(Invalid)
+{
+  // TLV-LENGTH exceeds the maximum packet size
+  StreamReceiveBuffer buffer1;
+  const std::vector<uint8_t> tooLarge{0xfd, 0x01, 0x2c, 0xfd, 0x22, 0x60};
+  receive(buffer1, tooLarge);
+  BOOST_CHECK_THROW(buffer1.extract(), StreamReceiveBuffer::Error);
+
+  // TLV-TYPE zero is detected once enough bytes are received for any valid header
+  StreamReceiveBuffer buffer2;
+  const std::vector<uint8_t> zeroType(20, 0);
+  receive(buffer2, span(zeroType).first(4));
+  BOOST_CHECK(!buffer2.extract());
+  receive(buffer2, span(zeroType).subspan(4));
+  BOOST_CHECK_THROW(buffer2.extract(), StreamReceiveBuffer::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestStreamReceiveBuffer
+BOOST_AUTO_TEST_SUITE_END() // Face
+
+} // namespace nfd::tests
@@ -69,6 +69,79 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Send, T, StreamTransportFixtures, T)
   BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(SendMany, T, StreamTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  // more packets than a single gather-write can take
+  std::vector<Block> blocks;
+  std::vector<uint8_t> expected;
+  for (int i = 0; i < 100; ++i) {
+    blocks.push_back(ndn::encoding::makeStringBlock(300, "packet" + std::to_string(i)));
+    expected.insert(expected.end(), blocks.back().begin(), blocks.back().end());
+  }
+  for (const auto& block : blocks) {
+    this->transport->send(block);
+  }
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nOutPackets, blocks.size());
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nOutBytes, expected.size());
+
+  std::vector<uint8_t> readBuf(expected.size());
+  boost::asio::async_read(this->remoteSocket, boost::asio::buffer(readBuf),
+    [this] (const boost::system::error_code& error, size_t) {
+      BOOST_REQUIRE_EQUAL(error, boost::system::errc::success);
+      this->limitedIo.afterOp();
+    });
+
+  BOOST_REQUIRE_EQUAL(this->limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+
+  BOOST_TEST(readBuf == expected, boost::test_tools::per_element());
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(SendQueueLimit, T, StreamTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  BOOST_CHECK_EQUAL(this->transport->getSendQueueCapacity(), QUEUE_UNSUPPORTED);
+  this->transport->setSendQueueLimit(1000);
+  BOOST_CHECK_EQUAL(this->transport->getSendQueueCapacity(), 1000);
+
+  std::vector<bool> congestionChanges;
+  this->transport->afterSendQueueCongestionChange.connect([&] (bool isCongested) {
+    congestionChanges.push_back(isCongested);
+  });
+
+  const std::vector<uint8_t> value(196);
+  auto block = ndn::encoding::makeBinaryBlock(300, value);
+  BOOST_REQUIRE_EQUAL(block.size(), 200);
+
+  // packets stay queued until the write completes in the event loop
+  std::vector<uint8_t> expected;
+  for (int i = 0; i < 6; ++i) {
+    this->transport->send(block);
+    if (i < 5) {
+      expected.insert(expected.end(), block.begin(), block.end());
+    }
+    // congested above 500 bytes
+    BOOST_CHECK_EQUAL(this->transport->isSendQueueCongested(), i >= 2);
+  }
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nOutDrops, 1);
+
+  std::vector<uint8_t> readBuf(expected.size());
+  boost::asio::async_read(this->remoteSocket, boost::asio::buffer(readBuf),
+    [this] (const boost::system::error_code& error, size_t) {
+      BOOST_REQUIRE_EQUAL(error, boost::system::errc::success);
+      this->limitedIo.afterOp();
+    });
+
+  BOOST_REQUIRE_EQUAL(this->limitedIo.run(1, 1_s), LimitedIo::EXCEED_OPS);
+  BOOST_TEST(readBuf == expected, boost::test_tools::per_element());
+  BOOST_CHECK_EQUAL(this->transport->isSendQueueCongested(), false);
+  BOOST_TEST(congestionChanges == (std::vector<bool>{true, false}), boost::test_tools::per_element());
+  BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveNormal, T, StreamTransportFixtures, T)
 {
   TRANSPORT_TEST_INIT();
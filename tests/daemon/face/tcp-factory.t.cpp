@@ -223,6 +223,36 @@ BOOST_AUTO_TEST_CASE(ConfigureNonLocal)
   limitedIo.defer(100_ms);
 }
 
+BOOST_AUTO_TEST_CASE(SocketBuffers)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      tcp
+      {
+        socket_receive_buffer 1048576
+        socket_send_buffer 262144
+        socket_send_buffer_max 4194304
+        send_queue_capacity 1048576
+      }
+    }
+  )CONFIG";
+
+  auto channel = createChannel("127.0.0.1", "7071");
+  parseConfig(CONFIG, true);
+  BOOST_CHECK_EQUAL(channel->getSocketBufferOptions().receiveBufferSize, 0);
+
+  parseConfig(CONFIG, false);
+  // existing channel and channel created by the configuration
+  for (const auto& ch : {channel, createChannel("0.0.0.0", "6363")}) {
+    const auto& options = ch->getSocketBufferOptions();
+    BOOST_CHECK_EQUAL(options.receiveBufferSize, 1048576);
+    BOOST_CHECK_EQUAL(options.sendBufferSize, 262144);
+    BOOST_CHECK_EQUAL(options.maxSendBufferSize, 4194304);
+    BOOST_CHECK_EQUAL(ch->getSendQueueLimit(), 1048576);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(Omitted)
 {
   const std::string CONFIG = R"CONFIG(
@@ -315,6 +345,52 @@ BOOST_AUTO_TEST_CASE(BadPort)
   BOOST_CHECK_THROW(parseConfig(CONFIG3, false), ConfigFile::Error);
 }
 
+BOOST_AUTO_TEST_CASE(BadSocketBuffers)
+{
+  // out of range
+  const std::string CONFIG1 = R"CONFIG(
+    face_system
+    {
+      tcp
+      {
+        socket_receive_buffer 2147483648
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG1, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG1, false), ConfigFile::Error);
+
+  // maximum smaller than initial size
+  const std::string CONFIG2 = R"CONFIG(
+    face_system
+    {
+      tcp
+      {
+        socket_send_buffer 262144
+        socket_send_buffer_max 65536
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG2, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG2, false), ConfigFile::Error);
+
+  // maximum without initial size
+  const std::string CONFIG3 = R"CONFIG(
+    face_system
+    {
+      tcp
+      {
+        socket_send_buffer_max 65536
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG3, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG3, false), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(UnknownOption)
 {
   const std::string CONFIG = R"CONFIG(
@@ -24,6 +24,7 @@
  */
 
 #include "udp-channel-fixture.hpp"
+#include "face/io-worker.hpp"
 
 #include "test-ip.hpp"
 
@@ -58,6 +59,91 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(DefaultMtu, F, AddressFamilies)
   }
 }
 
+#ifdef __linux__
+using SteeringModes = boost::mp11::mp_list_c<UdpChannel::Steering,
+                                             UdpChannel::Steering::HASH, UdpChannel::Steering::SOURCE>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(MultipleListenSockets, S, SteeringModes)
+{
+  auto address = getTestIp(AddressFamily::V4, AddressScope::Loopback);
+  SKIP_IF_IP_UNAVAILABLE(address);
+  listenerEp = udp::Endpoint(address, 7030);
+  listenerChannel = makeChannel(address, 7030);
+  listenerChannel->listen(
+    [this] (const shared_ptr<Face>& newFace) {
+      BOOST_REQUIRE(newFace != nullptr);
+      listenerFaces.push_back(newFace);
+      limitedIo.afterOp();
+    },
+    ChannelFixture::unexpectedFailure, 4, S::value);
+  BOOST_CHECK_EQUAL(listenerChannel->isListening(), true);
+  BOOST_CHECK_EQUAL(listenerChannel->getNListenSockets(), 4);
+
+  // listen() is idempotent
+  listenerChannel->listen(nullptr, nullptr, 2);
+  BOOST_CHECK_EQUAL(listenerChannel->getNListenSockets(), 4);
+
+  std::vector<shared_ptr<UdpChannel>> clientChannels;
+  for (int i = 0; i < 8; ++i) {
+    clientChannels.push_back(makeChannel(boost::asio::ip::address_v4()));
+    connect(*clientChannels.back());
+  }
+
+  BOOST_CHECK_EQUAL(limitedIo.run(16, 2_s), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(listenerChannel->size(), 8);
+  BOOST_CHECK_EQUAL(clientFaces.size(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(IoWorkers)
+{
+  auto address = getTestIp(AddressFamily::V4, AddressScope::Loopback);
+  SKIP_IF_IP_UNAVAILABLE(address);
+  std::vector<shared_ptr<UdpChannel>> clientChannels;
+  // the workers are stopped before the channels are destroyed
+  face::IoWorkerPool workers(2);
+
+  listenerEp = udp::Endpoint(address, 7031);
+  listenerChannel = makeChannel(address, 7031);
+  listenerChannel->setIoWorkers(&workers);
+  listenerChannel->listen(
+    [this] (const shared_ptr<Face>& newFace) {
+      BOOST_REQUIRE(newFace != nullptr);
+      listenerFaces.push_back(newFace);
+      limitedIo.afterOp();
+    },
+    ChannelFixture::unexpectedFailure, 2);
+  BOOST_CHECK_EQUAL(listenerChannel->getNListenSockets(), 2);
+
+  for (int i = 0; i < 4; ++i) {
+    clientChannels.push_back(makeChannel(boost::asio::ip::address_v4()));
+    connect(*clientChannels.back());
+  }
+  BOOST_CHECK_EQUAL(limitedIo.run(8, 2_s), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(listenerChannel->size(), 4);
+  for (const auto& face : listenerFaces) {
+    BOOST_CHECK_EQUAL(face->getPersistency(), ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
+    BOOST_CHECK_EQUAL(face->getLocalUri(), listenerChannel->getUri());
+  }
+
+  // a face created by connect() on a channel whose faces belong to the workers
+  auto client = makeChannel(boost::asio::ip::address_v4());
+  clientChannels.push_back(client);
+  client->setIoWorkers(&workers);
+  client->connect(listenerEp, {},
+    [this] (const shared_ptr<Face>& newFace) {
+      BOOST_REQUIRE(newFace != nullptr);
+      clientFaces.push_back(newFace);
+      newFace->sendInterest(*makeInterest("/A"));
+      limitedIo.afterOp();
+    },
+    ChannelFixture::unexpectedFailure);
+  BOOST_CHECK_EQUAL(limitedIo.run(2, 2_s), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(client->size(), 1);
+  BOOST_CHECK_EQUAL(listenerChannel->size(), 5);
+  BOOST_CHECK_EQUAL(workers.getNQueueDrops(), 0);
+}
+#endif // __linux__
+
 BOOST_AUTO_TEST_SUITE_END() // TestUdpChannel
 BOOST_AUTO_TEST_SUITE_END() // Face
 
@@ -177,6 +177,26 @@ BOOST_AUTO_TEST_CASE(SendQueueLength)
   BOOST_CHECK_EQUAL(transport->getSendQueueLength(), QUEUE_UNSUPPORTED);
 }
 
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE(PacketRingSend)
+{
+  SKIP_IF_NO_RUNNING_ETHERNET_NETIF();
+  ioBackend = face::EthernetIoBackend::PACKET_RING;
+  initializeUnicast(getRunningNetif());
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+
+  auto block = ndn::encoding::makeStringBlock(300, "hello");
+  for (int i = 0; i < 10; ++i) {
+    transport->send(block);
+  }
+  BOOST_CHECK_EQUAL(transport->getCounters().nOutPackets, 10);
+
+  // the frames are handed to the kernel in a single batch
+  limitedIo.defer(100_ms);
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+}
+#endif // __linux__
+
 BOOST_AUTO_TEST_SUITE_END() // TestUnicastEthernetTransport
 BOOST_AUTO_TEST_SUITE_END() // Face
 
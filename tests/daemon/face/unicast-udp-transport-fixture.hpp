@@ -54,7 +54,8 @@ protected:
     remoteConnect(address);
 
     m_face = make_unique<Face>(make_unique<DummyLinkService>(),
-                               make_unique<UnicastUdpTransport>(std::move(sock), persistency, 3_s));
+                               make_unique<UnicastUdpTransport>(std::move(sock), persistency, 3_s,
+                                                                                batchSize, ioBackend));
     transport = static_cast<UnicastUdpTransport*>(m_face->getTransport());
     receivedPackets = &static_cast<DummyLinkService*>(m_face->getLinkService())->receivedPackets;
 
@@ -100,6 +101,8 @@ protected:
   LimitedIo limitedIo;
   UnicastUdpTransport* transport = nullptr;
   udp::endpoint localEp;
+  size_t batchSize = 1;
+  face::DatagramIoBackend ioBackend = face::DatagramIoBackend::ASIO;
   udp::socket remoteSocket{g_io};
   std::vector<RxPacket>* receivedPackets = nullptr;
 
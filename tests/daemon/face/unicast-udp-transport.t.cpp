@@ -171,6 +171,92 @@ BOOST_FIXTURE_TEST_CASE(RemoteClosePermanent, RemoteCloseFixture)
   BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
 }
 
+BOOST_AUTO_TEST_CASE(BatchedIo)
+{
+  batchSize = 4;
+  TRANSPORT_TEST_INIT();
+
+  // more packets than the batch size, so that more than one batch is needed in each direction
+  std::vector<Block> packets;
+  size_t totalSize = 0;
+  for (int i = 0; i < 6; ++i) {
+    packets.push_back(ndn::encoding::makeStringBlock(300, "hello" + std::to_string(i)));
+    totalSize += packets.back().size();
+  }
+
+  for (const auto& pkt : packets) {
+    remoteSocket.send(boost::asio::buffer(pkt));
+  }
+  limitedIo.defer(1_s);
+
+  BOOST_CHECK_EQUAL(transport->getCounters().nInPackets, packets.size());
+  BOOST_CHECK_EQUAL(transport->getCounters().nInBytes, totalSize);
+  BOOST_REQUIRE_EQUAL(receivedPackets->size(), packets.size());
+  for (size_t i = 0; i < packets.size(); ++i) {
+    BOOST_CHECK(receivedPackets->at(i).packet == packets[i]);
+  }
+
+  for (const auto& pkt : packets) {
+    transport->send(pkt);
+  }
+  // the packets are queued until the current event has been handled
+  BOOST_CHECK_GE(transport->getSendQueueLength(), static_cast<ssize_t>(totalSize));
+
+  for (const auto& pkt : packets) {
+    std::vector<uint8_t> readBuf(pkt.size());
+    remoteRead(readBuf);
+    BOOST_TEST(readBuf == pkt, boost::test_tools::per_element());
+  }
+  BOOST_CHECK_EQUAL(transport->getCounters().nOutPackets, packets.size());
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::UP);
+}
+
+#ifdef NFD_HAVE_IO_URING
+BOOST_AUTO_TEST_CASE(IoUring)
+{
+  ioBackend = face::DatagramIoBackend::IO_URING;
+  TRANSPORT_TEST_INIT();
+
+  if (face::IoUring::get(g_io) == nullptr) {
+    BOOST_TEST_MESSAGE("io_uring is not available, the transport falls back to Boost.Asio");
+  }
+
+  std::vector<Block> packets;
+  size_t totalSize = 0;
+  for (int i = 0; i < 6; ++i) {
+    packets.push_back(ndn::encoding::makeStringBlock(300, "hello" + std::to_string(i)));
+    totalSize += packets.back().size();
+  }
+
+  for (const auto& pkt : packets) {
+    remoteSocket.send(boost::asio::buffer(pkt));
+  }
+  limitedIo.defer(1_s);
+
+  BOOST_CHECK_EQUAL(transport->getCounters().nInPackets, packets.size());
+  BOOST_CHECK_EQUAL(transport->getCounters().nInBytes, totalSize);
+  BOOST_REQUIRE_EQUAL(receivedPackets->size(), packets.size());
+  for (size_t i = 0; i < packets.size(); ++i) {
+    BOOST_CHECK(receivedPackets->at(i).packet == packets[i]);
+  }
+
+  for (const auto& pkt : packets) {
+    transport->send(pkt);
+  }
+  for (const auto& pkt : packets) {
+    std::vector<uint8_t> readBuf(pkt.size());
+    remoteRead(readBuf);
+    BOOST_TEST(readBuf == pkt, boost::test_tools::per_element());
+  }
+  BOOST_CHECK_EQUAL(transport->getCounters().nOutPackets, packets.size());
+
+  // the outstanding receive request is cancelled when the transport is closed
+  transport->close();
+  limitedIo.defer(100_ms);
+  BOOST_CHECK_EQUAL(transport->getState(), TransportState::CLOSED);
+}
+#endif // NFD_HAVE_IO_URING
+
 BOOST_AUTO_TEST_SUITE_END() // TestUnicastUdpTransport
 BOOST_AUTO_TEST_SUITE_END() // Face
 
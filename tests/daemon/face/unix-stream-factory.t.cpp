@@ -85,6 +85,42 @@ BOOST_AUTO_TEST_CASE(RelativePath)
   BOOST_TEST(uri.getPath() == std::filesystem::canonical("nfd-test.sock"));
 }
 
+BOOST_AUTO_TEST_CASE(SendQueueCapacity)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      unix
+      {
+        path /tmp/nfd-test.sock
+        send_queue_capacity 1048576
+      }
+    }
+  )CONFIG";
+
+  parseConfig(CONFIG, true);
+  parseConfig(CONFIG, false);
+
+  auto channel = factory.createChannel("/tmp/nfd-test.sock");
+  BOOST_TEST(channel->getSendQueueLimit() == 1048576);
+}
+
+BOOST_AUTO_TEST_CASE(BadSendQueueCapacity)
+{
+  const std::string CONFIG = R"CONFIG(
+    face_system
+    {
+      unix
+      {
+        send_queue_capacity -1
+      }
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(parseConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(parseConfig(CONFIG, false), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_CASE(Omitted)
 {
   const std::string CONFIG = R"CONFIG(
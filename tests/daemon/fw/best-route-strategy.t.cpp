@@ -139,6 +139,30 @@ BOOST_AUTO_TEST_CASE(Forward)
   // face1 cannot be used because it's gone from FIB entry
 }
 
+BOOST_AUTO_TEST_CASE(AvoidCongestedFace)
+{
+  fib::Entry& fibEntry = *fib.insert(Name()).first;
+  fib.addOrUpdateNextHop(fibEntry, *face1, 10);
+  fib.addOrUpdateNextHop(fibEntry, *face2, 20);
+
+  face1->setSendQueueCongested(true);
+  auto interest1 = makeInterest("/uxhmr4Fh");
+  auto pitEntry1 = pit.insert(*interest1).first;
+  pitEntry1->insertOrUpdateInRecord(*face3, *interest1);
+  strategy.afterReceiveInterest(*interest1, FaceEndpoint(*face3), pitEntry1);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 1);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.back().outFaceId, face2->getId());
+
+  // all eligible nexthops are congested
+  face2->setSendQueueCongested(true);
+  auto interest2 = makeInterest("/TKvoEjh4");
+  auto pitEntry2 = pit.insert(*interest2).first;
+  pitEntry2->insertOrUpdateInRecord(*face3, *interest2);
+  strategy.afterReceiveInterest(*interest2, FaceEndpoint(*face3), pitEntry2);
+  BOOST_REQUIRE_EQUAL(strategy.sendInterestHistory.size(), 2);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.back().outFaceId, face1->getId());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestBestRouteStrategy
 BOOST_AUTO_TEST_SUITE_END() // Fw
 
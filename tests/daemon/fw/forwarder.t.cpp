@@ -996,6 +996,38 @@ BOOST_AUTO_TEST_CASE(BadDefaultHopLimit)
   BOOST_CHECK_THROW(cf.parse(config, false, "dummy-config"), ConfigFile::Error);
 }
 
+BOOST_AUTO_TEST_CASE(Threads)
+{
+  ConfigFile cf;
+  forwarder.setConfigFile(cf);
+
+  std::string config = R"CONFIG(
+    forwarder
+    {
+      threads 4
+      shard_prefix_length 2
+      offload_forwarding yes
+    }
+  )CONFIG";
+
+  BOOST_TEST(forwarder.m_config.nThreads == 1);
+  BOOST_TEST(forwarder.m_config.shardPrefixLength == 1);
+
+  cf.parse(config, true, "dummy-config");
+  BOOST_TEST(forwarder.m_config.nThreads == 1);
+
+  cf.parse(config, false, "dummy-config");
+  BOOST_TEST(forwarder.m_config.nThreads == 4);
+  BOOST_TEST(forwarder.m_config.shardPrefixLength == 2);
+  BOOST_TEST(forwarder.m_config.wantForwardingOffload);
+
+  for (const auto& bad : {"threads 0", "threads 65", "shard_prefix_length 0", "shard_prefix_length x",
+                          "offload_forwarding maybe"}) {
+    config = std::string("forwarder\n{\n  ") + bad + "\n}\n";
+    BOOST_CHECK_THROW(cf.parse(config, true, "dummy-config"), ConfigFile::Error);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ProcessConfig
 
 BOOST_AUTO_TEST_SUITE_END() // TestForwarder
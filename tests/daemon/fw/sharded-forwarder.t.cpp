@@ -0,0 +1,331 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/sharded-forwarder.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace nfd::tests {
+
+using fw::ShardedForwarder;
+
+class ShardedForwarderFixture : public GlobalIoFixture
+{
+protected:
+  shared_ptr<DummyFace>
+  addFace()
+  {
+    auto face = make_shared<DummyFace>();
+    faceTable.add(face);
+    return face;
+  }
+
+  void
+  start(size_t nShards = 4, size_t shardPrefixLength = 1)
+  {
+    ShardedForwarder::Options options;
+    options.nShards = nShards;
+    options.shardPrefixLength = shardPrefixLength;
+    sharded = make_unique<ShardedForwarder>(faceTable, forwarder, options);
+  }
+
+  /** \brief Poll the main io_context until \p pred is satisfied, for up to 10 seconds.
+   */
+  template<typename Predicate>
+  bool
+  waitUntil(const Predicate& pred)
+  {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!pred()) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+      pollIo();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+protected:
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  unique_ptr<ShardedForwarder> sharded;
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestShardedForwarder, ShardedForwarderFixture)
+
+BOOST_AUTO_TEST_CASE(ShardIndex)
+{
+  start(4, 2);
+  BOOST_TEST(sharded->getNShards() == 4);
+
+  size_t index = sharded->getShardIndex("/A/B");
+  BOOST_TEST(index < 4);
+  BOOST_TEST(sharded->getShardIndex("/A/B/C") == index);
+  BOOST_TEST(sharded->getShardIndex("/A/B/D/E") == index);
+  auto data = makeData("/A/B");
+  BOOST_TEST(sharded->getShardIndex(data->getFullName()) == index);
+
+  // names are spread over the shards
+  std::set<size_t> indices;
+  for (int i = 0; i < 100; ++i) {
+    indices.insert(sharded->getShardIndex(Name("/A").appendNumber(i)));
+  }
+  BOOST_TEST(indices.size() == 4);
+}
+
+BOOST_AUTO_TEST_CASE(SimpleExchange)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  fib::Entry* entry = forwarder.getFib().insert("/A").first;
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face2, 0);
+  start();
+
+  for (int i = 0; i < 50; ++i) {
+    face1->receiveInterest(*makeInterest(Name("/A").appendNumber(i)));
+  }
+  BOOST_REQUIRE(waitUntil([&] { return face2->sentInterests.size() == 50; }));
+  // the main Forwarder does not process packets received on faces
+  BOOST_TEST(forwarder.getCounters().nInInterests == 0);
+  BOOST_TEST(forwarder.getPit().size() == 0);
+
+  for (const auto& interest : face2->sentInterests) {
+    face2->receiveData(*makeData(interest.getName()));
+  }
+  BOOST_REQUIRE(waitUntil([&] { return face1->sentData.size() == 50; }));
+
+  auto status = sharded->collectStatus();
+  BOOST_TEST(status.nInInterests == 50);
+  BOOST_TEST(status.nOutInterests == 50);
+  BOOST_TEST(status.nInData == 50);
+  BOOST_TEST(status.nOutData == 50);
+  BOOST_TEST(status.nQueueDrops == 0);
+}
+
+BOOST_AUTO_TEST_CASE(SingleForwardingThread)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  fib::Entry* entry = forwarder.getFib().insert("/A").first;
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face2, 0);
+  start(1);
+  BOOST_TEST(sharded->getShardIndex("/B") == 0);
+
+  face1->receiveInterest(*makeInterest("/A/1"));
+  BOOST_REQUIRE(waitUntil([&] { return face2->sentInterests.size() == 1; }));
+  face2->receiveData(*makeData("/A/1"));
+  BOOST_REQUIRE(waitUntil([&] { return face1->sentData.size() == 1; }));
+  BOOST_TEST(forwarder.getCounters().nInInterests == 0);
+}
+
+BOOST_AUTO_TEST_CASE(UnownedPackets)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  fib::Entry* entry = forwarder.getFib().insert("/A").first;
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face2, 0);
+  start(2);
+
+  // packets not owned by a shared_ptr are copied before they are queued to a shard
+  face1->receiveInterest(Interest(Name("/A/1")));
+  BOOST_REQUIRE(waitUntil([&] { return face2->sentInterests.size() == 1; }));
+  face2->receiveData(Data(Name("/A/1")));
+  BOOST_REQUIRE(waitUntil([&] { return face1->sentData.size() == 1; }));
+}
+
+BOOST_AUTO_TEST_CASE(FollowFaceChanges)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  auto face3 = addFace();
+  fib::Entry* entry = forwarder.getFib().insert("/A").first;
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face2, 0);
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face3, 10);
+  start(2);
+
+  face2->setSendQueueCongested(true);
+  face2->setState(face::FaceState::DOWN);
+  face2->setPersistency(ndn::nfd::FACE_PERSISTENCY_PERMANENT);
+
+  std::vector<bool> isCongested(sharded->getNShards());
+  std::vector<face::FaceState> states(sharded->getNShards());
+  std::vector<ndn::nfd::FacePersistency> persistencies(sharded->getNShards());
+  BOOST_REQUIRE(waitUntil([&] {
+    sharded->runInShards([&] (size_t i, Forwarder& shardForwarder) {
+      const fib::Entry* shardEntry = shardForwarder.getFib().findExactMatch("/A");
+      const Face& shardFace = shardEntry->getNextHops().front().getFace();
+      isCongested[i] = shardFace.isSendQueueCongested();
+      states[i] = shardFace.getState();
+      persistencies[i] = shardFace.getPersistency();
+    });
+    return std::all_of(isCongested.begin(), isCongested.end(), [] (bool b) { return b; });
+  }));
+  for (size_t i = 0; i < sharded->getNShards(); ++i) {
+    BOOST_TEST(states[i] == face::FaceState::DOWN);
+    BOOST_TEST(persistencies[i] == ndn::nfd::FACE_PERSISTENCY_PERMANENT);
+  }
+
+  // best-route skips the congested nexthop in every shard
+  face2->setState(face::FaceState::UP);
+  for (int i = 0; i < 10; ++i) {
+    face1->receiveInterest(*makeInterest(Name("/A").appendNumber(i)));
+  }
+  BOOST_REQUIRE(waitUntil([&] { return face3->sentInterests.size() == 10; }));
+  BOOST_TEST(face2->sentInterests.size() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(ReplicateTables)
+{
+  auto face1 = addFace();
+  start(2);
+  auto face2 = addFace();
+
+  Fib& fib = forwarder.getFib();
+  fib.addOrUpdateNextHop(*fib.insert("/B").first, *face2, 10);
+  BOOST_CHECK(forwarder.getStrategyChoice().insert("/B", "/localhost/nfd/strategy/multicast"));
+
+  auto getShardFib = [this] (const Name& prefix) {
+    std::vector<std::vector<std::pair<FaceId, uint64_t>>> nexthops(sharded->getNShards());
+    sharded->runInShards([&] (size_t i, Forwarder& shardForwarder) {
+      const fib::Entry* entry = shardForwarder.getFib().findExactMatch(prefix);
+      if (entry != nullptr) {
+        for (const auto& nh : entry->getNextHops()) {
+          nexthops[i].emplace_back(nh.getFace().getId(), nh.getCost());
+        }
+      }
+    });
+    return nexthops;
+  };
+
+  using NextHops = std::vector<std::pair<FaceId, uint64_t>>;
+  BOOST_REQUIRE(waitUntil([&] {
+    auto nexthops = getShardFib("/B");
+    return std::all_of(nexthops.begin(), nexthops.end(), [&] (const auto& nhs) {
+      return nhs == NextHops{{face2->getId(), 10}};
+    });
+  }));
+  // assertions are made in the main thread, because Boost.Test is not thread-safe
+  std::vector<std::pair<bool, Name>> strategies(sharded->getNShards());
+  sharded->runInShards([&] (size_t i, Forwarder& shardForwarder) {
+    strategies[i] = shardForwarder.getStrategyChoice().get("/B");
+  });
+  for (const auto& [hasEntry, strategy] : strategies) {
+    BOOST_TEST(hasEntry);
+    BOOST_TEST(strategy.getPrefix(-1) == "/localhost/nfd/strategy/multicast");
+  }
+
+  // packets received on a face added after the shards started are forwarded
+  face1->receiveInterest(*makeInterest("/B/1"));
+  BOOST_REQUIRE(waitUntil([&] { return face2->sentInterests.size() == 1; }));
+
+  fib.erase("/B");
+  forwarder.getStrategyChoice().erase("/B");
+  BOOST_REQUIRE(waitUntil([&] {
+    auto nexthops = getShardFib("/B");
+    return std::all_of(nexthops.begin(), nexthops.end(), [] (const auto& nhs) { return nhs.empty(); });
+  }));
+  sharded->runInShards([&] (size_t i, Forwarder& shardForwarder) {
+    strategies[i] = shardForwarder.getStrategyChoice().get("/B");
+  });
+  for (const auto& strategy : strategies) {
+    BOOST_TEST(!strategy.first);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RemoveFace)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  Fib& fib = forwarder.getFib();
+  fib.addOrUpdateNextHop(*fib.insert("/A").first, *face2, 0);
+  start(2);
+
+  face2->close();
+  BOOST_TEST(faceTable.size() == 1);
+  BOOST_REQUIRE(waitUntil([&] {
+    std::vector<size_t> nFibEntries(sharded->getNShards());
+    sharded->runInShards([&] (size_t i, Forwarder& shardForwarder) {
+      nFibEntries[i] = shardForwarder.getFib().size();
+    });
+    return std::all_of(nFibEntries.begin(), nFibEntries.end(), [] (size_t n) { return n == 0; });
+  }));
+
+  face1->receiveInterest(*makeInterest("/A/1"));
+  BOOST_REQUIRE(waitUntil([&] { return sharded->collectStatus().nInInterests == 1; }));
+  pollIo();
+  BOOST_TEST(face2->sentInterests.size() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(PushCsSettings)
+{
+  start(2);
+  forwarder.getCs().setLimit(201);
+  forwarder.getCs().enableServe(false);
+
+  // Content Store settings reach the shards without syncTables
+  std::vector<size_t> csLimits(sharded->getNShards());
+  std::vector<bool> isServing(sharded->getNShards());
+  BOOST_REQUIRE(waitUntil([&] {
+    sharded->runInShards([&] (size_t i, Forwarder& shardForwarder) {
+      csLimits[i] = shardForwarder.getCs().getLimit();
+      isServing[i] = shardForwarder.getCs().shouldServe();
+    });
+    return std::all_of(csLimits.begin(), csLimits.end(), [] (size_t n) { return n == 101; });
+  }));
+  for (size_t i = 0; i < sharded->getNShards(); ++i) {
+    BOOST_TEST(!isServing[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SyncTables)
+{
+  start(2);
+  forwarder.getCs().setLimit(101);
+  forwarder.getNetworkRegionTable().insert("/region");
+  sharded->syncTables();
+
+  std::vector<size_t> csLimits(sharded->getNShards());
+  std::vector<bool> hasRegion(sharded->getNShards());
+  sharded->runInShards([&] (size_t i, Forwarder& shardForwarder) {
+    csLimits[i] = shardForwarder.getCs().getLimit();
+    hasRegion[i] = shardForwarder.getNetworkRegionTable().count("/region") > 0;
+  });
+  for (size_t i = 0; i < sharded->getNShards(); ++i) {
+    BOOST_TEST(csLimits[i] == 51);
+    BOOST_TEST(hasRegion[i]);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestShardedForwarder
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace nfd::tests
@@ -27,6 +27,7 @@
 
 #include "manager-common-fixture.hpp"
 
+#include <ndn-cxx/encoding/block-helpers.hpp>
 #include <ndn-cxx/mgmt/nfd/cs-info.hpp>
 
 namespace nfd::tests {
@@ -209,6 +210,32 @@ BOOST_AUTO_TEST_CASE(Info)
   BOOST_CHECK_EQUAL(info.getNEntries(), 310);
   BOOST_CHECK_EQUAL(info.getNHits(), 362);
   BOOST_CHECK_EQUAL(info.getNMisses(), 1493);
+
+  const Block& infoBlock = *dataset.elements_begin();
+  infoBlock.parse();
+  BOOST_CHECK_EQUAL(ndn::encoding::readNonNegativeInteger(infoBlock.get(tlv::CsNBytes)), m_cs.getNBytes());
+  BOOST_CHECK(infoBlock.find(tlv::CsByteCapacity) == infoBlock.elements_end());
+}
+
+BOOST_AUTO_TEST_CASE(InfoByteCapacity)
+{
+  m_cs.setLimit(1000);
+  m_cs.setByteLimit(2000);
+  for (uint64_t i = 0; i < 100; ++i) {
+    m_cs.insert(*makeData(Name("/Q8H4oi4g").appendSequenceNumber(i)));
+  }
+  BOOST_CHECK_LT(m_cs.size(), 100);
+  BOOST_CHECK_LE(m_cs.getNBytes(), 2000);
+
+  receiveInterest(*makeInterest("/localhost/nfd/cs/info", true));
+  Block dataset = concatenateResponses();
+  dataset.parse();
+  BOOST_REQUIRE_EQUAL(dataset.elements_size(), 1);
+
+  const Block& infoBlock = *dataset.elements_begin();
+  infoBlock.parse();
+  BOOST_CHECK_EQUAL(ndn::encoding::readNonNegativeInteger(infoBlock.get(tlv::CsNBytes)), m_cs.getNBytes());
+  BOOST_CHECK_EQUAL(ndn::encoding::readNonNegativeInteger(infoBlock.get(tlv::CsByteCapacity)), 2000);
 }
 
 BOOST_AUTO_TEST_SUITE_END() // TestCsManager
@@ -24,6 +24,7 @@
  */
 
 #include "mgmt/face-manager.hpp"
+#include "face/generic-link-service.hpp"
 #include "face/protocol-factory.hpp"
 
 #include "face-manager-command-fixture.hpp"
@@ -80,6 +81,7 @@ protected:
       randomizeCounter(counters.nOutPackets);
       randomizeCounter(counters.nInBytes);
       randomizeCounter(counters.nOutBytes);
+      randomizeCounter(counters.nOutDrops);
     }
 
     advanceClocks(1_ms, 10); // wait for notification posted
@@ -203,6 +205,49 @@ BOOST_AUTO_TEST_CASE(FaceDataset)
   BOOST_CHECK_EQUAL(status.getNOutNacks(), face->getCounters().nOutNacks);
   BOOST_CHECK_EQUAL(status.getNInBytes(), face->getCounters().nInBytes);
   BOOST_CHECK_EQUAL(status.getNOutBytes(), face->getCounters().nOutBytes);
+
+  // check NFD-specific counters
+  const Block& wire = content.elements().front();
+  wire.parse();
+  BOOST_CHECK_EQUAL(ndn::encoding::readNonNegativeInteger(wire.get(tlv::FaceNOutDrops)),
+                    face->getCounters().nOutDrops);
+  BOOST_CHECK(wire.find(tlv::FaceNSpuriousRetx) == wire.elements_end()); // not GenericLinkService
+}
+
+BOOST_AUTO_TEST_CASE(FaceDatasetLinkServiceCounters)
+{
+  face::GenericLinkService::Options options;
+  options.allowReassembly = true;
+  options.reliabilityOptions.isEnabled = true;
+  auto face = make_shared<face::Face>(make_unique<face::GenericLinkService>(options),
+                                      make_unique<DummyTransport>());
+  auto transport = static_cast<DummyTransport*>(face->getTransport());
+  m_faceTable.add(face);
+  advanceClocks(1_ms, 10);
+
+  // the fragment is retransmitted after the initial RTO of 1 second,
+  // then an Ack for its first transmission makes the retransmission spurious
+  face->sendInterest(*makeInterest("/3sOsvJ5K"));
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  lp::Packet firstTx(transport->sentPackets.front());
+  advanceClocks(1250_ms, 1);
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 2);
+  lp::Packet ack;
+  ack.add<lp::AckField>(firstTx.get<lp::TxSequenceField>());
+  transport->receivePacket(ack.wireEncode());
+
+  receiveInterest(Interest("/localhost/nfd/faces/list").setCanBePrefix(true));
+
+  Block content = concatenateResponses();
+  content.parse();
+  BOOST_REQUIRE_EQUAL(content.elements().size(), 1);
+  const Block& wire = content.elements().front();
+  wire.parse();
+  BOOST_CHECK_EQUAL(ndn::nfd::FaceStatus(wire).getFaceId(), face->getId());
+  BOOST_CHECK_EQUAL(ndn::encoding::readNonNegativeInteger(wire.get(tlv::FaceNSpuriousRetx)), 1);
+  // nothing has been reassembled yet
+  BOOST_CHECK_EQUAL(ndn::encoding::readNonNegativeInteger(wire.get(tlv::FaceReassemblyP50)), 0);
+  BOOST_CHECK_EQUAL(ndn::encoding::readNonNegativeInteger(wire.get(tlv::FaceReassemblyP99)), 0);
 }
 
 BOOST_AUTO_TEST_CASE(FaceQuery)
@@ -106,6 +106,41 @@ BOOST_AUTO_TEST_CASE(GeneralStatusDataset)
   BOOST_CHECK_EQUAL(status.getNUnsatisfiedInterests(), m_forwarder.getCounters().nUnsatisfiedInterests);
 }
 
+BOOST_AUTO_TEST_CASE(MemoryStatusDataset)
+{
+  std::vector<shared_ptr<pit::Entry>> pitEntries;
+  for (int i = 0; i < 100; ++i) {
+    pitEntries.push_back(m_forwarder.getPit().insert(*makeInterest(Name("/pit").appendNumber(i))).first);
+  }
+
+  receiveInterest(Interest("/localhost/nfd/status/memory").setCanBePrefix(true));
+
+  Block content = concatenateResponses();
+  content.parse();
+  BOOST_REQUIRE_GE(content.elements_size(), 2); // at least name tree nodes and PIT entries
+
+  uint64_t prevBlockSize = 0;
+  uint64_t totalInUse = 0;
+  for (const auto& element : content.elements()) {
+    BOOST_REQUIRE_EQUAL(element.type(), tlv::SlabPoolStatus);
+    element.parse();
+    auto blockSize = ndn::encoding::readNonNegativeInteger(element.get(tlv::SlabBlockSize));
+    auto nSlabs = ndn::encoding::readNonNegativeInteger(element.get(tlv::NSlabs));
+    auto nBytes = ndn::encoding::readNonNegativeInteger(element.get(tlv::NSlabBytes));
+    auto nInUse = ndn::encoding::readNonNegativeInteger(element.get(tlv::NBlocksInUse));
+    auto nAllocations = ndn::encoding::readNonNegativeInteger(element.get(tlv::NAllocations));
+    BOOST_CHECK_GT(blockSize, prevBlockSize);
+    BOOST_CHECK_GE(nSlabs, 1);
+    BOOST_CHECK_GE(nBytes, nInUse * blockSize);
+    BOOST_CHECK_GE(nAllocations, nInUse);
+    prevBlockSize = blockSize;
+    totalInUse += nInUse;
+  }
+
+  // 100 PIT entries, plus name tree nodes for "/" "/pit" and each Interest name
+  BOOST_CHECK_GE(totalInUse, 100 + 102);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestForwarderStatusManager
 BOOST_AUTO_TEST_SUITE_END() // Mgmt
 
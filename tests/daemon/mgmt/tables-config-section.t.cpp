@@ -35,6 +35,9 @@
 #include "tests/daemon/global-io-fixture.hpp"
 #include "tests/daemon/fw/dummy-strategy.hpp"
 
+#include <filesystem>
+#include <fstream>
+
 namespace nfd::tests {
 
 class TablesConfigSectionFixture : public GlobalIoFixture
@@ -151,6 +154,139 @@ BOOST_AUTO_TEST_CASE(InvalidValue)
 
 BOOST_AUTO_TEST_SUITE_END() // CsMaxPackets
 
+BOOST_AUTO_TEST_SUITE(CsMaxBytes)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  cs.setByteLimit(4096);
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(cs.getByteLimit(), std::numeric_limits<size_t>::max());
+}
+
+BOOST_AUTO_TEST_CASE(Valid)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_max_bytes 1048576
+    }
+  )CONFIG";
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_EQUAL(cs.getByteLimit(), std::numeric_limits<size_t>::max());
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(cs.getByteLimit(), 1048576);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValue)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_max_bytes invalid
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CsMaxBytes
+
+class CsDiskFixture : public TablesConfigSectionFixture
+{
+protected:
+  CsDiskFixture()
+  {
+    std::filesystem::remove_all(testDir);
+  }
+
+  ~CsDiskFixture()
+  {
+    cs.setDiskStore(nullptr);
+    std::filesystem::remove_all(testDir);
+  }
+
+  static std::string
+  makeConfig(const std::string& options)
+  {
+    return "tables\n{\n" + options + "\n}\n";
+  }
+
+protected:
+  static inline const std::filesystem::path testDir{UNIT_TESTS_TMPDIR "/tables-config-section-cs-disk"};
+};
+
+BOOST_FIXTURE_TEST_SUITE(CsDisk, CsDiskFixture)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  BOOST_REQUIRE_NO_THROW(runConfig(makeConfig(""), false));
+  BOOST_CHECK(cs.getDiskStore() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Valid)
+{
+  const std::string CONFIG = makeConfig("cs_disk_path " + testDir.string() + "\n"
+                                        "cs_disk_max_bytes 1048576");
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK(cs.getDiskStore() == nullptr);
+  BOOST_CHECK(!std::filesystem::exists(testDir));
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  const cs::DiskStore* store = cs.getDiskStore();
+  BOOST_REQUIRE(store != nullptr);
+  BOOST_CHECK_EQUAL(store->getPath(), testDir);
+  BOOST_CHECK_EQUAL(store->getOptions().segmentSize, 524288);
+  BOOST_CHECK_EQUAL(store->getOptions().maxSegments, 2);
+
+  // reloading the same configuration keeps the store
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(cs.getDiskStore(), store);
+
+  // omitting cs_disk_path detaches the store
+  BOOST_REQUIRE_NO_THROW(runConfig(makeConfig(""), false));
+  BOOST_CHECK(cs.getDiskStore() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(DefaultMaxBytes)
+{
+  BOOST_REQUIRE_NO_THROW(runConfig(makeConfig("cs_disk_path " + testDir.string()), false));
+  BOOST_REQUIRE(cs.getDiskStore() != nullptr);
+  BOOST_CHECK_EQUAL(cs.getDiskStore()->getOptions().segmentSize, 64 * 1024 * 1024);
+  BOOST_CHECK_EQUAL(cs.getDiskStore()->getOptions().maxSegments, 16);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidMaxBytes)
+{
+  BOOST_CHECK_THROW(runConfig(makeConfig("cs_disk_path " + testDir.string() + "\n"
+                                         "cs_disk_max_bytes 1024"), true),
+                    ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(makeConfig("cs_disk_path " + testDir.string() + "\n"
+                                         "cs_disk_max_bytes -1"), true),
+                    ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Unusable)
+{
+  // a regular file where the directory should be
+  std::filesystem::create_directories(testDir);
+  std::ofstream(testDir / "file");
+  BOOST_CHECK_THROW(runConfig(makeConfig("cs_disk_path " + (testDir / "file").string()), false),
+                    ConfigFile::Error);
+  BOOST_CHECK(cs.getDiskStore() == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CsDisk
+
 BOOST_AUTO_TEST_SUITE(CsPolicy)
 
 BOOST_AUTO_TEST_CASE(Default)
@@ -199,6 +335,177 @@ BOOST_AUTO_TEST_CASE(Unknown)
 
 BOOST_AUTO_TEST_SUITE_END() // CsPolicy
 
+BOOST_AUTO_TEST_SUITE(CsEngine)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  cs.setEngine(cs::TableEngine::HASHED);
+  runConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(cs.getEngine(), cs::TableEngine::ORDERED);
+}
+
+BOOST_AUTO_TEST_CASE(Known)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_engine hashed
+    }
+  )CONFIG";
+
+  runConfig(CONFIG, true);
+  BOOST_CHECK_EQUAL(cs.getEngine(), cs::TableEngine::ORDERED);
+
+  runConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(cs.getEngine(), cs::TableEngine::HASHED);
+}
+
+BOOST_AUTO_TEST_CASE(Unknown)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      cs_engine unknown
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CsEngine
+
+BOOST_AUTO_TEST_SUITE(DnlEngine)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  DeadNonceList& dnl = forwarder.getDeadNonceList();
+  dnl.setEngine(DeadNonceList::Engine::FILTER, 0.01);
+  runConfig(CONFIG, false);
+  BOOST_CHECK(dnl.getEngine() == DeadNonceList::Engine::EXACT);
+}
+
+BOOST_AUTO_TEST_CASE(Known)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      dnl_engine filter
+      dnl_false_positive_rate 0.0001
+    }
+  )CONFIG";
+
+  DeadNonceList& dnl = forwarder.getDeadNonceList();
+  runConfig(CONFIG, true);
+  BOOST_CHECK(dnl.getEngine() == DeadNonceList::Engine::EXACT);
+
+  runConfig(CONFIG, false);
+  BOOST_CHECK(dnl.getEngine() == DeadNonceList::Engine::FILTER);
+  BOOST_CHECK_EQUAL(dnl.getFalsePositiveRate(), 0.0001);
+
+  // reloading the same settings keeps the entries
+  dnl.add("/A", Interest::Nonce(0x53b4eaa8));
+  runConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(dnl.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Invalid)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    tables
+    {
+      dnl_engine unknown
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG1, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG1, false), ConfigFile::Error);
+
+  for (const std::string rate : {"0", "1", "-0.1", "x"}) {
+    const std::string CONFIG2 = "tables\n{\n  dnl_engine filter\n  dnl_false_positive_rate " + rate + "\n}\n";
+    BOOST_CHECK_THROW(runConfig(CONFIG2, true), ConfigFile::Error);
+    BOOST_CHECK_THROW(runConfig(CONFIG2, false), ConfigFile::Error);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // DnlEngine
+
+BOOST_AUTO_TEST_SUITE(NameTreeEngine)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  NameTree& nameTree = forwarder.getNameTree();
+  nameTree.setHashtableEngine(name_tree::HashtableEngine::OPEN_ADDRESSING, true);
+  runConfig(CONFIG, false);
+  BOOST_CHECK(nameTree.getHashtableOptions().engine == name_tree::HashtableEngine::CHAINED);
+  BOOST_CHECK_EQUAL(nameTree.getHashtableOptions().incrementalResize, false);
+}
+
+BOOST_AUTO_TEST_CASE(Known)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      name_tree_engine open_addressing
+      name_tree_incremental_resize yes
+    }
+  )CONFIG";
+
+  NameTree& nameTree = forwarder.getNameTree();
+  forwarder.getFib().insert("/A");
+  runConfig(CONFIG, true);
+  BOOST_CHECK(nameTree.getHashtableOptions().engine == name_tree::HashtableEngine::CHAINED);
+
+  runConfig(CONFIG, false);
+  BOOST_CHECK(nameTree.getHashtableOptions().engine == name_tree::HashtableEngine::OPEN_ADDRESSING);
+  BOOST_CHECK_EQUAL(nameTree.getHashtableOptions().incrementalResize, true);
+  // existing entries are kept
+  BOOST_CHECK(forwarder.getFib().findExactMatch("/A") != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Invalid)
+{
+  const std::string CONFIG1 = R"CONFIG(
+    tables
+    {
+      name_tree_engine unknown
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG1, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG1, false), ConfigFile::Error);
+
+  const std::string CONFIG2 = R"CONFIG(
+    tables
+    {
+      name_tree_incremental_resize maybe
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG2, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG2, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // NameTreeEngine
+
 class CsUnsolicitedPolicyFixture : public TablesConfigSectionFixture
 {
 protected:
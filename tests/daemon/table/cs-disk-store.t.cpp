@@ -0,0 +1,296 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-disk-store.hpp"
+#include "table/cs-policy-tinylfu.hpp"
+
+#include "tests/daemon/table/cs-fixture.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+namespace nfd::tests {
+
+namespace fs = std::filesystem;
+using cs::DiskStore;
+
+class CsDiskStoreFixture : public CsFixture
+{
+protected:
+  CsDiskStoreFixture()
+  {
+    fs::remove_all(testDir);
+  }
+
+  ~CsDiskStoreFixture()
+  {
+    store.reset();
+    fs::remove_all(testDir);
+  }
+
+  void
+  openStore(size_t segmentSize = 4096, size_t maxSegments = 2)
+  {
+    store.reset();
+    DiskStore::Options options;
+    options.segmentSize = segmentSize;
+    options.maxSegments = maxSegments;
+    store = make_unique<DiskStore>(testDir, options);
+  }
+
+  shared_ptr<Data>
+  makeStoredData(const Name& name, uint32_t id)
+  {
+    auto data = makeData(name);
+    data->setContent(ndn::make_span(reinterpret_cast<const uint8_t*>(&id), sizeof(id)));
+    data->setFreshnessPeriod(1_s);
+    data->wireEncode();
+    return data;
+  }
+
+  void
+  insertToStore(const Data& data)
+  {
+    store->insert(data, time::system_clock::now() + data.getFreshnessPeriod());
+  }
+
+  size_t
+  countSegmentFiles() const
+  {
+    return std::distance(fs::directory_iterator(testDir), fs::directory_iterator{});
+  }
+
+protected:
+  static inline const fs::path testDir = fs::path(UNIT_TESTS_TMPDIR) / "cs-disk-store";
+  unique_ptr<DiskStore> store;
+};
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_FIXTURE_TEST_SUITE(TestCsDiskStore, CsDiskStoreFixture)
+
+BOOST_AUTO_TEST_CASE(InsertFind)
+{
+  openStore();
+  BOOST_CHECK(fs::is_directory(testDir));
+  BOOST_CHECK_EQUAL(store->size(), 0);
+
+  auto dataA = makeStoredData("/A", 1);
+  insertToStore(*dataA);
+  insertToStore(*makeStoredData("/B", 2));
+  BOOST_CHECK_EQUAL(store->size(), 2);
+
+  auto found = store->find(*makeInterest("/A"));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->wireEncode(), dataA->wireEncode());
+
+  BOOST_CHECK(store->find(*makeInterest("/C")) == nullptr);
+  BOOST_CHECK(store->find(*makeInterest("/A/0")) == nullptr);
+
+  // CanBePrefix is not supported
+  BOOST_CHECK(store->find(*makeInterest("/A", true)) == nullptr);
+  BOOST_CHECK_EQUAL(store->getNDeferredLookups(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(FullName)
+{
+  openStore();
+  auto data1 = makeStoredData("/A", 1);
+  auto data2 = makeStoredData("/A", 2);
+  insertToStore(*data1);
+  insertToStore(*data2);
+
+  auto found = store->find(*makeInterest(data1->getFullName()));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getContent(), data1->getContent());
+
+  found = store->find(*makeInterest(data2->getFullName()));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getContent(), data2->getContent());
+
+  BOOST_CHECK(store->find(*makeInterest(makeStoredData("/A", 3)->getFullName())) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(MustBeFresh)
+{
+  openStore();
+  insertToStore(*makeStoredData("/A", 1));
+
+  auto interest = makeInterest("/A");
+  interest->setMustBeFresh(true);
+  BOOST_CHECK(store->find(*interest) != nullptr);
+
+  advanceClocks(500_ms, 4);
+  BOOST_CHECK(store->find(*interest) == nullptr);
+  BOOST_CHECK(store->find(*makeInterest("/A")) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(SegmentRollover)
+{
+  openStore(4096, 2);
+
+  const int nPackets = 200;
+  for (int i = 0; i < nPackets; ++i) {
+    insertToStore(*makeStoredData(Name("/A").appendNumber(i), i));
+  }
+  BOOST_CHECK_EQUAL(countSegmentFiles(), 2);
+  BOOST_CHECK_LT(store->size(), nPackets);
+  BOOST_CHECK_GT(store->size(), 0);
+
+  BOOST_CHECK(store->find(*makeInterest(Name("/A").appendNumber(0))) == nullptr);
+  BOOST_CHECK(store->find(*makeInterest(Name("/A").appendNumber(nPackets - 1))) != nullptr);
+
+  // a packet larger than a segment is not stored
+  auto large = makeData("/large");
+  large->setContent(std::vector<uint8_t>(8192));
+  large->wireEncode();
+  size_t nStored = store->size();
+  insertToStore(*large);
+  BOOST_CHECK_EQUAL(store->size(), nStored);
+}
+
+BOOST_AUTO_TEST_CASE(Reopen)
+{
+  openStore(4096, 4);
+  auto dataA = makeStoredData("/A", 1);
+  insertToStore(*dataA);
+  for (int i = 0; i < 200; ++i) {
+    insertToStore(*makeStoredData(Name("/B").appendNumber(i), i));
+  }
+  size_t nStored = store->size();
+  BOOST_CHECK_GT(countSegmentFiles(), 1);
+
+  openStore(4096, 4);
+  BOOST_CHECK_EQUAL(store->size(), nStored);
+  auto found = store->find(*makeInterest("/A"));
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->wireEncode(), dataA->wireEncode());
+
+  // new packets are appended after the existing ones
+  insertToStore(*makeStoredData("/C", 3));
+  BOOST_CHECK_EQUAL(store->size(), nStored + 1);
+  BOOST_CHECK(store->find(*makeInterest("/A")) != nullptr);
+  BOOST_CHECK(store->find(*makeInterest("/C")) != nullptr);
+
+  // reopening with fewer segments drops the oldest ones
+  openStore(4096, 1);
+  BOOST_CHECK_EQUAL(countSegmentFiles(), 1);
+  BOOST_CHECK(store->find(*makeInterest("/A")) == nullptr);
+  BOOST_CHECK(store->find(*makeInterest("/C")) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ReopenWithGaps)
+{
+  openStore(4096, 8);
+  for (int i = 0; i < 300; ++i) {
+    insertToStore(*makeStoredData(Name("/A").appendNumber(i), i));
+  }
+  BOOST_REQUIRE_GE(countSegmentFiles(), 3);
+  store.reset();
+
+  // a missing segment in the middle, and a segment too short to hold a packet
+  fs::remove(testDir / "1.seg");
+  std::ofstream(testDir / "100.seg") << "short";
+
+  openStore(4096, 8);
+  BOOST_CHECK(!fs::exists(testDir / "100.seg"));
+  BOOST_CHECK(store->find(*makeInterest(Name("/A").appendNumber(0))) != nullptr);
+  BOOST_CHECK(store->find(*makeInterest(Name("/A").appendNumber(299))) != nullptr);
+
+  // new packets are found after the gap
+  insertToStore(*makeStoredData("/B", 1));
+  BOOST_CHECK(store->find(*makeInterest("/B")) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(CsSecondTier)
+{
+  openStore();
+  cs.setLimit(1);
+  cs.setDiskStore(std::move(store));
+  BOOST_REQUIRE(cs.getDiskStore() != nullptr);
+
+  insert(1, "/A");
+  insert(2, "/B"); // evicts /A to disk
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  BOOST_CHECK_EQUAL(cs.getDiskStore()->size(), 1);
+
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+  startInterest("/B");
+  CHECK_CS_FIND(2);
+
+  // disk hits are not promoted to memory
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+
+  // CanBePrefix Interests are served only from memory
+  startInterest("/A").setCanBePrefix(true);
+  CHECK_CS_FIND(0);
+
+  // unsolicited Data are not written to disk
+  insert(3, "/C", nullptr, true);
+  insert(4, "/D"); // evicts unsolicited /C
+  BOOST_CHECK_EQUAL(cs.getDiskStore()->size(), 2); // /A and /B
+  startInterest("/C");
+  CHECK_CS_FIND(0);
+
+  cs.enableServe(false);
+  startInterest("/A");
+  CHECK_CS_FIND(0);
+  cs.enableServe(true);
+
+  cs.setDiskStore(nullptr);
+  startInterest("/A");
+  CHECK_CS_FIND(0);
+}
+
+BOOST_AUTO_TEST_CASE(AdmissionRejectNotDemoted)
+{
+  openStore();
+  cs.setPolicy(make_unique<cs::TinyLfuPolicy>());
+  cs.setLimit(1);
+  cs.setDiskStore(std::move(store));
+
+  insert(1, "/A");
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+
+  // /B is refused by admission control, and is not written to disk
+  insert(2, "/B");
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  BOOST_CHECK_EQUAL(cs.getDiskStore()->size(), 0);
+
+  insert(2, "/B");
+  BOOST_CHECK_EQUAL(cs.getDiskStore()->size(), 0);
+
+  // /B is admitted once it is more popular than /A, which is evicted to disk
+  insert(2, "/B");
+  BOOST_CHECK_EQUAL(cs.getDiskStore()->size(), 1);
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsDiskStore
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace nfd::tests
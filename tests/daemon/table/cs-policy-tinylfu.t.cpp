@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs-policy-tinylfu.hpp"
+
+#include "tests/daemon/table/cs-fixture.hpp"
+
+namespace nfd::tests {
+
+using cs::tinylfu::FrequencySketch;
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_AUTO_TEST_SUITE(TestCsTinyLfu)
+
+BOOST_AUTO_TEST_CASE(Registration)
+{
+  std::set<std::string> policyNames = cs::Policy::getPolicyNames();
+  BOOST_CHECK_EQUAL(policyNames.count("tinylfu"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Sketch)
+{
+  FrequencySketch sketch(100);
+  BOOST_CHECK_EQUAL(sketch.getWidth(), 128);
+  BOOST_CHECK_EQUAL(sketch.getSampleSize(), 1280);
+  BOOST_CHECK_EQUAL(sketch.estimate(1), 0);
+
+  for (int i = 0; i < 5; ++i) {
+    sketch.increment(1);
+  }
+  sketch.increment(2);
+  BOOST_CHECK_EQUAL(sketch.estimate(1), 5);
+  BOOST_CHECK_EQUAL(sketch.estimate(2), 1);
+
+  // counters saturate
+  for (int i = 0; i < 100; ++i) {
+    sketch.increment(1);
+  }
+  BOOST_CHECK_EQUAL(sketch.estimate(1), FrequencySketch::MAX_COUNT);
+
+  // counters are halved after each sample period
+  for (size_t key = 1000; key < 1000 + sketch.getSampleSize(); ++key) {
+    sketch.increment(key);
+  }
+  BOOST_CHECK_LT(sketch.estimate(1), FrequencySketch::MAX_COUNT);
+}
+
+BOOST_FIXTURE_TEST_CASE(Admission, CsFixture)
+{
+  cs.setPolicy(make_unique<cs::TinyLfuPolicy>());
+  cs.setLimit(3);
+
+  insert(1, "/A");
+  insert(2, "/B");
+  insert(3, "/C");
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+
+  // D is not more popular than victim A, so it is rejected
+  insert(4, "/D");
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  startInterest("/D");
+  CHECK_CS_FIND(0);
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+
+  // D has been seen twice, so it is admitted in place of victim B
+  insert(4, "/D");
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  startInterest("/B");
+  CHECK_CS_FIND(0);
+  startInterest("/D");
+  CHECK_CS_FIND(4);
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+  startInterest("/C");
+  CHECK_CS_FIND(3);
+
+  // erased entries leave the queue
+  BOOST_CHECK_EQUAL(erase("/A", 1), 1);
+  insert(5, "/E");
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  startInterest("/E");
+  CHECK_CS_FIND(5);
+}
+
+BOOST_FIXTURE_TEST_CASE(ScanResistance, CsFixture)
+{
+  cs.setPolicy(make_unique<cs::TinyLfuPolicy>());
+  cs.setLimit(10);
+
+  for (uint32_t i = 0; i < 10; ++i) {
+    insert(i, Name("/hot").appendNumber(i));
+    for (int j = 0; j < 6; ++j) {
+      startInterest(Name("/hot").appendNumber(i));
+      CHECK_CS_FIND(i);
+    }
+  }
+
+  for (uint32_t i = 0; i < 100; ++i) {
+    insert(100 + i, Name("/scan").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(cs.size(), 10);
+
+  for (uint32_t i = 0; i < 10; ++i) {
+    startInterest(Name("/hot").appendNumber(i));
+    CHECK_CS_FIND(i);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(LowerLimit, CsFixture)
+{
+  cs.setPolicy(make_unique<cs::TinyLfuPolicy>());
+  cs.setLimit(5);
+
+  for (uint32_t i = 0; i < 5; ++i) {
+    insert(i, Name("/A").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(cs.size(), 5);
+
+  // lowering the limit evicts in LRU order
+  cs.setLimit(2);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  startInterest(Name("/A").appendNumber(0));
+  CHECK_CS_FIND(0);
+  startInterest(Name("/A").appendNumber(4));
+  CHECK_CS_FIND(4);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCsTinyLfu
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace nfd::tests
@@ -194,6 +194,41 @@ BOOST_AUTO_TEST_CASE(ZeroCapacity)
   CHECK_CS_FIND(0);
 }
 
+BOOST_AUTO_TEST_CASE(ByteCapacity)
+{
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 0);
+  BOOST_CHECK_EQUAL(cs.getByteLimit(), std::numeric_limits<size_t>::max());
+  cs.setLimit(100);
+
+  // Data packets below have the same wire size
+  insert(1, "/A");
+  size_t entrySize = cs.getNBytes();
+  BOOST_CHECK_GT(entrySize, 0);
+  insert(2, "/B");
+  insert(3, "/C");
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 3 * entrySize);
+
+  // lowering the byte limit evicts the least recently used entry
+  cs.setByteLimit(2 * entrySize + entrySize / 2);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 2 * entrySize);
+  startInterest("/A");
+  CHECK_CS_FIND(0);
+
+  // inserting beyond the byte limit evicts
+  insert(4, "/D");
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  startInterest("/B");
+  CHECK_CS_FIND(0);
+
+  // a refresh does not change the byte count
+  insert(4, "/D");
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 2 * entrySize);
+
+  BOOST_CHECK_EQUAL(erase("/", 10), 2);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(EnablementFlags)
 {
   BOOST_CHECK_EQUAL(cs.shouldAdmit(), true);
@@ -236,6 +271,92 @@ BOOST_AUTO_TEST_CASE(CachePolicyNoCache)
   CHECK_CS_FIND(0);
 }
 
+class HashedCsFixture : public CsFixture
+{
+protected:
+  HashedCsFixture()
+  {
+    cs.setEngine(cs::TableEngine::HASHED);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(HashedEngine, HashedCsFixture)
+
+BOOST_AUTO_TEST_CASE(Find)
+{
+  insert(1, "/");
+  insert(2, "/A");
+  insert(3, "/A/B");
+  Name n4 = insert(4, "/C");
+  Name n5 = insert(5, "/C");
+
+  startInterest("/A");
+  CHECK_CS_FIND(2);
+
+  startInterest("/A")
+    .setCanBePrefix(true);
+  CHECK_CS_FIND(2);
+
+  startInterest("/A/B/C");
+  CHECK_CS_FIND(0);
+
+  startInterest(n4);
+  CHECK_CS_FIND(4);
+
+  startInterest(n5);
+  CHECK_CS_FIND(5);
+
+  // same result as the ordered engine: first entry in Table order
+  uint32_t expectedC = n4 < n5 ? 4 : 5;
+  startInterest("/C");
+  CHECK_CS_FIND(expectedC);
+}
+
+BOOST_AUTO_TEST_CASE(EraseAndEvict)
+{
+  cs.setLimit(3);
+  insert(1, "/A/1");
+  insert(2, "/A/2");
+  insert(3, "/B/3");
+
+  BOOST_CHECK_EQUAL(erase("/A", 1), 1);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  startInterest("/A/1");
+  CHECK_CS_FIND(0);
+  startInterest("/A/2");
+  CHECK_CS_FIND(2);
+
+  insert(4, "/B/4");
+  insert(5, "/B/5"); // evicts the least recently used entry /B/3
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  startInterest("/B/3");
+  CHECK_CS_FIND(0);
+  startInterest("/A/2");
+  CHECK_CS_FIND(2);
+  startInterest("/B/5");
+  CHECK_CS_FIND(5);
+}
+
+BOOST_AUTO_TEST_CASE(ChangeEngine)
+{
+  cs.setEngine(cs::TableEngine::ORDERED);
+  insert(1, "/A");
+  insert(2, "/B");
+
+  cs.setEngine(cs::TableEngine::HASHED);
+  BOOST_CHECK_EQUAL(cs.getEngine(), cs::TableEngine::HASHED);
+  startInterest("/A");
+  CHECK_CS_FIND(1);
+  startInterest("/B");
+  CHECK_CS_FIND(2);
+
+  BOOST_CHECK_EQUAL(erase("/", 10), 2);
+  startInterest("/A");
+  CHECK_CS_FIND(0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // HashedEngine
+
 BOOST_AUTO_TEST_CASE(Enumeration)
 {
   Name nameA("/A");
@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/dead-nonce-filter.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <random>
+
+namespace nfd::tests {
+
+BOOST_AUTO_TEST_SUITE(Table)
+BOOST_AUTO_TEST_SUITE(TestDeadNonceFilter)
+
+BOOST_AUTO_TEST_CASE(FingerprintBits)
+{
+  // a lookup is compared against 2 buckets of 4 fingerprints, and a victim, in each slice
+  BOOST_CHECK_EQUAL(DeadNonceFilter(2, 0.1, 100, 1000).getFingerprintBits(), 8);
+  BOOST_CHECK_EQUAL(DeadNonceFilter(6, 0.1, 100, 1000).getFingerprintBits(), 16);
+  BOOST_CHECK_EQUAL(DeadNonceFilter(6, 0.001, 100, 1000).getFingerprintBits(), 16);
+  BOOST_CHECK_EQUAL(DeadNonceFilter(6, 0.00001, 100, 1000).getFingerprintBits(), 32);
+}
+
+BOOST_AUTO_TEST_CASE(Rotate)
+{
+  constexpr size_t N_ENTRIES = 10000;
+  DeadNonceFilter filter(3, 0.001, 100, 1000000);
+  std::mt19937_64 rng(0);
+
+  // slices grow beyond their initial capacity without losing entries
+  std::vector<std::vector<uint64_t>> slices(4);
+  for (auto& slice : slices) {
+    for (size_t i = 0; i < N_ENTRIES; ++i) {
+      slice.push_back(rng());
+      filter.add(slice.back());
+    }
+    filter.rotate();
+  }
+
+  // the first slice has been dropped, and the current slice is empty
+  for (size_t i = 2; i < slices.size(); ++i) {
+    BOOST_CHECK(std::all_of(slices[i].begin(), slices[i].end(),
+                            [&] (uint64_t entry) { return filter.has(entry); }));
+  }
+  size_t nPositives = std::count_if(slices[0].begin(), slices[0].end(),
+                                    [&] (uint64_t entry) { return filter.has(entry); });
+  BOOST_CHECK_LE(nPositives, N_ENTRIES / 100);
+  BOOST_CHECK_GE(filter.size(), 2 * N_ENTRIES - N_ENTRIES / 100);
+  BOOST_CHECK_LE(filter.size(), 2 * N_ENTRIES);
+
+  // a few bytes per entry, with 16-bit fingerprints
+  BOOST_CHECK_EQUAL(filter.getFingerprintBits(), 16);
+  BOOST_CHECK_LE(filter.getMemoryUsage(), 2 * N_ENTRIES * 6);
+}
+
+BOOST_AUTO_TEST_CASE(OverflowFilters)
+{
+  // 8-bit fingerprints: at most 2 slices * 9 comparisons / 256 = 7% false positives
+  DeadNonceFilter filter(2, 0.1, 100, 1000000);
+  BOOST_REQUIRE_EQUAL(filter.getFingerprintBits(), 8);
+  std::mt19937_64 rng(0);
+
+  // far beyond the capacity of the first filter of the slice
+  std::vector<uint64_t> entries;
+  for (size_t i = 0; i < 20 * DeadNonceFilter::MIN_SLICE_CAPACITY; ++i) {
+    entries.push_back(rng());
+    filter.add(entries.back());
+  }
+  BOOST_CHECK(std::all_of(entries.begin(), entries.end(),
+                          [&] (uint64_t entry) { return filter.has(entry); }));
+
+  // overflow filters barely add false positives; with 8-bit fingerprints, about 40% would be
+  constexpr size_t N_PROBES = 10000;
+  size_t nPositives = 0;
+  for (size_t i = 0; i < N_PROBES; ++i) {
+    nPositives += filter.has(rng());
+  }
+  BOOST_CHECK_LE(nPositives, N_PROBES / 10);
+}
+
+BOOST_AUTO_TEST_CASE(MaxEntries)
+{
+  DeadNonceFilter filter(3, 0.001, 100, 1000);
+  std::mt19937_64 rng(0);
+  uint64_t first = rng();
+  filter.add(first);
+  for (size_t i = 0; i < 1500; ++i) {
+    filter.add(rng());
+  }
+  BOOST_CHECK_LE(filter.size(), 1000);
+  BOOST_CHECK_EQUAL(filter.has(first), false);
+}
+
+BOOST_AUTO_TEST_CASE(SmallMaxEntries)
+{
+  DeadNonceFilter filter(3, 0.001, 100, 10);
+  std::mt19937_64 rng(0);
+  for (size_t i = 0; i < 100; ++i) {
+    if (i % 7 == 0) {
+      filter.rotate();
+    }
+    uint64_t entry = rng();
+    filter.add(entry);
+    // the entry just added survives the expiration it triggers
+    BOOST_CHECK(filter.has(entry));
+    BOOST_CHECK_LE(filter.size(), 10);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestDeadNonceFilter
+BOOST_AUTO_TEST_SUITE_END() // Table
+
+} // namespace nfd::tests
@@ -95,6 +95,42 @@ BOOST_AUTO_TEST_CASE(NoDuplicates)
   BOOST_CHECK_EQUAL(dnl.has(nameA, nonce5), true);
 }
 
+BOOST_AUTO_TEST_CASE(FilterEngine)
+{
+  Name nameA("ndn:/A");
+  Name nameB("ndn:/B");
+  const Interest::Nonce nonce1(0x53b4eaa8);
+  const Interest::Nonce nonce2(0x1f46372b);
+
+  DeadNonceList dnl;
+  dnl.add(nameA, nonce1);
+  BOOST_CHECK(dnl.getEngine() == DeadNonceList::Engine::EXACT);
+
+  // switching the engine drops the entries
+  dnl.setEngine(DeadNonceList::Engine::FILTER, 0.01);
+  BOOST_CHECK(dnl.getEngine() == DeadNonceList::Engine::FILTER);
+  BOOST_CHECK_EQUAL(dnl.getFalsePositiveRate(), 0.01);
+  BOOST_CHECK_EQUAL(dnl.size(), 0);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), false);
+
+  dnl.add(nameA, nonce1);
+  dnl.add(nameA, nonce1);
+  BOOST_CHECK_EQUAL(dnl.size(), 1);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce2), false);
+  BOOST_CHECK_EQUAL(dnl.has(nameB, nonce1), false);
+
+  // setting the same engine and rate keeps the entries
+  dnl.setEngine(DeadNonceList::Engine::FILTER, 0.01);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
+
+  dnl.setEngine(DeadNonceList::Engine::EXACT);
+  BOOST_CHECK(dnl.getEngine() == DeadNonceList::Engine::EXACT);
+  BOOST_CHECK_EQUAL(dnl.size(), 0);
+  dnl.add(nameB, nonce2);
+  BOOST_CHECK_EQUAL(dnl.has(nameB, nonce2), true);
+}
+
 BOOST_AUTO_TEST_CASE(MinLifetime)
 {
   BOOST_CHECK_THROW(DeadNonceList(0_ms), std::invalid_argument);
@@ -165,6 +201,29 @@ BOOST_FIXTURE_TEST_CASE(Lifetime, PeriodicalInsertionFixture)
   BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), false);
 }
 
+BOOST_FIXTURE_TEST_CASE(FilterLifetime, PeriodicalInsertionFixture)
+{
+  dnl.setEngine(DeadNonceList::Engine::FILTER);
+
+  const size_t RATE = DeadNonceList::INITIAL_CAPACITY * 3;
+  this->setRate(RATE);
+  this->advanceClocksByLifetime(10.0);
+  // about one lifetime of entries is kept, in slices of one MARK interval each
+  BOOST_CHECK_GE(dnl.size(), RATE);
+  BOOST_CHECK_LE(dnl.size(), RATE * 13 / 10);
+
+  Name nameC("ndn:/C");
+  const Interest::Nonce nonceC(0x25390656);
+  dnl.add(nameC, nonceC);
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), true);
+
+  this->advanceClocksByLifetime(0.9);
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), true);
+
+  this->advanceClocksByLifetime(0.6);
+  BOOST_CHECK_EQUAL(dnl.has(nameC, nonceC), false);
+}
+
 BOOST_FIXTURE_TEST_CASE(CapacityDown, PeriodicalInsertionFixture)
 {
   ssize_t cap0 = dnl.m_capacity;
@@ -190,6 +190,157 @@ BOOST_AUTO_TEST_CASE(Resize)
   BOOST_CHECK_EQUAL(ht.getNBuckets(), 6);
 }
 
+BOOST_AUTO_TEST_CASE(IncrementalResize)
+{
+  HashtableOptions options(8);
+  options.incrementalResize = true;
+  options.migrationBatchSize = 1;
+  Hashtable ht(options);
+
+  auto makeName = [] (int i) {
+    Name name;
+    name.appendNumber(i);
+    return name;
+  };
+
+  for (int i = 1; i <= 4; ++i) {
+    Name name = makeName(i);
+    ht.insert(name, name.size(), computeHashes(name));
+  }
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 8);
+  BOOST_CHECK_EQUAL(ht.getNPendingMigrations(), 0);
+
+  // exceeding the expand threshold allocates the new buckets but does not migrate any node
+  Name name5 = makeName(5);
+  ht.insert(name5, name5.size(), computeHashes(name5));
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 16);
+  BOOST_CHECK_EQUAL(ht.getNPendingMigrations(), 8);
+
+  // every node is reachable and enumerated during migration; lookups do not migrate
+  for (int i = 1; i <= 5; ++i) {
+    BOOST_CHECK(ht.find(makeName(i), 1) != nullptr);
+  }
+  BOOST_CHECK_EQUAL(ht.getNPendingMigrations(), 8);
+  size_t nEnumerated = 0;
+  for (const Node* node = ht.getNext(nullptr); node != nullptr; node = ht.getNext(node)) {
+    ++nEnumerated;
+  }
+  BOOST_CHECK_EQUAL(nEnumerated, 5);
+
+  // erase a node that may still be in an old bucket
+  ht.erase(const_cast<Node*>(ht.find(makeName(1), 1)));
+  BOOST_CHECK_EQUAL(ht.size(), 4);
+  BOOST_CHECK_EQUAL(ht.getNPendingMigrations(), 7);
+  BOOST_CHECK(ht.find(makeName(1), 1) == nullptr);
+
+  // each insert and erase migrates one bucket
+  for (int i = 6; i <= 9; ++i) {
+    Name name = makeName(i);
+    ht.insert(name, name.size(), computeHashes(name));
+  }
+  BOOST_CHECK_EQUAL(ht.getNPendingMigrations(), 3);
+  for (int i = 6; i <= 8; ++i) {
+    ht.erase(const_cast<Node*>(ht.find(makeName(i), 1)));
+  }
+  BOOST_CHECK_EQUAL(ht.getNPendingMigrations(), 0);
+  for (int i = 2; i <= 5; ++i) {
+    BOOST_CHECK(ht.find(makeName(i), 1) != nullptr);
+  }
+  BOOST_CHECK(ht.find(makeName(9), 1) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ResizeDuringMigration)
+{
+  HashtableOptions options(8);
+  options.expandFactor = 1.5f;
+  options.incrementalResize = true;
+  options.migrationBatchSize = 1;
+  Hashtable ht(options);
+
+  auto insertName = [&ht] (int i) {
+    Name name;
+    name.appendNumber(i);
+    ht.insert(name, name.size(), computeHashes(name));
+  };
+
+  for (int i = 1; i <= 5; ++i) {
+    insertName(i);
+  }
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 12);
+  BOOST_CHECK_EQUAL(ht.getNPendingMigrations(), 8);
+
+  // exceeding the expand threshold again does not interrupt the migration
+  insertName(6);
+  insertName(7);
+  BOOST_CHECK_EQUAL(ht.size(), 7);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 12);
+  BOOST_CHECK_EQUAL(ht.getNPendingMigrations(), 6);
+
+  // the next resize starts when the migration completes
+  for (int i = 8; i <= 12; ++i) {
+    insertName(i);
+  }
+  BOOST_CHECK_EQUAL(ht.getNPendingMigrations(), 1);
+  insertName(13);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 18);
+  BOOST_CHECK_EQUAL(ht.getNPendingMigrations(), 12);
+
+  for (int i = 1; i <= 13; ++i) {
+    Name name;
+    name.appendNumber(i);
+    BOOST_CHECK(ht.find(name, 1) != nullptr);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(OpenAddressing)
+{
+  HashtableOptions options(16);
+  options.engine = HashtableEngine::OPEN_ADDRESSING;
+  Hashtable ht(options);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 4 * GroupTable::GROUP_SIZE); // rounded up to 2^n groups
+
+  const int nNames = 2000;
+  std::vector<const Node*> nodes;
+  for (int i = 0; i < nNames; ++i) {
+    Name name;
+    name.appendNumber(i);
+    const Node* node = nullptr;
+    bool isNew = false;
+    std::tie(node, isNew) = ht.insert(name, 1, computeHashes(name));
+    BOOST_CHECK(isNew);
+    nodes.push_back(node);
+
+    // every node remains reachable while the table is being resized
+    if (i % 97 == 0) {
+      for (int j = 0; j <= i; j += 13) {
+        Name name2;
+        name2.appendNumber(j);
+        BOOST_CHECK_EQUAL(ht.find(name2, 1), nodes[j]);
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(ht.size(), nNames);
+  BOOST_CHECK_GT(ht.getNBuckets(), static_cast<size_t>(nNames));
+
+  std::set<const Node*> enumerated;
+  for (const Node* node = ht.getNext(nullptr); node != nullptr; node = ht.getNext(node)) {
+    BOOST_CHECK(enumerated.insert(node).second);
+  }
+  BOOST_CHECK_EQUAL(enumerated.size(), ht.size());
+
+  for (int i = 0; i < nNames; ++i) {
+    Name name;
+    name.appendNumber(i);
+    const Node* node = ht.find(name, 1);
+    BOOST_REQUIRE_EQUAL(node, nodes[i]);
+    ht.erase(const_cast<Node*>(node));
+    BOOST_CHECK(ht.find(name, 1) == nullptr);
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 0);
+  BOOST_CHECK(ht.getNext(nullptr) == nullptr);
+  BOOST_CHECK_LT(ht.getNBuckets(), static_cast<size_t>(nNames));
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Hashtable
 
 BOOST_AUTO_TEST_SUITE(TestEntry)
@@ -425,6 +576,70 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_EQUAL(nt.size(), 8);
 }
 
+BOOST_AUTO_TEST_CASE(PrecomputedHashes)
+{
+  NameTree nt;
+
+  Name nameABCDE("/a/b/c/d/e");
+  HashSequence hashes = computeHashes(nameABCDE);
+  BOOST_CHECK_EQUAL(hashes.size(), 6);
+  for (size_t i = 0; i < hashes.size(); ++i) {
+    BOOST_CHECK_EQUAL(hashes[i], computeHash(nameABCDE, i));
+  }
+
+  Entry& npeABC = nt.lookup(nameABCDE, 3, hashes);
+  BOOST_CHECK_EQUAL(npeABC.getName(), "/a/b/c");
+  BOOST_CHECK_EQUAL(nt.size(), 4);
+  BOOST_CHECK_EQUAL(&nt.lookup(nameABCDE, 3), &npeABC);
+  BOOST_CHECK_EQUAL(nt.size(), 4);
+
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(nameABCDE, hashes), &npeABC);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(nameABCDE, hashes,
+                      [] (const Entry& entry) { return entry.getName().size() < 2; }),
+                    nt.findExactMatch("/a"));
+
+  // hash sequence of a maximum-depth name is stored inline
+  Name longName;
+  for (size_t i = 0; i < NameTree::getMaxDepth() + 8; ++i) {
+    longName.appendNumber(i);
+  }
+  HashSequence longHashes = computeHashes(longName, NameTree::getMaxDepth());
+  BOOST_CHECK_EQUAL(longHashes.size(), NameTree::getMaxDepth() + 1);
+  BOOST_CHECK_LE(longHashes.capacity(), HASH_SEQUENCE_INLINE_CAPACITY);
+  BOOST_CHECK_EQUAL(&nt.lookup(longName, NameTree::getMaxDepth(), longHashes),
+                    nt.findLongestPrefixMatch(longName, longHashes));
+}
+
+BOOST_AUTO_TEST_CASE(PacketHashes)
+{
+  NameTree nt;
+  nt.lookup("/a/b/x");
+
+  Name nameABCD("/a/b/c/d");
+  {
+    NameTree::PacketScope packet(nt, nameABCD);
+    BOOST_CHECK_EQUAL(packet.getHashes().size(), 5);
+    BOOST_CHECK_EQUAL(packet.getHashes()[4], computeHash(nameABCD, 4));
+
+    // lookups of the packet name, of an equal name, and of a name that shares only
+    // a shorter prefix with the packet name all find the right entries
+    BOOST_CHECK_EQUAL(nt.lookup(nameABCD, 3).getName(), "/a/b/c");
+    BOOST_CHECK_EQUAL(nt.lookup(Name("/a/b/c/d")).getName(), "/a/b/c/d");
+    BOOST_CHECK_EQUAL(nt.findExactMatch("/a/b/x")->getName(), "/a/b/x");
+    BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch("/a/b/x/y")->getName(), "/a/b/x");
+    BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch("/a/b/c/d/e")->getName(), "/a/b/c/d");
+
+    {
+      Name nameZ("/z");
+      NameTree::PacketScope inner(nt, nameZ);
+      BOOST_CHECK(nt.findExactMatch(nameABCD) != nullptr);
+      BOOST_CHECK_EQUAL(nt.lookup(nameZ).getName(), "/z");
+    }
+    BOOST_CHECK_EQUAL(nt.findExactMatch(nameABCD, 2)->getName(), "/a/b");
+  }
+  BOOST_CHECK_EQUAL(nt.size(), 7);
+}
+
 /** \brief Verify a NameTree enumeration contains expected entries.
  *
  *  Example:
@@ -708,6 +923,43 @@ BOOST_AUTO_TEST_CASE(HashTableResizeShrink)
   BOOST_CHECK_EQUAL(nameTree.getNBuckets(), 16);
 }
 
+BOOST_AUTO_TEST_CASE(OpenAddressingEngine)
+{
+  HashtableOptions options(16);
+  options.engine = HashtableEngine::OPEN_ADDRESSING;
+  NameTree nt(options);
+
+  std::set<Name> names;
+  for (int i = 0; i < 200; ++i) {
+    Name name("/A");
+    name.appendNumber(i % 10).appendNumber(i);
+    nt.lookup(name);
+    names.insert(name);
+    names.insert(name.getPrefix(2));
+  }
+  names.insert("/");
+  names.insert("/A");
+  BOOST_CHECK_EQUAL(nt.size(), names.size());
+
+  std::set<Name> enumerated;
+  for (const Entry& entry : nt) {
+    BOOST_CHECK(enumerated.insert(entry.getName()).second);
+  }
+  BOOST_CHECK(enumerated == names);
+
+  Name nameA313 = Name("/A").appendNumber(3).appendNumber(13);
+  Entry* lpm = nt.findLongestPrefixMatch(Name(nameA313).append("Z"));
+  BOOST_REQUIRE(lpm != nullptr);
+  BOOST_CHECK_EQUAL(lpm->getName(), nameA313);
+
+  for (const Name& name : names) {
+    if (name.size() == 3) {
+      nt.eraseIfEmpty(nt.findExactMatch(name));
+    }
+  }
+  BOOST_CHECK_EQUAL(nt.size(), 0);
+}
+
 // .lookup should not invalidate iterator
 BOOST_AUTO_TEST_CASE(SurvivedIteratorAfterLookup)
 {
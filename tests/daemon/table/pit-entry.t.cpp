@@ -168,6 +168,41 @@ BOOST_AUTO_TEST_CASE(InOutRecords)
   BOOST_CHECK(entry.findOutRecord(*face2) == entry.out_end());
 }
 
+BOOST_AUTO_TEST_CASE(StableRecords)
+{
+  auto pools = boost::intrusive_ptr<SlabPoolSet>(new SlabPoolSet);
+  std::vector<shared_ptr<DummyFace>> faces;
+  for (int i = 0; i < 5; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+  }
+
+  auto interest = makeInterest("/AhUQOZbo");
+  Entry entry(*interest, pools);
+
+  // out-records outlive insertions beyond the inline capacity and deletions of other records
+  OutRecord* out0 = &*entry.insertOrUpdateOutRecord(*faces[0], *interest);
+  OutRecord* out1 = &*entry.insertOrUpdateOutRecord(*faces[1], *interest);
+  for (size_t i = 2; i < faces.size(); ++i) {
+    entry.insertOrUpdateOutRecord(*faces[i], *interest);
+  }
+  BOOST_CHECK_EQUAL(&*entry.findOutRecord(*faces[0]), out0);
+  BOOST_CHECK_EQUAL(&*entry.findOutRecord(*faces[1]), out1);
+
+  entry.deleteOutRecord(*faces[0]);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), 4);
+  BOOST_CHECK_EQUAL(&out1->getFace(), faces[1].get());
+
+  InRecord* in1 = &*entry.insertOrUpdateInRecord(*faces[1], *interest);
+  entry.insertOrUpdateInRecord(*faces[2], *interest);
+  entry.insertOrUpdateInRecord(*faces[3], *interest);
+  entry.deleteInRecord(entry.findInRecord(*faces[2]));
+  BOOST_CHECK_EQUAL(&entry.getInRecords().front(), in1);
+  BOOST_CHECK_EQUAL(&in1->getFace(), faces[1].get());
+
+  entry.clearInRecords();
+  BOOST_CHECK_EQUAL(entry.hasInRecords(), false);
+}
+
 const time::milliseconds lifetimes[] = {
   -1_ms, // unset
   1_ms,
@@ -26,8 +26,11 @@
 #include "benchmark-helpers.hpp"
 #include "table/cs.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <iostream>
+#include <random>
 
 #ifdef NFD_HAVE_VALGRIND
 #include <valgrind/callgrind.h>
@@ -210,4 +213,132 @@ BOOST_FIXTURE_TEST_CASE(FindCanBePrefixHit, CsBenchmarkFixture)
   std::cout << "find(CanBePrefix-hit) " << (N_INTERESTS * N_CHILDREN * REPEAT) << ": " << d << std::endl;
 }
 
+// insert, then find hit by exact name, with each table engine on a large cache
+BOOST_FIXTURE_TEST_CASE(FindExactHitEngines, CsBenchmarkFixture)
+{
+  constexpr size_t N_WORKLOAD = 1000000;
+  constexpr size_t REPEAT = 4;
+
+  auto interestWorkload = makeInterestWorkload(N_WORKLOAD);
+  auto dataWorkload = makeDataWorkload(N_WORKLOAD);
+
+  for (auto engine : {cs::TableEngine::ORDERED, cs::TableEngine::HASHED}) {
+    Cs largeCs(N_WORKLOAD);
+    largeCs.setEngine(engine);
+    for (const auto& data : dataWorkload) {
+      largeCs.insert(*data, false);
+    }
+    BOOST_REQUIRE(largeCs.size() == N_WORKLOAD);
+
+    time::microseconds d = timedRun([&] {
+      for (size_t j = 0; j < REPEAT; ++j) {
+        for (const auto& interest : interestWorkload) {
+          largeCs.find(*interest, [] (auto&&...) {}, [] (auto&&...) {});
+        }
+      }
+    });
+
+    std::cout << "find(exact-hit) engine=" << engine << " " << (N_WORKLOAD * REPEAT) << ": " << d << std::endl;
+  }
+}
+
+// insert into a full large cache, so that every insertion evicts an entry, with each policy
+BOOST_FIXTURE_TEST_CASE(InsertEvictPolicies, CsBenchmarkFixture)
+{
+  constexpr size_t N_ENTRIES = 1000000;
+
+  auto initialData = makeDataWorkload(N_ENTRIES);
+  auto evictingData = makeDataWorkload(N_ENTRIES, SimpleNameGenerator("/cs/benchmark/evict"));
+
+  for (const char* policyName : {"lru", "priority_fifo", "tinylfu"}) {
+    Cs largeCs(N_ENTRIES);
+    largeCs.setPolicy(cs::Policy::create(policyName));
+
+    time::microseconds d1 = timedRun([&] {
+      for (const auto& data : initialData) {
+        largeCs.insert(*data, false);
+      }
+    });
+    BOOST_REQUIRE(largeCs.size() == N_ENTRIES);
+
+    time::microseconds d2 = timedRun([&] {
+      for (const auto& data : evictingData) {
+        largeCs.insert(*data, false);
+      }
+    });
+    BOOST_REQUIRE(largeCs.size() == N_ENTRIES);
+
+    std::cout << "insert policy=" << policyName << " " << N_ENTRIES << ": " << d1 << std::endl;
+    std::cout << "insert-evict policy=" << policyName << " " << N_ENTRIES << ": " << d2 << std::endl;
+  }
+}
+
+// hit ratio of each replacement policy, under a Zipf workload with and without a sequential scan
+BOOST_FIXTURE_TEST_CASE(PolicyHitRatio, CsBenchmarkFixture)
+{
+  constexpr size_t N_CATALOG = CS_CAPACITY * 10;
+  constexpr size_t N_REQUESTS = CS_CAPACITY * 20;
+  constexpr double ZIPF_EXPONENT = 0.9;
+
+  std::vector<double> cdf(N_CATALOG);
+  double sum = 0.0;
+  for (size_t i = 0; i < N_CATALOG; ++i) {
+    sum += 1.0 / std::pow(static_cast<double>(i + 1), ZIPF_EXPONENT);
+    cdf[i] = sum;
+  }
+
+  auto catalogData = makeDataWorkload(N_CATALOG);
+  auto catalogInterests = makeInterestWorkload(N_CATALOG);
+  // scanned names are never requested again, so they are generated on the fly
+  SimpleNameGenerator genScanName("/cs/benchmark/scan");
+
+  // every other request is part of a scan if scanRatio is 0.5
+  for (double scanRatio : {0.0, 0.5}) {
+    for (const char* policyName : {"lru", "priority_fifo", "tinylfu"}) {
+      Cs policyCs;
+      policyCs.setPolicy(cs::Policy::create(policyName));
+      policyCs.setLimit(CS_CAPACITY);
+
+      std::mt19937 rng(0);
+      std::uniform_real_distribution<double> uniform(0.0, 1.0);
+      size_t nScans = 0, nHits = 0, nZipfRequests = 0, nZipfHits = 0;
+
+      time::microseconds d = timedRun([&] {
+        for (size_t i = 0; i < N_REQUESTS; ++i) {
+          if (uniform(rng) < scanRatio) {
+            Name name = genScanName(nScans++);
+            bool isHit = false;
+            policyCs.find(Interest(name), [&] (auto&&...) { isHit = true; }, [] (auto&&...) {});
+            if (isHit) {
+              ++nHits;
+            }
+            else {
+              policyCs.insert(*makeData(name), false);
+            }
+            continue;
+          }
+
+          size_t key = std::distance(cdf.begin(), std::lower_bound(cdf.begin(), cdf.end(), uniform(rng) * sum));
+          key = std::min(key, N_CATALOG - 1);
+          ++nZipfRequests;
+          bool isHit = false;
+          policyCs.find(*catalogInterests[key], [&] (auto&&...) { isHit = true; }, [] (auto&&...) {});
+          if (isHit) {
+            ++nHits;
+            ++nZipfHits;
+          }
+          else {
+            policyCs.insert(*catalogData[key], false);
+          }
+        }
+      });
+
+      std::cout << "hit-ratio policy=" << policyName << " scan=" << scanRatio
+                << " overall=" << static_cast<double>(nHits) / N_REQUESTS
+                << " zipf=" << static_cast<double>(nZipfHits) / std::max<size_t>(nZipfRequests, 1)
+                << " " << N_REQUESTS << ": " << d << std::endl;
+    }
+  }
+}
+
 } // namespace nfd::tests
@@ -24,6 +24,7 @@
  */
 
 #include "common/global.hpp"
+#include "face/datagram-batch.hpp"
 #include "face/face.hpp"
 #include "face/tcp-channel.hpp"
 #include "face/udp-channel.hpp"
@@ -32,6 +33,7 @@
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
@@ -44,12 +46,12 @@ namespace nfd::tests {
 class FaceBenchmark
 {
 public:
-  explicit
-  FaceBenchmark(const char* configFileName)
+  FaceBenchmark(const char* configFileName, size_t udpBatchSize, face::DatagramIoBackend udpIoBackend)
     : m_terminationSignalSet{getGlobalIoService(), SIGINT, SIGTERM}
     , m_tcpChannel{tcp::Endpoint{boost::asio::ip::tcp::v4(), 6363}, false,
                    [] (auto&&...) { return ndn::nfd::FACE_SCOPE_NON_LOCAL; }}
-    , m_udpChannel{udp::Endpoint{boost::asio::ip::udp::v4(), 6363}, 10_min, false, ndn::MAX_NDN_PACKET_SIZE}
+    , m_udpChannel{udp::Endpoint{boost::asio::ip::udp::v4(), 6363}, 10_min, false, ndn::MAX_NDN_PACKET_SIZE,
+                   udpBatchSize, udpIoBackend}
   {
     m_terminationSignalSet.async_wait([] (const auto& error, int) {
       if (!error)
@@ -64,7 +66,19 @@ public:
 
     m_udpChannel.listen(std::bind(&FaceBenchmark::onLeftFaceCreated, this, _1),
                         std::bind(&FaceBenchmark::onFaceCreationFailed, _1, _2));
-    std::clog << "Listening on " << m_udpChannel.getUri() << std::endl;
+    std::clog << "Listening on " << m_udpChannel.getUri()
+              << " (I/O batch size " << udpBatchSize << ", " << udpIoBackend << " I/O backend)" << std::endl;
+  }
+
+  ~FaceBenchmark()
+  {
+    if (m_nRelayedPackets == 0) {
+      return;
+    }
+    auto elapsed = time::duration_cast<time::microseconds>(time::steady_clock::now() - m_firstRelayTime);
+    double seconds = std::max<double>(elapsed.count(), 1) / 1e6;
+    std::clog << "Relayed " << m_nRelayedPackets << " packets in " << seconds << " seconds ("
+              << static_cast<uint64_t>(m_nRelayedPackets / seconds) << " packets/s)" << std::endl;
   }
 
 private:
@@ -125,17 +139,17 @@ private:
     auto port = boost::lexical_cast<uint16_t>(uriR.getPort());
     if (uriR.getScheme() == "tcp4") {
       m_tcpChannel.connect(tcp::Endpoint(addr, port), {},
-                           std::bind(&FaceBenchmark::onRightFaceCreated, faceL, _1),
+                           std::bind(&FaceBenchmark::onRightFaceCreated, this, faceL, _1),
                            std::bind(&FaceBenchmark::onFaceCreationFailed, _1, _2));
     }
     else if (uriR.getScheme() == "udp4") {
       m_udpChannel.connect(udp::Endpoint(addr, port), {},
-                           std::bind(&FaceBenchmark::onRightFaceCreated, faceL, _1),
+                           std::bind(&FaceBenchmark::onRightFaceCreated, this, faceL, _1),
                            std::bind(&FaceBenchmark::onFaceCreationFailed, _1, _2));
     }
   }
 
-  static void
+  void
   onRightFaceCreated(const shared_ptr<Face>& faceL, const shared_ptr<Face>& faceR)
   {
     std::clog << "Right face created: remote=" << faceR->getRemoteUri()
@@ -145,20 +159,31 @@ private:
     tieFaces(faceL, faceR);
   }
 
-  static void
+  void
   tieFaces(const shared_ptr<Face>& face1, const shared_ptr<Face>& face2)
   {
-    face1->afterReceiveInterest.connect([face2] (const auto& interest, const EndpointId&) {
+    face1->afterReceiveInterest.connect([this, face2] (const auto& interest, const EndpointId&) {
+      countRelayedPacket();
       face2->sendInterest(interest);
     });
-    face1->afterReceiveData.connect([face2] (const auto& data, const EndpointId&) {
+    face1->afterReceiveData.connect([this, face2] (const auto& data, const EndpointId&) {
+      countRelayedPacket();
       face2->sendData(data);
     });
-    face1->afterReceiveNack.connect([face2] (const auto& nack, const EndpointId&) {
+    face1->afterReceiveNack.connect([this, face2] (const auto& nack, const EndpointId&) {
+      countRelayedPacket();
       face2->sendNack(nack);
     });
   }
 
+  void
+  countRelayedPacket()
+  {
+    if (m_nRelayedPackets++ == 0) {
+      m_firstRelayTime = time::steady_clock::now();
+    }
+  }
+
   [[noreturn]] static void
   onFaceCreationFailed(uint32_t status, const std::string& reason)
   {
@@ -171,6 +196,8 @@ private:
   face::TcpChannel m_tcpChannel;
   face::UdpChannel m_udpChannel;
   std::vector<std::pair<FaceUri, FaceUri>> m_faceUris;
+  uint64_t m_nRelayedPackets = 0;
+  time::steady_clock::time_point m_firstRelayTime;
 };
 
 } // namespace nfd::tests
@@ -182,13 +209,44 @@ main(int argc, char** argv)
   std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
 #endif
 
-  if (argc != 2) {
-    std::cerr << "Usage: " << argv[0] << " <config-file>" << std::endl;
+  if (argc < 2 || argc > 4) {
+    std::cerr << "Usage: " << argv[0] << " <config-file> [udp-io-batch-size [udp-io-backend]]" << std::endl;
     return 2;
   }
 
+  size_t udpBatchSize = 1;
+  if (argc >= 3) {
+    try {
+      udpBatchSize = boost::lexical_cast<size_t>(argv[2]);
+    }
+    catch (const boost::bad_lexical_cast&) {
+      udpBatchSize = 0;
+    }
+    if (udpBatchSize < 1 || udpBatchSize > nfd::face::MAX_DATAGRAM_BATCH_SIZE) {
+      std::cerr << "ERROR: udp-io-batch-size must be between 1 and "
+                << nfd::face::MAX_DATAGRAM_BATCH_SIZE << std::endl;
+      return 2;
+    }
+  }
+
+  auto udpIoBackend = nfd::face::DatagramIoBackend::ASIO;
+  if (argc == 4) {
+    if (std::strcmp(argv[3], "io_uring") == 0) {
+#ifdef NFD_HAVE_IO_URING
+      udpIoBackend = nfd::face::DatagramIoBackend::IO_URING;
+#else
+      std::cerr << "ERROR: io_uring is not supported by this build" << std::endl;
+      return 2;
+#endif
+    }
+    else if (std::strcmp(argv[3], "asio") != 0) {
+      std::cerr << "ERROR: udp-io-backend must be either 'asio' or 'io_uring'" << std::endl;
+      return 2;
+    }
+  }
+
   try {
-    nfd::tests::FaceBenchmark bench{argv[1]};
+    nfd::tests::FaceBenchmark bench{argv[1], udpBatchSize, udpIoBackend};
 #ifdef NFD_HAVE_VALGRIND
     CALLGRIND_START_INSTRUMENTATION;
 #endif
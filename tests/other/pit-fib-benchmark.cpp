@@ -24,11 +24,18 @@
  */
 
 #include "benchmark-helpers.hpp"
+#include "face/face.hpp"
+#include "face/generic-link-service.hpp"
+#include "face/internal-transport.hpp"
+#include "fw/algorithm.hpp"
 #include "table/fib.hpp"
 #include "table/pit.hpp"
 
+#include <fstream>
 #include <iostream>
 
+#include <unistd.h>
+
 #ifdef NFD_HAVE_VALGRIND
 #include <valgrind/callgrind.h>
 #endif
@@ -148,4 +155,188 @@ BOOST_FIXTURE_TEST_CASE(SimpleExchanges, PitFibBenchmarkFixture)
   std::cout << time::duration_cast<time::microseconds>(t2 - t1) << std::endl;
 }
 
+// This test case compares computing the name hashes in every table lookup against
+// computing them once per packet and reusing them in the PIT and FIB lookups.
+// Names have 8 to 20 components, where the cost of hashing is most visible.
+BOOST_FIXTURE_TEST_CASE(SharedHashSequence, PitFibBenchmarkFixture)
+{
+  // number of Interest-Data exchanges for each name length
+  const size_t nRoundTrip = 200000;
+  // total amount of FIB entries
+  const size_t nFibEntries = 2000;
+  // length of fibPrefix, must be >= 1
+  const size_t fibPrefixLength = 4;
+
+  for (size_t nameLength : {8, 12, 16, 20}) {
+    interests.clear();
+    data.clear();
+    generatePacketsAndPopulateFib(nRoundTrip, nFibEntries, fibPrefixLength, nameLength, nameLength);
+
+    auto run = [&] (bool reuseHashes) {
+      auto t1 = time::steady_clock::now();
+
+      for (size_t i = 0; i < nRoundTrip; ++i) {
+        const Name& name = interests[i]->getName();
+        if (reuseHashes) {
+          // Interest and Data names are equal, so the same hashes serve both
+          auto hashes = name_tree::computeHashes(name, NameTree::getMaxDepth());
+          auto pitEntry = m_pit.insert(*interests[i], hashes).first;
+          m_fib.findLongestPrefixMatch(name, hashes);
+          m_pit.findAllDataMatches(*data[i], hashes);
+          m_pit.erase(pitEntry.get());
+        }
+        else {
+          auto pitEntry = m_pit.insert(*interests[i]).first;
+          m_fib.findLongestPrefixMatch(name);
+          m_pit.findAllDataMatches(*data[i]);
+          m_pit.erase(pitEntry.get());
+        }
+      }
+
+      auto t2 = time::steady_clock::now();
+      return time::duration_cast<time::microseconds>(t2 - t1);
+    };
+
+    // a warm-up pass brings the tables and packets into the cache, then the two modes
+    // alternate, with their order swapped in every round, so that neither is favored
+    run(false);
+    time::microseconds recompute{0}, reuse{0};
+    for (int round = 0; round < 4; ++round) {
+      bool reuseFirst = round % 2 != 0;
+      auto first = run(reuseFirst);
+      auto second = run(!reuseFirst);
+      recompute += reuseFirst ? second : first;
+      reuse += reuseFirst ? first : second;
+    }
+    std::cout << "name-length=" << nameLength
+              << " recompute=" << recompute
+              << " reuse=" << reuse << std::endl;
+  }
+}
+
+/** \return resident set size of this process in KiB, or 0 if unavailable
+ */
+static size_t
+getRssKib()
+{
+  std::ifstream statm("/proc/self/statm");
+  size_t vmPages = 0, rssPages = 0;
+  if (!(statm >> vmPages >> rssPages)) {
+    return 0;
+  }
+  return rssPages * static_cast<size_t>(::sysconf(_SC_PAGESIZE)) / 1024;
+}
+
+// This test case compares allocating name tree nodes and PIT entries with the
+// global allocator against allocating them from a SlabPoolSet.
+// Each mode runs on fresh tables; the RSS growth is measured while replyGap PIT entries are pending.
+// Memory released by the first mode may be reused by the second, understating its RSS growth;
+// the pool mode therefore runs first, so that the comparison does not favor it.
+BOOST_FIXTURE_TEST_CASE(SlabAllocation, PitFibBenchmarkFixture)
+{
+  // number of Interest-Data exchanges
+  const size_t nRoundTrip = 1000000;
+  // number of iterations between processing incoming Interest and processing incoming Data
+  const size_t replyGap = 100000;
+  // total amount of FIB entries
+  const size_t nFibEntries = 2000;
+
+  generatePacketsAndPopulateFib(nRoundTrip, nFibEntries, 1, 4, 4);
+  face::Face face(make_unique<face::GenericLinkService>(),
+                  make_unique<face::InternalForwarderTransport>());
+
+  auto run = [&] (const char* mode, boost::intrusive_ptr<SlabPoolSet> pools) {
+    NameTree nameTree(1024, pools);
+    Fib fib(nameTree);
+    Pit pit(nameTree);
+    for (size_t i = 0; i < nRoundTrip; i += nFibEntries) {
+      fib.insert(interests[i]->getName().getPrefix(1));
+    }
+
+    size_t rssBefore = getRssKib();
+    size_t rssPeak = rssBefore;
+    auto t1 = time::steady_clock::now();
+
+    for (size_t i = 0; i < nRoundTrip + replyGap; ++i) {
+      if (i < nRoundTrip) {
+        auto pitEntry = pit.insert(*interests[i]).first;
+        pitEntry->insertOrUpdateInRecord(face, *interests[i]);
+        fib.findLongestPrefixMatch(*pitEntry);
+        pitEntry->insertOrUpdateOutRecord(face, *interests[i]);
+      }
+      if (i == replyGap) {
+        rssPeak = getRssKib();
+      }
+      if (i >= replyGap) {
+        for (const auto& pitEntry : pit.findAllDataMatches(*data[i - replyGap])) {
+          pit.erase(pitEntry.get());
+        }
+      }
+    }
+
+    auto t2 = time::steady_clock::now();
+    std::cout << mode
+              << " time=" << time::duration_cast<time::microseconds>(t2 - t1)
+              << " rss-growth=" << std::max(rssPeak, rssBefore) - rssBefore << "KiB" << std::endl;
+  };
+
+  run("pool", boost::intrusive_ptr<SlabPoolSet>(new SlabPoolSet));
+  run("malloc", nullptr);
+}
+
+// This test case models the in-record and out-record operations of the forwarding pipelines.
+// Each Interest arrives from nDownstreams faces and is forwarded to nUpstreams faces; every
+// arrival scans the records for a duplicate Nonce and for the last expiring in-record.
+BOOST_FIXTURE_TEST_CASE(InOutRecords, PitFibBenchmarkFixture)
+{
+  // number of Interest-Data exchanges
+  const size_t nRoundTrip = 500000;
+  // number of pending PIT entries
+  const size_t replyGap = 10000;
+  const size_t nDownstreams = 2;
+  const size_t nUpstreams = 3;
+
+  generatePacketsAndPopulateFib(nRoundTrip, 2000, 1, 4, 4);
+
+  std::vector<unique_ptr<face::Face>> faces;
+  for (size_t i = 0; i < nDownstreams + nUpstreams; ++i) {
+    faces.push_back(make_unique<face::Face>(make_unique<face::GenericLinkService>(),
+                                            make_unique<face::InternalForwarderTransport>()));
+  }
+
+  size_t nDuplicates = 0;
+  auto lastExpiry = time::steady_clock::time_point::min();
+  auto t1 = time::steady_clock::now();
+
+  for (size_t i = 0; i < nRoundTrip + replyGap; ++i) {
+    if (i < nRoundTrip) {
+      const Interest& interest = *interests[i];
+      auto pitEntry = m_pit.insert(interest).first;
+      for (size_t j = 0; j < nDownstreams; ++j) {
+        if (fw::findDuplicateNonce(*pitEntry, interest.getNonce(), *faces[j]) != fw::DUPLICATE_NONCE_NONE) {
+          ++nDuplicates;
+        }
+        pitEntry->insertOrUpdateInRecord(*faces[j], interest);
+        lastExpiry = std::max_element(pitEntry->in_begin(), pitEntry->in_end(),
+          [] (const auto& a, const auto& b) { return a.getExpiry() < b.getExpiry(); })->getExpiry();
+      }
+      for (size_t j = nDownstreams; j < faces.size(); ++j) {
+        pitEntry->insertOrUpdateOutRecord(*faces[j], interest);
+      }
+    }
+    if (i >= replyGap) {
+      for (const auto& pitEntry : m_pit.findAllDataMatches(*data[i - replyGap])) {
+        pitEntry->clearInRecords();
+        pitEntry->deleteOutRecord(*faces.back());
+        m_pit.erase(pitEntry.get());
+      }
+    }
+  }
+
+  auto t2 = time::steady_clock::now();
+  BOOST_CHECK_GT(lastExpiry, time::steady_clock::time_point::min());
+  std::cout << time::duration_cast<time::microseconds>(t2 - t1)
+            << " duplicates=" << nDuplicates << std::endl;
+}
+
 } // namespace nfd::tests
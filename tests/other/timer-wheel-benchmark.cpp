@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "common/timer-wheel.hpp"
+
+#include <boost/asio/io_context.hpp>
+
+#include <functional>
+#include <iostream>
+#include <random>
+
+#ifdef NFD_HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd::tests {
+
+class TimerWheelBenchmarkFixture
+{
+protected:
+  TimerWheelBenchmarkFixture()
+  {
+#ifndef NDEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+
+    // PIT-like lifetimes, so that no timer fires during a run
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<int> lifetime(1000, 60000);
+    durations.reserve(N_TIMERS + N_CHURN);
+    for (size_t i = 0; i < N_TIMERS + N_CHURN; ++i) {
+      durations.emplace_back(lifetime(rng));
+    }
+    std::uniform_int_distribution<size_t> index(0, N_TIMERS - 1);
+    churnIndexes.reserve(N_CHURN);
+    for (size_t i = 0; i < N_CHURN; ++i) {
+      churnIndexes.push_back(index(rng));
+    }
+  }
+
+  static time::microseconds
+  timedRun(const std::function<void()>& f)
+  {
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+    auto t1 = time::steady_clock::now();
+    f();
+    auto t2 = time::steady_clock::now();
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+    return time::duration_cast<time::microseconds>(t2 - t1);
+  }
+
+protected:
+  static constexpr size_t N_TIMERS = 1000000;
+  static constexpr size_t N_CHURN = 4000000;
+
+  boost::asio::io_context io;
+  ndn::Scheduler scheduler{io};
+  std::vector<time::milliseconds> durations;
+  std::vector<size_t> churnIndexes;
+  size_t nFired = 0;
+};
+
+// fill with N_TIMERS live timers, then repeatedly cancel and reschedule a random one,
+// as the PIT does on every Interest retransmission and Measurements on every lifetime extension
+BOOST_FIXTURE_TEST_CASE(ScheduleCancelChurn, TimerWheelBenchmarkFixture)
+{
+  {
+    std::vector<ndn::scheduler::EventId> events(N_TIMERS);
+    auto fill = timedRun([&] {
+      for (size_t i = 0; i < N_TIMERS; ++i) {
+        events[i] = scheduler.schedule(durations[i], [this] { ++nFired; });
+      }
+    });
+    auto churn = timedRun([&] {
+      for (size_t i = 0; i < N_CHURN; ++i) {
+        auto& event = events[churnIndexes[i]];
+        event.cancel();
+        event = scheduler.schedule(durations[N_TIMERS + i], [this] { ++nFired; });
+      }
+    });
+    auto clear = timedRun([&] {
+      for (auto& event : events) {
+        event.cancel();
+      }
+    });
+
+    std::cout << "scheduler fill " << N_TIMERS << ": " << fill << std::endl;
+    std::cout << "scheduler churn " << N_CHURN << ": " << churn << std::endl;
+    std::cout << "scheduler cancel " << N_TIMERS << ": " << clear << std::endl;
+  }
+
+  {
+    TimerWheel wheel(scheduler);
+    std::vector<TimerWheel::Timer> timers(N_TIMERS);
+    auto fill = timedRun([&] {
+      for (size_t i = 0; i < N_TIMERS; ++i) {
+        wheel.schedule(timers[i], durations[i], [this] { ++nFired; });
+      }
+    });
+    BOOST_REQUIRE_EQUAL(wheel.size(), N_TIMERS);
+    auto churn = timedRun([&] {
+      for (size_t i = 0; i < N_CHURN; ++i) {
+        wheel.schedule(timers[churnIndexes[i]], durations[N_TIMERS + i], [this] { ++nFired; });
+      }
+    });
+    auto clear = timedRun([&] {
+      for (auto& timer : timers) {
+        timer.cancel();
+      }
+    });
+    BOOST_REQUIRE_EQUAL(wheel.size(), 0);
+
+    std::cout << "wheel fill " << N_TIMERS << ": " << fill << std::endl;
+    std::cout << "wheel churn " << N_CHURN << ": " << churn << std::endl;
+    std::cout << "wheel cancel " << N_TIMERS << ": " << clear << std::endl;
+  }
+
+  BOOST_CHECK_EQUAL(nFired, 0);
+}
+
+} // namespace nfd::tests